@@ -0,0 +1,6 @@
+-- Adds a unique {region/type/day} key to mktHistory, so daily aggregates can be saved with ON DUPLICATE KEY UPDATE.
+--  duplicate rows from older history imports are dropped.
+-- +migrate Up
+ALTER IGNORE TABLE mktHistory ADD UNIQUE KEY regionTypeDate (regionID, typeID, historyDate);
+-- +migrate Down
+ALTER TABLE mktHistory DROP INDEX regionTypeDate;
@@ -131,6 +131,18 @@ namespace Market {
         float price;
     };
 
+    // one day of price history for a {region/type}, as saved in mktHistory
+    struct HistoryData {
+        uint16 typeID;
+        uint32 regionID;
+        uint32 volume;
+        uint32 orders;
+        int64 historyDate;
+        double lowPrice;
+        double highPrice;
+        double avgPrice;
+    };
+
     // POD structure for mineral data used in pricing method
     struct matlData {
         uint16 typeID;
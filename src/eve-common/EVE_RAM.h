@@ -102,6 +102,33 @@ namespace EvERam {
         EVEItemFlags outputFlag;
     };
 
+    /* POD structure for running job data, as listed by ramProxy.GetJobs2 */
+    struct JobData {
+        int8 activity;
+        int8 status;
+        int16 pLevel;
+        int16 mLevel;
+        uint16 outputFlag;
+        uint16 installedTypeID;
+        uint16 outputTypeID;
+        uint16 containerTypeID;
+        int32 runs;
+        int32 licensedRuns;
+        uint32 jobID;
+        uint32 assemblyLineID;
+        uint32 containerID;
+        uint32 installedItemID;
+        uint32 installedItemOwnerID;
+        uint32 ownerID;
+        uint32 installerID;
+        uint32 solarSystemID;
+        uint32 eventID;
+        int64 installTime;
+        int64 beginTime;
+        int64 pauseTime;
+        int64 endTime;
+    };
+
     /* POD structure for blueprint data */
     struct bpData {
         bool copy :1;
@@ -31,20 +31,9 @@
 #include "log/logsys.h"
 #include "utils/misc.h"
 #include "utils/utils_time.h"
-//#include "../eve-server/Profiler.h"
 
 #define COLUMN_BOUNDS_CHECKING
 
-// this is to enable profile tracking for db
-#define sProfiler ( Profiler::get() )
-
-class Profiler
-: public Singleton<Profiler>
-{
-public:
-    void AddTime(uint8 key, double value);
-};
-
 
 DBcore::DBcore()
 : mysql(nullptr),
@@ -54,7 +43,8 @@ pReconnect(false),
 pProfile(false),
 pCompress(false),
 pSSL(false),
-pPort(3306)
+pPort(3306),
+pProfileHook(nullptr)
 {
     mysql_thread_init();    // this is for each thread used for db connections
     mysql = mysql_init(nullptr);
@@ -351,8 +341,8 @@ bool DBcore::DoQuery_locked(DBerror &err, const char *query, int querylen, bool
 
     err.ClearError();
 
-    if (pProfile)
-        sProfiler.AddTime(9, GetTimeUSeconds() - profileStartTime);
+    if (pProfile and (pProfileHook != nullptr))
+        pProfileHook(GetTimeUSeconds() - profileStartTime);
 
     return true;
 }
@@ -171,6 +171,10 @@ public:
 
     eStatus GetStatus() const { return pStatus; }
 
+    // called with each successful query's time in us, when profiling is on.  eve-core cannot see the server's profiler
+    typedef void (*ProfileHook)(double time);
+    void    SetProfileHook(ProfileHook hook) { pProfileHook = hook; }
+
 protected:
     MYSQL*  getMySQL()              { return mysql; }
 
@@ -194,6 +198,7 @@ private:
     bool    pSSL;
 
     int16   pPort;
+    ProfileHook pProfileHook;
 
     std::string pHost;
     std::string pUser;
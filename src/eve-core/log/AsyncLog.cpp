@@ -0,0 +1,290 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name AsyncLog.cpp
+ *   per-thread ring buffers and a writer thread for console and logfile output
+ */
+
+#include "eve-core.h"
+
+#include "log/AsyncLog.h"
+#include "log/LogNew.h"
+#include "log/logsys.h"
+
+/*
+ * each ring is single-producer (its owning thread) and single-consumer (the writer).
+ * head and tail only ever increase, and are masked to index the buffer.
+ * records are 16-byte aligned, so there is always room for a header at the end of the buffer.
+ *   a record that would wrap is placed at the start, after a skip record filling the end.
+ */
+struct AsyncLog::Ring
+{
+    static const uint32 size = 0x20000;     // 128k
+    static const uint32 mask = size - 1;
+
+    struct Record {
+        uint32 size;        // whole record, aligned
+        uint16 length;      // text only
+        uint8 target;
+        uint8 skip;         // padding to end of buffer
+        int64 time;
+    };
+
+    std::atomic<int64> head;   // written by owning thread
+    std::atomic<int64> tail;   // written by writer
+    std::atomic<bool> closed;   // owning thread has exited
+    char data[size];
+
+    Ring() : head(0), tail(0), closed(false) { }
+};
+
+namespace {
+    // marks this thread's ring as closed when the thread exits, so the writer can free it once empty
+    struct RingHolder {
+        AsyncLog::Ring* pRing;
+        RingHolder() : pRing(nullptr) { }
+        ~RingHolder() {
+            if (pRing != nullptr)
+                pRing->closed.store(true, std::memory_order_release);
+            // anything logged later by this thread gets a new ring
+            pRing = nullptr;
+        }
+    };
+    thread_local RingHolder t_ring;
+}
+
+std::atomic<bool> AsyncLog::s_running(false);
+
+AsyncLog::AsyncLog()
+: m_block(false),
+m_dropped(0),
+m_written(0),
+m_reported(0),
+m_writers(0),
+m_thread(nullptr),
+m_lastTime(0),
+m_lastDay(-1)
+{
+    m_rings.clear();
+    memset(m_timeBuf, 0, sizeof(m_timeBuf));
+}
+
+AsyncLog::~AsyncLog()
+{
+    Stop();
+    for (auto cur : m_rings)
+        delete cur;
+    m_rings.clear();
+}
+
+void AsyncLog::Start(bool block)
+{
+    if (m_thread != nullptr)
+        return;
+
+    m_block = block;
+    s_running.store(true, std::memory_order_release);
+    m_thread = new std::thread([this] { Run(); });
+}
+
+void AsyncLog::Stop()
+{
+    if (m_thread == nullptr)
+        return;
+
+    /* a writer that saw s_running before this store may still be copying into its ring.
+     * Write() counts itself in before checking s_running, and both are seq_cst, so once the count is 0
+     * every later Write() sees s_running false.
+     * the wait is capped, as Stop() is also called from the signal handler, which may have interrupted a Write() on this thread.
+     */
+    s_running.store(false);
+    std::chrono::steady_clock::time_point limit(std::chrono::steady_clock::now() + std::chrono::seconds(1));
+    while ((m_writers.load() > 0) and (std::chrono::steady_clock::now() < limit))
+        std::this_thread::yield();
+
+    m_thread->join();
+    SafeDelete(m_thread);
+
+    // anything written after the writer's final pass
+    MutexLock lock(m_mutex);
+    for (auto cur : m_rings)
+        Drain(cur);
+    sLog.Flush();
+    log_flush();
+}
+
+AsyncLog::Ring* AsyncLog::GetRing()
+{
+    if (t_ring.pRing != nullptr)
+        return t_ring.pRing;
+
+    t_ring.pRing = new Ring();
+    MutexLock lock(m_mutex);
+    m_rings.push_back(t_ring.pRing);
+    return t_ring.pRing;
+}
+
+namespace {
+    // counts a thread in Write() for Stop()
+    struct WriterGuard {
+        std::atomic<int32>& count;
+        WriterGuard(std::atomic<int32>& c) : count(c)  { count.fetch_add(1); }
+        ~WriterGuard()                                  { count.fetch_sub(1); }
+    };
+}
+
+bool AsyncLog::Write(Target target, const char* text, size_t length)
+{
+    WriterGuard guard(m_writers);
+    if (!s_running.load())
+        return false;
+
+    // one message may not take more than a quarter of the ring
+    if (length > Ring::size / 4)
+        length = Ring::size / 4;
+
+    Ring* pRing(GetRing());
+    uint32 need((sizeof(Ring::Record) + length + 15) & ~15u);
+    int64 head(pRing->head.load(std::memory_order_relaxed));
+    uint32 pos(head & Ring::mask), toEnd(Ring::size - pos);
+    uint32 total(need + (toEnd < need ? toEnd : 0));
+
+    while (Ring::size - (head - pRing->tail.load(std::memory_order_acquire)) < total) {
+        if (!m_block) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        if (!s_running.load(std::memory_order_acquire))
+            return false;
+        std::this_thread::yield();
+    }
+
+    Ring::Record* pRec(nullptr);
+    if (toEnd < need) {
+        pRec = reinterpret_cast<Ring::Record*>(&pRing->data[pos]);
+        pRec->size = toEnd;
+        pRec->skip = 1;
+        head += toEnd;
+        pos = 0;
+    }
+
+    pRec = reinterpret_cast<Ring::Record*>(&pRing->data[pos]);
+    pRec->size = need;
+    pRec->length = (uint16)length;
+    pRec->target = (uint8)target;
+    pRec->skip = 0;
+    pRec->time = time(nullptr);
+    memcpy(&pRing->data[pos + sizeof(Ring::Record)], text, length);
+
+    pRing->head.store(head + need, std::memory_order_release);
+    return true;
+}
+
+void AsyncLog::FormatTime(time_t time, char* buf)
+{
+    tm t;
+    localtime_r(&time, &t);
+    snprintf(buf, 9, "%02u:%02u:%02u", t.tm_hour, t.tm_min, t.tm_sec);
+}
+
+uint32 AsyncLog::Drain(Ring* pRing)
+{
+    uint32 count(0);
+    int64 tail(pRing->tail.load(std::memory_order_relaxed));
+    int64 head(pRing->head.load(std::memory_order_acquire));
+    Ring::Record* pRec(nullptr);
+    while (tail < head) {
+        pRec = reinterpret_cast<Ring::Record*>(&pRing->data[tail & Ring::mask]);
+        if (pRec->skip == 0) {
+            if (pRec->time != m_lastTime) {
+                m_lastTime = pRec->time;
+                FormatTime(m_lastTime, m_timeBuf);
+            }
+            const char* text(reinterpret_cast<const char*>(pRec) + sizeof(Ring::Record));
+            if (pRec->target == TARGET_NEWLOG) {
+                sLog.WriteOut(m_timeBuf, text, pRec->length);
+            } else {
+                log_write_out(m_timeBuf, text, pRec->length);
+            }
+            ++count;
+        }
+        tail += pRec->size;
+    }
+    pRing->tail.store(tail, std::memory_order_release);
+    m_written.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+void AsyncLog::Run()
+{
+    uint32 count(0);
+    tm t;
+    time_t now(0);
+    while (s_running.load(std::memory_order_acquire)) {
+        count = 0;
+        {
+            MutexLock lock(m_mutex);
+            for (std::vector<Ring*>::iterator itr = m_rings.begin(); itr != m_rings.end();) {
+                count += Drain(*itr);
+                // closed is set after the thread's last write, so an empty closed ring is done
+                if ((*itr)->closed.load(std::memory_order_acquire)
+                and ((*itr)->tail.load(std::memory_order_relaxed) == (*itr)->head.load(std::memory_order_acquire))) {
+                    delete *itr;
+                    itr = m_rings.erase(itr);
+                } else {
+                    ++itr;
+                }
+            }
+        }
+
+        if (count > 0) {
+            sLog.Flush();
+            log_flush();
+        }
+
+        int64 dropped(m_dropped.load(std::memory_order_relaxed));
+        if (dropped != m_reported) {
+            sLog.Warning("Log", "%li log messages dropped (%li total).", dropped - m_reported, dropped);
+            m_reported = dropped;
+        }
+
+        // new logfile each day
+        now = time(nullptr);
+        localtime_r(&now, &t);
+        if ((m_lastDay != -1) and (m_lastDay != t.tm_yday))
+            sLog.Rotate();
+        m_lastDay = t.tm_yday;
+
+        if (count == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    // final pass for anything queued before stopping
+    MutexLock lock(m_mutex);
+    for (auto cur : m_rings)
+        Drain(cur);
+    sLog.Flush();
+    log_flush();
+}
@@ -0,0 +1,136 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name AsyncLog.h
+ *   per-thread ring buffers and a writer thread for console and logfile output
+ */
+
+#ifndef __LOG__ASYNC_LOG_H__INCL__
+#define __LOG__ASYNC_LOG_H__INCL__
+
+#include <atomic>
+
+#include "utils/Singleton.h"
+#include "threading/Mutex.h"
+
+/**
+ * @brief asynchronous output for NewLog and logsys.
+ *
+ * messages are still formatted on the calling thread, but are then copied into a
+ * lock-free ring buffer owned by that thread, and a writer thread does all console
+ * and file output, timestamps, flushing and daily logfile rotation.
+ * each thread gets its own ring on its first message, so producers never contend.
+ * when a ring is full, the message is dropped and counted, or the caller waits for
+ * the writer, as set in Start().
+ * until Start() is called (or after Stop()), Write() returns false and callers print directly.
+ * callers check IsRunning() first, so nothing touches the instance while it is being destroyed at exit.
+ * Stop() waits for writers already past that check, so no message is written into a ring after its final drain.
+ * queued messages are lost if the process dies without Stop(), so this is off by default.
+ */
+class AsyncLog
+: public Singleton< AsyncLog >
+{
+public:
+    AsyncLog();
+    ~AsyncLog();
+
+    /// where a message is sent by the writer thread
+    enum Target {
+        TARGET_NEWLOG = 0,  ///< NewLog::WriteOut(), console with color and NewLog's logfile
+        TARGET_LOGSYS = 1   ///< log_write_out(), console and logsys logfile
+    };
+
+    /**
+     * @brief Starts the writer thread.
+     *
+     * @param[in] block true to have callers wait when their ring is full, false to drop the message.
+     */
+    void Start( bool block );
+    /**
+     * @brief Writes everything still queued and stops the writer thread.
+     */
+    void Stop();
+
+    /**
+     * @brief Queues a formatted message for the writer thread.
+     *
+     * @param[in] target where the message is to be written.
+     * @param[in] text   the message, without timestamp.
+     * @param[in] length length of text.
+     *
+     * @retval true  The message was queued (or dropped).
+     * @retval false The writer is not running; caller should print it directly.
+     */
+    bool Write( Target target, const char* text, size_t length );
+
+    static bool IsRunning()                             { return s_running.load( std::memory_order_acquire ); }
+    /// messages dropped because their ring was full
+    int64 GetDropped()                                 { return m_dropped.load( std::memory_order_relaxed ); }
+    /// messages written out by the writer thread
+    int64 GetWritten()                                 { return m_written.load( std::memory_order_relaxed ); }
+
+    /**
+     * @brief Formats a timestamp as used by both log systems.
+     *
+     * @param[in]  time the time to format.
+     * @param[out] buf  at least 9 chars.
+     */
+    static void FormatTime( time_t time, char* buf );
+
+    /// one thread's message buffer
+    struct Ring;
+
+private:
+
+    Ring* GetRing();
+    // returns number of messages written
+    uint32 Drain( Ring* pRing );
+    void Run();
+
+    static std::atomic<bool> s_running;
+    bool m_block;
+    std::atomic<int64> m_dropped;
+    std::atomic<int64> m_written;
+    int64 m_reported;
+    /// threads inside Write().  Stop() waits for this to reach 0
+    std::atomic<int32> m_writers;
+
+    std::thread* m_thread;
+
+    /// protects m_rings.  only taken when a thread makes its ring, and by the writer
+    Mutex m_mutex;
+    std::vector<Ring*> m_rings;
+
+    /// last timestamp formatted by the writer
+    time_t m_lastTime;
+    char m_timeBuf[ 16 ];
+    int m_lastDay;
+};
+
+/// Evaluates to an AsyncLog instance.
+#define sAsyncLog \
+    ( AsyncLog::get() )
+
+#endif /* !__LOG__ASYNC_LOG_H__INCL__ */
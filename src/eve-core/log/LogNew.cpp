@@ -25,6 +25,7 @@
 
 #include "eve-core.h"
 
+#include "log/AsyncLog.h"
 #include "log/LogNew.h"
 #include "log/logtypes.h"
 #include "log/logsys.h"
@@ -247,6 +248,31 @@ void NewLog::PrintMsg( Color color, char pfx, const char* source, const char* fm
     if( !m_initialized )
         return;
 
+#ifndef HAVE_WINDOWS_H
+    // build the whole message here, so it can be handed to the async writer in one piece
+    char buf[ 0x1000 ];
+    // room for newline and reset of color
+    const size_t max = sizeof( buf ) - 8;
+    int size = 0;
+    if( source && *source )
+        size = snprintf( buf, max, "%s %c %s%s: %s", COLOR_TABLE[ color ], pfx, COLOR_TABLE[ COLOR_WHITE ], source, COLOR_TABLE[ color ] );
+    else
+        size = snprintf( buf, max, "%s %c ", COLOR_TABLE[ color ], pfx );
+    size_t length = ( size < 0 ? 0 : std::min( (size_t)size, max - 1 ) );
+
+    size = vsnprintf( &buf[ length ], max - length, fmt, ap );
+    length += ( size < 0 ? 0 : std::min( (size_t)size, max - length - 1 ) );
+
+    buf[ length++ ] = '\n';
+    length += snprintf( &buf[ length ], sizeof( buf ) - length, "%s", COLOR_TABLE[ COLOR_DEFAULT ] );
+
+    if( !AsyncLog::IsRunning() || !sAsyncLog.Write( AsyncLog::TARGET_NEWLOG, buf, length ) )
+    {
+        char time[ 16 ];
+        AsyncLog::FormatTime( ::time( NULL ), time );
+        WriteOut( time, buf, length );
+    }
+#else /* HAVE_WINDOWS_H */
     MutexLock l( mMutex );
 
     PrintTime();
@@ -266,6 +292,53 @@ void NewLog::PrintMsg( Color color, char pfx, const char* source, const char* fm
     Print( "\n" );
 
     SetColor( COLOR_DEFAULT );
+#endif /* HAVE_WINDOWS_H */
+}
+
+void NewLog::WriteOut( const char* time, const char* text, size_t length )
+{
+    MutexLock l( mMutex );
+
+    ::fputs( time, stdout );
+    ::fwrite( text, 1, length, stdout );
+
+    if( NULL != mLogfile )
+    {
+        ::fputs( time, mLogfile );
+        // skip color codes
+        size_t begin = 0;
+        for( size_t i = 0; i < length; ++i )
+        {
+            if( text[ i ] != '\033' )
+                continue;
+            ::fwrite( &text[ begin ], 1, i - begin, mLogfile );
+            while( ( i < length ) && ( text[ i ] != 'm' ) )
+                ++i;
+            begin = i + 1;
+        }
+        if( begin < length )
+            ::fwrite( &text[ begin ], 1, length - begin, mLogfile );
+
+#ifndef NDEBUG
+        // flush immediately so logfile is accurate if we crash
+        fflush( mLogfile );
+#endif /* !NDEBUG */
+    }
+}
+
+void NewLog::Flush()
+{
+    MutexLock l( mMutex );
+
+    fflush( stdout );
+    if( NULL != mLogfile )
+        fflush( mLogfile );
+}
+
+void NewLog::Rotate()
+{
+    if( !mLogPath.empty() )
+        SetLogfileDefault( mLogPath );
 }
 
 void NewLog::PrintTime()
@@ -331,6 +404,8 @@ void NewLog::SetLogfileDefault(std::string logPath)
 {
     MutexLock l( mMutex );
 
+    mLogPath = logPath;
+
     // set initial log system time
     SetTime( time( NULL ) );
 
@@ -346,6 +421,9 @@ void NewLog::SetLogfileDefault(std::string logPath)
     //          t.tm_mday, t.tm_mon + 1, t.tm_year + 1900, t.tm_hour, t.tm_min );
 
     // this isnt accurate as log system is not initalized yet.  all Print calls will fail
-    if (!SetLogfile(filename))
+    if (!SetLogfile(filename)) {
+        // not while locked, as the async writer may be waiting on this lock
+        l.Unlock();
         Warning( "Log", "Unable to open logfile '%s': %s", filename, strerror( errno ) );
+    }
 }
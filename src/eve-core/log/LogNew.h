@@ -157,6 +157,26 @@ public:
      */
     void SetTime( time_t time ) { mTime = time; }
 
+    /**
+     * @brief Writes a formatted message to console and logfile.
+     *
+     * Called by the async log writer, or directly when it is not running.
+     * Color codes in @a text are written to console only.
+     *
+     * @param[in] time   the timestamp.
+     * @param[in] text   the message, with color codes.
+     * @param[in] length length of text.
+     */
+    void WriteOut( const char* time, const char* text, size_t length );
+    /**
+     * @brief Flushes console and logfile.
+     */
+    void Flush();
+    /**
+     * @brief Closes the current logfile and opens a new one with the current date.
+     */
+    void Rotate();
+
 protected:
     /// A convenience color enum.
     enum Color
@@ -225,6 +245,8 @@ protected:
 
     /// The active logfile.
     FILE* mLogfile;
+    /// Directory of the default logfile.
+    std::string mLogPath;
     /// Current timestamp.
     time_t mTime; // crap there should be 1 generic easy to understand time manager.
     /// Protection against concurrent log messages
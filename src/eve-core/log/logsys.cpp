@@ -25,6 +25,7 @@
 
 #include "eve-core.h"
 
+#include "log/AsyncLog.h"
 #include "log/logsys.h"
 #include "utils/utils_hex.h"
 #include "threading/Mutex.h"
@@ -83,52 +84,59 @@ void log_messageVA(LogType type, const char *fmt, va_list args) {
 
 extern void log_messageVA( LogType type, uint32 iden, const char *fmt, va_list args )
 {
-    /* allocate enough room for a med message  (changed from 4k to 1k) */
-    size_t log_msg_size = 0x400;
+    /* enough room for a med message.  longer messages are truncated */
+    char log_msg[0x400];
+    /* room for the newline */
+    const size_t log_msg_size = sizeof(log_msg) - 1;
     size_t log_msg_index = 0;
-    char* log_msg = (char*)malloc(log_msg_size);
 
-    /* handle the time part.. cross platform */
-    tm t;
-    time_t tTime;
-    time(&tTime);
-    localtime_r( &tTime, &t );
-    int va_size = snprintf(&log_msg[log_msg_index], log_msg_size, "%02u:%02u:%02u [%s] ", t.tm_hour, t.tm_min, t.tm_sec, log_type_info[type].display_name );
-
-    /* store the resulting size */
-    log_msg_size-=va_size;
-    log_msg_index+=va_size;
+    /* timestamp is added when written */
+    int va_size = snprintf(log_msg, log_msg_size, " [%s] ", log_type_info[type].display_name );
+    log_msg_index += (va_size < 0 ? 0 : std::min((size_t)va_size, log_msg_size - 1));
 
     /* add the required spaces */
-    for (uint32 i = 0; i < iden; i++)
+    for (uint32 i = 0; (i < iden) and (log_msg_index < log_msg_size - 1); ++i)
         log_msg[log_msg_index++] = ' ';
 
-    /* make sure the resulting size is corrected */
-    log_msg_size-=iden;
-
     /* put in the rest of the va stuff */
-    va_size = vsnprintf(&log_msg[log_msg_index], log_msg_size, fmt, args);
-    log_msg_index+=va_size;
+    va_size = vsnprintf(&log_msg[log_msg_index], log_msg_size - log_msg_index, fmt, args);
+    log_msg_index += (va_size < 0 ? 0 : std::min((size_t)va_size, log_msg_size - log_msg_index - 1));
 
     /* make sure that there is a new line at the end */
     log_msg[log_msg_index++] = '\n';
-    log_msg[log_msg_index++] = '\0';
 
+    if (AsyncLog::IsRunning() and sAsyncLog.Write(AsyncLog::TARGET_LOGSYS, log_msg, log_msg_index))
+        return;
+
+    char time[16];
+    AsyncLog::FormatTime(::time(nullptr), time);
+    log_write_out(time, log_msg, log_msg_index);
+}
+
+void log_write_out( const char* time, const char* text, size_t length )
+{
     MutexLock lock(mLogSys);
 
-    fputs(log_msg, stdout);
+    fputs(time, stdout);
+    fwrite(text, 1, length, stdout);
 
     //print into the logfile (if any)
     if (logsys_log_file != nullptr) {
-        //fprintf(logsys_log_file, "%s\n", message.c_str());
-        fputs(log_msg, logsys_log_file);
-        //keep the logfile updated
-        fflush(logsys_log_file);
+        fputs(time, logsys_log_file);
+        fwrite(text, 1, length, logsys_log_file);
+        //keep the logfile updated when writing directly.  async writer flushes after each batch
+        if (!AsyncLog::IsRunning())
+            fflush(logsys_log_file);
     }
+}
 
-    lock.Unlock();
+void log_flush()
+{
+    MutexLock lock(mLogSys);
 
-    free(log_msg);
+    fflush(stdout);
+    if (logsys_log_file != nullptr)
+        fflush(logsys_log_file);
 }
 
 void log_enable( LogType t )
@@ -162,7 +170,9 @@ bool log_close_logfile()
     MutexLock lock(mLogSys);
     if (!logsys_log_file)
         return true;
-    return ( 0 == fclose( logsys_log_file ) );
+    FILE* file(logsys_log_file);
+    logsys_log_file = nullptr;
+    return ( 0 == fclose( file ) );
 }
 
 bool load_log_settings(const char *filename) {
@@ -87,6 +87,9 @@ extern bool load_log_settings( const char* filename );
 extern void log_message(LogType type, const char *fmt, ...);
 extern void log_messageVA(LogType type, const char *fmt, va_list args);
 extern void log_messageVA(LogType type, uint32 iden, const char *fmt, va_list args);
+// writes a formatted message to console and logfile.  called by the async log writer, or directly when it is not running
+extern void log_write_out(const char* time, const char* text, size_t length);
+extern void log_flush();
 extern void log_hex(LogType type, const void *data, unsigned long length, unsigned char padding=4);
 extern void log_phex(LogType type, const void *data, unsigned long length, unsigned char padding=4);
 
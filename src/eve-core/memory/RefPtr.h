@@ -56,7 +56,7 @@ public:
      *
      * @param[in] initRefCount Initial reference count.
      */
-    RefObject(uint16 initRefCount)
+    RefObject(uint32 initRefCount)
     : mRefCount(initRefCount),
     mDeleted(false)
     {
@@ -70,34 +70,37 @@ public:
      */
     virtual ~RefObject()
     {
+#ifndef NDEBUG
         if (mDeleted) {
             _log(REFPTR__ERROR, "~RefObject() - mDeleted: true");
             EvE::traceStack();
         }
+#endif /* !NDEBUG */
 
         mDeleted = true;
     }
 
-    uint16 GetCount()           { return mRefCount; }
+    uint32 GetCount()           { return mRefCount; }
     bool IsDeleted()            { return mDeleted; }
 
 protected:
     /**
      * @brief Increments reference count of object by one.
+     *
+     * The deleted-object check is only compiled into debug builds;
+     * release builds pay a single increment here.
      */
     void IncRef() const
     {
+#ifndef NDEBUG
         // ---modulefix; issue with installing and uninstalling modules caused a soft freeze and unable to make changes to modules in fit screen.
         if (mDeleted) {
             _log(REFPTR__ERROR, "IncRef() - Attempted to increase ref count on deleted object! Current Count: %u", mRefCount);
             std::cerr << "FATAL: IncRef() called on deleted object! Type: " << typeid(*this).name() << std::endl;
             EvE::traceStack();
-
-            // Optional: Either abort to catch error early, or return to avoid crashing.
-            // abort(); // Uncomment for hard fail (debug build)
-            return; // Production builds, silently fail
+            return;
         }
-        //Removed assert(mDeleted == false); --causing constant server hang, when installing and removed modules from ships.
+#endif /* !NDEBUG */
         ++mRefCount;
     }
     /**
@@ -107,15 +110,16 @@ protected:
      */
     void DecRef() const
     {
+#ifndef NDEBUG
         if (mDeleted) {
             // ---modulefix; issue with installing and uninstalling modules caused a soft freeze and unable to make changes to modules in fit screen.
-            _log(REFPTR__ERROR, "IncRef() - Attempted to increase ref count on deleted object! Current Count: %u", mRefCount);
-            std::cerr << "FATAL: IncRef() called on deleted object! Type: " << typeid(*this).name() << std::endl;
+            _log(REFPTR__ERROR, "DecRef() - Attempted to decrease ref count on deleted object! Current Count: %u", mRefCount);
+            std::cerr << "FATAL: DecRef() called on deleted object! Type: " << typeid(*this).name() << std::endl;
             EvE::traceStack();
             return;
         }
+#endif /* !NDEBUG */
 
-        // Removed assert(mDeleted == false);
         assert(mRefCount > 0);
         --mRefCount;
 
@@ -125,7 +129,9 @@ protected:
 
 private:
     /// Reference count of instance.
-    mutable uint16 mRefCount;
+    // 32 bits costs nothing here (padded to the vptr either way), and shared objects like
+    // PyStatic's None can pick up more than 64k refs in a long run, which wrapped a 16 bit count
+    mutable uint32 mRefCount;
     mutable bool mDeleted;
 };
 
@@ -176,28 +182,66 @@ public:
         if (*this)
             (*this)->IncRef();
     }
+    /**
+     * @brief Move constructor.
+     *
+     * Takes over the reference held by oth; no refcount traffic.
+     *
+     * @param[in] oth Object to take the reference from.
+     */
+    RefPtr(RefPtr&& oth) noexcept
+    : mPtr(oth.mPtr)
+    {
+        oth.mPtr = nullptr;
+    }
+    /**
+     * @brief Casting move constructor.
+     *
+     * @param[in] oth Object to take the reference from.
+     */
+    template<typename Y>
+    RefPtr(RefPtr<Y>&& oth) noexcept
+    : mPtr(oth.release())
+    {
+    }
 
     /**
      * @brief Destructor, releases reference.
      */
-    virtual ~RefPtr()
+    ~RefPtr()
     {
-        if (*this)
-            (*this)->DecRef();
+        if (mPtr != nullptr)
+            mPtr->DecRef();
     }
 
     /**
      * @brief Move operator.
      *
-     * @param[in] oth Object to move.
+     * @param[in] oth Object to take the reference from.
      */
-    RefPtr& operator=(const RefPtr&& oth)
+    RefPtr& operator=(RefPtr&& oth) noexcept
     {
-        if (*this)
-            (*this)->DecRef();
-        mPtr = std::move(oth.get());
-        if (*this)
-            (*this)->IncRef();
+        if (this != &oth) {
+            X* old(mPtr);
+            mPtr = oth.mPtr;
+            oth.mPtr = nullptr;
+            if (old != nullptr)
+                old->DecRef();
+        }
+        return *this;
+    }
+    /**
+     * @brief Casting move operator.
+     *
+     * @param[in] oth Object to take the reference from.
+     */
+    template<typename Y>
+    RefPtr& operator=(RefPtr<Y>&& oth) noexcept
+    {
+        X* old(mPtr);
+        mPtr = oth.release();
+        if (old != nullptr)
+            old->DecRef();
         return *this;
     }
     /**
@@ -207,11 +251,13 @@ public:
      */
     RefPtr& operator=(const RefPtr& oth)
     {
-        if (*this)
-            (*this)->DecRef();
-        mPtr = oth.get();
-        if (*this)
-            (*this)->IncRef();
+        // take the new reference first so self-assignment cannot free the object
+        if (oth.mPtr != nullptr)
+            oth.mPtr->IncRef();
+        X* old(mPtr);
+        mPtr = oth.mPtr;
+        if (old != nullptr)
+            old->DecRef();
         return *this;
     }
     /**
@@ -222,14 +268,30 @@ public:
     template<typename Y>
     RefPtr& operator=(const RefPtr<Y>& oth)
     {
-        if (*this)
-            (*this)->DecRef();
-        mPtr = oth.get();
-        if (*this)
-            (*this)->IncRef();
+        X* ptr(oth.get());
+        if (ptr != nullptr)
+            ptr->IncRef();
+        X* old(mPtr);
+        mPtr = ptr;
+        if (old != nullptr)
+            old->DecRef();
         return *this;
     }
 
+    /**
+     * @brief Gives up the stored reference without releasing it.
+     *
+     * Caller becomes responsible for the reference; used by the casting move operations.
+     *
+     * @return Previously stored pointer.
+     */
+    X* release() noexcept
+    {
+        X* ptr(mPtr);
+        mPtr = nullptr;
+        return ptr;
+    }
+
     /**
      * @return Stored reference.
      */
@@ -239,10 +301,12 @@ public:
      * @return True if stores a reference, false otherwise.
      */
     operator bool() const noexcept {
-        if (this == nullptr) {                        // Comment Line 240-243 if debugging is not needed.
+#ifndef NDEBUG
+        if (this == nullptr) {
             fprintf(stderr, "[RefPtr::operator bool] ERROR: 'this' is nullptr! Possibly corrupted RefPtr.\n");
             return false;
         }
+#endif /* !NDEBUG */
         return mPtr != nullptr;
     }
 
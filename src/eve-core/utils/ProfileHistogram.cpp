@@ -0,0 +1,114 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name ProfileHistogram.cpp
+ *   fixed-size log-linear histogram of timings
+ */
+
+#include "eve-core.h"
+
+#include "utils/ProfileHistogram.h"
+
+void ProfileHistogram::Reset()
+{
+    m_count = 0;
+    m_total = 0;
+    m_min = 0;
+    m_max = 0;
+    memset(m_buckets, 0, sizeof(m_buckets));
+}
+
+// index of highest set bit.  value must not be 0
+static uint8 HighBit(int64 value)
+{
+    uint8 bit(0);
+    for (uint8 step = 32; step > 0; step >>= 1)
+        if (value >> step) {
+            value >>= step;
+            bit += step;
+        }
+    return bit;
+}
+
+uint16 ProfileHistogram::GetBucket(int64 ns)
+{
+    // values below 64ns (and 0, which has no high bit) are their own bucket
+    if (ns < 64)
+        return (ns < 0 ? 0 : (uint16)ns);
+    // shift so the top subBits+1 bits are left, giving 32 sub-buckets per power of two
+    uint8 shift(HighBit(ns) - subBits);
+    uint32 bucket(64 + ((shift - 1) << subBits) + ((ns >> shift) - 32));
+    return (bucket < bucketCount ? bucket : bucketCount - 1);
+}
+
+double ProfileHistogram::GetBucketValue(uint16 bucket)
+{
+    if (bucket < 64)
+        return bucket / 1000.0;
+    uint8 shift(((bucket - 64) >> subBits) + 1);
+    int64 sub(((bucket - 64) & 31) + 32);
+    return (((sub + 1) << shift) - 1) / 1000.0;
+}
+
+void ProfileHistogram::Record(double us)
+{
+    if ((m_count == 0) or (us < m_min))
+        m_min = us;
+    if (us > m_max)
+        m_max = us;
+    m_total += us;
+    ++m_count;
+    ++m_buckets[GetBucket((int64)(us * 1000))];
+}
+
+void ProfileHistogram::Merge(const ProfileHistogram& oth)
+{
+    if (oth.m_count == 0)
+        return;
+    if ((m_count == 0) or (oth.m_min < m_min))
+        m_min = oth.m_min;
+    if (oth.m_max > m_max)
+        m_max = oth.m_max;
+    m_total += oth.m_total;
+    m_count += oth.m_count;
+    for (uint16 i = 0; i < bucketCount; ++i)
+        m_buckets[i] += oth.m_buckets[i];
+}
+
+double ProfileHistogram::Percentile(double percent) const
+{
+    if (m_count == 0)
+        return 0;
+    uint32 target(std::ceil(percent / 100 * m_count));
+    if (target < 1)
+        target = 1;
+    uint32 seen(0);
+    for (uint16 i = 0; i < bucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= target)  // bucket upper bound can be above anything actually recorded
+            return std::min(GetBucketValue(i), m_max);
+    }
+    return m_max;
+}
@@ -0,0 +1,72 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name ProfileHistogram.h
+ *   fixed-size log-linear histogram of timings
+ */
+
+#ifndef __UTILS__PROFILE_HISTOGRAM_H__INCL__
+#define __UTILS__PROFILE_HISTOGRAM_H__INCL__
+
+/*
+ * used by the server's Profiler and the load generator.
+ * histograms are log-linear (HDR style).  values below 64ns are exact, above that each power of two is
+ *  split into 32 buckets, so any reported percentile is within ~3% of the real value.
+ * values are given in microseconds and stored in nanoseconds.
+ */
+class ProfileHistogram
+{
+public:
+    ProfileHistogram()                                  { Reset(); }
+
+    void Reset();
+    void Record(double us);
+    void Merge(const ProfileHistogram& oth);
+
+    // returns the value (in us) at or below which the given percent (0-100) of samples fall
+    double Percentile(double percent) const;
+
+    uint32 Count() const                                { return m_count; }
+    double Total() const                                { return m_total; }
+    double Mean() const                                 { return (m_count ? m_total / m_count : 0); }
+    double Min() const                                  { return (m_count ? m_min : 0); }
+    double Max() const                                  { return m_max; }
+
+    // linear buckets for values below 64ns, then 32 per power of two up to 2^40ns (~18m)
+    static const uint8 subBits = 5;
+    static const uint16 bucketCount = 64 + (40 - subBits) * 32;
+
+    static uint16 GetBucket(int64 ns);
+    static double GetBucketValue(uint16 bucket);   // upper bound of bucket, in us
+
+private:
+    uint32 m_count;
+    double m_total;
+    double m_min;
+    double m_max;
+    uint32 m_buckets[bucketCount];
+};
+
+#endif /* !__UTILS__PROFILE_HISTOGRAM_H__INCL__ */
@@ -0,0 +1,185 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name TimerWheel.cpp
+ *   hierarchical timing wheel for one-shot callbacks, driven from the main loop
+ */
+
+#include "eve-core.h"
+
+#include "utils/timer.h"
+#include "utils/TimerWheel.h"
+
+TimerWheel::TimerWheel()
+: m_current(Timer::Now() + 1),
+m_nextID(0)
+{
+    for (uint32 i = 0; i < lvl0Size; ++i)
+        m_lvl0[i].prev = m_lvl0[i].next = &m_lvl0[i];
+    for (uint8 l = 0; l < levels - 1; ++l)
+        for (uint32 i = 0; i < lvlSize; ++i)
+            m_lvl[l][i].prev = m_lvl[l][i].next = &m_lvl[l][i];
+
+    m_timers.clear();
+}
+
+TimerWheel::~TimerWheel()
+{
+    for (auto cur : m_timers)
+        delete cur.second;
+    m_timers.clear();
+}
+
+uint32 TimerWheel::Schedule(uint32 delay, Callback callback)
+{
+    if (++m_nextID == 0)
+        ++m_nextID;
+    // skip ids still in use after wrap
+    while (m_timers.find(m_nextID) != m_timers.end())
+        if (++m_nextID == 0)
+            ++m_nextID;
+
+    Node* pNode = new Node();
+    pNode->timerID = m_nextID;
+    // m_current is the next ms to run, so 'now' is the one before it
+    pNode->expires = m_current - 1 + delay;
+    pNode->callback = callback;
+    m_timers[m_nextID] = pNode;
+    Add(pNode);
+    return m_nextID;
+}
+
+bool TimerWheel::Cancel(uint32 timerID)
+{
+    if (timerID == 0)
+        return false;
+
+    std::unordered_map<uint32, Node*>::iterator itr = m_timers.find(timerID);
+    if (itr == m_timers.end())
+        return false;
+
+    Unlink(itr->second);
+    delete itr->second;
+    m_timers.erase(itr);
+    return true;
+}
+
+uint32 TimerWheel::GetRemainingTime(uint32 timerID)
+{
+    std::unordered_map<uint32, Node*>::iterator itr = m_timers.find(timerID);
+    if (itr == m_timers.end())
+        return 0;
+    int32 remain = (int32)(itr->second->expires - (m_current - 1));
+    return (remain > 0 ? remain : 0);
+}
+
+void TimerWheel::Process(uint32 now)
+{
+    // local head for the slot being run, so callbacks can safely schedule or cancel anything
+    Node due = Node();
+    Node* pNode(nullptr);
+    uint32 index(0);
+    while ((int32)(now - m_current) >= 0) {
+        index = m_current & (lvl0Size - 1);
+        // level 0 has wrapped.  pull the next slot of each level above down, as far as needed
+        if ((index == 0)
+        and (Cascade(0, (m_current >> lvl0Bits) & (lvlSize - 1)) == 0)
+        and (Cascade(1, (m_current >> (lvl0Bits + lvlBits)) & (lvlSize - 1)) == 0)
+        and (Cascade(2, (m_current >> (lvl0Bits + 2 * lvlBits)) & (lvlSize - 1)) == 0))
+            Cascade(3, (m_current >> (lvl0Bits + 3 * lvlBits)) & (lvlSize - 1));
+
+        ++m_current;
+
+        Node* pHead = &m_lvl0[index];
+        if (pHead->next == pHead)
+            continue;
+
+        // move slot contents to local list
+        due.next = pHead->next;
+        due.prev = pHead->prev;
+        due.next->prev = &due;
+        due.prev->next = &due;
+        pHead->prev = pHead->next = pHead;
+
+        while (due.next != &due) {
+            pNode = due.next;
+            Unlink(pNode);
+            m_timers.erase(pNode->timerID);
+            // callback may schedule or cancel other timers, including those still in 'due'
+            pNode->callback();
+            delete pNode;
+        }
+    }
+}
+
+void TimerWheel::Add(Node* pNode)
+{
+    uint32 expires = pNode->expires;
+    uint32 delta = expires - m_current;
+    if ((int32)delta < 0) {
+        // already due.  run on next Process()
+        Link(&m_lvl0[m_current & (lvl0Size - 1)], pNode);
+    } else if (delta < (1u << lvl0Bits)) {
+        Link(&m_lvl0[expires & (lvl0Size - 1)], pNode);
+    } else if (delta < (1u << (lvl0Bits + lvlBits))) {
+        Link(&m_lvl[0][(expires >> lvl0Bits) & (lvlSize - 1)], pNode);
+    } else if (delta < (1u << (lvl0Bits + 2 * lvlBits))) {
+        Link(&m_lvl[1][(expires >> (lvl0Bits + lvlBits)) & (lvlSize - 1)], pNode);
+    } else if (delta < (1u << (lvl0Bits + 3 * lvlBits))) {
+        Link(&m_lvl[2][(expires >> (lvl0Bits + 2 * lvlBits)) & (lvlSize - 1)], pNode);
+    } else {
+        Link(&m_lvl[3][(expires >> (lvl0Bits + 3 * lvlBits)) & (lvlSize - 1)], pNode);
+    }
+}
+
+uint32 TimerWheel::Cascade(uint8 level, uint32 index)
+{
+    Node* pHead = &m_lvl[level][index];
+    Node* pNode = pHead->next;
+    pHead->prev = pHead->next = pHead;
+
+    Node* pNext(nullptr);
+    while (pNode != pHead) {
+        pNext = pNode->next;
+        Add(pNode);
+        pNode = pNext;
+    }
+    return index;
+}
+
+void TimerWheel::Link(Node* pHead, Node* pNode)
+{
+    pNode->prev = pHead->prev;
+    pNode->next = pHead;
+    pHead->prev->next = pNode;
+    pHead->prev = pNode;
+}
+
+void TimerWheel::Unlink(Node* pNode)
+{
+    pNode->prev->next = pNode->next;
+    pNode->next->prev = pNode->prev;
+    pNode->prev = pNode->next = pNode;
+}
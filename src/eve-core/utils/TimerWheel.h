@@ -0,0 +1,104 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name TimerWheel.h
+ *   hierarchical timing wheel for one-shot callbacks, driven from the main loop
+ */
+
+#ifndef __UTILS__TIMER_WHEEL_H__INCL__
+#define __UTILS__TIMER_WHEEL_H__INCL__
+
+#include "utils/Singleton.h"
+
+/*
+ * time is in ms, on the same clock as Timer (Timer::Now()).
+ * the first level has a slot per ms for the next 256ms.  each higher level has 64 slots covering
+ *   64 of the level below it, so five levels cover the whole 32bit range.
+ * when the first level wraps, the next slot of the level above is emptied back into the lower levels.
+ * scheduling and cancelling are O(1), and Process() only touches slots that are due.
+ *
+ * timers are one-shot.  a callback can schedule itself again for periodic use.
+ * owners MUST Cancel() their timers before they are destroyed.
+ */
+class TimerWheel
+: public Singleton< TimerWheel >
+{
+public:
+    typedef std::function<void()> Callback;
+
+    TimerWheel();
+    ~TimerWheel();
+
+    // runs callback once, delay ms from now.  returns timerID for Cancel().  timerID is never 0
+    uint32 Schedule(uint32 delay, Callback callback);
+    // returns false if timer has already run or was not found.  0 is ignored
+    bool Cancel(uint32 timerID);
+    bool IsScheduled(uint32 timerID)                    { return (m_timers.find(timerID) != m_timers.end()); }
+    // ms until this timer runs, or 0 if not scheduled
+    uint32 GetRemainingTime(uint32 timerID);
+
+    // runs all timers due at or before now
+    void Process(uint32 now);
+
+    uint32 Count()                                      { return (uint32)m_timers.size(); }
+
+private:
+    struct Node {
+        uint32 timerID;
+        uint32 expires;
+        Callback callback;
+        Node* prev;
+        Node* next;
+    };
+
+    static const uint8 lvl0Bits = 8;
+    static const uint8 lvlBits = 6;
+    static const uint8 levels = 5;
+    static const uint32 lvl0Size = 1 << lvl0Bits;
+    static const uint32 lvlSize = 1 << lvlBits;
+
+    // places node in slot for its expiry time
+    void Add(Node* pNode);
+    static void Link(Node* pHead, Node* pNode);
+    static void Unlink(Node* pNode);
+    // moves timers in this slot down a level.  returns the slot index
+    uint32 Cascade(uint8 level, uint32 index);
+
+    uint32 m_current;       // next ms to run.  Process(now) leaves this at now + 1
+    uint32 m_nextID;
+
+    // slot list heads.  level 0 is lvl0Size slots, others are lvlSize
+    Node m_lvl0[lvl0Size];
+    Node m_lvl[levels - 1][lvlSize];
+
+    std::unordered_map<uint32, Node*> m_timers;
+};
+
+//Singleton
+#define sTimerWheel \
+( TimerWheel::get() )
+
+
+#endif  // __UTILS__TIMER_WHEEL_H__INCL__
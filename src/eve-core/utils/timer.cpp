@@ -135,6 +135,10 @@ uint32 Timer::GetCurrentTime() {
     return currentTime;
 }
 
+uint32 Timer::Now() {
+    return currentTime;
+}
+
 const void Timer::SetCurrentTime()
 {
     int64 tickCount = GetSteadyTime();
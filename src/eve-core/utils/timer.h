@@ -54,6 +54,8 @@ public:
     // return remaining time in ms
     uint32 GetRemainingTime() const;
     uint32 GetCurrentTime();
+    // same clock as GetCurrentTime(), without needing an instance
+    static uint32 Now();
 
 
 private:
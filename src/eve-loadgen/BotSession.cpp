@@ -0,0 +1,681 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name BotSession.cpp
+ *   one scripted client connection for the load generator
+ */
+
+#include "eve-loadgen.h"
+
+#include "auth/PasswordModule.h"
+#include "packets/Crypto.h"
+#include "python/PyPacket.h"
+#include "EVEVersion.h"
+
+#include "BotSession.h"
+
+void BotRegistry::Update(uint32 botID, uint32 systemID, uint32 shipID)
+{
+    MutexLock lock(m_mutex);
+    std::map<uint32, std::pair<uint32, uint32>>::iterator itr = m_bots.find(botID);
+    if (itr != m_bots.end()) {
+        if ((itr->second.first == systemID) and (itr->second.second == shipID))
+            return;
+        std::vector<uint32>& ships = m_systems[itr->second.first];
+        ships.erase(std::remove(ships.begin(), ships.end(), itr->second.second), ships.end());
+        m_bots.erase(itr);
+    }
+    if ((systemID == 0) or (shipID == 0))
+        return;
+    m_bots[botID] = std::make_pair(systemID, shipID);
+    m_systems[systemID].push_back(shipID);
+}
+
+uint32 BotRegistry::GetPeer(uint32 systemID, uint32 shipID, std::mt19937& rng)
+{
+    MutexLock lock(m_mutex);
+    std::map<uint32, std::vector<uint32>>::iterator itr = m_systems.find(systemID);
+    if ((itr == m_systems.end()) or (itr->second.size() < 2))
+        return 0;
+    // pick from the others
+    std::uniform_int_distribution<size_t> dist(0, itr->second.size() - 2);
+    size_t idx(dist(rng));
+    if (itr->second[idx] == shipID)
+        idx = itr->second.size() - 1;
+    return itr->second[idx];
+}
+
+BotSession::BotSession(uint32 botID, const BotConfig& config, const Scenario& scenario, BotRegistry& registry, LoadStats& stats)
+: m_botID(botID),
+m_state(stNone),
+m_config(config),
+m_scenario(scenario),
+m_registry(registry),
+m_stats(stats),
+m_net(nullptr),
+m_rng(botID),
+m_connectTime(0),
+m_clientID(0),
+m_userID(0),
+m_step(0),
+m_waitUntil(0),
+m_nextCallID(0),
+m_callID(0),
+m_callTime(0)
+{
+    m_userName = config.userPrefix + std::to_string(botID);
+}
+
+BotSession::~BotSession()
+{
+    Disconnect();
+}
+
+bool BotSession::Connect()
+{
+    char errbuf[TCPCONN_ERRBUF_SIZE];
+    m_net = new EVETCPConnection();
+    m_connectTime = GetTimeUSeconds();
+    if (!m_net->Connect(m_config.ip, m_config.port, errbuf)) {
+        sLog.Error("              Bot", "%s: unable to connect: %s", m_userName.c_str(), errbuf);
+        m_stats.AddLoginFail();
+        SafeDelete(m_net);
+        m_state = stClosed;
+        return false;
+    }
+
+    m_state = stVersion;
+    return true;
+}
+
+void BotSession::Disconnect()
+{
+    m_state = stClosed;
+    m_registry.Update(m_botID, 0, 0);
+    if (m_net == nullptr)
+        return;
+    // d'tor disconnects and waits for the connection thread to end
+    SafeDelete(m_net);
+}
+
+void BotSession::Fail(const char* reason)
+{
+    sLog.Error("              Bot", "%s: %s", m_userName.c_str(), reason);
+    if ((m_state > stNone) and (m_state < stRunning))
+        m_stats.AddLoginFail();
+    Disconnect();
+}
+
+void BotSession::Send(PyRep* rep)
+{
+    m_net->QueueRep(rep);
+    m_stats.AddPacketOut();
+}
+
+bool BotSession::Process(double nowUs)
+{
+    if ((m_state == stNone) or (m_state == stClosed))
+        return false;
+
+    if (m_net->GetState() != TCPConnection::STATE_CONNECTED) {
+        if (m_state < stRunning) {
+            Fail("connection closed during login.");
+        } else {
+            m_stats.AddDisconnect();
+            Disconnect();
+        }
+        return true;
+    }
+
+    bool work(false);
+    PyRep* rep(nullptr);
+    while ((m_net != nullptr) and ((rep = m_net->PopRep()) != nullptr)) {
+        work = true;
+        m_stats.AddPacketIn();
+        if (m_state < stSession) {
+            HandleLogin(rep);
+            continue;
+        }
+        PyPacket* packet = new PyPacket();
+        if (packet->Decode(&rep)) {    // rep is consumed here
+            HandlePacket(packet);
+        } else {
+            sLog.Error("              Bot", "%s: failed to decode packet.", m_userName.c_str());
+            PySafeDecRef(rep);
+        }
+        SafeDelete(packet);
+    }
+
+    if (m_state == stRunning)
+        RunScript(nowUs);
+
+    return work;
+}
+
+void BotSession::HandleLogin(PyRep* rep)
+{
+    switch (m_state) {
+        case stVersion: {
+            VersionExchangeServer server;
+            if (!server.Decode(&rep)) {
+                Fail("invalid version exchange.");
+                return;
+            }
+            VersionExchangeClient version;
+                version.birthday = EVEBirthday;
+                version.macho_version = MachoNetVersion;
+                version.user_count = server.user_count;
+                version.version_number = EVEVersionNumber;
+                version.build_version = EVEBuildVersion;
+                version.project_version = EVEProjectVersion;
+            Send(version.Encode());
+
+            NetCommand_VK vk;
+                vk.vipKey = "";
+            Send(vk.Encode());
+
+            CryptoRequestPacket cr;
+                cr.keyVersion = "placebo";
+                cr.keyParams = new PyDict();
+            Send(cr.Encode());
+            m_state = stCrypto;
+        } break;
+        case stCrypto: {
+            if (!rep->IsString() or (PyRep::StringContent(rep) != "OK CC")) {
+                PySafeDecRef(rep);
+                Fail("crypto request refused.");
+                return;
+            }
+            PySafeDecRef(rep);
+
+            CryptoChallengePacket ccp;
+                ccp.clientChallenge = "";
+                ccp.macho_version = MachoNetVersion;
+                ccp.boot_version = EVEVersionNumber;
+                ccp.boot_build = EVEBuildVersion;
+                ccp.boot_codename = EVEProjectCodename;
+                ccp.boot_region = EVEProjectRegion;
+                ccp.user_name = m_userName;
+                ccp.user_languageid = "EN";
+                ccp.user_affiliateid = 0;
+            if (m_config.plainPassword) {
+                ccp.user_password = m_config.password;
+            } else {
+                // the server only compares this with the stored hash, so any stable value will do
+                std::string hash;
+                PasswordModule::GeneratePassHash(m_userName, m_config.password, hash);
+                char hex[3];
+                for (auto c : hash) {
+                    snprintf(hex, sizeof(hex), "%02x", (uint8)c);
+                    ccp.user_password_hash += hex;
+                }
+            }
+            Send(ccp.Encode());
+            m_state = stPassVersion;
+        } break;
+        case stPassVersion: {
+            PySafeDecRef(rep);
+            m_state = stHandshake;
+        } break;
+        case stHandshake: {
+            // login failure is sent as an exception object rather than the handshake tuple
+            if (!rep->IsTuple()) {
+                PySafeDecRef(rep);
+                Fail("login refused.");
+                return;
+            }
+            PySafeDecRef(rep);
+
+            CryptoHandshakeResult hr;
+                hr.challenge_responsehash = "55087";
+                hr.func_output = "";
+                hr.func_result = PyStatic.NewNone();
+            Send(hr.Encode());
+            m_state = stAck;
+        } break;
+        case stAck: {
+            PySafeDecRef(rep);
+            m_state = stSession;
+        } break;
+        default: {
+            PySafeDecRef(rep);
+        } break;
+    }
+}
+
+void BotSession::HandlePacket(PyPacket* packet)
+{
+    switch (packet->type) {
+        case SESSIONINITIALSTATENOTIFICATION: {
+            m_clientID = packet->dest.objectID;
+            m_userID = packet->userid;
+            ReadSession(packet->payload, false);
+            if (m_state == stSession) {
+                m_stats.AddLogin(GetTimeUSeconds() - m_connectTime);
+                m_state = stRunning;
+            }
+        } break;
+        case SESSIONCHANGENOTIFICATION: {
+            ReadSession(packet->payload, true);
+        } break;
+        case CALL_RSP: {
+            HandleResponse(packet, false);
+        } break;
+        case ERRORRESPONSE: {
+            HandleResponse(packet, true);
+        } break;
+        default: {
+            // notifications, destiny updates and pings are not needed here
+        } break;
+    }
+}
+
+void BotSession::ReadSession(PyRep* payload, bool change)
+{
+    // first dict in the payload holds the values
+    PyDict* dict(nullptr);
+    std::vector<PyRep*> todo(1, payload);
+    while (!todo.empty() and (dict == nullptr)) {
+        PyRep* rep(todo.back());
+        todo.pop_back();
+        if (rep == nullptr)
+            continue;
+        if (rep->IsDict()) {
+            dict = rep->AsDict();
+        } else if (rep->IsTuple()) {
+            for (auto itr = rep->AsTuple()->items.rbegin(); itr != rep->AsTuple()->items.rend(); ++itr)
+                todo.push_back(*itr);
+        }
+    }
+    if (dict == nullptr)
+        return;
+
+    for (auto cur : dict->items) {
+        if (!cur.first->IsString())
+            continue;
+        PyRep* value(cur.second);
+        if (change) {
+            if (!value->IsTuple() or (value->AsTuple()->size() != 2))
+                continue;
+            value = value->AsTuple()->GetItem(1);
+        }
+        std::string key(PyRep::StringContent(cur.first));
+        if (value->IsInt() or value->IsLong()) {
+            m_vars[key] = PyRep::IntegerValue(value);
+        } else if (value->IsNone()) {
+            m_vars.erase(key);
+        }
+    }
+
+    UpdateRegistry();
+}
+
+void BotSession::UpdateRegistry()
+{
+    // in space when solarsystemid is set
+    int64 systemID(0), shipID(0);
+    if (GetVar("solarsystemid", systemID) and GetVar("shipid", shipID)) {
+        m_registry.Update(m_botID, (uint32)systemID, (uint32)shipID);
+    } else {
+        m_registry.Update(m_botID, 0, 0);
+    }
+}
+
+bool BotSession::GetVar(const std::string& name, int64& value)
+{
+    if (name == "peer") {
+        int64 systemID(0), shipID(0);
+        if (!GetVar("solarsystemid", systemID) or !GetVar("shipid", shipID))
+            return false;
+        value = m_registry.GetPeer((uint32)systemID, (uint32)shipID, m_rng);
+        return (value != 0);
+    }
+    if (name == "bot") {
+        value = m_botID;
+        return true;
+    }
+
+    std::map<std::string, int64>::iterator itr = m_vars.find(name);
+    if (itr == m_vars.end())
+        return false;
+    value = itr->second;
+    return true;
+}
+
+PyRep* BotSession::Build(const ScenarioArg& arg)
+{
+    switch (arg.type) {
+        case ScenarioArg::tInt:       return new PyInt((int32)arg.intVal);
+        case ScenarioArg::tLong:      return new PyLong(arg.intVal);
+        case ScenarioArg::tFloat:     return new PyFloat(arg.floatVal);
+        case ScenarioArg::tString:    return new PyString(arg.strVal);
+        case ScenarioArg::tWString:   return new PyWString(arg.strVal);
+        case ScenarioArg::tBool:      return new PyBool(arg.intVal != 0);
+        case ScenarioArg::tNone:      return PyStatic.NewNone();
+        case ScenarioArg::tVar: {
+            int64 value(0);
+            if (!GetVar(arg.strVal, value))
+                return nullptr;
+            if ((value > INT32_MAX) or (value < INT32_MIN))
+                return new PyLong(value);
+            return new PyInt((int32)value);
+        }
+        case ScenarioArg::tRand: {
+            std::uniform_int_distribution<int64> dist(arg.intVal, arg.maxVal);
+            return new PyInt((int32)dist(m_rng));
+        }
+        case ScenarioArg::tTuple: {
+            PyTuple* tuple = new PyTuple(arg.items.size());
+            for (size_t i = 0; i < arg.items.size(); ++i) {
+                PyRep* item(Build(arg.items[i]));
+                if (item == nullptr) {
+                    PyDecRef(tuple);
+                    return nullptr;
+                }
+                tuple->SetItem(i, item);
+            }
+            return tuple;
+        }
+        case ScenarioArg::tList: {
+            PyList* list = new PyList(arg.items.size());
+            for (size_t i = 0; i < arg.items.size(); ++i) {
+                PyRep* item(Build(arg.items[i]));
+                if (item == nullptr) {
+                    PyDecRef(list);
+                    return nullptr;
+                }
+                list->SetItem(i, item);
+            }
+            return list;
+        }
+    }
+    return nullptr;
+}
+
+bool BotSession::SendCall(const ScenarioStep& step, const std::string& remoteObject, const std::string& service, double nowUs)
+{
+    m_callName = service + "::" + step.method;
+
+    PyRep* args(Build(step.args));
+    if (args == nullptr) {
+        m_stats.Skip(m_callName);
+        return false;
+    }
+    // bind params are the first arg of MachoBindObject
+    if (step.type == ScenarioStep::sBind) {
+        PyTuple* tuple = new PyTuple(1);
+        tuple->SetItem(0, args);
+        args = tuple;
+    }
+
+    // payload is ((flag, substream((remoteObject, method, args, kwargs))),), as PyCallStream::Decode() expects
+    PyTuple* call = new PyTuple(4);
+        call->SetItem(0, (remoteObject.empty() ? (PyRep*)new PyInt(1) : (PyRep*)new PyString(remoteObject)));
+        call->SetItem(1, new PyString(step.method));
+        call->SetItem(2, args);
+        call->SetItem(3, PyStatic.NewNone());
+    PyTuple* inner = new PyTuple(2);
+        inner->SetItem(0, new PyInt(remoteObject.empty() ? 0 : 1));
+        inner->SetItem(1, new PySubStream(call));
+
+    m_callID = ++m_nextCallID;
+    m_callTime = nowUs;
+
+    PyPacket packet;
+        packet.type_string = "macho.CallReq";
+        packet.type = CALL_REQ;
+        packet.source.type = PyAddress::Client;
+        packet.source.objectID = m_clientID;
+        packet.source.callID = m_callID;
+        packet.dest.type = PyAddress::Any;
+        // bound objects are called with no service
+        packet.dest.service = (remoteObject.empty() ? service : "");
+        packet.userid = m_userID;
+        packet.payload = new PyTuple(1);
+        packet.payload->SetItem(0, inner);
+    PyRep* rep(packet.Encode());
+    // Encode() put payload into rep
+    packet.payload = nullptr;
+    Send(rep);
+    return true;
+}
+
+void BotSession::HandleResponse(PyPacket* packet, bool error)
+{
+    // late answer to a call that already timed out
+    if ((m_callID == 0) or (packet->dest.callID != m_callID))
+        return;
+
+    m_stats.Record(m_callName, GetTimeUSeconds() - m_callTime);
+    m_callID = 0;
+
+    const ScenarioStep& step = m_scenario[m_step];
+    ++m_step;
+    if (error) {
+        m_stats.Error(m_callName);
+        return;
+    }
+
+    if (step.type == ScenarioStep::sBind) {
+        std::string boundID(FindBoundID(packet->payload));
+        if (boundID.empty()) {
+            m_stats.Error(m_callName);
+            m_bound.erase(step.target);
+        } else {
+            m_bound[step.target] = std::make_pair(boundID, step.service);
+        }
+        return;
+    }
+
+    if (!step.captureVar.empty()) {
+        int64 value(0);
+        if (FindFirstValue(packet->payload, value, true) or FindFirstValue(packet->payload, value, false)) {
+            m_vars[step.captureVar] = value;
+        } else {
+            m_vars.erase(step.captureVar);
+        }
+    }
+    if (!step.captureObj.empty()) {
+        std::string boundID(FindBoundID(packet->payload));
+        if (boundID.empty()) {
+            m_bound.erase(step.captureObj);
+        } else {
+            // calls on it are reported under the service of the step that returned it
+            std::string service(step.target);
+            if (step.type == ScenarioStep::sCallBound) {
+                std::map<std::string, std::pair<std::string, std::string>>::iterator itr = m_bound.find(step.target);
+                if (itr != m_bound.end())
+                    service = itr->second.second;
+            }
+            m_bound[step.captureObj] = std::make_pair(boundID, service);
+        }
+    }
+}
+
+void BotSession::RunScript(double nowUs)
+{
+    // at most one pass of the script per call, so a loop without calls or sleeps can't hold the thread
+    size_t count(0);
+    while (m_state == stRunning) {
+        if (m_callID != 0) {
+            if (nowUs - m_callTime < m_config.callTimeout * 1000.0)
+                return;
+            m_stats.Timeout(m_callName);
+            m_callID = 0;
+            ++m_step;
+            continue;
+        }
+
+        if (m_waitUntil > 0) {
+            const ScenarioStep& step = m_scenario[m_step];
+            if (step.type == ScenarioStep::sWait) {
+                int64 value(0);
+                if (!GetVar(step.target, value)) {
+                    if (nowUs < m_waitUntil)
+                        return;
+                    m_stats.Timeout("wait " + step.target);
+                }
+            } else if (nowUs < m_waitUntil) {
+                return;
+            }
+            m_waitUntil = 0;
+            ++m_step;
+            continue;
+        }
+
+        if (m_step >= m_scenario.Size()) {
+            m_state = stIdle;
+            return;
+        }
+        if (++count > m_scenario.Size())
+            return;
+
+        const ScenarioStep& step = m_scenario[m_step];
+        switch (step.type) {
+            case ScenarioStep::sCall: {
+                if (!SendCall(step, "", step.target, nowUs))
+                    ++m_step;
+            } break;
+            case ScenarioStep::sBind: {
+                if (!SendCall(step, "", step.service, nowUs))
+                    ++m_step;
+            } break;
+            case ScenarioStep::sCallBound: {
+                std::map<std::string, std::pair<std::string, std::string>>::iterator itr = m_bound.find(step.target);
+                if (itr == m_bound.end()) {
+                    m_stats.Skip(step.target + "::" + step.method);
+                    ++m_step;
+                } else if (!SendCall(step, itr->second.first, itr->second.second, nowUs)) {
+                    ++m_step;
+                }
+            } break;
+            case ScenarioStep::sSet: {
+                PyRep* value(Build(step.args));
+                if (value == nullptr) {
+                    m_vars.erase(step.target);
+                } else {
+                    m_vars[step.target] = PyRep::IntegerValue(value);
+                    PyDecRef(value);
+                }
+                ++m_step;
+            } break;
+            case ScenarioStep::sSleep: {
+                std::uniform_int_distribution<uint32> dist(step.minMs, step.maxMs);
+                m_waitUntil = nowUs + dist(m_rng) * 1000.0;
+            } break;
+            case ScenarioStep::sWait: {
+                m_waitUntil = nowUs + step.minMs * 1000.0;
+            } break;
+            case ScenarioStep::sRepeat: {
+                if (m_loops.find(m_step) == m_loops.end())
+                    m_loops[m_step] = step.count;
+                ++m_step;
+            } break;
+            case ScenarioStep::sEnd: {
+                const ScenarioStep& repeat = m_scenario[step.jump];
+                uint32& left = m_loops[step.jump];
+                if ((repeat.count == 0) or (--left > 0)) {
+                    m_step = step.jump + 1;
+                } else {
+                    m_loops.erase(step.jump);
+                    ++m_step;
+                }
+            } break;
+        }
+    }
+}
+
+std::string BotSession::FindBoundID(PyRep* rep)
+{
+    if (rep == nullptr)
+        return "";
+    if (rep->IsString()) {
+        std::string str(PyRep::StringContent(rep));
+        if (str.compare(0, 2, "N=") == 0)
+            return str;
+    } else if (rep->IsTuple()) {
+        for (auto cur : rep->AsTuple()->items) {
+            std::string str(FindBoundID(cur));
+            if (!str.empty())
+                return str;
+        }
+    } else if (rep->IsList()) {
+        for (auto cur : rep->AsList()->items) {
+            std::string str(FindBoundID(cur));
+            if (!str.empty())
+                return str;
+        }
+    } else if (rep->IsSubStruct()) {
+        return FindBoundID(rep->AsSubStruct()->sub());
+    } else if (rep->IsSubStream()) {
+        rep->AsSubStream()->DecodeData();
+        return FindBoundID(rep->AsSubStream()->decoded());
+    }
+    return "";
+}
+
+bool BotSession::FindFirstValue(PyRep* rep, int64& value, bool rows)
+{
+    if (rep == nullptr)
+        return false;
+    if (rep->IsPackedRow()) {
+        PyRep* field(rep->AsPackedRow()->GetField(0));
+        if ((field == nullptr) or !(field->IsInt() or field->IsLong()))
+            return false;
+        value = PyRep::IntegerValue(field);
+        return true;
+    }
+    if (rep->IsInt() or rep->IsLong()) {
+        if (rows)
+            return false;
+        value = PyRep::IntegerValue(rep);
+        return true;
+    }
+    if (rep->IsTuple()) {
+        for (auto cur : rep->AsTuple()->items)
+            if (FindFirstValue(cur, value, rows))
+                return true;
+    } else if (rep->IsList()) {
+        for (auto cur : rep->AsList()->items)
+            if (FindFirstValue(cur, value, rows))
+                return true;
+    } else if (rep->IsObjectEx()) {
+        // rowsets: header, then the rows
+        PyObjectEx* obj(rep->AsObjectEx());
+        if (FindFirstValue(obj->header(), value, rows))
+            return true;
+        for (auto cur : obj->list().items)
+            if (FindFirstValue(cur, value, rows))
+                return true;
+    } else if (rep->IsObject()) {
+        return FindFirstValue(rep->AsObject()->arguments(), value, rows);
+    } else if (rep->IsSubStream()) {
+        rep->AsSubStream()->DecodeData();
+        return FindFirstValue(rep->AsSubStream()->decoded(), value, rows);
+    } else if (rep->IsSubStruct()) {
+        return FindFirstValue(rep->AsSubStruct()->sub(), value, rows);
+    }
+    return false;
+}
@@ -0,0 +1,174 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name BotSession.h
+ *   one scripted client connection for the load generator
+ */
+
+#ifndef __EVE_LOADGEN__BOT_SESSION_H__INCL__
+#define __EVE_LOADGEN__BOT_SESSION_H__INCL__
+
+#include <random>
+
+#include "network/EVETCPConnection.h"
+#include "threading/Mutex.h"
+
+#include "LoadStats.h"
+#include "Scenario.h"
+
+class PyPacket;
+class PyRep;
+class PyTuple;
+
+/* login and connection settings shared by all bots */
+struct BotConfig
+{
+    uint32 ip;              // network order, from ResolveIP()
+    uint16 port;
+    std::string userPrefix; // account name is prefix + index
+    std::string password;
+    bool plainPassword;     // send the password itself, rather than its hash
+    uint32 callTimeout;     // ms before an unanswered call is counted as a timeout
+};
+
+/*
+ * ships of bots that are in space, by solar system, so scripts can target each other ($peer).
+ * shared by all worker threads.
+ */
+class BotRegistry
+{
+public:
+    BotRegistry()                                       { /* do nothing here */ }
+    ~BotRegistry()                                      { /* do nothing here */ }
+
+    // systemID 0 removes the bot
+    void Update(uint32 botID, uint32 systemID, uint32 shipID);
+    // returns a random ship in this system other than shipID, or 0 if there is none
+    uint32 GetPeer(uint32 systemID, uint32 shipID, std::mt19937& rng);
+
+private:
+    Mutex m_mutex;
+    // botID/(systemID, shipID)
+    std::map<uint32, std::pair<uint32, uint32>> m_bots;
+    // systemID/shipIDs
+    std::map<uint32, std::vector<uint32>> m_systems;
+};
+
+/*
+ * client side of the login handshake (mirror of EVEClientSession), followed by the scenario.
+ * Process() is called from a worker thread, which owns the bot and its LoadStats.
+ * the connection's own IO thread does the socket work, as on the server.
+ * one call is outstanding at a time, as a player would do.
+ *
+ * session values (charid, shipid, stationid, solarsystemid, ...) are kept as variables,
+ * alongside values captured from call results and 'set' steps.
+ */
+class BotSession
+{
+public:
+    BotSession(uint32 botID, const BotConfig& config, const Scenario& scenario, BotRegistry& registry, LoadStats& stats);
+    ~BotSession();
+
+    bool Connect();
+    void Disconnect();
+
+    // handles received packets and runs the script.  returns true if anything was done
+    bool Process(double nowUs);
+
+    bool IsOnline() const                               { return (m_state == stRunning) or (m_state == stIdle); }
+    // disconnected, failed login, or script ended
+    bool IsDone() const                                 { return (m_state == stIdle) or (m_state == stClosed); }
+    uint32 GetID() const                                { return m_botID; }
+
+protected:
+    enum State {
+        stNone,
+        stVersion,          // waiting for server version
+        stCrypto,           // waiting for "OK CC"
+        stPassVersion,      // waiting for password version
+        stHandshake,        // waiting for server handshake (or login failure)
+        stAck,              // waiting for handshake ack
+        stSession,          // waiting for initial session state
+        stRunning,          // running script
+        stIdle,             // script finished, still connected
+        stClosed
+    };
+
+    void HandleLogin(PyRep* rep);
+    void HandlePacket(PyPacket* packet);
+    void HandleResponse(PyPacket* packet, bool error);
+    // reads session values.  change=true for a SessionChangeNotification ((old, new) pairs)
+    void ReadSession(PyRep* payload, bool change);
+    void UpdateRegistry();
+
+    // runs steps until one has to wait
+    void RunScript(double nowUs);
+    // sends the call for this step.  returns false if it was skipped
+    bool SendCall(const ScenarioStep& step, const std::string& remoteObject, const std::string& service, double nowUs);
+
+    // builds arg into a PyRep.  returns nullptr if a variable is not set
+    PyRep* Build(const ScenarioArg& arg);
+    bool GetVar(const std::string& name, int64& value);
+
+    static std::string FindBoundID(PyRep* rep);
+    static bool FindFirstValue(PyRep* rep, int64& value, bool rows);
+
+    void Send(PyRep* rep);
+    void Fail(const char* reason);
+
+private:
+    uint32 m_botID;
+    State m_state;
+    std::string m_userName;
+
+    const BotConfig& m_config;
+    const Scenario& m_scenario;
+    BotRegistry& m_registry;
+    LoadStats& m_stats;
+    EVETCPConnection* m_net;
+    std::mt19937 m_rng;
+
+    double m_connectTime;
+    int64 m_clientID;
+    uint32 m_userID;
+
+    // script position
+    size_t m_step;
+    // repeat step/loops remaining (0 = forever)
+    std::map<size_t, uint32> m_loops;
+    double m_waitUntil;
+
+    // outstanding call
+    int64 m_nextCallID;
+    int64 m_callID;
+    double m_callTime;
+    std::string m_callName;
+
+    std::map<std::string, int64> m_vars;
+    // object/(bound id, service)
+    std::map<std::string, std::pair<std::string, std::string>> m_bound;
+};
+
+#endif /* !__EVE_LOADGEN__BOT_SESSION_H__INCL__ */
@@ -0,0 +1,136 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name LoadStats.cpp
+ *   per-call latency histograms and counters for the load generator
+ */
+
+#include "eve-loadgen.h"
+
+#include "LoadStats.h"
+
+LoadStats::LoadStats()
+: m_loginFail(0),
+m_disconnects(0),
+m_packetsIn(0),
+m_packetsOut(0)
+{
+}
+
+void LoadStats::Merge(const LoadStats& oth)
+{
+    for (auto& cur : oth.m_calls) {
+        Entry& entry = m_calls[cur.first];
+        entry.hist.Merge(cur.second.hist);
+        entry.errors += cur.second.errors;
+        entry.timeouts += cur.second.timeouts;
+        entry.skipped += cur.second.skipped;
+    }
+    m_login.Merge(oth.m_login);
+    m_loginFail += oth.m_loginFail;
+    m_disconnects += oth.m_disconnects;
+    m_packetsIn += oth.m_packetsIn;
+    m_packetsOut += oth.m_packetsOut;
+}
+
+void LoadStats::Print(FILE* fp, double seconds) const
+{
+    if (seconds <= 0)
+        seconds = 1;
+
+    fprintf(fp, "\n Run time: %.1fs\n", seconds);
+    fprintf(fp, " Logins: %u ok, %u failed, %u disconnected.  avg %.2fms, p50 %.2fms, p95 %.2fms, p99 %.2fms, max %.2fms\n", \
+            m_login.Count(), m_loginFail, m_disconnects, m_login.Mean() / 1000, m_login.Percentile(50) / 1000, \
+            m_login.Percentile(95) / 1000, m_login.Percentile(99) / 1000, m_login.Max() / 1000);
+    fprintf(fp, " Packets: %li in (%.1f/s), %li out (%.1f/s)\n", m_packetsIn, m_packetsIn / seconds, m_packetsOut, m_packetsOut / seconds);
+
+    uint32 total(0), errors(0);
+    for (auto& cur : m_calls) {
+        total += cur.second.hist.Count();
+        errors += cur.second.errors;
+    }
+    fprintf(fp, " Calls: %u answered (%.1f/s), %u errors\n\n", total, total / seconds, errors);
+
+    fprintf(fp, " %-40s %9s %9s %6s %6s %6s %9s %9s %9s %9s %9s\n", "call", "count", "rate/s", "err", "tmout", "skip", \
+            "avg ms", "p50 ms", "p95 ms", "p99 ms", "max ms");
+    for (auto& cur : m_calls) {
+        const ProfileHistogram& hist = cur.second.hist;
+        fprintf(fp, " %-40s %9u %9.1f %6u %6u %6u %9.3f %9.3f %9.3f %9.3f %9.3f\n", cur.first.c_str(), hist.Count(), \
+                hist.Count() / seconds, cur.second.errors, cur.second.timeouts, cur.second.skipped, hist.Mean() / 1000, \
+                hist.Percentile(50) / 1000, hist.Percentile(95) / 1000, hist.Percentile(99) / 1000, hist.Max() / 1000);
+    }
+}
+
+bool ServerTick::Read(const std::string& fileName)
+{
+    FILE* fp = fopen(fileName.c_str(), "r");
+    if (fp == nullptr)
+        return false;
+
+    bool found(false);
+    char buf[512];
+    while (fgets(buf, sizeof(buf), fp) != nullptr) {
+        std::string line(buf);
+        if ((line[0] == '#') or (line.find("zone=\"Server\"") == std::string::npos))
+            continue;
+        size_t brace(line.find('{')), close(line.find("} "));
+        if ((brace == std::string::npos) or (close == std::string::npos))
+            continue;
+        std::string metric(line.substr(0, brace));
+        bool run(line.find("window=\"run\"") != std::string::npos);
+        double value(atof(line.c_str() + close + 2));
+        if (run) {
+            if (metric == "evemu_profile_count") {
+                m_count = (int64)value;
+                found = true;
+            } else if (metric == "evemu_profile_sum_us") {
+                m_sum = value;
+            }
+        } else if (metric == "evemu_profile_max_us") {
+            m_max = value;
+        } else if (metric == "evemu_profile_us") {
+            if (line.find("quantile=\"0.50\"") != std::string::npos) {
+                m_p50 = value;
+            } else if (line.find("quantile=\"0.95\"") != std::string::npos) {
+                m_p95 = value;
+            } else if (line.find("quantile=\"0.99\"") != std::string::npos) {
+                m_p99 = value;
+            }
+        }
+    }
+    fclose(fp);
+    return found;
+}
+
+void ServerTick::Print(FILE* fp, const ServerTick& start) const
+{
+    int64 ticks(m_count - start.m_count);
+    if (ticks <= 0) {
+        fprintf(fp, "\n Server tick: no profile export during the run (check debug.ProfileExport and ProfileInterval)\n");
+        return;
+    }
+    fprintf(fp, "\n Server tick: %li ticks, avg %.3fms.  last interval p50 %.3fms, p95 %.3fms, p99 %.3fms, max %.3fms\n", \
+            ticks, (m_sum - start.m_sum) / ticks / 1000, m_p50 / 1000, m_p95 / 1000, m_p99 / 1000, m_max / 1000);
+}
@@ -0,0 +1,106 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name LoadStats.h
+ *   per-call latency histograms and counters for the load generator
+ */
+
+#ifndef __EVE_LOADGEN__LOAD_STATS_H__INCL__
+#define __EVE_LOADGEN__LOAD_STATS_H__INCL__
+
+#include "utils/ProfileHistogram.h"
+
+/*
+ * each worker thread keeps its own LoadStats, so recording takes no locks.
+ * they are merged into one for the report when the run ends.
+ * calls are keyed as "service::Method" (bound calls use the service the object was bound from).
+ */
+class LoadStats
+{
+public:
+    LoadStats();
+    ~LoadStats()                                        { /* do nothing here */ }
+
+    void Record(const std::string& name, double us)     { m_calls[name].hist.Record(us); }
+    void Error(const std::string& name)                 { ++m_calls[name].errors; }
+    void Timeout(const std::string& name)               { ++m_calls[name].timeouts; }
+    // step was not sent, as a variable it uses is not set
+    void Skip(const std::string& name)                  { ++m_calls[name].skipped; }
+
+    void AddPacketIn()                                  { ++m_packetsIn; }
+    void AddPacketOut()                                 { ++m_packetsOut; }
+    void AddLogin(double us)                            { m_login.Record(us); }
+    void AddLoginFail()                                 { ++m_loginFail; }
+    void AddDisconnect()                                { ++m_disconnects; }
+
+    void Merge(const LoadStats& oth);
+
+    // prints the report for a run of 'seconds' length
+    void Print(FILE* fp, double seconds) const;
+
+private:
+    struct Entry {
+        ProfileHistogram hist;
+        uint32 errors;
+        uint32 timeouts;
+        uint32 skipped;
+        Entry() : errors(0), timeouts(0), skipped(0) { }
+    };
+
+    std::map<std::string, Entry> m_calls;
+    ProfileHistogram m_login;
+    uint32 m_loginFail;
+    uint32 m_disconnects;
+    int64 m_packetsIn;
+    int64 m_packetsOut;
+};
+
+/*
+ * server tick time, as read from the server's profile export (<logDir>/server_profile.txt).
+ * the server writes it every debug.ProfileInterval minutes when debug.UseProfiling and
+ * debug.ProfileExport are set.  the mean over the run is taken from the difference of the
+ * run totals read at the start and end, so it is only as current as the last export.
+ */
+class ServerTick
+{
+public:
+    ServerTick() : m_count(0), m_sum(0), m_p50(0), m_p95(0), m_p99(0), m_max(0) { }
+
+    // returns false if the file can't be read or has no main loop data
+    bool Read(const std::string& fileName);
+
+    // prints mean tick time between 'start' and this, and the latest interval's percentiles
+    void Print(FILE* fp, const ServerTick& start) const;
+
+private:
+    int64 m_count;
+    double m_sum;
+    double m_p50;
+    double m_p95;
+    double m_p99;
+    double m_max;
+};
+
+#endif /* !__EVE_LOADGEN__LOAD_STATS_H__INCL__ */
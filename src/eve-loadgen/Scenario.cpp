@@ -0,0 +1,349 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name Scenario.cpp
+ *   scripted steps run by each load generator bot
+ */
+
+#include "eve-loadgen.h"
+
+#include "Scenario.h"
+
+namespace {
+    // cursor over one script line
+    class Reader
+    {
+    public:
+        Reader(const std::string& str) : m_str(str), m_pos(0) { }
+
+        void SkipSpace() {
+            while ((m_pos < m_str.size()) and isspace((uint8)m_str[m_pos]))
+                ++m_pos;
+        }
+        bool AtEnd() {
+            SkipSpace();
+            return (m_pos >= m_str.size());
+        }
+        char Peek() {
+            SkipSpace();
+            return (m_pos < m_str.size() ? m_str[m_pos] : '\0');
+        }
+        bool Accept(char c) {
+            if (Peek() != c)
+                return false;
+            ++m_pos;
+            return true;
+        }
+        bool Accept(const char* str) {
+            SkipSpace();
+            size_t len(strlen(str));
+            if (m_str.compare(m_pos, len, str) != 0)
+                return false;
+            m_pos += len;
+            return true;
+        }
+        // identifier (letters, digits, '_' and '.')
+        std::string Word() {
+            SkipSpace();
+            size_t start(m_pos);
+            while ((m_pos < m_str.size()) and (isalnum((uint8)m_str[m_pos]) or (m_str[m_pos] == '_') or (m_str[m_pos] == '.')))
+                ++m_pos;
+            return m_str.substr(start, m_pos - start);
+        }
+        bool Number(ScenarioArg& arg) {
+            SkipSpace();
+            const char* start(m_str.c_str() + m_pos);
+            char* end(nullptr);
+            arg.intVal = strtoll(start, &end, 10);
+            if (end == start)
+                return false;
+            if ((*end == '.') or (*end == 'e') or (*end == 'E')) {
+                arg.type = ScenarioArg::tFloat;
+                arg.floatVal = strtod(start, &end);
+            } else if ((*end == 'L') or (*end == 'l')) {
+                arg.type = ScenarioArg::tLong;
+                ++end;
+            } else {
+                arg.type = (((arg.intVal > INT32_MAX) or (arg.intVal < INT32_MIN)) ? ScenarioArg::tLong : ScenarioArg::tInt);
+            }
+            m_pos += (end - start);
+            return true;
+        }
+        bool Quoted(std::string& into) {
+            if (!Accept('"'))
+                return false;
+            into.clear();
+            while ((m_pos < m_str.size()) and (m_str[m_pos] != '"')) {
+                if ((m_str[m_pos] == '\\') and (m_pos + 1 < m_str.size()))
+                    ++m_pos;
+                into += m_str[m_pos++];
+            }
+            if (m_pos >= m_str.size())
+                return false;
+            ++m_pos;
+            return true;
+        }
+
+        bool Arg(ScenarioArg& arg);
+        // comma separated args up to close, into arg.items.  sets tuple if a comma was seen
+        bool Items(ScenarioArg& arg, char close, bool& comma);
+
+    private:
+        const std::string& m_str;
+        size_t m_pos;
+    };
+
+    bool Reader::Items(ScenarioArg& arg, char close, bool& comma)
+    {
+        comma = false;
+        while (!Accept(close)) {
+            if (AtEnd())
+                return false;
+            ScenarioArg item;
+            if (!Arg(item))
+                return false;
+            arg.items.push_back(item);
+            if (Accept(',')) {
+                comma = true;
+            } else if (Peek() != close) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Reader::Arg(ScenarioArg& arg)
+    {
+        bool comma(false);
+        char c(Peek());
+        if (c == '(') {
+            Accept('(');
+            arg.type = ScenarioArg::tTuple;
+            if (!Items(arg, ')', comma))
+                return false;
+            // (a) is a, (a,) is a tuple
+            if ((arg.items.size() == 1) and !comma) {
+                ScenarioArg inner(arg.items.front());
+                arg = inner;
+            }
+            return true;
+        }
+        if (c == '[') {
+            Accept('[');
+            arg.type = ScenarioArg::tList;
+            return Items(arg, ']', comma);
+        }
+        if (c == '"') {
+            arg.type = ScenarioArg::tString;
+            return Quoted(arg.strVal);
+        }
+        if (c == '$') {
+            Accept('$');
+            arg.type = ScenarioArg::tVar;
+            arg.strVal = Word();
+            return !arg.strVal.empty();
+        }
+        if ((c == '-') or isdigit((uint8)c))
+            return Number(arg);
+        if (Accept("u\"")) {
+            --m_pos;
+            arg.type = ScenarioArg::tWString;
+            return Quoted(arg.strVal);
+        }
+        if (Accept("rand(")) {
+            ScenarioArg lo, hi;
+            if (!Number(lo) or !Accept(',') or !Number(hi) or !Accept(')'))
+                return false;
+            arg.type = ScenarioArg::tRand;
+            arg.intVal = std::min(lo.intVal, hi.intVal);
+            arg.maxVal = std::max(lo.intVal, hi.intVal);
+            return true;
+        }
+
+        std::string word(Word());
+        if (word == "True" or word == "False") {
+            arg.type = ScenarioArg::tBool;
+            arg.intVal = (word == "True");
+            return true;
+        }
+        if (word == "None") {
+            arg.type = ScenarioArg::tNone;
+            return true;
+        }
+        return false;
+    }
+}
+
+bool Scenario::Load(const std::string& fileName)
+{
+    FILE* fp = fopen(fileName.c_str(), "r");
+    if (fp == nullptr) {
+        sLog.Error("         Scenario", "Unable to open scenario '%s'.", fileName.c_str());
+        return false;
+    }
+
+    m_name = fileName;
+    m_steps.clear();
+
+    char buf[1024];
+    uint32 lineNo(0);
+    bool ok(true);
+    while (fgets(buf, sizeof(buf), fp) != nullptr) {
+        ++lineNo;
+        std::string line(buf);
+        while (!line.empty() and ((line.back() == '\n') or (line.back() == '\r')))
+            line.pop_back();
+        size_t hash(std::string::npos);
+        // strip comments, but not inside quotes
+        bool quoted(false);
+        for (size_t i = 0; i < line.size(); ++i) {
+            if (line[i] == '"') {
+                quoted = !quoted;
+            } else if ((line[i] == '#') and !quoted) {
+                hash = i;
+                break;
+            }
+        }
+        if (hash != std::string::npos)
+            line.erase(hash);
+        Reader r(line);
+        if (r.AtEnd())
+            continue;
+        if (!ParseLine(line, lineNo)) {
+            sLog.Error("         Scenario", "%s:%u: unable to parse '%s'.", fileName.c_str(), lineNo, line.c_str());
+            ok = false;
+        }
+    }
+    fclose(fp);
+
+    // match repeat/end pairs
+    std::vector<uint32> open;
+    for (uint32 i = 0; i < m_steps.size(); ++i) {
+        if (m_steps[i].type == ScenarioStep::sRepeat) {
+            open.push_back(i);
+        } else if (m_steps[i].type == ScenarioStep::sEnd) {
+            if (open.empty()) {
+                sLog.Error("         Scenario", "%s:%u: 'end' without 'repeat'.", fileName.c_str(), m_steps[i].line);
+                ok = false;
+                continue;
+            }
+            m_steps[i].jump = open.back();
+            m_steps[open.back()].jump = i;
+            open.pop_back();
+        }
+    }
+    for (auto cur : open) {
+        sLog.Error("         Scenario", "%s:%u: 'repeat' without 'end'.", fileName.c_str(), m_steps[cur].line);
+        ok = false;
+    }
+
+    if (ok and m_steps.empty()) {
+        sLog.Error("         Scenario", "%s has no steps.", fileName.c_str());
+        ok = false;
+    }
+    return ok;
+}
+
+bool Scenario::ParseLine(const std::string& line, uint32 lineNo)
+{
+    Reader r(line);
+    ScenarioStep step;
+    step.line = lineNo;
+    std::string cmd(r.Word());
+
+    if ((cmd == "call") or (cmd == "callbound")) {
+        step.type = (cmd == "call" ? ScenarioStep::sCall : ScenarioStep::sCallBound);
+        step.target = r.Word();
+        step.method = r.Word();
+        if (step.target.empty() or step.method.empty() or !r.Accept('('))
+            return false;
+        bool comma(false);
+        step.args.type = ScenarioArg::tTuple;
+        if (!r.Items(step.args, ')', comma))
+            return false;
+        while (!r.AtEnd()) {
+            if (r.Accept("->")) {
+                step.captureVar = r.Word();
+                if (step.captureVar.empty())
+                    return false;
+            } else if (r.Accept("=>")) {
+                step.captureObj = r.Word();
+                if (step.captureObj.empty())
+                    return false;
+            } else {
+                return false;
+            }
+        }
+    } else if (cmd == "bind") {
+        step.type = ScenarioStep::sBind;
+        step.target = r.Word();
+        step.service = r.Word();
+        step.method = "MachoBindObject";
+        if (step.target.empty() or step.service.empty() or !r.Arg(step.args))
+            return false;
+    } else if (cmd == "set") {
+        step.type = ScenarioStep::sSet;
+        step.target = r.Word();
+        if (step.target.empty() or !r.Arg(step.args))
+            return false;
+    } else if ((cmd == "sleep") or (cmd == "wait")) {
+        step.type = (cmd == "sleep" ? ScenarioStep::sSleep : ScenarioStep::sWait);
+        if (step.type == ScenarioStep::sWait) {
+            step.target = r.Word();
+            if (step.target.empty())
+                return false;
+            // default wait is 30s
+            step.minMs = 30000;
+        }
+        ScenarioArg a;
+        if (!r.AtEnd()) {
+            if (!r.Number(a) or (a.intVal < 0))
+                return false;
+            step.minMs = a.intVal;
+        }
+        step.maxMs = step.minMs;
+        if ((step.type == ScenarioStep::sSleep) and !r.AtEnd()) {
+            if (!r.Number(a) or (a.intVal < step.minMs))
+                return false;
+            step.maxMs = a.intVal;
+        }
+    } else if (cmd == "repeat") {
+        step.type = ScenarioStep::sRepeat;
+        ScenarioArg a;
+        if (!r.Number(a) or (a.intVal < 0))
+            return false;
+        step.count = a.intVal;
+    } else if (cmd == "end") {
+        step.type = ScenarioStep::sEnd;
+    } else {
+        return false;
+    }
+
+    if (!r.AtEnd())
+        return false;
+
+    m_steps.push_back(step);
+    return true;
+}
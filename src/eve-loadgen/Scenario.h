@@ -0,0 +1,120 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name Scenario.h
+ *   scripted steps run by each load generator bot
+ */
+
+#ifndef __EVE_LOADGEN__SCENARIO_H__INCL__
+#define __EVE_LOADGEN__SCENARIO_H__INCL__
+
+/*
+ * a literal in a scenario script, built into a PyRep for each call.
+ * syntax is close to python:
+ *   123  123L  1.5  "str"  u"wstr"  True  False  None  $var  rand(1, 10)  (a, b)  (a,)  [a, b]
+ * ints that do not fit in 32 bits are sent as longs.  (a) is just a, as in python.
+ */
+struct ScenarioArg
+{
+    enum Type {
+        tInt,
+        tLong,
+        tFloat,
+        tString,
+        tWString,
+        tBool,
+        tNone,
+        tVar,       // session or captured variable, by name
+        tRand,      // random int in [intVal, maxVal]
+        tTuple,
+        tList
+    };
+
+    Type type;
+    int64 intVal;
+    int64 maxVal;
+    double floatVal;
+    std::string strVal;
+    std::vector<ScenarioArg> items;
+
+    ScenarioArg() : type(tNone), intVal(0), maxVal(0), floatVal(0) { }
+};
+
+/* one line of a scenario script */
+struct ScenarioStep
+{
+    enum Type {
+        sCall,          // call <svc> <Method>(<args>) [-> var] [=> obj]
+        sBind,          // bind <obj> <svc> <args>
+        sCallBound,     // callbound <obj> <Method>(<args>) [-> var] [=> obj]
+        sSet,           // set <var> <value>
+        sSleep,         // sleep <ms> [<max ms>]
+        sWait,          // wait <var> [<timeout ms>]
+        sRepeat,        // repeat <count>   (0 = forever)
+        sEnd            // end of repeat block
+    };
+
+    Type type;
+    uint32 line;
+    std::string target;         // service (call, bind) or object (callbound, bind) or var (set, wait)
+    std::string service;        // bind only
+    std::string method;
+    ScenarioArg args;           // call args tuple, bind params or set value
+    std::string captureVar;     // -> var   first value in result
+    std::string captureObj;     // => obj   first bound object in result
+    uint32 minMs;               // sleep/wait
+    uint32 maxMs;
+    uint32 count;               // repeat
+    uint32 jump;                // repeat: index of matching end.  end: index of matching repeat
+
+    ScenarioStep() : type(sCall), line(0), minMs(0), maxMs(0), count(0), jump(0) { }
+};
+
+/*
+ * a parsed scenario script, shared (read-only) by every bot.
+ * one step per line, '#' starts a comment.  see utils/loadgen/README.md for the step list.
+ */
+class Scenario
+{
+public:
+    Scenario()                                          { /* do nothing here */ }
+    ~Scenario()                                         { /* do nothing here */ }
+
+    // returns false (and logs the line) on any error
+    bool Load(const std::string& fileName);
+
+    size_t Size() const                                 { return m_steps.size(); }
+    const ScenarioStep& operator[](size_t idx) const    { return m_steps[idx]; }
+    const std::string& GetName() const                  { return m_name; }
+
+protected:
+    bool ParseLine(const std::string& line, uint32 lineNo);
+
+private:
+    std::string m_name;
+    std::vector<ScenarioStep> m_steps;
+};
+
+#endif /* !__EVE_LOADGEN__SCENARIO_H__INCL__ */
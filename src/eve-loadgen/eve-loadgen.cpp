@@ -0,0 +1,296 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name eve-loadgen.cpp
+ *   headless load generator.  runs scripted bots against a server, and reports
+ *   per-call latency, throughput and server tick time.
+ */
+
+#include "eve-loadgen.h"
+
+#include <csignal>
+
+#include "BotSession.h"
+#include "LoadStats.h"
+#include "Scenario.h"
+
+namespace {
+    std::atomic<bool> s_run(true);
+
+    void Stop(int)
+    {
+        s_run.store(false);
+    }
+
+    struct Options {
+        std::string host;
+        uint16 port;
+        uint32 bots;
+        uint32 first;
+        uint32 threads;
+        double ramp;            // connects per second
+        uint32 duration;        // seconds.  0 = until every bot has finished its script
+        std::string profile;    // server's profile export file
+        std::string report;
+        std::string scenario;
+
+        Options() : host("127.0.0.1"), port(26000), bots(10), first(0), threads(4), ramp(50), duration(0) { }
+    };
+
+    /* a slice of the bots, run on its own thread */
+    struct Worker {
+        std::vector<BotSession*> bots;
+        LoadStats stats;
+        std::thread* thread;
+        std::atomic<uint32> online;
+        std::atomic<bool> finished;
+
+        Worker() : thread(nullptr), online(0), finished(false) { }
+    };
+
+    void Usage()
+    {
+        printf("usage: eve-loadgen [options] <scenario>\n"
+               "  --host <addr>        server address (127.0.0.1)\n"
+               "  --port <port>        server port (26000)\n"
+               "  --bots <n>           number of bots (10)\n"
+               "  --first <n>          index of first bot account (0)\n"
+               "  --user <prefix>      account name prefix; bot n logs in as <prefix><n> (loadbot)\n"
+               "  --password <pass>    account password (loadbot)\n"
+               "  --plain              send the plain password instead of its hash\n"
+               "  --threads <n>        worker threads (4)\n"
+               "  --ramp <n>           connects per second (50)\n"
+               "  --duration <s>       run time; 0 runs until every bot finishes its script (0)\n"
+               "  --timeout <ms>       time before an unanswered call is counted as a timeout (30000)\n"
+               "  --profile <file>     server's server_profile.txt, for tick time\n"
+               "  --report <file>      also write the report to this file\n");
+    }
+
+    bool ParseArgs(int argc, char* argv[], Options& opt, BotConfig& config)
+    {
+        config.userPrefix = "loadbot";
+        config.password = "loadbot";
+        config.plainPassword = false;
+        config.callTimeout = 30000;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg(argv[i]);
+            if (arg == "--plain") {
+                config.plainPassword = true;
+                continue;
+            }
+            if (arg.compare(0, 2, "--") != 0) {
+                if (!opt.scenario.empty())
+                    return false;
+                opt.scenario = arg;
+                continue;
+            }
+            if (i + 1 >= argc)
+                return false;
+            std::string val(argv[++i]);
+            if (arg == "--host") {
+                opt.host = val;
+            } else if (arg == "--port") {
+                opt.port = atoi(val.c_str());
+            } else if (arg == "--bots") {
+                opt.bots = atoi(val.c_str());
+            } else if (arg == "--first") {
+                opt.first = atoi(val.c_str());
+            } else if (arg == "--user") {
+                config.userPrefix = val;
+            } else if (arg == "--password") {
+                config.password = val;
+            } else if (arg == "--threads") {
+                opt.threads = atoi(val.c_str());
+            } else if (arg == "--ramp") {
+                opt.ramp = atof(val.c_str());
+            } else if (arg == "--duration") {
+                opt.duration = atoi(val.c_str());
+            } else if (arg == "--timeout") {
+                config.callTimeout = atoi(val.c_str());
+            } else if (arg == "--profile") {
+                opt.profile = val;
+            } else if (arg == "--report") {
+                opt.report = val;
+            } else {
+                return false;
+            }
+        }
+
+        if (opt.scenario.empty() or (opt.bots == 0) or (opt.port == 0))
+            return false;
+        if (opt.threads == 0)
+            opt.threads = 1;
+        if (opt.threads > opt.bots)
+            opt.threads = opt.bots;
+        if (opt.ramp <= 0)
+            opt.ramp = 1;
+        return true;
+    }
+
+    void RunWorker(Worker* pWorker, uint32 threads, double ramp, double startUs)
+    {
+        size_t next(0), done(0);
+        bool work(false);
+        double now(0);
+        while (s_run.load()) {
+            now = GetTimeUSeconds();
+            // bot n starts n/ramp seconds into the run.  bots are dealt to workers in turn, so slot i is bot i*threads
+            while ((next < pWorker->bots.size()) and (now >= startUs + (next * threads) / ramp * 1000000)) {
+                pWorker->bots[next]->Connect();
+                ++next;
+            }
+
+            work = false;
+            done = 0;
+            uint32 online(0);
+            for (auto cur : pWorker->bots) {
+                work |= cur->Process(now);
+                if (cur->IsOnline())
+                    ++online;
+                if (cur->IsDone())
+                    ++done;
+            }
+            pWorker->online.store(online);
+
+            if ((next == pWorker->bots.size()) and (done == next)) {
+                pWorker->finished.store(true);
+                // when running for a fixed time, idle bots stay connected until the end
+                if (online == 0)
+                    break;
+            }
+
+            if (!work)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        for (auto cur : pWorker->bots)
+            SafeDelete(cur);
+        pWorker->bots.clear();
+        pWorker->online.store(0);
+        pWorker->finished.store(true);
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    Options opt;
+    BotConfig config;
+    if (!ParseArgs(argc, argv, opt, config)) {
+        Usage();
+        return 1;
+    }
+
+    Scenario scenario;
+    if (!scenario.Load(opt.scenario))
+        return 1;
+
+    char errbuf[ERRBUF_SIZE];
+    config.ip = ResolveIP(opt.host.c_str(), errbuf);
+    if (config.ip == 0) {
+        sLog.Error("          LoadGen", "Unable to resolve %s: %s", opt.host.c_str(), errbuf);
+        return 1;
+    }
+    config.port = opt.port;
+
+    signal(SIGINT, Stop);
+    signal(SIGTERM, Stop);
+    // a dropped connection must not kill the run
+    signal(SIGPIPE, SIG_IGN);
+
+    ServerTick tickStart;
+    if (!opt.profile.empty() and !tickStart.Read(opt.profile))
+        sLog.Warning("          LoadGen", "Unable to read server profile %s.  Tick time will not be reported until it is written.", opt.profile.c_str());
+
+    sLog.Green("          LoadGen", "Running %u bots (%s%u - %s%u) from %s against %s:%u on %u threads, %.1f connects/s.", \
+               opt.bots, config.userPrefix.c_str(), opt.first, config.userPrefix.c_str(), opt.first + opt.bots - 1, \
+               scenario.GetName().c_str(), opt.host.c_str(), opt.port, opt.threads, opt.ramp);
+
+    BotRegistry registry;
+    std::vector<Worker*> workers;
+    for (uint32 i = 0; i < opt.threads; ++i)
+        workers.push_back(new Worker());
+    for (uint32 i = 0; i < opt.bots; ++i) {
+        Worker* pWorker(workers[i % opt.threads]);
+        pWorker->bots.push_back(new BotSession(opt.first + i, config, scenario, registry, pWorker->stats));
+    }
+
+    double startUs(GetTimeUSeconds());
+    for (auto cur : workers)
+        cur->thread = new std::thread(RunWorker, cur, opt.threads, opt.ramp, startUs);
+
+    double lastPrint(startUs), now(startUs);
+    while (s_run.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        now = GetTimeUSeconds();
+        if ((opt.duration > 0) and (now - startUs >= opt.duration * 1000000.0))
+            break;
+
+        uint32 online(0), finished(0);
+        for (auto cur : workers) {
+            online += cur->online.load();
+            if (cur->finished.load())
+                ++finished;
+        }
+        if ((opt.duration == 0) and (finished == workers.size()))
+            break;
+        if (now - lastPrint >= 10000000) {
+            sLog.Log("          LoadGen", "%.0fs: %u bots online.", (now - startUs) / 1000000, online);
+            lastPrint = now;
+        }
+    }
+    s_run.store(false);
+
+    LoadStats stats;
+    for (auto cur : workers) {
+        cur->thread->join();
+        SafeDelete(cur->thread);
+        stats.Merge(cur->stats);
+        SafeDelete(cur);
+    }
+    double seconds((GetTimeUSeconds() - startUs) / 1000000);
+
+    ServerTick tickEnd;
+    bool haveTick(!opt.profile.empty() and tickEnd.Read(opt.profile));
+
+    stats.Print(stdout, seconds);
+    if (haveTick)
+        tickEnd.Print(stdout, tickStart);
+
+    if (!opt.report.empty()) {
+        FILE* fp = fopen(opt.report.c_str(), "w");
+        if (fp == nullptr) {
+            sLog.Error("          LoadGen", "Unable to open report file %s.", opt.report.c_str());
+        } else {
+            fprintf(fp, " Scenario %s, %u bots, %u threads, %.1f connects/s\n", scenario.GetName().c_str(), opt.bots, opt.threads, opt.ramp);
+            stats.Print(fp, seconds);
+            if (haveTick)
+                tickEnd.Print(fp, tickStart);
+            fclose(fp);
+        }
+    }
+
+    return 0;
+}
@@ -121,7 +121,6 @@ Client::Client(EVEServiceManager& services, EVETCPConnection** con)
     //m_toGate = 0;
     m_locationID = 0;
     m_moveSystemID = 0;
-    m_skillTimer = 0;
     m_dockStationID = 0;
 
     m_lpMap.clear();
@@ -270,7 +269,7 @@ bool Client::SelectCharacter(int32 charID/*0*/)
     m_char->VerifySP();
     m_char->SetLoginTime();
     m_char->SetClient(this);
-    m_char->SkillQueueLoop(false);
+    // skill queue is kept current by sSkillQueueMgr while offline, so no need to run it here
 
     // register with our system manager AFTER character is constructed and initialized
     m_system->AddClient(this, true);
@@ -365,10 +364,6 @@ void Client::ProcessClient() {
         m_char->SetLogonMinutes();
     }
 
-    if (m_skillTimer > 0)
-        if (m_skillTimer < GetFileTimeNow())
-            m_char->SkillQueueLoop();
-
     if (m_sessionTimer.Check(false)) {
         _log(CLIENT__TIMER, "Client::ProcessClient():  SetSessionChange to false for %s(%u)", m_char->name(), m_char->itemID());
         m_sessionTimer.Disable();
@@ -525,34 +520,14 @@ void Client::ProcessClient() {
     if (m_fleetTimer.Enabled())
         if (m_fleetTimer.Check(false)) {
             m_fleetTimer.Disable();
+            // boost levels are cached by the fleet service
             BoostData bData = BoostData();
-            if (IsSquadID(m_squad)) {
-                SquadData sData = SquadData();
-                sFltSvc.GetSquadData(m_squad, sData);
-                if ((sData.leader != nullptr) and (sData.booster != nullptr))
-                    if ((sData.leader->IsInSpace()) and (sData.booster->IsInSpace()))
-                        bData = sData.boost;
-            } else if (IsWingID(m_wing)) {
-                WingData wData = WingData();
-                sFltSvc.GetWingData(m_wing, wData);
-                if ((wData.leader != nullptr) and (wData.booster != nullptr))
-                    if ((wData.leader->IsInSpace()) and (wData.booster->IsInSpace()))
-                        bData = wData.boost;
-            } else if (IsFleetID(m_fleet)) {
-                FleetData fData = FleetData();
-                sFltSvc.GetFleetData(m_fleet, fData);
-                if ((fData.leader != nullptr) and (fData.booster != nullptr))
-                    if ((fData.leader->IsInSpace()) and (fData.booster->IsInSpace())) {
-                        CharacterRef bRef = fData.booster->GetChar();
-                        bData.leader    = fData.leader->GetChar()->GetSkillLevel(EvESkill::Leadership);
-                        bData.armored   = bRef->GetSkillLevel(EvESkill::ArmoredWarfare);
-                        bData.info      = bRef->GetSkillLevel(EvESkill::InformationWarfare);
-                        bData.mining    = bRef->GetSkillLevel(EvESkill::MiningForeman);
-                        bData.siege     = bRef->GetSkillLevel(EvESkill::SiegeWarfare);
-                        bData.skirmish  = bRef->GetSkillLevel(EvESkill::SkirmishWarfare);
-                    }
+            sFltSvc.GetBoostData(this, bData);
+            if (!bData.IsEmpty()) {
+                pShipSE->ApplyBoost(bData);
+            } else if (pShipSE->IsBoosted()) {
+                pShipSE->RemoveBoost();
             }
-            pShipSE->ApplyBoost(bData);
         }
 
     if (sConfig.debug.UseProfiling)
@@ -686,6 +661,8 @@ void Client::MoveToLocation(uint32 locationID, const GPoint& pt) {
     m_locationID = locationID;
     // get data for new system.  this checks for stationID sent as locationID, so is safe here.
     sDataMgr.GetSystemData(m_locationID, m_systemData);
+    if (IsFleetID(m_fleet))
+        sFltSvc.UpdateMemberSystem(this);
 
     m_bubbleWait = false;           // allow client processing of subsequent destiny msgs
 
@@ -336,9 +336,6 @@ public:
     // this will add clone alpha if no clone is found
     void InitSession( int32 characterID  );
 
-    // skill training timer shit
-    void SetTrainingEndTime(int64 endTime)              { m_skillTimer = endTime; }
-
 protected:
     ServiceDB m_sDB;
     StationData m_stationData;
@@ -413,8 +410,6 @@ protected:
     std::set<LSCChannel*>   m_channels;    //we do not own these.
     std::map<uint32, bool>  m_hangarLoaded;
 
-    int64                   m_skillTimer;
-
     int8                    m_clientState;
 
     /********************************************************************/
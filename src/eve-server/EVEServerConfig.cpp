@@ -120,6 +120,7 @@ EVEServerConfig::EVEServerConfig()
     market.OldPriceLimit = 10;
     market.NewPriceLimit = 10;
     market.HistoryUpdateTime = 6/*h*/;
+    market.BookIdleTime = 30/*m*/;
     market.UseOrderRange = true;//N
     market.DeleteOldTransactions = false;
     market.salesTax = 1.0f;
@@ -224,6 +225,7 @@ EVEServerConfig::EVEServerConfig()
     // testing
     testing.EnableDrones = false;
     testing.ShipHeat = false;
+    testing.IncrementalFx = false;
 
     // debug
     debug.BeanCount = false;
@@ -237,6 +239,10 @@ EVEServerConfig::EVEServerConfig()
     debug.SpawnTest = false;
     debug.AnomalyFaction = 0;
     debug.ProfileTraceTime = 150/*ms*/;
+    debug.ProfileInterval = 5/*m*/;
+    debug.ProfileExport = false;
+    debug.AsyncLog = false;
+    debug.AsyncLogBlock = false;
 
     // database
     database.host = "localhost";
@@ -262,6 +268,7 @@ EVEServerConfig::EVEServerConfig()
     net.port = 26000;
     net.imageServer = "localhost";
     net.imageServerPort = 26001;
+    net.imageCacheSize = 64;
 
     // threads  -not implemented
     threads.ConsoleThreads = 1;//P
@@ -484,6 +491,7 @@ bool EVEServerConfig::ProcessMarket(const TiXmlElement* ele)
     AddValueParser( "UseOrderRange",                market.UseOrderRange);
     AddValueParser( "DeleteOldTransactions",        market.DeleteOldTransactions);
     AddValueParser( "HistoryUpdateTime",            market.HistoryUpdateTime);
+    AddValueParser( "BookIdleTime",                 market.BookIdleTime);
     AddValueParser( "SalesTax",                     market.salesTax);
 
     const bool result = ParseElementChildren( ele );
@@ -498,6 +506,7 @@ bool EVEServerConfig::ProcessMarket(const TiXmlElement* ele)
     RemoveParser( "UseOrderRange" );
     RemoveParser( "DeleteOldTransactions" );
     RemoveParser( "HistoryUpdateTime" );
+    RemoveParser( "BookIdleTime" );
     RemoveParser( "SalesTax" );
 
     return result;
@@ -660,12 +669,14 @@ bool EVEServerConfig::ProcessNet( const TiXmlElement* ele )
     AddValueParser( "port",             net.port );
     AddValueParser( "imageServerPort",  net.imageServerPort);
     AddValueParser( "imageServer",      net.imageServer);
+    AddValueParser( "imageCacheSize",   net.imageCacheSize);
 
     const bool result = ParseElementChildren( ele );
 
     RemoveParser( "port" );
     RemoveParser( "imageServerPort" );
     RemoveParser( "imageServer" );
+    RemoveParser( "imageCacheSize" );
 
     return result;
 }
@@ -830,6 +841,10 @@ bool EVEServerConfig::ProcessDebug(const TiXmlElement* ele)
     AddValueParser( "SpawnTest",            debug.SpawnTest );
     AddValueParser( "DeleteTrackingCans",   debug.DeleteTrackingCans );
     AddValueParser( "ProfileTraceTime",     debug.ProfileTraceTime );
+    AddValueParser( "ProfileInterval",      debug.ProfileInterval );
+    AddValueParser( "ProfileExport",        debug.ProfileExport );
+    AddValueParser( "AsyncLog",             debug.AsyncLog );
+    AddValueParser( "AsyncLogBlock",        debug.AsyncLogBlock );
 
     const bool result = ParseElementChildren( ele );
 
@@ -844,6 +859,10 @@ bool EVEServerConfig::ProcessDebug(const TiXmlElement* ele)
     RemoveParser( "SpawnTest" );
     RemoveParser( "BubbleTrack" );
     RemoveParser( "ProfileTraceTime" );
+    RemoveParser( "ProfileInterval" );
+    RemoveParser( "ProfileExport" );
+    RemoveParser( "AsyncLog" );
+    RemoveParser( "AsyncLogBlock" );
 
     return result;
 }
@@ -852,11 +871,13 @@ bool EVEServerConfig::ProcessTesting(const TiXmlElement* ele)
 {
     AddValueParser( "ShipHeat",             testing.ShipHeat );
     AddValueParser( "EnableDrones",         testing.EnableDrones);
+    AddValueParser( "IncrementalFx",        testing.IncrementalFx);
 
     const bool result = ParseElementChildren( ele );
 
     RemoveParser( "ShipHeat" );
     RemoveParser( "EnableDrones" );
+    RemoveParser( "IncrementalFx" );
 
     return result;
 }
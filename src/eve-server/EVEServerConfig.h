@@ -146,6 +146,7 @@ public:
         uint8 OldPriceLimit;
         uint8 NewPriceLimit;
         uint8 HistoryUpdateTime;
+        uint8 BookIdleTime;
         float salesTax;
     } market;
 
@@ -249,6 +250,8 @@ public:
         uint16 imageServerPort;
         /// the imageServer for char images. should be the evemu server external ip/host
         std::string imageServer;
+        /// Mb of images the imageServer keeps in memory.
+        uint32 imageCacheSize;
     } net;
 
     // From <thread>
@@ -326,6 +329,7 @@ public:
     struct {
         bool ShipHeat;
         bool EnableDrones;
+        bool IncrementalFx;
     } testing;
 
     // From <debug>
@@ -340,6 +344,10 @@ public:
         bool DeleteTrackingCans;
         bool PositionHack;
         uint16 ProfileTraceTime;
+        uint16 ProfileInterval;
+        bool ProfileExport;
+        bool AsyncLog;
+        bool AsyncLogBlock;
         uint32 AnomalyFaction;
     } debug;
 
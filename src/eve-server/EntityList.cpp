@@ -34,11 +34,16 @@
 #include "EVEServerConfig.h"
 #include "ServiceDB.h"
 #include "agents/Agent.h"
+#include "character/SkillQueueMgr.h"
 #include "exploration/Probes.h"
+#include "manufacturing/RamJobMgr.h"
 #include "map/MapDB.h"
 #include "market/MarketMgr.h"
 #include "market/MarketBotMgr.h"
+#include "market/MarketHistory.h"
+#include "market/MarketOrderBook.h"
 #include "missions/MissionDataMgr.h"
+#include "standing/StandingMgr.h"
 #include "station/Station.h"
 #include "system/DestinyManager.h"
 #include "system/SystemManager.h"
@@ -249,11 +254,16 @@ void EntityList::Process() {
         // these need 1Hz tics
         sCivMgr.Process();
         sBubbleMgr.Process();
+        sSkillQueueMgr.Process();
+        sRamJobMgr.Process();
 
         // these minute tics do not need to be precise
         if (m_minuteTimer.Check()) {
             ++m_minutes;
             sMissionDataMgr.Process();  // 1m
+            sOrderBook.Process();       // 1m  save changed orders and unload idle books
+            sMktHistory.Process();      // 1m  save changed history days and unload idle series
+            sStandingMgr.Process();     // 1m  save changed standings
 
             if (m_minutes % 5 == 0) { // ~5m
                 sWHMgr.Process();
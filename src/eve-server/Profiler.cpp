@@ -10,164 +10,75 @@
 #include "EVEServerConfig.h"
 #include "../eve-core/utils/misc.h"
 
+Profiler::Profiler()
+: m_intervalTimer(0)
+{
+}
+
 int Profiler::Initialize() {
     ClearAll();
+    if (sConfig.debug.ProfileInterval > 0)
+        m_intervalTimer.Start(sConfig.debug.ProfileInterval * 60 * 1000);
     sLog.Blue("  Profile Manager", "Profiling initialized.");
     return 1;
 }
 
+void Profiler::Process()
+{
+    if (!m_intervalTimer.Check())
+        return;
+
+    if (sConfig.debug.ProfileExport)
+        Export();
+
+    for (uint8 i = 0; i < Profile::count; ++i) {
+        m_total[i].Merge(m_interval[i]);
+        m_interval[i].Reset();
+    }
+}
+
 void Profiler::AddTime(uint8 key, double value) {
     if (sConfig.debug.ProfileTraceTime > 0)
         if (value > sConfig.debug.ProfileTraceTime *1000) {
             sLog.Warning("  Profile Manager", "Long Profile Time on key %s, time %.3f.", GetKeyName(key).c_str(), value);
             //EvE::traceStack();
         }
-    /*
-    Profile::destiny     = 1,    *
-    Profile::map         = 2,
-    Profile::client      = 3,    *
-    Profile::npc         = 4,    *
-    Profile::bubbles     = 5,    *
-    Profile::items       = 6,
-    Profile::modules     = 7,    *
-    Profile::functions   = 8,
-    Profile::db          = 9,    *
-    Profile::ship        = 10,   *
-    Profile::targets     = 11,
-    Profile::server      = 12,
-    Profile::missile     = 13,
-    Profile::system      = 14,
-    Profile::entityS     = 15,   *
-    Profile::loot        = 16,   *
-    Profile::salvage     = 17,
-    Profile::spawn       = 18,   *
-    Profile::collision   = 19,   *
-    Profile::drone       = 20,   *
-    Profile::itemload    = 21,   *
-    Profile::concord     = 22,   *
-    Profile::colony      = 23,   *
-    Profile::damage      = 24,   *
-    Profile::parseFX     = 25,   *
-    Profile::applyFX     = 26,   *
-    Profile::onTarg      = 27
-    */
-    switch(key) {
-        case 1:
-            m_destiny.push_back(value);
-            break;
-        case 2:
-            m_map.push_back(value);
-            break;
-        case 3:
-            m_client.push_back(value);
-            break;
-        case 4:
-            m_npc.push_back(value);
-            break;
-        case 5:
-            m_bubbles.push_back(value);
-            break;
-        case 6:
-            m_items.push_back(value);
-            break;
-        case 7:
-            m_modules.push_back(value);
-            break;
-        case 8:
-            m_functions.push_back(value);
-            break;
-        case 9:
-            m_db.push_back(value);
-            break;
-        case 10:
-            m_ship.push_back(value);
-            break;
-        case 11:
-            m_targets.push_back(value);
-            break;
-        case 12:
-            m_server.push_back(value);
-            break;
-        case 13:
-            m_missile.push_back(value);
-            break;
-        case 14:
-            m_system.push_back(value);
-            break;
-        case 15:
-            m_entityS.push_back(value);
-            break;
-        case 16:
-            m_loot.push_back(value);
-            break;
-        case 17:
-            m_salvage.push_back(value);
-            break;
-        case 18:
-            m_spawn.push_back(value);
-            break;
-        case 19:
-            m_collision.push_back(value);
-            break;
-        case 20:
-            m_drone.push_back(value);
-            break;
-        case 21:
-            m_itemload.push_back(value);
-            break;
-        case 22:
-            m_concord.push_back(value);
-            break;
-        case 23:
-            m_colony.push_back(value);
-            break;
-        case 24:
-            m_damage.push_back(value);
-            break;
-        case 25:
-            m_effects1.push_back(value);
-            break;
-        case 26:
-            m_effects2.push_back(value);
-            break;
-        case 27:
-            m_ontarget.push_back(value);
-            break;
-        default:
-            sLog.Error("Profile::AddTime()", "Default reached on key %u.", key );
-            break;
+
+    if ((key < 1) or (key >= Profile::count)) {
+        sLog.Error("Profile::AddTime()", "Default reached on key %u.", key );
+        return;
     }
+
+    m_interval[key].Record(value);
 }
 
 void Profiler::ClearAll()
 {
-    m_server.clear();
-    m_destiny.clear();
-    m_map.clear();
-    m_client.clear();
-    m_npc.clear();
-    m_bubbles.clear();
-    m_items.clear();
-    m_modules.clear();
-    m_functions.clear();
-    m_db.clear();
-    m_ship.clear();
-    m_targets.clear();
-    m_ontarget.clear();
-    m_missile.clear();
-    m_system.clear();
-    m_entityS.clear();
-    m_loot.clear();
-    m_salvage.clear();
-    m_spawn.clear();
-    m_collision.clear();
-    m_drone.clear();
-    m_itemload.clear();
-    m_concord.clear();
-    m_colony.clear();
-    m_damage.clear();
-    m_effects1.clear();
-    m_effects2.clear();
+    for (uint8 i = 0; i < Profile::count; ++i) {
+        m_interval[i].Reset();
+        m_total[i].Reset();
+    }
+}
+
+void Profiler::GetRunData(uint8 key, ProfileHistogram& hist)
+{
+    hist = m_total[key];
+    hist.Merge(m_interval[key]);
+}
+
+void Profiler::PrintKey(uint8 key, const char* label, bool enabled/*true*/)
+{
+    if (!enabled) {
+        std::printf("%14s   Disabled.\n", label);
+        return;
+    }
+
+    std::string fSize;
+    ProfileHistogram hist;
+    GetRunData(key, hist);
+    GetSize(hist.Count(), fSize);
+    std::printf("%14s   %s times.   \tAvg: %.4fus   \tp50: %.4fus   \tp95: %.4fus   \tp99: %.4fus   \tMax: %.4fus\n", label, fSize.c_str(), \
+            hist.Mean(), hist.Percentile(50), hist.Percentile(95), hist.Percentile(99), hist.Max());
 }
 
 void Profiler::PrintProfile()
@@ -175,113 +86,43 @@ void Profiler::PrintProfile()
     /** @todo figure out how to color this based on times....R,Y,G,M,B,W  */
 
     double startTime = GetTimeUSeconds();
-    std::string fSize;
-    float h(0.0f), l(0.0f), a(0.0f);
     sLog.Green("   Server Profile", " Current Process Profile times for this run:");
     //std::printf("\n");     // spacer
     std::printf("\t\tLoop Calls\n");
-    GetRunTimes(m_entityS, h, l, a);
-    GetSize(m_entityS.size(), fSize);
-    std::printf("    EntityList   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_client, h, l, a);
-    GetSize(m_client.size(), fSize);
-    std::printf("        Client   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_system, h, l, a);
-    GetSize(m_system.size(), fSize);
-    std::printf("     SystemMgr   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_bubbles, h, l, a);
-    GetSize(m_bubbles.size(), fSize);
-    std::printf("       Bubbles   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_destiny, h, l, a);
-    GetSize(m_destiny.size(), fSize);
-    std::printf("       Destiny   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_npc, h, l, a);
-    GetSize(m_npc.size(), fSize);
-    std::printf("           NPC   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_modules, h, l, a);
-    GetSize(m_modules.size(), fSize);
-    std::printf("       Modules   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_ship, h, l, a);
-    GetSize(m_ship.size(), fSize);
-    std::printf("          Ship   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    //GetRunTimes(m_ontarget, h, l, a);
-    //GetSize(m_ontarget.size(), fSize);
-    //std::printf("      OnTarget   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_targets, h, l, a);
-    GetSize(m_targets.size(), fSize);
-    std::printf("    TargetProc   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_missile, h, l, a);
-    GetSize(m_missile.size(), fSize);
-    std::printf("       Missile   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_damage, h, l, a);
-    GetSize(m_damage.size(), fSize);
-    std::printf("        Damage   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    if (sConfig.npc.RoamingSpawns or sConfig.npc.StaticSpawns) {
-        GetRunTimes(m_spawn, h, l, a);
-        GetSize(m_spawn.size(), fSize);
-        std::printf("        Spawns   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    } else {
-        std::printf("        Spawns   Disabled.\n");
-    }
-    if (sConfig.cosmic.BumpEnabled) {
-        GetRunTimes(m_collision, h, l, a);
-        GetSize(m_collision.size(), fSize);
-        std::printf("    Collisions   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    } else {
-        std::printf("    Collisions   Disabled.\n");
-    }
-    if (sConfig.testing.EnableDrones) {
-        GetRunTimes(m_drone, h, l, a);
-        GetSize(m_drone.size(), fSize);
-        std::printf("        Drones   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    } else {
-        std::printf("        Drones   Disabled.\n");
-    }
+    PrintKey(Profile::server,    "Main Loop");
+    PrintKey(Profile::entityS,   "EntityList");
+    PrintKey(Profile::client,    "Client");
+    PrintKey(Profile::system,    "SystemMgr");
+    PrintKey(Profile::bubbles,   "Bubbles");
+    PrintKey(Profile::destiny,   "Destiny");
+    PrintKey(Profile::npc,       "NPC");
+    PrintKey(Profile::modules,   "Modules");
+    PrintKey(Profile::ship,      "Ship");
+    //PrintKey(Profile::onTarg,    "OnTarget");
+    PrintKey(Profile::targets,   "TargetProc");
+    PrintKey(Profile::missile,   "Missile");
+    PrintKey(Profile::damage,    "Damage");
+    PrintKey(Profile::combat,    "CombatPass");
+    PrintKey(Profile::spawn,     "Spawns",       sConfig.npc.RoamingSpawns or sConfig.npc.StaticSpawns);
+    PrintKey(Profile::collision, "Collisions",   sConfig.cosmic.BumpEnabled);
+    PrintKey(Profile::drone,     "Drones",       sConfig.testing.EnableDrones);
 
     //std::printf("\n");     // spacer
     std::printf("\t\tPeriodic Calls\n");
-    GetRunTimes(m_db, h, l, a);
-    GetSize(m_db.size(), fSize);
-    std::printf("            DB   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_effects1, h, l, a);
-    GetSize(m_effects1.size(), fSize);
-    std::printf(" Parse Effects   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_effects2, h, l, a);
-    GetSize(m_effects2.size(), fSize);
-    std::printf(" Apply Effects   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_itemload, h, l, a);
-    GetSize(m_itemload.size(), fSize);
-    std::printf("  Item Loading   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_loot, h, l, a);
-    GetSize(m_loot.size(), fSize);
-    std::printf("          Loot   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_salvage, h, l, a);
-    GetSize(m_salvage.size(), fSize);
-    std::printf("       Salvage   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    if (sConfig.cosmic.PIEnabled) {
-        GetRunTimes(m_colony, h, l, a);
-        GetSize(m_colony.size(), fSize);
-        std::printf("        Colony   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    } else {
-        std::printf("        Colony   Disabled.\n");
-    }
-    if (sConfig.crime.Enabled) {
-        GetRunTimes(m_concord, h, l, a);GetSize(m_concord.size(), fSize);
-        std::printf("       Concord   %s times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    } else {
-        std::printf("       Concord   Disabled.\n");
-    }
+    PrintKey(Profile::db,        "DB");
+    PrintKey(Profile::parseFX,   "Parse Effects");
+    PrintKey(Profile::applyFX,   "Apply Effects");
+    PrintKey(Profile::itemload,  "Item Loading");
+    PrintKey(Profile::loot,      "Loot");
+    PrintKey(Profile::salvage,   "Salvage");
+    PrintKey(Profile::colony,    "Colony",       sConfig.cosmic.PIEnabled);
+    PrintKey(Profile::concord,   "Concord",      sConfig.crime.Enabled);
 
     //std::printf("\n");     // spacer
     std::printf("\t\tUnimplemented Calls\n");
-    GetRunTimes(m_server, h, l, a);
-    std::printf("        *Main()  %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_server.size(), h, l, a );
-    GetRunTimes(m_map, h, l, a);
-    std::printf("          *Map   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_map.size(), h, l, a );
-    GetRunTimes(m_items, h, l, a);
-    std::printf("        *Items   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_items.size(),  h, l, a );
-    GetRunTimes(m_functions, h, l, a);
-    std::printf("    *Functions   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_functions.size(), h, l, a );
+    PrintKey(Profile::map,       "*Map");
+    PrintKey(Profile::items,     "*Items");
+    PrintKey(Profile::functions, "*Functions");
 
     std::printf(" Profile Times Compiled in %.4fus\n", (GetTimeUSeconds() -startTime) );
 }
@@ -289,52 +130,57 @@ void Profiler::PrintProfile()
 void Profiler::PrintStartUpData()
 {
     double startTime = GetTimeUSeconds();
-    std::string fSize;
-    float h(0.0f), l(0.0f), a(0.0f);
     sLog.Green("   Server Profile", " Current Process Profile times for this run:");
 
-    GetRunTimes(m_db, h, l, a);
-    GetSize(m_db.size(), fSize);
-    std::printf("            DB   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
-    GetRunTimes(m_itemload, h, l, a);
-    GetSize(m_itemload.size(), fSize);
-    std::printf("  Item Loading   %s times.   \tHi: %.4fus   \tLo: %.4fus   \tAvg: %.4fus\n", fSize.c_str(), h, l, a );
+    PrintKey(Profile::db,        "DB");
+    PrintKey(Profile::itemload,  "Item Loading");
     std::printf("\n");     // spacer
     std::printf("\t\tUnimplemented Calls\n");
-    GetRunTimes(m_server, h, l, a);
-    std::printf("        *Main()  %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_server.size(), h, l, a );
-    GetRunTimes(m_map, h, l, a);
-    std::printf("          *Map   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_map.size(), h, l, a );
-    GetRunTimes(m_items, h, l, a);
-    std::printf("        *Items   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_items.size(),  h, l, a );
-    GetRunTimes(m_functions, h, l, a);
-    std::printf("    *Functions   %u times.   \tHi: %.4f   \tLo: %.4fus   \tAvg: %.4fus\n", m_functions.size(), h, l, a );
+    PrintKey(Profile::map,       "*Map");
+    PrintKey(Profile::items,     "*Items");
+    PrintKey(Profile::functions, "*Functions");
 
     std::printf(" Profile Times Compiled in %.4fus\n", (GetTimeUSeconds() -startTime) );
 }
 
-void Profiler::GetRunTimes(std::vector< double >& container, float& h, float& l, float& a)
+void Profiler::Export()
 {
-    if (container.empty()) {
-        h = 0.0f;
-        l = 0.0f;
-        a = 0.0f;
+    // write to temp file and rename, so anything reading this never sees a partial file
+    std::string fileName(sConfig.files.logDir + "server_profile.txt");
+    std::string tmpName(fileName + ".tmp");
+    FILE* fp = fopen(tmpName.c_str(), "w");
+    if (fp == nullptr) {
+        sLog.Error("  Profile Manager", "Unable to open %s for writing.", tmpName.c_str());
         return;
     }
 
-    uint32 size = container.size();
-    float total(0.0f), lo(0.0f), hi(0.0f);
-    for (uint32 i = 0; i < size; ++i) {
-        total += container.at(i);
-        if ((lo > container.at(i)) or (lo < 0.000001f))
-            lo = container.at(i);
-        if (hi < container.at(i))
-            hi = container.at(i);
+    fprintf(fp, "# EVEmu server profile.  times in us.  interval %u minutes.  written %s\n", \
+            sConfig.debug.ProfileInterval, currentDateTime().c_str());
+
+    const char* window[2] = {"interval", "run"};
+    const double quantile[3] = {50, 95, 99};
+    ProfileHistogram hist;
+    for (uint8 key = 1; key < Profile::count; ++key) {
+        for (uint8 w = 0; w < 2; ++w) {
+            if (w == 0)
+                hist = m_interval[key];
+            else
+                GetRunData(key, hist);
+            if (hist.Count() == 0)
+                continue;
+            std::string name(GetKeyName(key));
+            fprintf(fp, "evemu_profile_count{zone=\"%s\",window=\"%s\"} %u\n", name.c_str(), window[w], hist.Count());
+            fprintf(fp, "evemu_profile_sum_us{zone=\"%s\",window=\"%s\"} %.3f\n", name.c_str(), window[w], hist.Total());
+            for (uint8 q = 0; q < 3; ++q)
+                fprintf(fp, "evemu_profile_us{zone=\"%s\",window=\"%s\",quantile=\"%.2f\"} %.3f\n", \
+                        name.c_str(), window[w], quantile[q] / 100, hist.Percentile(quantile[q]));
+            fprintf(fp, "evemu_profile_max_us{zone=\"%s\",window=\"%s\"} %.3f\n", name.c_str(), window[w], hist.Max());
+        }
     }
 
-    h = hi;
-    l = lo;
-    a = total / size;
+    fclose(fp);
+    if (rename(tmpName.c_str(), fileName.c_str()) != 0)
+        sLog.Error("  Profile Manager", "Unable to rename %s to %s.", tmpName.c_str(), fileName.c_str());
 }
 
 void Profiler::GetSize(size_t cSize, std::string& fSize)
@@ -378,11 +224,25 @@ std::string Profiler::GetKeyName(uint8& key)
         case Profile::colony:        return "Colony";    //  23,
         case Profile::damage:        return "Damage";    //  24,
         case Profile::parseFX:       return "ParseFX";   //  25,
-        case Profile::applyFX:       return "ApplyFX";   //  26
+        case Profile::applyFX:       return "ApplyFX";   //  26,
+        case Profile::onTarg:        return "OnTarget";  //  27
+        case Profile::combat:        return "Combat";    //  28
         default:                     return "Invalid Key";
     }
 }
 
+ProfileZone::ProfileZone(uint8 key)
+: m_key(key),
+m_startTime(sConfig.debug.UseProfiling ? GetTimeUSeconds() : 0)
+{
+}
+
+ProfileZone::~ProfileZone()
+{
+    if (m_startTime > 0)
+        sProfiler.AddTime(m_key, GetTimeUSeconds() - m_startTime);
+}
+
 /*  color shit....
  *
     ::fputs( COLOR_TABLE[ color ], stdout );
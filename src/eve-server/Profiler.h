@@ -7,13 +7,15 @@
  */
 
 /**   Allan's EvEmu Profiler
- * simple singleton profiler using std::vector<double> being simple mem object storage.
- * vector object denotes call type, (db, client, map, etc.)
- * double precision float holds elapsed time for that particular call
- * output functions use size() to count calls, and give readouts as
- *     CALL_TYPE: called N times, hi: Xus, lo: Yus, avg: Zus
+ * simple singleton profiler.  each call type (db, client, map, etc.) has a pair of fixed-size histograms,
+ *  one for the current interval and one for the whole run, so memory use does not grow with uptime.
+ * histograms are log-linear (HDR style), see utils/ProfileHistogram.h
+ * output functions give readouts as
+ *     CALL_TYPE: called N times, avg: Xus, p50: Yus, p95: Zus, p99: Wus, max: Vus
  *  Times are measured in microseconds via GetTimeUSeconds() from core/utils/utils_time.cpp
  *
+ * the current interval is rolled into the run totals every debug.ProfileInterval minutes,
+ *  and optionally written to <logDir>/server_profile.txt as text metrics.
  */
 
 
@@ -23,6 +25,8 @@
 
 #include "eve-common.h"
 
+#include "utils/ProfileHistogram.h"
+
 namespace Profile {
     enum {          // implemented?  (* = yes)
         destiny     = 1,    //*
@@ -36,7 +40,7 @@ namespace Profile {
         db          = 9,    //*
         ship        = 10,   //*
         targets     = 11,   //*
-        server      = 12,   //
+        server      = 12,   //*
         missile     = 13,   //*
         system      = 14,   //*
         entityS     = 15,   //*
@@ -51,7 +55,9 @@ namespace Profile {
         damage      = 24,   //*
         parseFX     = 25,   //*
         applyFX     = 26,   //*
-        onTarg      = 27    //
+        onTarg      = 27,   //
+        combat      = 28,   //*
+        count       = 29    // must be last
     };
 }
 
@@ -59,54 +65,59 @@ class Profiler
 : public Singleton<Profiler>
 {
 public:
-    Profiler() {};
+    Profiler();
     ~Profiler() {};
 
     int Initialize();
 
+    // called from main loop.  rolls interval data into run totals and writes export file
+    void Process();
+
     void AddTime(uint8 key, double value);
     void PrintProfile();
     void PrintStartUpData();
     void ClearAll();
 
-    void GetSize(size_t cSize, std::string& ret);
+    // writes current interval and run totals to <logDir>/server_profile.txt
+    void Export();
 
-    void GetRunTimes(std::vector< double >& container, float& h, float& l, float& a);
+    void GetSize(size_t cSize, std::string& ret);
 
 protected:
     std::string GetKeyName(uint8& key);
 
+    // prints run totals for this key, or 'Disabled' if enabled=false
+    void PrintKey(uint8 key, const char* label, bool enabled=true);
+    // current interval is not included in the run totals until rollover, so merge for readouts
+    void GetRunData(uint8 key, ProfileHistogram& hist);
+
 private:
-    std::vector<double> m_server;
-    std::vector<double> m_functions;
-    std::vector<double> m_db;
-    std::vector<double> m_client;
-    std::vector<double> m_map;
-    std::vector<double> m_destiny;
-    std::vector<double> m_system;
-    std::vector<double> m_entityS;
-    std::vector<double> m_npc;
-    std::vector<double> m_drone;
-    std::vector<double> m_bubbles;
-    std::vector<double> m_items;
-    std::vector<double> m_itemload;
-    std::vector<double> m_modules;
-    std::vector<double> m_ship;
-    std::vector<double> m_targets;
-    std::vector<double> m_ontarget;
-    std::vector<double> m_missile;
-    std::vector<double> m_loot;
-    std::vector<double> m_salvage;
-    std::vector<double> m_spawn;
-    std::vector<double> m_collision;
-    std::vector<double> m_concord;
-    std::vector<double> m_colony;
-    std::vector<double> m_damage;
-    std::vector<double> m_effects1;
-    std::vector<double> m_effects2;
+    Timer m_intervalTimer;
+
+    ProfileHistogram m_interval[Profile::count];
+    ProfileHistogram m_total[Profile::count];
 };
 
 #define sProfiler \
     ( Profiler::get() )
 
+/*
+ * RAII timing zone.  times from construction to end of scope and adds it to the given key.
+ * does nothing (other than check config) if profiling is disabled
+ *  {
+ *      ProfileZone zone(Profile::system);
+ *      ...
+ *  }
+ */
+class ProfileZone
+{
+public:
+    ProfileZone(uint8 key);
+    ~ProfileZone();
+
+private:
+    uint8 m_key;
+    double m_startTime;
+};
+
 #endif  // EVEMU_EVESERVER_PROFILER_H_
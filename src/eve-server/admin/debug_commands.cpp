@@ -10,6 +10,7 @@
 #include "npc/NPCAI.h"
 #include "admin/AllCommands.h"
 #include "admin/CommandDB.h"
+#include "services/ServiceManager.h"
 #include "fleet/FleetService.h"
 #include "inventory/AttributeEnum.h"
 #include "inventory/Inventory.h"
@@ -1207,6 +1208,94 @@ PyResult Command_runtest(Client* pClient, CommandDB* db, EVEServiceManager &serv
     return nullptr;
 }
 
+PyResult Command_fxtest(Client* pClient, CommandDB* db, EVEServiceManager &services, const Seperator& args)
+{
+    std::string report(testing::fxTest(pClient));
+    pClient->SendInfoModalMsg("%s", report.c_str());
+    return new PyString(report);
+}
+
+PyResult Command_benchmark(Client* pClient, CommandDB* db, EVEServiceManager &services, const Seperator& args)
+{
+    if (args.argCount() < 2)
+        throw CustomError ("Correct Usage: /benchmark <name> [loops]");
+
+    uint32 loops(0);
+    if (args.argCount() > 2) {
+        if (!args.isNumber(2))
+            throw CustomError ("Argument 2 should be the number of loops to run");
+        loops = atoi(args.arg(2).c_str());
+    }
+
+    std::string report;
+    const std::string& name = args.arg(1);
+    if (name == "refptr") {
+        report = testing::refPtrBench(pClient, loops);
+    } else if (name == "dscan") {
+        report = testing::dscanBench(pClient, loops);
+    } else if (name == "dispatch") {
+        report = testing::dispatchBench(pClient, loops);
+    } else if (name == "search") {
+        report = testing::searchBench(pClient, loops);
+    } else if (name == "rowset") {
+        report = testing::rowsetBench(pClient, loops);
+    } else if (name == "npcai") {
+        report = testing::npcAIBench(pClient, loops);
+    } else if (name == "ball") {
+        report = testing::ballBench(pClient, loops);
+    } else if (name == "intercept") {
+        report = testing::interceptBench(pClient, loops);
+    } else if (name == "combat") {
+        report = testing::combatBench(pClient, loops);
+    } else {
+        throw CustomError ("Unknown benchmark '%s'.", name.c_str());
+    }
+
+    pClient->SendInfoModalMsg("%s", report.c_str());
+    return new PyString(report);
+}
+
+PyResult Command_callStats(Client* pClient, CommandDB* db, EVEServiceManager &services, const Seperator& args)
+{
+    uint32 count(25);
+    if (args.argCount() > 1) {
+        if (!args.isNumber(1))
+            throw CustomError ("Argument 1 should be the number of methods to list");
+        count = atoi(args.arg(1).c_str());
+    }
+
+    // calls, mismatches, service::method
+    std::vector<std::tuple<uint32, uint32, std::string>> stats;
+    for (auto& svc : services.GetServices())
+        for (auto& cur : svc.second->GetCallTable().methods())
+            if (cur.second.calls > 0)
+                stats.emplace_back(cur.second.calls, cur.second.mismatches, svc.first + "::" + cur.first);
+    // bound object tables are shared per type, so only list each table once
+    std::set<const CallTable*> tables;
+    for (auto& bound : services.GetBoundServices()) {
+        const CallTable& table = bound.second->GetCallTable();
+        if (!tables.insert(&table).second)
+            continue;
+        for (auto& cur : table.methods())
+            if (cur.second.calls > 0)
+                stats.emplace_back(cur.second.calls, cur.second.mismatches, "bound::" + cur.first);
+    }
+
+    std::sort(stats.begin(), stats.end(), [](const auto& a, const auto& b) { return std::get<0>(a) > std::get<0>(b); });
+
+    std::ostringstream str;
+    str << "Service method calls (" << stats.size() << " methods called)<br>";
+    for (size_t i = 0; (i < stats.size()) and (i < count); ++i) {
+        str << "  " << std::get<2>(stats[i]) << ": " << std::get<0>(stats[i]) << " calls";
+        if (std::get<1>(stats[i]) > 0)
+            str << ", " << std::get<1>(stats[i]) << " not matched";
+        str << "<br>";
+    }
+
+    pClient->SendInfoModalMsg("%s", str.str().c_str());
+    return new PyString(str.str());
+}
+
 PyResult Command_bindList(Client* pClient, CommandDB* db, EVEServiceManager &services, const Seperator& args)
 {
     // TODO: properly implement this
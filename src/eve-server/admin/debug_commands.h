@@ -62,6 +62,12 @@
           " - begin warp to given bubbleID in current ship.")
  COMMAND( runtest, Acct::Role::PROGRAMMER,
           " - run testing::posTest()." )
+ COMMAND( fxtest, Acct::Role::PROGRAMMER,
+          " - check incremental effects (FxGraph) against the legacy full recompute on your ship.  must be docked" )
+ COMMAND( benchmark, Acct::Role::PROGRAMMER,
+          "(name) [loops] - run a testing:: micro-benchmark.  names: refptr, dscan, dispatch, search, rowset, npcai, ball, intercept, combat" )
+ COMMAND( callStats, Acct::Role::PROGRAMMER,
+          "[count] - list most called service methods, with call and signature mismatch counts." )
  COMMAND( bindList, Acct::Role::PROGRAMMER,
           " - list of current bound objects (with clients)." )
  COMMAND( dropLoot, Acct::Role::PROGRAMMER,
@@ -34,11 +34,14 @@
 #include "StatisticMgr.h"
 #include "account/AccountService.h"
 #include "character/Character.h"
+#include "character/SkillQueueMgr.h"
 #include "effects/EffectsProcessor.h"
 #include "fleet/FleetService.h"
 #include "inventory/AttributeEnum.h"
 #include "inventory/Inventory.h"
+#include "market/MarketOrderBook.h"
 #include "ship/Ship.h"
+#include "standing/StandingMgr.h"
 
 /*
  * CharacterTypeData
@@ -354,7 +357,8 @@ void Character::LogOut()
 void Character::Delete() {
     // delete contents
     pInventory->DeleteContents();
-    // delete character record
+    // delete character record.  this also deletes their market orders, so drop any loaded copies
+    sOrderBook.RemoveOwnerOrders(m_itemID);
     m_db.DeleteCharacter(m_itemID);
     // let the parent care about the rest
     InventoryItem::Delete();
@@ -506,15 +510,15 @@ void Character::ProcessEffects(ShipItem* pShip)
 
     Effect curEffect = Effect();
     std::vector<TypeEffects> typeFx;
-    for (auto curSkill : allSkills) {
+    for (auto& curSkill : allSkills) {
         typeFx.clear();
         sFxDataMgr.GetTypeEffect(curSkill->typeID(), typeFx);
-        for (auto curFx : typeFx) {
+        for (auto& curFx : typeFx) {
             curEffect = sFxDataMgr.GetEffect(curFx.effectID);
             fxData data = fxData();
             data.action = FX::Action::Invalid;
             data.srcRef = curSkill;
-            sFxProc.ParseExpression(this, sFxDataMgr.GetExpression(curEffect.preExpression), data);
+            sFxProc.ExecuteProgram(this, curEffect.preExpression, data);
         }
     }
     // apply processed char effects
@@ -631,11 +635,11 @@ int64 Character::GetEndOfTraining() {
                 m_inTraining->name(), m_inTraining->itemID());
         m_inTraining->SetFlag(flagSkill, true);
         m_inTraining = nullptr;
-        m_pClient->SetTrainingEndTime(0);
+        sSkillQueueMgr.Schedule(m_itemID, 0);
         return 0;
     }
 
-    m_pClient->SetTrainingEndTime(m_skillQueue.front().endTime);
+    sSkillQueueMgr.Schedule(m_itemID, m_skillQueue.front().endTime);
     return m_skillQueue.front().endTime;
 }
 
@@ -1169,14 +1173,14 @@ void Character::UpdateSkillQueueEndTime()
 {
     if (m_skillQueue.empty()) {
         m_db.UpdateSkillQueueEndTime(0, m_itemID);
-        m_pClient->SetTrainingEndTime(0);
+        sSkillQueueMgr.Schedule(m_itemID, 0);
         if (is_log_enabled(SKILL__TRACE))
             _log(SKILL__QUEUE, "%s(%u):  UpdateSkillQueueEndTime() - Queue is empty.", name(), m_itemID);
         return;
     }
 
-    // update client timer check for skill in training
-    m_pClient->SetTrainingEndTime(m_skillQueue.front().endTime);
+    // update completion queue for skill in training
+    sSkillQueueMgr.Schedule(m_itemID, m_skillQueue.front().endTime);
     m_db.UpdateSkillQueueEndTime(m_skillQueue.back().endTime, m_itemID);
 
     SaveSkillQueue();
@@ -1364,7 +1368,7 @@ float Character::GetStandingModified(uint32 fromID, uint32 toID)
 {
     if (toID == 0)
         toID = m_itemID;
-    float res = StandingDB::GetStanding(fromID, toID);
+    float res = sStandingMgr.GetStanding(fromID, toID);
     if (res < 0.0f) {
         res += ((10.0f + res) * (0.04f * GetSkillLevel(EvESkill::Diplomacy)));
     } else {
@@ -1376,7 +1380,7 @@ float Character::GetStandingModified(uint32 fromID, uint32 toID)
 float Character::GetNPCCorpStanding(uint32 fromID, uint32 toID) {
     if (toID == 0)
         toID = m_itemID;
-    float res = StandingDB::GetStanding(fromID, toID);
+    float res = sStandingMgr.GetStanding(fromID, toID);
     if (res < 0.0f) {
         res += ((10.0f + res) * (0.04f * GetSkillLevel(EvESkill::Diplomacy)));
     } else {
@@ -1386,7 +1390,7 @@ float Character::GetNPCCorpStanding(uint32 fromID, uint32 toID) {
 }
 
 void Character::SetStanding(uint32 fromID, uint32 toID, float standing) {
-    StandingDB::SetStanding(fromID, toID, standing);
+    sStandingMgr.SetStanding(fromID, toID, standing);
     PyTuple* payload = new PyTuple(0);
     m_pClient->SendNotification("OnStandingSet", "charid", payload, false);
 }
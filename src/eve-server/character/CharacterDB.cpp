@@ -29,6 +29,8 @@
 #include "EVEServerConfig.h"
 #include "character/Character.h"
 #include "character/CharacterDB.h"
+#include "search/SearchIndex.h"
+#include "standing/StandingMgr.h"
 
 uint32 CharacterDB::NewCharacter(const CharacterData& data, const CorpData& corpData) {
     DBerror err;
@@ -59,6 +61,7 @@ uint32 CharacterDB::NewCharacter(const CharacterData& data, const CorpData& corp
     }
 
     AddEmployment(charID, corpData.corporationID);
+    sSearchIndex.Add(searchResultCharacter, charID, data.name);
 
     return charID;
 }
@@ -145,10 +148,12 @@ void CharacterDB::DeleteCharacter(uint32 characterID) {
     //sDatabase.RunQuery(err, "DELETE FROM bookmarkVouchers WHERE ownerID = %u",  characterID);
     sDatabase.RunQuery(err, "DELETE FROM mktOrders WHERE ownerID = %u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM mktTransactions WHERE clientID = %u", characterID);
+    sStandingMgr.RemoveOwner(characterID);
     sDatabase.RunQuery(err, "DELETE FROM repStandings WHERE (fromID = %u OR toID = %u)", characterID, characterID);
     sDatabase.RunQuery(err, "DELETE FROM repStandingChanges WHERE (fromID = %u OR toID = %u)", characterID, characterID);
     sDatabase.RunQuery(err, "DELETE FROM chrCertificates WHERE characterID=%u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM chrCharacters WHERE characterID=%u", characterID);
+    sSearchIndex.Remove(searchResultCharacter, characterID);
     sDatabase.RunQuery(err, "DELETE FROM chrEmployment WHERE characterID=%u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM jnlCharacters WHERE ownerID=%u", characterID);
     sDatabase.RunQuery(err, "DELETE FROM crpShares WHERE shareholderID=%u", characterID);
@@ -1546,6 +1551,116 @@ bool CharacterDB::LoadSkillQueue(uint32 characterID, SkillQueue &into) {
     return true;
 }
 
+bool CharacterDB::LoadSkillQueueEndTimes(std::map<uint32, int64>& into) {
+    DBQueryResult res;
+    // queue is saved in training order, so first skill has lowest endTime
+    if (!sDatabase.RunQuery( res, "SELECT characterID, MIN(endTime) FROM chrSkillQueue WHERE endTime > 0 GROUP BY characterID")) {
+        _log(DATABASE__ERROR, "Failed to query skill queue end times: %s.", res.error.c_str());
+        return false;
+    }
+
+    DBResultRow row;
+    while (res.GetRow(row))
+        into[row.GetUInt(0)] = row.GetInt64(1);
+
+    return true;
+}
+
+bool CharacterDB::LoadSkillItemIDs(uint32 charID, std::map<uint16, uint32>& into) {
+    DBQueryResult res;
+    if (!sDatabase.RunQuery( res, "SELECT typeID, itemID FROM entity WHERE locationID = %u AND flag IN (%u, %u)", \
+            charID, flagSkill, flagSkillInTraining)) {
+        _log(DATABASE__ERROR, "Failed to query skills of character %u: %s.", charID, res.error.c_str());
+        return false;
+    }
+
+    DBResultRow row;
+    while (res.GetRow(row))
+        into[row.GetUInt(0)] = row.GetUInt(1);
+
+    return true;
+}
+
+void CharacterDB::SaveSkillQueueEvents(std::vector<SkillQueueEvent>& events, std::vector<uint32>& emptied) {
+    if (events.empty() and emptied.empty())
+        return;
+
+    std::ostringstream Attribs, Trained, Training, History, Queue;
+    bool first(true), firstTrained(true), firstTraining(true), firstQueue(true);
+    Attribs << "REPLACE INTO entity_attributes (itemID, attributeID, valueInt, valueFloat) VALUES ";
+    History << "INSERT INTO chrSkillHistory (eventTypeID, logDate, characterID, skillTypeID, skillLevel, absolutePoints) VALUES ";
+    Queue << "DELETE FROM chrSkillQueue WHERE (characterID, typeID, level) IN (";
+    for (const auto& cur : events) {
+        if (first) {
+            first = false;
+        } else {
+            History << ",";
+        }
+        History << "(" << (cur.completed ? EvESkill::Event::QueueTrainingCompleted : EvESkill::Event::TrainingStarted) << ", ";
+        History << cur.logDate << ", " << cur.characterID << ", " << cur.typeID << ", " << (uint16)cur.level << ", " << cur.points << ")";
+
+        if (!cur.completed) {
+            if (firstTraining) {
+                firstTraining = false;
+            } else {
+                Training << ",";
+            }
+            Training << cur.itemID;
+            continue;
+        }
+
+        if (firstTrained) {
+            firstTrained = false;
+        } else {
+            Attribs << ",";
+            Trained << ",";
+            Queue << ",";
+        }
+        Attribs << "(" << cur.itemID << ", " << AttrSkillLevel << ", " << (uint16)cur.level << ", NULL),";
+        Attribs << "(" << cur.itemID << ", " << AttrSkillPoints << ", " << cur.points << ", NULL)";
+        Trained << cur.itemID;
+        Queue << "(" << cur.characterID << ", " << cur.typeID << ", " << (uint16)cur.level << ")";
+    }
+    Queue << ")";
+
+    DBerror err;
+    bool queueRemoved(true);
+    if (!firstTrained) {
+        if (!sDatabase.RunQuery(err, Attribs.str().c_str()))
+            _log(DATABASE__ERROR, "SaveSkillQueueEvents - unable to save attributes - %s", err.c_str());
+        if (!sDatabase.RunQuery(err, "UPDATE entity SET flag = %u WHERE itemID IN (%s)", flagSkill, Trained.str().c_str()))
+            _log(DATABASE__ERROR, "SaveSkillQueueEvents - unable to save trained flags - %s", err.c_str());
+        if (!sDatabase.RunQuery(err, Queue.str().c_str())) {
+            _log(DATABASE__ERROR, "SaveSkillQueueEvents - unable to remove queue rows - %s", err.c_str());
+            queueRemoved = false;
+        }
+    }
+    // after trained flags, as the next level of a trained skill can start in the same pass
+    if (!firstTraining)
+        if (!sDatabase.RunQuery(err, "UPDATE entity SET flag = %u WHERE itemID IN (%s)", flagSkillInTraining, Training.str().c_str()))
+            _log(DATABASE__ERROR, "SaveSkillQueueEvents - unable to save training flags - %s", err.c_str());
+    if (!first)
+        if (!sDatabase.RunQuery(err, History.str().c_str()))
+            _log(DATABASE__ERROR, "SaveSkillQueueEvents - unable to save history - %s", err.c_str());
+
+    // emptied queues still have their rows if the delete failed, so they keep their end time and are done again next boot
+    if (emptied.empty() or !queueRemoved)
+        return;
+
+    std::ostringstream Chars;
+    first = true;
+    for (auto cur : emptied) {
+        if (first) {
+            first = false;
+        } else {
+            Chars << ",";
+        }
+        Chars << cur;
+    }
+    if (!sDatabase.RunQuery(err, "UPDATE chrCharacters SET skillQueueEndTime = 0 WHERE characterID IN (%s)", Chars.str().c_str()))
+        _log(DATABASE__ERROR, "SaveSkillQueueEvents - unable to clear queue end times - %s", err.c_str());
+}
+
 bool CharacterDB::LoadPausedSkillQueue(uint32 characterID, SkillQueue &into) {
     DBQueryResult res;
     if (!sDatabase.RunQuery( res, "SELECT typeID, level FROM chrPausedSkillQueue WHERE characterID = %u ORDER BY orderIndex ASC", characterID)) {
@@ -77,6 +77,17 @@ struct QueuedSkill {
 };
 typedef std::vector<QueuedSkill> SkillQueue;
 
+/* POD structure for skill changes made by SkillQueueMgr for offline characters */
+struct SkillQueueEvent {
+    bool completed;     // true for level trained, false for training started
+    uint8 level;
+    uint16 typeID;
+    uint32 characterID;
+    uint32 itemID;
+    uint32 points;
+    int64 logDate;
+};
+
 //class PyObject;
 //class PyString;
 //class PyObjectEx;
@@ -215,6 +226,14 @@ public:
     PyRep*      GetSkillHistory(uint32 charID);
     void        UpdateSkillQueueEndTime(int64 endtime, uint32 charID);
 
+    // endTime of first skill in queue for all characters with skills in training.  charID/endTime
+    bool        LoadSkillQueueEndTimes(std::map<uint32, int64>& into);
+    // skill itemIDs for character.  typeID/itemID
+    bool        LoadSkillItemIDs(uint32 charID, std::map<uint16, uint32>& into);
+    // saves levels, flags, history and queue rows for all events in one set of queries.
+    //  emptied is characters with no skills left in queue
+    void        SaveSkillQueueEvents(std::vector<SkillQueueEvent>& events, std::vector<uint32>& emptied);
+
     void        SetLogInTime(uint32 charID);
     void        SetLogOffTime(uint32 charID);
 
@@ -0,0 +1,205 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name SkillQueueMgr.cpp
+ *   server-wide skill training completion queue, for online and offline characters
+ */
+
+#include "Client.h"
+#include "EntityList.h"
+#include "StaticDataMgr.h"
+#include "character/SkillQueueMgr.h"
+#include "inventory/ItemType.h"
+
+/*
+ * SKILL__ERROR
+ * SKILL__WARNING
+ * SKILL__MESSAGE
+ * SKILL__INFO
+ * SKILL__DEBUG
+ * SKILL__TRACE
+ * SKILL__QUEUE
+ */
+
+SkillQueueMgr::SkillQueueMgr()
+{
+    m_queue.clear();
+    m_chars.clear();
+}
+
+int SkillQueueMgr::Initialize()
+{
+    std::map<uint32, int64> endTimes;
+    if (!m_db.LoadSkillQueueEndTimes(endTimes))
+        return 0;
+
+    for (auto cur : endTimes)
+        Schedule(cur.first, cur.second);
+
+    sLog.Blue("    SkillQueueMgr", "Skill Queue Manager Initialized with %u characters in training.", Count());
+    return 1;
+}
+
+void SkillQueueMgr::Close()
+{
+    // nothing to save.  all changes are written as they happen
+    m_queue.clear();
+    m_chars.clear();
+    sLog.Warning("    SkillQueueMgr", "Skill Queue Manager has been closed." );
+}
+
+void SkillQueueMgr::Schedule(uint32 charID, int64 endTime)
+{
+    std::unordered_map<uint32, std::multimap<int64, uint32>::iterator>::iterator itr = m_chars.find(charID);
+    if (itr != m_chars.end()) {
+        if (itr->second->first == endTime)
+            return;
+        m_queue.erase(itr->second);
+        m_chars.erase(itr);
+    }
+
+    if (endTime < 1)
+        return;
+
+    m_chars[charID] = m_queue.insert(std::pair<int64, uint32>(endTime, charID));
+}
+
+void SkillQueueMgr::Process()
+{
+    int64 curTime(GetFileTimeNow());
+    if (m_queue.empty() or (m_queue.begin()->first >= curTime))
+        return;
+
+    double start(GetTimeMSeconds());
+
+    // take all due characters off the queue first, as completing them will schedule their next skill
+    std::vector<uint32> due;
+    while (!m_queue.empty() and (m_queue.begin()->first < curTime)) {
+        due.push_back(m_queue.begin()->second);
+        m_chars.erase(m_queue.begin()->second);
+        m_queue.erase(m_queue.begin());
+    }
+
+    std::vector<uint32> emptied;
+    std::vector<SkillQueueEvent> events;
+    Client* pClient(nullptr);
+    for (auto cur : due) {
+        pClient = sEntityList.FindClientByCharID(cur);
+        if (pClient != nullptr) {
+            // online.  character object does all the work and reschedules itself
+            if (pClient->IsValidSession() and (pClient->GetChar().get() != nullptr)) {
+                pClient->GetChar()->SkillQueueLoop();
+            } else {
+                Schedule(cur, curTime + EvE::Time::Minute);
+            }
+            continue;
+        }
+
+        // character is still loaded but not online (logging out, or loaded by a GM command).
+        //   db changes would be overwritten when it saves, so try again later
+        if (sItemFactory.GetItemRefFromID(cur, false).get() != nullptr) {
+            Schedule(cur, curTime + EvE::Time::Minute);
+            continue;
+        }
+
+        ProcessOffline(cur, curTime, events, emptied);
+    }
+
+    m_db.SaveSkillQueueEvents(events, emptied);
+
+    _log(SKILL__QUEUE, "SkillQueueMgr::Process() - %u characters due, %u offline events saved in %.3fms", \
+            (uint32)due.size(), (uint32)events.size(), (GetTimeMSeconds() - start));
+}
+
+void SkillQueueMgr::ProcessOffline(uint32 charID, int64 curTime, std::vector<SkillQueueEvent>& events, std::vector<uint32>& emptied)
+{
+    SkillQueue queue;
+    if (!m_db.LoadSkillQueue(charID, queue))
+        return;
+    if (queue.empty()) {
+        emptied.push_back(charID);
+        return;
+    }
+
+    std::map<uint16, uint32> skills;
+    if (!m_db.LoadSkillItemIDs(charID, skills))
+        return;
+
+    bool skipped(false);
+    const ItemType* pType(nullptr);
+    std::map<uint16, uint32>::iterator itr = skills.end();
+    SkillQueue::iterator qitr = queue.begin();
+    for (; qitr != queue.end(); ++qitr) {
+        if (qitr->endTime >= curTime)
+            break;
+
+        itr = skills.find(qitr->typeID);
+        pType = sItemFactory.GetType(qitr->typeID);
+        if ((itr == skills.end()) or (pType == nullptr) or (!sDataMgr.IsSkillTypeID(qitr->typeID))) {
+            // left in queue for SkillQueueLoop() to clean up on login
+            _log(SKILL__WARNING, "SkillQueueMgr - skill %u level %u in queue for %u was not found.", qitr->typeID, qitr->level, charID);
+            skipped = true;
+            continue;
+        }
+
+        SkillQueueEvent evt = SkillQueueEvent();
+            evt.completed = true;
+            evt.level = qitr->level;
+            evt.typeID = qitr->typeID;
+            evt.characterID = charID;
+            evt.itemID = itr->second;
+            evt.points = EvEMath::Skill::PointsAtLevel(qitr->level, pType->GetAttribute(AttrSkillTimeConstant).get_float());
+            evt.logDate = qitr->endTime;
+        events.push_back(evt);
+
+        _log(SKILL__INFO, "SkillQueueMgr - %u completed training of %s level %u while offline.", charID, pType->name().c_str(), qitr->level);
+    }
+
+    // queue is only empty once every row in it is removed, so a skipped skill keeps the end time
+    if (qitr == queue.end()) {
+        if (!skipped)
+            emptied.push_back(charID);
+        return;
+    }
+
+    // start next skill, if the one before it has just completed
+    if (qitr != queue.begin()) {
+        itr = skills.find(qitr->typeID);
+        pType = sItemFactory.GetType(qitr->typeID);
+        if ((itr != skills.end()) and (pType != nullptr)) {
+            SkillQueueEvent evt = SkillQueueEvent();
+                evt.completed = false;
+                evt.level = qitr->level;
+                evt.typeID = qitr->typeID;
+                evt.characterID = charID;
+                evt.itemID = itr->second;
+                evt.points = EvEMath::Skill::PointsAtLevel(qitr->level, pType->GetAttribute(AttrSkillTimeConstant).get_float());
+                evt.logDate = qitr->startTime;
+            events.push_back(evt);
+        }
+    }
+
+    Schedule(charID, qitr->endTime);
+}
@@ -0,0 +1,80 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name SkillQueueMgr.h
+ *   server-wide skill training completion queue, for online and offline characters
+ */
+
+#ifndef _EVE_SERVER_SKILL_QUEUE_MANAGER_H__
+#define _EVE_SERVER_SKILL_QUEUE_MANAGER_H__
+
+
+#include "eve-server.h"
+
+#include "character/CharacterDB.h"
+
+/*
+ * holds the endTime of the skill in training for every character with a queue, ordered by endTime.
+ * Process() is called at 1Hz and only looks at the front of the queue.
+ * online characters complete training through Character::SkillQueueLoop(), which reschedules them.
+ * offline characters are completed here, directly in the db, with all changes from one pass saved together.
+ *   this keeps offline queues current, so login doesnt have to replay them.
+ */
+class SkillQueueMgr
+: public Singleton< SkillQueueMgr >
+{
+public:
+    SkillQueueMgr();
+    ~SkillQueueMgr()                                    { /* do nothing here */ }
+
+    int Initialize();
+    void Close();
+    // called at 1Hz.  completes all training due by now
+    void Process();
+
+    // sets when this character's skill in training completes.  0 removes character from queue
+    void Schedule(uint32 charID, int64 endTime);
+
+    uint32 Count()                                      { return (uint32)m_chars.size(); }
+
+private:
+    // completes due skills for an offline character from db data, adding changes to events and scheduling next skill.
+    //  character is added to emptied if nothing is left in queue
+    void ProcessOffline(uint32 charID, int64 curTime, std::vector<SkillQueueEvent>& events, std::vector<uint32>& emptied);
+
+    CharacterDB m_db;
+
+    // endTime/charID
+    std::multimap<int64, uint32> m_queue;
+    // charID/position in m_queue
+    std::unordered_map<uint32, std::multimap<int64, uint32>::iterator> m_chars;
+};
+
+//Singleton
+#define sSkillQueueMgr \
+( SkillQueueMgr::get() )
+
+
+#endif  // _EVE_SERVER_SKILL_QUEUE_MANAGER_H__
@@ -0,0 +1,379 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name ContractIndex.cpp
+ *   in-memory search index of outstanding contracts, for contract browser searches
+ */
+
+#include "contract/ContractIndex.h"
+
+// column order used by Load()
+static const char* contractQueryBase = "SELECT contractId, contractType, isPrivate, assigneeID, issuerID, issuerCorpID, forCorp, price, reward,"
+                                       " startSolarSystemID, startRegionID, endSolarSystemID, endRegionID"
+                                       " FROM ctrContracts"
+                                       " WHERE status = 0";
+// only items with an entity are searchable, same as the old search query
+static const char* itemQueryBase = "SELECT cI.contractId, e.typeID, iT.groupID, iG.categoryID"
+                                   " FROM ctrItems cI"
+                                   " JOIN ctrContracts cC ON cC.contractId = cI.contractId"
+                                   " JOIN entity e ON cI.itemID = e.itemID"
+                                   " JOIN invTypes iT ON iT.typeID = e.typeID"
+                                   " JOIN invGroups iG ON iG.groupID = iT.groupID"
+                                   " WHERE cC.status = 0";
+
+ContractIndex::ContractIndex()
+{
+    m_contracts.clear();
+    m_byPrice.clear();
+}
+
+int ContractIndex::Initialize()
+{
+    double start(GetTimeMSeconds());
+    DBQueryResult res, items;
+    if (!sDatabase.RunQuery(res, "%s ORDER BY contractId", contractQueryBase)) {
+        codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
+        return 0;
+    }
+    if (!sDatabase.RunQuery(items, "%s ORDER BY cI.contractId", itemQueryBase)) {
+        codelog(DATABASE__ERROR, "Error in query: %s", items.error.c_str());
+        return 0;
+    }
+
+    uint32 count(Load(res, items));
+    sLog.Cyan("    ContractIndex", "%u outstanding contracts indexed in %.3fms.", count, (GetTimeMSeconds() - start));
+    sLog.Blue("    ContractIndex", "Contract Index Initialized.");
+    return 1;
+}
+
+void ContractIndex::Close()
+{
+    // nothing to save.  contracts are written to db when changed
+    sLog.Warning("    ContractIndex", "Contract Index has been closed." );
+}
+
+uint32 ContractIndex::Load(DBQueryResult& res, DBQueryResult& items)
+{
+    std::vector<uint32> added;
+    DBResultRow row;
+    while (res.GetRow(row)) {
+        //contractId, contractType, isPrivate, assigneeID, issuerID, issuerCorpID, forCorp, price, reward,
+        // startSolarSystemID, startRegionID, endSolarSystemID, endRegionID
+        Contract data = Contract();
+        data.type           = row.GetUInt(1);
+        data.isPrivate      = row.GetBool(2);
+        data.assigneeID     = row.GetUInt(3);
+        data.issuerID       = row.GetUInt(4);
+        data.issuerCorpID   = row.GetUInt(5);
+        data.forCorp        = row.GetBool(6);
+        data.price          = row.GetDouble(7);
+        data.reward         = row.GetDouble(8);
+        data.startSystemID  = row.GetUInt(9);
+        data.startRegionID  = row.GetUInt(10);
+        data.endSystemID    = row.GetUInt(11);
+        data.endRegionID    = row.GetUInt(12);
+        m_contracts[row.GetUInt(0)] = data;
+        added.push_back(row.GetUInt(0));
+    }
+
+    std::unordered_map<uint32, Contract>::iterator itr = m_contracts.end();
+    while (items.GetRow(row)) {
+        //contractId, typeID, groupID, categoryID
+        if ((itr == m_contracts.end()) or (itr->first != row.GetUInt(0)))
+            itr = m_contracts.find(row.GetUInt(0));
+        if (itr == m_contracts.end())
+            continue;
+        AddUnique(itr->second.typeIDs, row.GetUInt(1));
+        AddUnique(itr->second.groupIDs, row.GetUInt(2));
+        AddUnique(itr->second.catIDs, row.GetUInt(3));
+    }
+
+    for (auto contractID : added) {
+        const Contract& data = m_contracts[contractID];
+        AddID(m_byType, data.type, contractID);
+        for (auto cur : data.typeIDs)
+            AddID(m_byItemType, cur, contractID);
+        for (auto cur : data.groupIDs)
+            AddID(m_byGroup, cur, contractID);
+        for (auto cur : data.catIDs)
+            AddID(m_byCategory, cur, contractID);
+        AddID(m_byStartSystem, data.startSystemID, contractID);
+        AddID(m_byStartRegion, data.startRegionID, contractID);
+        AddID(m_byEndSystem, data.endSystemID, contractID);
+        AddID(m_byEndRegion, data.endRegionID, contractID);
+        AddID(m_byIssuer, data.issuerID, contractID);
+        AddID(m_byIssuerCorp, data.issuerCorpID, contractID);
+        std::pair<double, uint32> price(data.price, contractID);
+        m_byPrice.insert(std::lower_bound(m_byPrice.begin(), m_byPrice.end(), price), price);
+    }
+
+    return (uint32)added.size();
+}
+
+void ContractIndex::AddContract(uint32 contractID)
+{
+    // called after contract and its items are saved
+    DBQueryResult res, items;
+    if (!sDatabase.RunQuery(res, "%s AND contractId = %u", contractQueryBase, contractID)) {
+        codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
+        return;
+    }
+    if (!sDatabase.RunQuery(items, "%s AND cI.contractId = %u", itemQueryBase, contractID)) {
+        codelog(DATABASE__ERROR, "Error in query: %s", items.error.c_str());
+        return;
+    }
+
+    RemoveContract(contractID);
+    Load(res, items);
+}
+
+void ContractIndex::RemoveContract(uint32 contractID)
+{
+    std::unordered_map<uint32, Contract>::iterator itr = m_contracts.find(contractID);
+    if (itr == m_contracts.end())
+        return;
+
+    const Contract& data = itr->second;
+    RemoveID(m_byType, data.type, contractID);
+    for (auto cur : data.typeIDs)
+        RemoveID(m_byItemType, cur, contractID);
+    for (auto cur : data.groupIDs)
+        RemoveID(m_byGroup, cur, contractID);
+    for (auto cur : data.catIDs)
+        RemoveID(m_byCategory, cur, contractID);
+    RemoveID(m_byStartSystem, data.startSystemID, contractID);
+    RemoveID(m_byStartRegion, data.startRegionID, contractID);
+    RemoveID(m_byEndSystem, data.endSystemID, contractID);
+    RemoveID(m_byEndRegion, data.endRegionID, contractID);
+    RemoveID(m_byIssuer, data.issuerID, contractID);
+    RemoveID(m_byIssuerCorp, data.issuerCorpID, contractID);
+    std::vector<std::pair<double, uint32>>::iterator price = std::lower_bound(m_byPrice.begin(), m_byPrice.end(), std::make_pair(data.price, contractID));
+    if ((price != m_byPrice.end()) and (price->second == contractID))
+        m_byPrice.erase(price);
+
+    m_contracts.erase(itr);
+}
+
+uint32 ContractIndex::SearchContracts(const Search& data, uint32 start, uint32 limit, std::vector<int>& into)
+{
+    // lists to intersect.  lists built here (unions, price range) are kept in `built`
+    std::vector<const IDList*> lists;
+    std::deque<IDList> built;
+    const IDList* pList(nullptr);
+
+    // multiple types or typeIDs are OR'd, so union them first
+    if (data.types.size() == 1) {
+        lists.push_back(Find(m_byType, data.types.front()));
+    } else if (!data.types.empty()) {
+        built.emplace_back();
+        for (auto cur : data.types) {
+            pList = Find(m_byType, cur);
+            if (pList == nullptr)
+                continue;
+            IDList tmp;
+            Union(built.back(), *pList, tmp);
+            built.back().swap(tmp);
+        }
+        lists.push_back(&built.back());
+    }
+    if (data.typeIDs.size() == 1) {
+        lists.push_back(Find(m_byItemType, data.typeIDs.front()));
+    } else if (!data.typeIDs.empty()) {
+        built.emplace_back();
+        for (auto cur : data.typeIDs) {
+            pList = Find(m_byItemType, cur);
+            if (pList == nullptr)
+                continue;
+            IDList tmp;
+            Union(built.back(), *pList, tmp);
+            built.back().swap(tmp);
+        }
+        lists.push_back(&built.back());
+    }
+
+    if (data.groupID > 0)
+        lists.push_back(Find(m_byGroup, data.groupID));
+    if (data.categoryID > 0)
+        lists.push_back(Find(m_byCategory, data.categoryID));
+
+    // locationID can only be system, constellation or region.  we only have system and region
+    if (IsSolarSystemID(data.locationID)) {
+        lists.push_back(Find(m_byStartSystem, data.locationID));
+    } else if (IsRegionID(data.locationID)) {
+        lists.push_back(Find(m_byStartRegion, data.locationID));
+    }
+    if (IsSolarSystemID(data.endLocationID)) {
+        lists.push_back(Find(m_byEndSystem, data.endLocationID));
+    } else if (IsRegionID(data.endLocationID)) {
+        lists.push_back(Find(m_byEndRegion, data.endLocationID));
+    }
+
+    // issuer can be either a character or a corporation
+    if (data.issuerID > 0) {
+        if (IsCorp(data.issuerID)) {
+            lists.push_back(Find(m_byIssuerCorp, data.issuerID));
+        } else {
+            lists.push_back(Find(m_byIssuer, data.issuerID));
+        }
+    }
+
+    // any filter with no contracts means no results
+    for (auto cur : lists)
+        if ((cur == nullptr) or cur->empty())
+            return 0;
+
+    std::sort(lists.begin(), lists.end(), [](const IDList* a, const IDList* b) { return a->size() < b->size(); });
+
+    // use price index only if it is the most selective filter.  price is checked on each contract anyway
+    if ((data.minPrice > -1) or (data.maxPrice > -1)) {
+        std::vector<std::pair<double, uint32>>::iterator begin = m_byPrice.begin(), end = m_byPrice.end();
+        if (data.minPrice > -1)
+            begin = std::lower_bound(m_byPrice.begin(), m_byPrice.end(), std::make_pair((double)data.minPrice, (uint32)0));
+        if (data.maxPrice > -1)
+            end = std::upper_bound(begin, m_byPrice.end(), std::make_pair((double)data.maxPrice, (uint32)-1));
+        if (lists.empty() or ((size_t)std::distance(begin, end) < lists.front()->size())) {
+            built.emplace_back();
+            for (; begin != end; ++begin)
+                built.back().push_back(begin->second);
+            std::sort(built.back().begin(), built.back().end());
+            lists.insert(lists.begin(), &built.back());
+        }
+    }
+
+    // intersect smallest first, so each step is bounded by the smallest list
+    IDList result, tmp;
+    if (lists.empty()) {
+        result.reserve(m_contracts.size());
+        for (auto& cur : m_contracts)
+            result.push_back(cur.first);
+        std::sort(result.begin(), result.end());
+    } else {
+        result = *lists.front();
+        for (uint8 i = 1; i < lists.size(); ++i) {
+            Intersect(result, *lists[i], tmp);
+            result.swap(tmp);
+            if (result.empty())
+                return 0;
+        }
+    }
+
+    uint32 count(0);
+    std::unordered_map<uint32, Contract>::iterator itr = m_contracts.end();
+    for (auto cur : result) {
+        itr = m_contracts.find(cur);
+        if (itr == m_contracts.end())
+            continue;
+        if (!Matches(itr->second, data))
+            continue;
+        if ((count >= start) and (into.size() < limit))
+            into.push_back(cur);
+        ++count;
+    }
+
+    return count;
+}
+
+bool ContractIndex::Matches(const Contract& data, const Search& search)
+{
+    if (data.typeIDs.empty())
+        return false;   // no items to trade
+    switch (search.availability) {
+        case 0: {   // public
+            if (data.isPrivate)
+                return false;
+        } break;
+        case 1:     // private, assigned to character
+        case 2: {   // private, assigned to corp
+            if (!data.isPrivate or (data.assigneeID != search.assigneeID))
+                return false;
+        } break;
+    }
+    if (search.issuerID > 0)
+        if (data.forCorp != IsCorp(search.issuerID))
+            return false;
+    if ((search.minPrice > -1) and (data.price < search.minPrice))
+        return false;
+    if ((search.maxPrice > -1) and (data.price > search.maxPrice))
+        return false;
+    if ((search.minReward > -1) and (data.reward < search.minReward))
+        return false;
+    if ((search.maxReward > -1) and (data.reward > search.maxReward))
+        return false;
+    return true;
+}
+
+void ContractIndex::AddID(IDIndex& index, uint32 key, uint32 contractID)
+{
+    if (key == 0)
+        return;
+    IDList& list = index[key];
+    // contractIDs are increasing, so this is almost always push_back
+    if (list.empty() or (list.back() < contractID)) {
+        list.push_back(contractID);
+        return;
+    }
+    IDList::iterator itr = std::lower_bound(list.begin(), list.end(), contractID);
+    if ((itr == list.end()) or (*itr != contractID))
+        list.insert(itr, contractID);
+}
+
+void ContractIndex::RemoveID(IDIndex& index, uint32 key, uint32 contractID)
+{
+    IDIndex::iterator itr = index.find(key);
+    if (itr == index.end())
+        return;
+    IDList::iterator id = std::lower_bound(itr->second.begin(), itr->second.end(), contractID);
+    if ((id != itr->second.end()) and (*id == contractID))
+        itr->second.erase(id);
+    if (itr->second.empty())
+        index.erase(itr);
+}
+
+void ContractIndex::AddUnique(std::vector<uint16>& into, uint16 value)
+{
+    if (std::find(into.begin(), into.end(), value) == into.end())
+        into.push_back(value);
+}
+
+const ContractIndex::IDList* ContractIndex::Find(const IDIndex& index, uint32 key)
+{
+    IDIndex::const_iterator itr = index.find(key);
+    if (itr == index.end())
+        return nullptr;
+    return &itr->second;
+}
+
+void ContractIndex::Union(const IDList& a, const IDList& b, IDList& into)
+{
+    into.clear();
+    into.reserve(a.size() + b.size());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(into));
+}
+
+void ContractIndex::Intersect(const IDList& a, const IDList& b, IDList& into)
+{
+    into.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(into));
+}
@@ -0,0 +1,133 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name ContractIndex.h
+ *   in-memory search index of outstanding contracts, for contract browser searches
+ */
+
+#ifndef _EVE_SERVER_CONTRACT_INDEX_H__
+#define _EVE_SERVER_CONTRACT_INDEX_H__
+
+
+#include "eve-server.h"
+
+/*
+ * outstanding (status 0) contracts are loaded on startup with the typeID/groupID/categoryID of each item in them.
+ * each searchable field has a map of key -> contractIDs, kept sorted, so a search intersects the lists
+ *   for the filters given (smallest first) and checks the rest against the contract.
+ * contracts are added when created and removed when they leave outstanding status.
+ * the db is still written by ContractProxy as before.  this only replaces the search query.
+ */
+class ContractIndex
+: public Singleton< ContractIndex >
+{
+public:
+    ContractIndex();
+    ~ContractIndex()                                    { /* do nothing here */ }
+
+    int Initialize();
+    void Close();
+
+    // loads contract from db and adds to index if outstanding
+    void AddContract(uint32 contractID);
+    void RemoveContract(uint32 contractID);
+
+    // zero (or -1 for availability and price/reward limits) is not used
+    struct Search {
+        int8 availability;
+        uint16 groupID;
+        uint16 categoryID;
+        uint32 assigneeID;  // for private availability
+        uint32 locationID;
+        uint32 endLocationID;
+        uint32 issuerID;
+        int64 minPrice;
+        int64 maxPrice;
+        int64 minReward;
+        int64 maxReward;
+        std::vector<uint8> types;
+        std::vector<uint16> typeIDs;
+    };
+    // fills into with up to limit matching contractIDs from start, in id order.  returns total number found
+    uint32 SearchContracts(const Search& data, uint32 start, uint32 limit, std::vector<int>& into);
+
+    uint32 Count()                                      { return (uint32)m_contracts.size(); }
+
+private:
+    struct Contract {
+        bool isPrivate :1;
+        bool forCorp :1;
+        uint8 type;
+        uint32 assigneeID;
+        uint32 issuerID;
+        uint32 issuerCorpID;
+        uint32 startSystemID;
+        uint32 startRegionID;
+        uint32 endSystemID;
+        uint32 endRegionID;
+        double price;
+        double reward;
+        std::vector<uint16> typeIDs;
+        std::vector<uint16> groupIDs;
+        std::vector<uint16> catIDs;
+    };
+    typedef std::vector<uint32> IDList;
+    typedef std::unordered_map<uint32, IDList> IDIndex;
+
+    // adds contracts and their items from these results.  returns number added
+    uint32 Load(DBQueryResult& res, DBQueryResult& items);
+    // true if contract passes the filters not covered by index lists
+    bool Matches(const Contract& data, const Search& search);
+
+    static void AddID(IDIndex& index, uint32 key, uint32 contractID);
+    static void RemoveID(IDIndex& index, uint32 key, uint32 contractID);
+    static void AddUnique(std::vector<uint16>& into, uint16 value);
+    // returns list for key, or nullptr if none
+    static const IDList* Find(const IDIndex& index, uint32 key);
+    static void Union(const IDList& a, const IDList& b, IDList& into);
+    static void Intersect(const IDList& a, const IDList& b, IDList& into);
+
+    std::unordered_map<uint32, Contract> m_contracts;
+
+    IDIndex m_byType;
+    IDIndex m_byItemType;
+    IDIndex m_byGroup;
+    IDIndex m_byCategory;
+    IDIndex m_byStartSystem;
+    IDIndex m_byStartRegion;
+    IDIndex m_byEndSystem;
+    IDIndex m_byEndRegion;
+    IDIndex m_byIssuer;
+    IDIndex m_byIssuerCorp;
+    // price, contractID.  sorted by price
+    std::vector<std::pair<double, uint32>> m_byPrice;
+};
+
+//Singleton
+#define sContractIdx \
+( ContractIndex::get() )
+
+
+#endif  // _EVE_SERVER_CONTRACT_INDEX_H__
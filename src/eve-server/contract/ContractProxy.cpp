@@ -35,6 +35,7 @@
 #include "inventory/Inventory.h"
 #include "system/SolarSystem.h"
 
+#include "contract/ContractIndex.h"
 #include "contract/ContractUtils.h"
 #include "account/AccountService.h"
 
@@ -72,137 +73,82 @@ ContractProxy::ContractProxy () :
      */
 }
 
+// returns value of named arg, or def if it was not sent or is None
+static int64 GetNamedInt(PyCallArgs& call, const char* name, int64 def)
+{
+    std::map<std::string, PyRep*>::iterator itr = call.byname.find(name);
+    if (itr == call.byname.end())
+        return def;
+    if (itr->second->IsInt())
+        return itr->second->AsInt()->value();
+    if (itr->second->IsLong())
+        return itr->second->AsLong()->value();
+    if (itr->second->IsFloat())
+        return (int64)itr->second->AsFloat()->value();
+    return def;
+}
+
 PyResult ContractProxy::SearchContracts(PyCallArgs &call) {
     // We will not proceed, if contractType is not specified
-    if (!call.byname.find("contractType")->second->IsNone()) {
-        int contractType = call.byname.find("contractType")->second->AsInt()->value();
-
-        /**
-         * We're using sort of query constructor here - if request have certain value specified, we add it as another AND block.
-         * For now, we will only filter by contract type, item type, item category, min/max price, min/max reward, location/end location, issuer and availability
-         */
-        std::string query = "SELECT cC.contractId FROM ctrContracts cC "
-                            "JOIN ctrItems cI on cC.contractId = cI.contractId "
-                            "JOIN entity e on cI.itemID = e.itemID "
-                            "JOIN invTypes iT on iT.typeID = e.typeID "
-                            "JOIN invGroups iG on iG.groupID = iT.groupID "
-                            "JOIN invCategories iC on iG.categoryID = iC.categoryID "
-                            "WHERE cC.contractType IN " + std::string(contractType == 10 ? "(1,2)" : "(" + std::to_string(contractType) + ")");
-                                                         // Type 10 is "All" and "Exclude WTB", for some reason. We'll assume it's "All", lol
-
-        if (!call.byname.find("itemTypes")->second->IsNone()) {
-            PyList* itemTypes = call.byname.find("itemTypes")->second->AsObjectEx()->header()->AsTuple()->GetItem(1)->AsTuple()->GetItem(0)->AsList();
-            std::string types;
-            for (auto index = 0; index < itemTypes->size(); index++) {
-                types.append(std::to_string(itemTypes->GetItem(index)->AsInt()->value()));
-                if (index != itemTypes->size() - 1) {
-                    types.append(",");
-                }
-            }
-
-            if (!types.empty()) {
-                query.append(" AND e.typeID IN (" + types + ")");
-            }
-        }
+    int contractType = GetNamedInt(call, "contractType", -1);
+    if (contractType < 0) {
+        codelog(SERVICE__ERROR, "%s: ContractType was not specified. Aborting search", GetName());
+        return nullptr;
+    }
 
-        if (!call.byname.find("itemGroupID")->second->IsNone()) {
-            query.append(" AND iG.groupID = " + std::to_string(call.byname.find("itemGroupID")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("itemCategoryID")->second->IsNone()) {
-            query.append(" AND iC.categoryID = " + std::to_string(call.byname.find("itemCategoryID")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("minPrice")->second->IsNone()) {
-            query.append(" AND cC.price >= " + std::to_string(call.byname.find("minPrice")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("maxPrice")->second->IsNone()) {
-            query.append(" AND cC.price <= " + std::to_string(call.byname.find("maxPrice")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("minReward")->second->IsNone()) {
-            query.append(" AND cC.reward >= " + std::to_string(call.byname.find("minReward")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("maxReward")->second->IsNone()) {
-            query.append(" AND cC.reward <= " + std::to_string(call.byname.find("maxReward")->second->AsInt()->value()));
-        }
-        if (!call.byname.find("availability")->second->IsNone()) {
-            int availability = call.byname.find("availability")->second->AsInt()->value();
-            if (availability == 0) {
-                // Public contracts
-                query.append(" AND cC.isPrivate = 0");
-            } else if (availability == 1) {
-                // Private contracts, assigned to character
-                query.append(" AND cC.isPrivate = 1 AND cC.assigneeId = " + std::to_string(call.client->GetCharacterID()));
-            } else if(availability == 2) {
-                // Private contracts, assigned to corp
-                query.append(" AND cC.isPrivate = 1 AND cC.assigneeId = " + std::to_string(call.client->GetCorporationID()));
-            }
-        }
-        // According to what i had during testing, locationID can only be system, constellation or region. Given that we only store system and region ID, we use OR clause for these
-        if (!call.byname.find("locationID")->second->IsNone()) {
-            int locationId = call.byname.find("locationID")->second->AsInt()->value();
-            if (IsSolarSystemID(locationId)) {
-                // Solar system range
-                query.append(" AND cC.startSolarSystemID = " + std::to_string(locationId));
-            } else if (IsRegionID(locationId)) {
-                // Region range
-                query.append(" AND cC.startRegionID = " + std::to_string(locationId));
-            }
-        }
-        // Same applies to endLocationID - it uses the same search::QuickQuery() call to get it
-        if (!call.byname.find("endLocationID")->second->IsNone()) {
-            int locationId = call.byname.find("endLocationID")->second->AsInt()->value();
-            if (IsSolarSystemID(locationId)) {
-                // Solar system range
-                query.append(" AND cC.endSolarSystemID = " + std::to_string(locationId));
-            } else if (IsRegionID(locationId)) {
-                // Region range
-                query.append(" AND cC.endRegionID = " + std::to_string(locationId));
-            }
-        }
-        // Once again, issuer can be either a character or a corporation. We use separate filters depending on value
-        if (!call.byname.find("issuerID")->second->IsNone()) {
-            int issuerId = call.byname.find("issuerID")->second->AsInt()->value();
-            if (IsCorp(issuerId)) {
-                // Corporation case
-                query.append(" AND cC.issuerCorpID = " + std::to_string(issuerId) + " AND cC.forCorp = true");
-            } else {
-                query.append(" AND cC.issuerID = " + std::to_string(issuerId) + " AND cC.forCorp = false");
-            }
-        }
-        query.append(" AND cC.status = 0");
-        /**
-         * Once query is constructed, we execute it and collect contractID's. Since we can have duplicate values, we first
-         * collect it to std::vector, and then we pass it to GetContractEntries function
-         */
-
-        DBQueryResult contractRes;
-        if (!sDatabase.RunQuery(contractRes, query.c_str()))
-        {
-            codelog(DATABASE__ERROR, "Error in query: %s", contractRes.error.c_str());
-            return nullptr;
-        }
-        std::vector<int> contractIDs;
-        DBResultRow contractRow;
-        while (contractRes.GetRow(contractRow)) {
-            int contractId = contractRow.GetInt(0);
-
-            // To make sure we don't add duplicates, we check whether we already have said contractID in vector already.
-            if (std::find(contractIDs.begin(), contractIDs.end(), contractId) == contractIDs.end()) {
-                contractIDs.push_back(contractId);
-            }
-        }
+    /**
+     * Search is run against the in-memory contract index - see ContractIndex.h
+     * For now, we will only filter by contract type, item type, item category, min/max price, min/max reward, location/end location, issuer and availability
+     */
+    ContractIndex::Search search = ContractIndex::Search();
+    if (contractType == 10) {
+        // Type 10 is "All" and "Exclude WTB", for some reason. We'll assume it's "All", lol
+        search.types.push_back(1);
+        search.types.push_back(2);
+    } else {
+        search.types.push_back(contractType);
+    }
 
-        PyDict* response = new PyDict;
-        PyList* contracts = ContractUtils::GetContractEntries(contractIDs);
-        response->SetItemString("contracts", contracts ? contracts : new PyList);
-        response->SetItemString("numFound", contracts ? new PyInt(contracts->size()) : new PyInt(0));
-        response->SetItemString("searchTime", new PyInt(153));  // Since search time is of no relevance to the client, we simply hard-code it
-        response->SetItemString("maxResults", new PyInt(1000)); // Same here - we do not limit the list of contracts queried, so we leave this value hard-coded
+    std::map<std::string, PyRep*>::iterator itr = call.byname.find("itemTypes");
+    if ((itr != call.byname.end()) and !itr->second->IsNone()) {
+        PyList* itemTypes = itr->second->AsObjectEx()->header()->AsTuple()->GetItem(1)->AsTuple()->GetItem(0)->AsList();
+        for (auto index = 0; index < itemTypes->size(); index++)
+            search.typeIDs.push_back(itemTypes->GetItem(index)->AsInt()->value());
+    }
 
-        return new PyObject("util.KeyVal", response);
-    } else {
-        codelog(SERVICE__ERROR, "%s: ContractType was not specified. Aborting search", GetName());
-        return nullptr;
+    search.groupID = GetNamedInt(call, "itemGroupID", 0);
+    search.categoryID = GetNamedInt(call, "itemCategoryID", 0);
+    search.minPrice = GetNamedInt(call, "minPrice", -1);
+    search.maxPrice = GetNamedInt(call, "maxPrice", -1);
+    search.minReward = GetNamedInt(call, "minReward", -1);
+    search.maxReward = GetNamedInt(call, "maxReward", -1);
+    search.availability = GetNamedInt(call, "availability", -1);
+    if (search.availability == 1) {
+        // Private contracts, assigned to character
+        search.assigneeID = call.client->GetCharacterID();
+    } else if (search.availability == 2) {
+        // Private contracts, assigned to corp
+        search.assigneeID = call.client->GetCorporationID();
     }
+    // locationID and endLocationID can be system, constellation or region.  We only store system and region ID
+    search.locationID = GetNamedInt(call, "locationID", 0);
+    search.endLocationID = GetNamedInt(call, "endLocationID", 0);
+    // Once again, issuer can be either a character or a corporation.
+    search.issuerID = GetNamedInt(call, "issuerID", 0);
+
+    // page through results if client asks for it.  we return up to maxResults per call
+    uint32 startNum = GetNamedInt(call, "startNum", 0);
+    std::vector<int> contractIDs;
+    uint32 numFound = sContractIdx.SearchContracts(search, startNum, 1000, contractIDs);
+
+    PyDict* response = new PyDict;
+    PyList* contracts = contractIDs.empty() ? nullptr : ContractUtils::GetContractEntries(contractIDs);
+    response->SetItemString("contracts", contracts ? contracts : new PyList);
+    response->SetItemString("numFound", new PyInt(numFound));
+    response->SetItemString("searchTime", new PyInt(153));  // Since search time is of no relevance to the client, we simply hard-code it
+    response->SetItemString("maxResults", new PyInt(1000));
+
+    return new PyObject("util.KeyVal", response);
 }
 
 PyResult ContractProxy::CreateContract(PyCallArgs &call,
@@ -439,6 +385,7 @@ PyResult ContractProxy::CreateContract(PyCallArgs &call,
         return nullptr;
     }
 
+    sContractIdx.AddContract(contractId);
     return new PyInt((int) contractId);
 }
 
@@ -468,6 +415,7 @@ PyResult ContractProxy::DeleteContract(PyCallArgs &call, PyInt* contractID) {
     {
         codelog(DATABASE__ERROR, "Failed to update contract volume: %s", err.c_str());
     }
+    sContractIdx.RemoveContract(contractID->value());
 
     return new PyBool(true);
 }
@@ -573,10 +521,11 @@ PyResult ContractProxy::AcceptContract(PyCallArgs &call, PyInt* contractID) {
                     DBerror err;
                     if (!sDatabase.RunQuery(err,
                                             "UPDATE ctrContracts SET status = 4, dateAccepted = %lli, dateCompleted = %lli, acceptorID = %u WHERE contractId = %u",
-                                            timestamp, timestamp, call.client->GetCharacterID(), contractID))
+                                            timestamp, timestamp, call.client->GetCharacterID(), contractID->value()))
                     {
                         codelog(DATABASE__ERROR, "Failed to update contract : %s", err.c_str());
                     }
+                    sContractIdx.RemoveContract(contractID->value());
                 } else {
                     if (!iskRequirementMet) {
                         call.client->SendNotifyMsg("You have insufficient funds");
@@ -644,10 +593,11 @@ PyResult ContractProxy::AcceptContract(PyCallArgs &call, PyInt* contractID) {
                 DBerror err;
                 if (!sDatabase.RunQuery(err,
                                         "UPDATE ctrContracts SET status = 1, dateAccepted = %lli, acceptorID = %u, crateID = %u WHERE contractId = %u",
-                                        timestamp, call.client->GetCharacterID(), plasticWrap->itemID(), contractID))
+                                        timestamp, call.client->GetCharacterID(), plasticWrap->itemID(), contractID->value()))
                 {
                     codelog(DATABASE__ERROR, "Failed to update contract : %s", err.c_str());
                 }
+                sContractIdx.RemoveContract(contractID->value());
                 break;
             }
             default:
@@ -655,7 +605,7 @@ PyResult ContractProxy::AcceptContract(PyCallArgs &call, PyInt* contractID) {
                 return nullptr;
         }
         // Once type-specific manipulations are done, we query brief contract information (requested by client) and send it out.
-        if (!sDatabase.RunQuery(res, "SELECT contractId, contractType, startStationID, endStationID, dateAccepted, numDays FROM ctrContracts WHERE contractId = %u", contractID))
+        if (!sDatabase.RunQuery(res, "SELECT contractId, contractType, startStationID, endStationID, dateAccepted, numDays FROM ctrContracts WHERE contractId = %u", contractID->value()))
         {
             codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
             return nullptr;
@@ -29,6 +29,7 @@
 #include "StaticDataMgr.h"
 #include "character/Character.h"
 #include "corporation/CorporationDB.h"
+#include "search/SearchIndex.h"
 
 // this shall be removed when i remove MulticastTarget
 #include "EntityList.h"
@@ -573,6 +574,7 @@ bool CorporationDB::AddCorporation(Call_AddCorporation & corpInfo, Client* pClie
 
     // It has to go into the eveStaticOwners too
     sDatabase.RunQuery(err, " INSERT INTO eveStaticOwners (ownerID,ownerName,typeID) VALUES (%u, '%s', 2)", corpID, cName.c_str());
+    sSearchIndex.Add(searchResultCorporation, corpID, corpInfo.corpName);
 
     return true;
 }
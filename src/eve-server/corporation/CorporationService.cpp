@@ -29,6 +29,7 @@
 #include "StaticDataMgr.h"
 #include "account/AccountService.h"
 #include "corporation/CorporationService.h"
+#include "market/MarketOrderBook.h"
 #include "station/StationDataMgr.h"
 
 CorporationService::CorporationService() :
@@ -96,6 +97,7 @@ PyResult CorporationService::GetFactionInfo(PyCallArgs &call) {
 
 // this wants corp market info
 PyResult CorporationService::GetCorpInfo(PyCallArgs &call, PyInt* corporationID) {
+    sOrderBook.SaveOrders();
     return m_db.GetMktInfo(corporationID->value());
 }
 
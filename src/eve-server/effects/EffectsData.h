@@ -66,6 +66,27 @@ struct TypeEffects {
     uint16 effectID;
 };
 
+// single modifier from an expression tree flattened by FxProc::CompileExpression()
+//  all enums, attribs and target selectors are resolved at load.  only srcRef (and typeID when srcType) are set at runtime
+struct fxOp {
+    bool remove;        // call RemoveModifier() instead of AddModifier()
+    bool srcType;       // typeID is taken from srcRef (opGETTYPE)
+    int8 math;
+    int8 fxSrc;
+    int8 targLoc;
+    uint8 action;
+    uint16 targAttr;
+    uint16 srcAttr;
+    uint16 grpID;
+    uint16 typeID;
+};
+
+// compiled program for an expression.  skill/implant sources resolve some operands differently, so each gets its own op list
+struct fxProgram {
+    std::vector<fxOp> item;
+    std::vector<fxOp> skill;
+};
+
 typedef std::map<uint16, Effect> effectMapType;
 
 // these tables are used to decode fields in Effects table
@@ -19,6 +19,7 @@ FxDataMgr::FxDataMgr()
     m_fxMap.clear();
     m_opMap.clear();
     m_expMap.clear();
+    m_progMap.clear();
     m_effectMap.clear();
     m_typeFxMap.clear();
 }
@@ -136,6 +137,8 @@ void FxDataMgr::Populate()
     //cleanup
     SafeDelete(res);
 
+    CompilePrograms();
+
     m_loaded = true;
     sLog.Cyan("        FxDataMgr", "Effects Data loaded in %.3fms.", (GetTimeMSeconds() - begin));
 }
@@ -163,6 +166,38 @@ Expression FxDataMgr::GetExpression(uint16 eID)
     return m_expMap.at(0);
 }
 
+const std::vector<fxOp>* FxDataMgr::GetProgram(uint16 eID, bool skill)
+{
+    std::unordered_map<uint16, fxProgram>::const_iterator itr = m_progMap.find(eID);
+    if (itr == m_progMap.end())
+        return nullptr;
+    return (skill ? &itr->second.skill : &itr->second.item);
+}
+
+void FxDataMgr::CompilePrograms()
+{
+    double start = GetTimeMSeconds();
+    uint32 count(0);
+    for (auto& cur : m_effectMap) {
+        for (uint16 expID : { cur.second.preExpression, cur.second.postExpression }) {
+            if (expID == 0)
+                continue;
+            if (m_progMap.find(expID) != m_progMap.end())
+                continue;
+            fxProgram program = fxProgram();
+            fxOp data = fxOp();
+            data.action = FX::Action::Invalid;
+            sFxProc.CompileExpression(expID, false, data, program.item);
+            data = fxOp();
+            data.action = FX::Action::Invalid;
+            sFxProc.CompileExpression(expID, true, data, program.skill);
+            count += program.item.size() + program.skill.size();
+            m_progMap.emplace(expID, program);
+        }
+    }
+    sLog.Cyan("        FxDataMgr", "%lu Expressions compiled into %u modifier ops in %.3fms.", m_progMap.size(), count, (GetTimeMSeconds() - start));
+}
+
 Operand FxDataMgr::GetOperand(uint16 oID)
 {
     std::map<uint16, Operand>::const_iterator itr = m_opMap.find(oID);
@@ -33,6 +33,8 @@ public:
     Effect GetEffect(uint16 eID);
     Operand GetOperand(uint16 oID);
     Expression GetExpression(uint16 eID);
+    // returns compiled modifier program for expression, or nullptr if not compiled
+    const std::vector<fxOp>* GetProgram(uint16 eID, bool skill);
 
     void GetTypeEffect(uint16 typeID, std::vector< TypeEffects >& typeEffMap);
 
@@ -45,6 +47,9 @@ protected:
     void GetExpressions(DBQueryResult& res);
     void GetDgmTypeEffects(DBQueryResult &res);
 
+    // flatten all effect expressions into modifier programs
+    void CompilePrograms();
+
 private:
     bool m_loaded;
     float m_time;
@@ -55,6 +60,7 @@ private:
     effectMapType m_effectMap;  //std::map<uint16, Effect>
     std::map<uint16, Operand> m_opMap;
     std::map<uint16, Expression> m_expMap;
+    std::unordered_map<uint16, fxProgram> m_progMap;   // k,v of expressionID, compiled program
     std::map<std::string, uint16> m_effectName;  // k,v of effectID, effectName.  maps all effectIDs to their name.
     std::unordered_multimap<uint16, TypeEffects> m_typeFxMap;  // k,v of typeID, data<effectID, isDefault>
 };
@@ -0,0 +1,405 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ *   modifier dependency graph for incremental attribute recalculation
+ */
+
+#include "effects/EffectsGraph.h"
+#include "effects/EffectsProcessor.h"
+#include "character/Character.h"
+#include "inventory/AttributeMap.h"
+#include "ship/Ship.h"
+
+/*
+ * # Effects Logging:
+ * EFFECTS=0
+ * EFFECTS__ERROR=1
+ * EFFECTS__WARNING=0
+ * EFFECTS__MESSAGE=0
+ * EFFECTS__DEBUG=0
+ * EFFECTS__TRACE=0
+ */
+
+FxGraph::FxGraph(ShipItem* pShip)
+: m_pShip(pShip),
+m_edgeCount(0),
+m_writing(false),
+m_bypass(false)
+{
+    m_nodes.clear();
+    m_dependents.clear();
+    m_dirty.clear();
+    m_items.clear();
+}
+
+bool FxGraph::Covers(InventoryItem* pItem, Character* pChar)
+{
+    if (pItem == m_pShip)
+        return true;
+    if (pItem->locationID() == m_pShip->itemID())
+        return true;
+    if (pChar == nullptr)
+        return false;
+    if (pItem == pChar)
+        return true;
+    return (pItem->locationID() == pChar->itemID());
+}
+
+bool FxGraph::AddEdge(const fxData& data, int8 math, InventoryItemRef pTarg)
+{
+    if (data.srcRef.get() == nullptr) {
+        _log(EFFECTS__ERROR, "FxGraph::AddEdge() - no source for <%s> on %s(%u):%s", \
+                sFxProc.GetMathMethodName(math), pTarg->name(), pTarg->itemID(), sDataMgr.GetAttrName(data.targAttr));
+        return false;
+    }
+
+    int64 key(MakeKey(pTarg->itemID(), data.targAttr));
+    std::unordered_map<int64, Node>::iterator itr = m_nodes.find(key);
+    if (itr == m_nodes.end()) {
+        Node node = Node();
+        node.attrID = data.targAttr;
+        node.base = pTarg->GetAttribute(data.targAttr);
+        // check for inf/nan and use default if found.  same as FxProc::ApplyEffects()
+        if (node.base.isNaN() or node.base.isInf())
+            node.base = pTarg->GetDefaultAttribute(data.targAttr);
+        node.itemRef = pTarg;
+        itr = m_nodes.emplace(key, node).first;
+        // have this item's writes from outside the graph come to SetBase()
+        if (m_items.emplace(pTarg->itemID(), pTarg).second)
+            pTarg->GetAttributeMap()->SetFxGraph(this);
+    }
+
+    // keep edges in math order, so Compute() can just walk the vector
+    Edge edge = Edge();
+    edge.math = math;
+    edge.srcAttr = data.srcAttr;
+    edge.srcRef = data.srcRef;
+    std::vector<Edge>& edges = itr->second.edges;
+    std::vector<Edge>::iterator pos = edges.begin();
+    while ((pos != edges.end()) and (pos->math <= math))
+        ++pos;
+    edges.insert(pos, edge);
+
+    m_dependents.emplace(MakeKey(data.srcRef->itemID(), data.srcAttr), key);
+    ++m_edgeCount;
+    MarkDirty(key);
+
+    _log(EFFECTS__TRACE, "FxGraph::AddEdge() - %s(%u):%s <%s> %s(%u):%s", \
+            data.srcRef->name(), data.srcRef->itemID(), sDataMgr.GetAttrName(data.srcAttr), sFxProc.GetMathMethodName(math), \
+            pTarg->name(), pTarg->itemID(), sDataMgr.GetAttrName(data.targAttr));
+    return true;
+}
+
+bool FxGraph::RemoveEdge(const fxData& data, int8 math, InventoryItemRef pTarg)
+{
+    if (data.srcRef.get() == nullptr)
+        return false;
+
+    int64 key(MakeKey(pTarg->itemID(), data.targAttr));
+    std::unordered_map<int64, Node>::iterator itr = m_nodes.find(key);
+    if (itr == m_nodes.end())
+        return false;
+
+    uint32 srcID(data.srcRef->itemID());
+    std::vector<Edge>& edges = itr->second.edges;
+    std::vector<Edge>::iterator edge = edges.begin();
+    for (; edge != edges.end(); ++edge)
+        if ((edge->math == math) and (edge->srcAttr == data.srcAttr) and (edge->srcRef->itemID() == srcID))
+            break;
+    if (edge == edges.end())
+        return false;
+    edges.erase(edge);
+
+    // remove one matching dependent entry for this edge
+    int64 srcKey(MakeKey(srcID, data.srcAttr));
+    auto range = m_dependents.equal_range(srcKey);
+    for (auto it = range.first; it != range.second; ++it)
+        if (it->second == key) {
+            m_dependents.erase(it);
+            break;
+        }
+
+    --m_edgeCount;
+    MarkDirty(key);
+
+    _log(EFFECTS__TRACE, "FxGraph::RemoveEdge() - %s(%u):%s <%s> %s(%u):%s", \
+            data.srcRef->name(), srcID, sDataMgr.GetAttrName(data.srcAttr), sFxProc.GetMathMethodName(math), \
+            pTarg->name(), pTarg->itemID(), sDataMgr.GetAttrName(data.targAttr));
+    return true;
+}
+
+void FxGraph::RemoveItem(uint32 itemID)
+{
+    // remove edges sourced from this item and mark their targets dirty
+    for (auto& cur : m_nodes) {
+        std::vector<Edge>& edges = cur.second.edges;
+        size_t count(edges.size());
+        edges.erase(std::remove_if(edges.begin(), edges.end(),
+                [itemID](const Edge& edge) { return edge.srcRef->itemID() == itemID; }), edges.end());
+        if (count != edges.size()) {
+            m_edgeCount -= (count - edges.size());
+            MarkDirty(cur.first);
+        }
+    }
+
+    // remove this item's own nodes, putting their attributes back to unmodified values
+    std::unordered_map<int64, Node>::iterator itr = m_nodes.begin();
+    while (itr != m_nodes.end()) {
+        if (itr->second.itemRef->itemID() == itemID) {
+            m_edgeCount -= itr->second.edges.size();
+            Write(itr->second, itr->second.base, false);
+            m_dirty.erase(itr->first);
+            itr = m_nodes.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+
+    std::unordered_map<uint32, InventoryItemRef>::iterator item = m_items.find(itemID);
+    if (item != m_items.end()) {
+        item->second->GetAttributeMap()->SetFxGraph(nullptr);
+        m_items.erase(item);
+    }
+
+    std::unordered_multimap<int64, int64>::iterator dep = m_dependents.begin();
+    while (dep != m_dependents.end()) {
+        if (((uint32)(dep->first >> 16) == itemID) or ((uint32)(dep->second >> 16) == itemID)) {
+            dep = m_dependents.erase(dep);
+        } else {
+            ++dep;
+        }
+    }
+}
+
+void FxGraph::Clear()
+{
+    for (auto& cur : m_items)
+        cur.second->GetAttributeMap()->SetFxGraph(nullptr);
+    m_items.clear();
+    m_nodes.clear();
+    m_dependents.clear();
+    m_dirty.clear();
+    m_edgeCount = 0;
+}
+
+void FxGraph::MarkDirty(int64 key)
+{
+    m_dirty.insert(key);
+}
+
+bool FxGraph::GetBase(InventoryItem* pItem, uint16 attrID, EvilNumber& value)
+{
+    std::unordered_map<int64, Node>::iterator itr = m_nodes.find(MakeKey(pItem->itemID(), attrID));
+    if (itr == m_nodes.end())
+        return false;
+    value = itr->second.base;
+    return true;
+}
+
+bool FxGraph::SetBase(InventoryItem* pItem, uint16 attrID, const EvilNumber& value)
+{
+    if (m_writing)
+        return false;   // our own write
+    int64 key(MakeKey(pItem->itemID(), attrID));
+    std::unordered_map<int64, Node>::iterator itr = m_nodes.find(key);
+    if (itr == m_nodes.end())
+        return false;
+    itr->second.base = value;
+    MarkDirty(key);
+    return true;
+}
+
+void FxGraph::Write(Node& node, const EvilNumber& value, bool update)
+{
+    m_writing = true;
+    node.itemRef->SetAttribute(node.attrID, value, update);
+    m_writing = false;
+}
+
+void FxGraph::CountEdges(uint32& additive, uint32& multiplicative)
+{
+    additive = 0;
+    multiplicative = 0;
+    for (auto& node : m_nodes)
+        for (auto& cur : node.second.edges)
+            switch (cur.math) {
+                case FX::Math::PreMul:
+                case FX::Math::PostMul:
+                case FX::Math::PreDiv:
+                case FX::Math::PostDiv:
+                case FX::Math::PostPercent:
+                case FX::Math::RevPostPercent:
+                    ++multiplicative;
+                    break;
+                default:
+                    ++additive;
+            }
+}
+
+EvilNumber FxGraph::Compute(Node& node)
+{
+    EvilNumber value(node.base), srcValue(EvilZero);
+    for (auto& cur : node.edges) {
+        srcValue = cur.srcRef->GetAttribute(cur.srcAttr);
+        switch (cur.math) {
+            case FX::Math::PreMul:
+            case FX::Math::PostMul:
+            case FX::Math::PreDiv:
+            case FX::Math::PostDiv: {
+                if (value == EvilZero)
+                    value = EvilOne;
+            } break;
+        }
+        value = sFxProc.CalculateAttributeValue(value, srcValue, cur.math);
+    }
+    return value;
+}
+
+void FxGraph::Recalculate(bool update/*false*/)
+{
+    if (m_dirty.empty())
+        return;
+
+    // add everything depending on a dirty node
+    std::vector<int64> order(m_dirty.begin(), m_dirty.end());
+    for (size_t i = 0; i < order.size(); ++i) {
+        auto range = m_dependents.equal_range(order[i]);
+        for (auto it = range.first; it != range.second; ++it)
+            if (m_dirty.insert(it->second).second)
+                order.push_back(it->second);
+    }
+
+    // topological sort (Kahn) of the dirty set, so sources are updated before anything reading them
+    std::unordered_map<int64, uint16> inDegree;
+    inDegree.reserve(m_dirty.size());
+    for (auto cur : m_dirty)
+        inDegree.emplace(cur, 0);
+    for (auto cur : m_dirty) {
+        auto range = m_dependents.equal_range(cur);
+        for (auto it = range.first; it != range.second; ++it) {
+            std::unordered_map<int64, uint16>::iterator deg = inDegree.find(it->second);
+            if (deg != inDegree.end())
+                ++deg->second;
+        }
+    }
+
+    order.clear();
+    for (auto& cur : inDegree)
+        if (cur.second == 0)
+            order.push_back(cur.first);
+    for (size_t i = 0; i < order.size(); ++i) {
+        auto range = m_dependents.equal_range(order[i]);
+        for (auto it = range.first; it != range.second; ++it) {
+            std::unordered_map<int64, uint16>::iterator deg = inDegree.find(it->second);
+            if ((deg != inDegree.end()) and (deg->second > 0))
+                if (--deg->second == 0)
+                    order.push_back(it->second);
+        }
+    }
+    if (order.size() < inDegree.size()) {
+        _log(EFFECTS__WARNING, "FxGraph::Recalculate() - %u attribs in modifier cycle on %s(%u).  processing in any order.", \
+                (uint32)(inDegree.size() - order.size()), m_pShip->name(), m_pShip->itemID());
+        for (auto& cur : inDegree)
+            if (cur.second > 0)
+                order.push_back(cur.first);
+    }
+
+    uint16 updated(0);
+    EvilNumber current(EvilZero), value(EvilZero);
+    for (auto key : order) {
+        std::unordered_map<int64, Node>::iterator itr = m_nodes.find(key);
+        if (itr == m_nodes.end())
+            continue;   // not a modified attribute (source only)
+        Node& node = itr->second;
+        current = node.itemRef->GetAttribute(node.attrID);
+        if (node.edges.empty()) {
+            if (current != node.base) {
+                Write(node, node.base, update);
+                ++updated;
+            }
+            m_nodes.erase(itr);
+            continue;
+        }
+
+        value = Compute(node);
+        if (value != current) {
+            Write(node, value, update);
+            ++updated;
+        }
+    }
+
+    _log(EFFECTS__DEBUG, "FxGraph::Recalculate() - %u dirty attribs, %u updated.  graph has %u nodes, %u edges.", \
+            (uint32)order.size(), updated, (uint32)m_nodes.size(), (uint32)m_edgeCount);
+
+    m_dirty.clear();
+}
+
+uint32 FxGraph::Verify()
+{
+    if (!m_pShip->HasPilot())
+        return 0;
+
+    struct Value {
+        InventoryItemRef itemRef;
+        uint16 attrID;
+        EvilNumber value;
+    };
+    std::vector<Value> values;
+    values.reserve(m_nodes.size());
+    for (auto& cur : m_nodes) {
+        Value val = Value();
+        val.itemRef = cur.second.itemRef;
+        val.attrID = cur.second.attrID;
+        val.value = cur.second.itemRef->GetAttribute(cur.second.attrID);
+        values.push_back(val);
+    }
+
+    // legacy full recompute.  everything is reset and every modifier applied directly
+    m_bypass = true;
+    m_pShip->ProcessEffects(false);
+    m_pShip->ProcessEffects(true, false);
+    m_bypass = false;
+
+    uint32 count(0);
+    double legacy(0), graph(0);
+    for (auto& cur : values) {
+        legacy = cur.itemRef->GetAttribute(cur.attrID).get_double();
+        graph = cur.value.get_double();
+        // legacy applies modifiers in source order, the graph in math order.  allow for float rounding
+        if (fabs(legacy - graph) <= (fabs(legacy) * 1e-5))
+            continue;
+        ++count;
+        _log(EFFECTS__ERROR, "FxGraph::Verify() - %s(%u):%s is %.3f.  legacy full recompute gives %.3f", \
+                cur.itemRef->name(), cur.itemRef->itemID(), sDataMgr.GetAttrName(cur.attrID), graph, legacy);
+    }
+
+    // back to the graph
+    m_pShip->ProcessEffects(false);
+    m_pShip->ProcessEffects(true, false);
+
+    _log(EFFECTS__DEBUG, "FxGraph::Verify() - %u of %u attribs on %s(%u) differ from legacy.", \
+            count, (uint32)values.size(), m_pShip->name(), m_pShip->itemID());
+    return count;
+}
@@ -0,0 +1,122 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ *   modifier dependency graph for incremental attribute recalculation
+ */
+
+#ifndef _EVE_FX_GRAPH_H__
+#define _EVE_FX_GRAPH_H__
+
+#include "effects/fxData.h"
+#include "inventory/InventoryItem.h"
+
+class Character;
+class ShipItem;
+
+/*
+ * the graph holds every modifier currently applied to a ship, its modules and charges, and its pilot (char and skills)
+ * nodes are keyed by (itemID, attrID) and hold the attribute's unmodified value and all modifier edges into it.
+ * edges are registered when an effect's source activates and removed when it deactivates.
+ * Recalculate() only touches nodes that were marked dirty (and nodes depending on them), in topological order,
+ * and only calls SetAttribute() when the final value actually changed, so the client only gets real changes.
+ *
+ * every tracked item's AttributeMap reports writes from outside the graph (cargo mass, reset, etc) to SetBase(),
+ * so they replace the unmodified value and the modifiers are applied on top at the next Recalculate().
+ *
+ * this is only used when sConfig.testing.IncrementalFx is set.  otherwise FxProc applies modifiers directly.
+ * Verify() checks the graph's values against the legacy full recompute (FxProc's direct path).
+ */
+class FxGraph
+{
+public:
+    FxGraph(ShipItem* pShip);
+    ~FxGraph()                                          { Clear(); }
+
+    // true if the graph tracks modifiers on this item (ship, pilot, or item located in either)
+    bool Covers(InventoryItem* pItem, Character* pChar);
+
+    // register modifier from data.srcRef/data.srcAttr onto pTarg/data.targAttr.  returns false if there is no source (caller must apply directly)
+    bool AddEdge(const fxData& data, int8 math, InventoryItemRef pTarg);
+    // remove a previously registered modifier.  returns false if edge was not found (caller must undo directly)
+    bool RemoveEdge(const fxData& data, int8 math, InventoryItemRef pTarg);
+    // drop all nodes and edges for this item (item removed from ship)
+    void RemoveItem(uint32 itemID);
+    // drop everything.  does NOT reset attributes (caller does that)
+    void Clear();
+
+    // unmodified value of a tracked attrib.  returns false if the graph does not track it
+    bool GetBase(InventoryItem* pItem, uint16 attrID, EvilNumber& value);
+    // replace the unmodified value of a tracked attrib and mark it dirty.  returns false if the graph does not track it
+    bool SetBase(InventoryItem* pItem, uint16 attrID, const EvilNumber& value);
+
+    // recompute all dirty nodes and their dependents.  update is passed to SetAttribute()
+    void Recalculate(bool update=false);
+    /* reset the ship and pilot and reapply all modifiers thru FxProc's direct path (the legacy full recompute),
+     *   compare each tracked attrib with what the graph gave, then rebuild the graph.
+     * returns number that differ.  this runs ShipItem::ProcessEffects(), so never call it from inside an effects pass
+     */
+    uint32 Verify();
+    // true while Verify() runs the legacy path.  FxProc does not use the graph then
+    bool IsBypassed()                                   { return m_bypass; }
+
+    // number of edges with additive (add/sub/assign) and multiplicative (mul/div/percent) math
+    void CountEdges(uint32& additive, uint32& multiplicative);
+
+    size_t GetNodeCount()                               { return m_nodes.size(); }
+    size_t GetEdgeCount()                               { return m_edgeCount; }
+
+    static int64 MakeKey(uint32 itemID, uint16 attrID)  { return ((int64)itemID << 16) | attrID; }
+
+private:
+    struct Edge {
+        int8 math;
+        uint16 srcAttr;
+        InventoryItemRef srcRef;    // never null.  AddEdge() refuses those
+    };
+    struct Node {
+        uint16 attrID;
+        EvilNumber base;        // value before any modifier
+        InventoryItemRef itemRef;
+        std::vector<Edge> edges;
+    };
+
+    void MarkDirty(int64 key);
+    EvilNumber Compute(Node& node);
+    // set attrib without it coming back to SetBase()
+    void Write(Node& node, const EvilNumber& value, bool update);
+
+    ShipItem* m_pShip;      // our owner
+    size_t m_edgeCount;
+    bool m_writing;
+    bool m_bypass;
+
+    std::unordered_map<uint32, InventoryItemRef> m_items;  // items whose AttributeMap reports to us
+
+    std::unordered_map<int64, Node> m_nodes;
+    std::unordered_multimap<int64, int64> m_dependents;    // srcKey, targKey
+    std::unordered_set<int64> m_dirty;
+};
+
+#endif  // _EVE_FX_GRAPH_H__
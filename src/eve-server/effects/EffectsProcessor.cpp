@@ -11,6 +11,7 @@
 
 #include "Client.h"
 #include "effects/EffectsActions.h"
+#include "effects/EffectsGraph.h"
 #include "effects/EffectsProcessor.h"
 #include "inventory/InventoryItem.h"
 #include "character/Character.h"
@@ -274,12 +275,185 @@ void FxProc::ParseExpression(InventoryItem* pItem, Expression expression, fxData
         sProfiler.AddTime(Profile::parseFX, GetTimeUSeconds() - profileStartTime);
 }
 
-void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShip, bool update/*false*/)
+void FxProc::ExecuteProgram(InventoryItem* pItem, uint16 expID, fxData& data)
 {
+    bool skill(false);
+    switch (data.srcRef->categoryID()) {
+        case  EVEDB::invCategories::Skill:
+        case  EVEDB::invCategories::Implant: {  // cat::implant also covers grp::booster
+            skill = true;
+        } break;
+    }
+
+    const std::vector<fxOp>* pProgram = sFxDataMgr.GetProgram(expID, skill);
+    if (pProgram == nullptr) {
+        // not an effect expression (or not loaded yet).  walk the tree
+        ParseExpression(pItem, sFxDataMgr.GetExpression(expID), data);
+        return;
+    }
+
     double profileStartTime(GetTimeUSeconds());
+    for (auto& cur : *pProgram) {
+        data.math = cur.math;
+        data.fxSrc = cur.fxSrc;
+        data.targLoc = cur.targLoc;
+        data.action = cur.action;
+        data.targAttr = cur.targAttr;
+        data.srcAttr = cur.srcAttr;
+        data.grpID = cur.grpID;
+        data.typeID = (cur.srcType ? data.srcRef->typeID() : cur.typeID);
+        if (cur.remove) {
+            pItem->RemoveModifier(data);
+        } else {
+            pItem->AddModifier(data);
+        }
+    }
+
+    if (sConfig.debug.UseProfiling)
+        sProfiler.AddTime(Profile::parseFX, GetTimeUSeconds() - profileStartTime);
+}
+
+/*  this follows ParseExpression() exactly, but on a working fxOp with no item.
+ *  anything ParseExpression() would add/remove on the container is appended to program instead.
+ *  the only runtime-dependent parts are the skill flag (separate program) and opGETTYPE (srcType flag)
+ */
+void FxProc::CompileExpression(uint16 expID, bool skill, fxOp& data, std::vector<fxOp>& program)
+{
+    Expression expression = sFxDataMgr.GetExpression(expID);
+
     using namespace FX;
+    switch(expression.operandID) {
+        case Operands::DEFBOOL:   //23
+        case Operands::DEFINT: {  //27
+        } break;
+        case Operands::DEFASSOCIATION: { //21
+            data.math = GetAssociationEnum(expression.expressionValue);
+        } break;
+        case Operands::DEFENVIDX: {     //24
+            data.targLoc = GetEnvironmentEnum(expression.expressionValue);
+        } break;
+        case Operands::DEFATTRIBUTE: {  //22
+            if (expression.expressionAttributeID) {
+                if (data.targAttr) {  // always processed first
+                    data.srcAttr = expression.expressionAttributeID;
+                } else {
+                    data.targAttr = expression.expressionAttributeID;
+                }
+            } else {
+                _log(EFFECTS__ERROR, "FxProc::CompileExpression(): opATTR called with no expressionAttributeID defined in %u", expID);
+            }
+        } break;
+        case Operands::DEFGROUP: {      //26
+            data.fxSrc = Source::Group;
+            if (expression.expressionGroupID) {
+                data.grpID = expression.expressionGroupID;
+            } else if (expression.expressionValue != "") {
+                _log(EFFECTS__WARNING, "FxProc::CompileExpression(): opGROUP using expressionValue %s called by %s",\
+                        expression.expressionValue.c_str(), expression.expressionName.c_str());
+            } else {
+                _log(EFFECTS__ERROR, "FxProc::CompileExpression(): opGROUP called with no expressionGroupID or expressionValue defined in %u", expID);
+            }
+        } break;
+        case Operands::DEFTYPEID: {     //29
+            if (skill)
+                data.fxSrc = Source::Skill;
+            if (expression.expressionTypeID) {
+                data.typeID = expression.expressionTypeID;
+                data.srcType = false;
+            } else if (expression.expressionValue != "") {
+                _log(EFFECTS__WARNING, "FxProc::CompileExpression(): opTYPEID using expressionValue %s", expression.expressionValue.c_str());
+            } else {
+                _log(EFFECTS__ERROR, "FxProc::CompileExpression(): opTYPEID called with no expressionTypeID or expressionValue defined in %u", expID);
+            }
+        } break;
+        case Operands::GETTYPE: { //36
+            if ((!data.typeID) and (!data.srcType))
+                data.srcType = true;
+        } break;
+        case Operands::GM:      //37
+        case Operands::RSA:     //64
+        case Operands::LG: {    //48
+            CompileExpression(expression.arg1, skill, data, program);
+            CompileExpression(expression.arg2, skill, data, program);
+        } break;
+        case Operands::COMBINE: { //17
+            CompileExpression(expression.arg1, skill, data, program);
+            fxOp data1 = fxOp();
+            data1.action = Action::Invalid;
+            CompileExpression(expression.arg2, skill, data1, program);
+        } break;
+        case Operands::SRLG: {    //49
+            CompileExpression(expression.arg1, skill, data, program);
+            CompileExpression(expression.arg2, skill, data, program);
+            if (!data.fxSrc)
+                data.fxSrc = Source::Skill;
+        } break;
+        case Operands::ATT:     //12
+        case Operands::EFF:     //31
+        case Operands::GA:      //34
+        case Operands::GET:     //35
+        case Operands::IA: {    //40
+            CompileExpression(expression.arg1, skill, data, program);
+            if (expression.arg2)
+                CompileExpression(expression.arg2, skill, data, program);
+        } break;
+        case Operands::AIM:     //6
+        case Operands::AGRSM:   //5
+        case Operands::AGSM: {  //3
+            CompileExpression(expression.arg1, skill, data, program);
+            CompileExpression(expression.arg2, skill, data, program);
+            data.remove = false;
+            program.push_back(data);
+        } break;
+        case Operands::ALGM:    //7
+        case Operands::ALM:     //8
+        case Operands::ALRSM:   //9
+        case Operands::AORSM: { //11
+            CompileExpression(expression.arg1, skill, data, program);
+            CompileExpression(expression.arg2, skill, data, program);
+            if ((skill) and (!data.fxSrc))
+                data.fxSrc = Source::Skill;
+            data.remove = false;
+            program.push_back(data);
+        } break;
+        case Operands::RIM:     //58
+        case Operands::RGGM:    //54
+        case Operands::RGSM:    //55
+        case Operands::RGORSM:  //56
+        case Operands::RGRSM: { //57
+            CompileExpression(expression.arg1, skill, data, program);
+            CompileExpression(expression.arg2, skill, data, program);
+            data.remove = true;
+            program.push_back(data);
+            // RemoveModifier() inverts math on the caller's data
+            data.math = GetInverseMath(data.math);
+        } break;
+        case Operands::RLGM:    //59
+        case Operands::RLM:     //60
+        case Operands::RLRSM:   //61
+        case Operands::RORSM: { //62
+            CompileExpression(expression.arg1, skill, data, program);
+            CompileExpression(expression.arg2, skill, data, program);
+            if ((skill) and (!data.fxSrc))
+                data.fxSrc = Source::Skill;
+            data.remove = true;
+            program.push_back(data);
+            data.math = GetInverseMath(data.math);
+        } break;
+        // conditionals, attrib math and module actions are not handled by ParseExpression() either
+    }
+}
+
+void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShip, bool update/*false*/)
+{
+    ProfileZone zone(Profile::applyFX);
+    using namespace FX;
+    // modifiers on ship, pilot and their contents go thru the ship's graph when enabled.  targets outside that use the direct path
+    FxGraph* pGraph(nullptr);
+    if (sConfig.testing.IncrementalFx and (pShip != nullptr) and !pShip->GetFxGraph()->IsBypassed())
+        pGraph = pShip->GetFxGraph();
     //uint8 action = Action::dgmActInvalid;
-    for (auto cur : pItem->GetModifiers()) {  // k,v of assoc, data<math, src, targLoc, targAttr, srcAttr, grpID, typeID>
+    for (auto& cur : pItem->GetModifiers()) {  // k,v of assoc, data<math, src, targLoc, targAttr, srcAttr, grpID, typeID>
         /*
         if (cur.second.action) {
             action = cur.second.action;
@@ -294,7 +468,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
                 // this is to apply modifiers to ship's modules of groupID defined in 'grpID'
                 std::vector<InventoryItemRef> moduleList;
                 pShip->GetModuleManager()->GetModuleListOfRefsAsc(moduleList);
-                for (auto mod : moduleList)
+                for (auto& mod : moduleList)
                     if (mod->groupID() == cur.second.grpID)
                         itemRefVec.push_back(mod);
             } break;
@@ -324,7 +498,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
                             // ... char skills that require skill in 'srcRef' or defined in 'typeID'
                             std::vector<InventoryItemRef> allSkills;
                             pChar->GetSkillsList(allSkills);
-                            for (auto curSkill : allSkills)
+                            for (auto& curSkill : allSkills)
                                 if (curSkill->HasReqSkill(cur.second.typeID))
                                     itemRefVec.push_back(curSkill);
                         } else {
@@ -341,7 +515,7 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
                         // will need more testing to verify this.
                         std::map<EVEItemFlags, InventoryItemRef> charges;
                         pShip->GetModuleManager()->GetLoadedCharges(charges);
-                        for (auto mod : charges)
+                        for (auto& mod : charges)
                             if (mod.second->HasReqSkill(cur.second.typeID))
                                 itemRefVec.push_back(mod.second);
                     } break;
@@ -477,11 +651,23 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
 
         // set target attr to modified value
         EvilNumber targValue(EvilZero), newValue(EvilZero);
-        for (auto item : itemRefVec) {
+        bool tracked(false);
+        for (auto& item : itemRefVec) {
             if (item.get() == nullptr)  // still occasional nulls in the vector (segfaults)
                 continue;
-            // get targAttr
-            targValue = item->GetAttribute(cur.second.targAttr);
+            if ((pGraph != nullptr) and pGraph->Covers(item.get(), pChar)) {
+                if (!cur.second.remove) {
+                    if (pGraph->AddEdge(cur.second, cur.first, item))
+                        continue;
+                } else if (pGraph->RemoveEdge(cur.second, GetInverseMath(cur.first), item)) {
+                    continue;
+                }
+                // edge not in graph (applied before graph was enabled).  apply or undo it directly
+            }
+            // get targAttr.  if the graph tracks it, modify the unmodified value, and let Recalculate() apply the edges on top
+            tracked = ((pGraph != nullptr) and pGraph->GetBase(item.get(), cur.second.targAttr, targValue));
+            if (!tracked)
+                targValue = item->GetAttribute(cur.second.targAttr);
             // check for inf/nan and then reset?  this will fuck up all previous fx processing on this value.
             // but it will allow continuing w/o error in subsequent processing
             if (targValue.isNaN() or targValue.isInf()) {
@@ -512,7 +698,11 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
 
             // set new calculated value for target attribute
             // update is used to send attrib changes to client when changing module states while in space, but NOT for pilot login. (client acts funky)
-            item->SetAttribute(cur.second.targAttr, newValue, update);
+            if (tracked) {
+                pGraph->SetBase(item.get(), cur.second.targAttr, newValue);
+            } else {
+                item->SetAttribute(cur.second.targAttr, newValue, update);
+            }
             newValue = EvilZero;
         }
     }
@@ -521,10 +711,11 @@ void FxProc::ApplyEffects(InventoryItem* pItem, Character* pChar, ShipItem* pShi
         sFxAct.DoAction(action, pShip->GetPilot()->GetShipSE());   // this MUST be called AFTER all active effects are applied, as it uses those modified values
      */
 
-    pItem->ClearModifiers();
+    // recompute only the attribs touched above (and those depending on them)
+    if (pGraph != nullptr)
+        pGraph->Recalculate(update);
 
-    if (sConfig.debug.UseProfiling)
-        sProfiler.AddTime(Profile::applyFX, GetTimeUSeconds() - profileStartTime);
+    pItem->ClearModifiers();
 }
 
 EvilNumber FxProc::CalculateAttributeValue(EvilNumber val1/*targ*/, EvilNumber val2/*src*/, int8 method)
@@ -562,6 +753,24 @@ EvilNumber FxProc::CalculateAttributeValue(EvilNumber val1/*targ*/, EvilNumber v
     return val1;
 }
 
+int8 FxProc::GetInverseMath(int8 method)
+{
+    switch (method) {
+        case FX::Math::PreMul:          return FX::Math::PreDiv;
+        case FX::Math::PreDiv:          return FX::Math::PreMul;
+        case FX::Math::ModAdd:          return FX::Math::ModSub;
+        case FX::Math::ModSub:          return FX::Math::ModAdd;
+        case FX::Math::PostMul:         return FX::Math::PostDiv;
+        case FX::Math::PostDiv:         return FX::Math::PostMul;
+        case FX::Math::PostPercent:     return FX::Math::RevPostPercent;
+        // no association maps to RevPostPercent, so RemoveModifier() never sees it.  this maps a removal back to its edge
+        case FX::Math::RevPostPercent:  return FX::Math::PostPercent;
+        case FX::Math::PreAssignment:   return FX::Math::PostAssignment;
+        case FX::Math::PostAssignment:  return FX::Math::PreAssignment;
+    }
+    return method;
+}
+
 int8 FxProc::GetAssociationEnum(const std::string& association)
 {   // opID 21
     if (association == "PreAssignment") {
@@ -32,6 +32,10 @@ public:
     // pItem is modifier container
     // pMod is not used
     void            ParseExpression(InventoryItem* pItem, Expression expression, fxData& data, GenericModule* pMod=nullptr);
+    // pItem is modifier container.  runs compiled program for expID (falls back to ParseExpression() if not compiled)
+    void            ExecuteProgram(InventoryItem* pItem, uint16 expID, fxData& data);
+    // flatten expression tree into program.  called once for each expression by FxDataMgr at load.  data is working state
+    void            CompileExpression(uint16 expID, bool skill, fxOp& data, std::vector<fxOp>& program);
     int8            GetEnvironmentEnum(const std::string& domain);
     int8            GetAssociationEnum(const std::string& association);
 
@@ -41,6 +45,8 @@ public:
     const char*     GetStateName(int8 id);
 
     EvilNumber      CalculateAttributeValue(EvilNumber val1, EvilNumber val2, /*FX::Math*/int8 method);
+    // returns math method that will undo 'method'
+    int8            GetInverseMath(/*FX::Math*/int8 method);
 
     void DecodeEffects(const uint16 fxID);
 protected:
@@ -23,5 +23,6 @@ struct fxData {
     uint16 grpID;       // used to define items in env grouped by item groupID
     uint16 typeID;      // used to define items in env grouped by skill requirement
     InventoryItemRef srcRef;   // source item ref, if required
+    bool remove;        // set by RemoveModifier().  math is already inverted
 };
 #endif // _EVE_FX_DATA_H__
\ No newline at end of file
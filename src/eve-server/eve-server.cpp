@@ -29,6 +29,8 @@
 #include "../eve-common/EVEVersion.h"
 
 #include "EVEServerConfig.h"
+#include "log/AsyncLog.h"
+#include "utils/TimerWheel.h"
 #include "NetService.h"
 // data managers
 #include "StaticDataMgr.h"
@@ -73,6 +75,7 @@
 #include "character/PaperDollService.h"
 #include "character/PhotoUploadService.h"
 #include "character/SkillMgrService.h"
+#include "character/SkillQueueMgr.h"
 // chat services
 #include "chat/LookupService.h"
 #include "chat/LSCService.h"
@@ -83,6 +86,7 @@
 #include "config/LanguageService.h"
 #include "config/LocalizationServerService.h"
 // contract services
+#include "contract/ContractIndex.h"
 #include "contract/ContractProxy.h"
 // corporation services
 #include "corporation/BillMgr.h"
@@ -125,9 +129,11 @@
 #include "mail/NotificationMgrService.h"
 // manufacturing services
 #include "manufacturing/FactoryService.h"
+#include "manufacturing/RamJobMgr.h"
 #include "manufacturing/RamProxyService.h"
 // map services
 #include "map/MapData.h"
+#include "map/MapGraph.h"
 #include "map/MapService.h"
 // market services
 #include "market/MarketMgr.h"
@@ -149,6 +155,7 @@
 #include "qaTools/zActionServer.h"
 // search services
 #include "search/Search.h"
+#include "search/SearchIndex.h"
 // ship services
 #include "ship/BeyonceService.h"
 #include "ship/ShipService.h"
@@ -249,6 +256,12 @@ int main( int argc, char* argv[] )
     }
     std::printf("\n");     // spacer
 
+    /* move console and file output off the calling threads */
+    if (sConfig.debug.AsyncLog) {
+        sAsyncLog.Start(sConfig.debug.AsyncLogBlock);
+        sLog.Green( "       ServerInit", "Async logging started.  Full buffers will %s.", sConfig.debug.AsyncLogBlock ? "block" : "drop messages" );
+    }
+
     sLog.Green("       ServerInit", "Server Configuration Files Loaded.");
     std::printf("\n");     // spacer
 
@@ -466,6 +479,11 @@ int main( int argc, char* argv[] )
     } else {
         sLog.Warning("        Ship Heat","Disabled.");
     }
+    if (sConfig.testing.IncrementalFx) {
+        sLog.Green("   Incremental Fx","Enabled.");
+    } else {
+        sLog.Warning("   Incremental Fx","Disabled.");
+    }
     if (sConfig.cosmic.PIEnabled) {
         sLog.Green("        PI System","Enabled.");
     } else {
@@ -550,6 +568,9 @@ int main( int argc, char* argv[] )
     if (sConfig.debug.UseProfiling) {
         sLog.Green(" Server Profiling","Enabled.");
         sProfiler.Initialize();
+        sDatabase.SetProfileHook([](double time) { sProfiler.AddTime(Profile::db, time); });
+        if (sConfig.debug.ProfileExport)
+            sLog.Green("   Profile Export","Enabled.  Written to %sserver_profile.txt every %u minutes", sConfig.files.logDir.c_str(), sConfig.debug.ProfileInterval);
     } else {
         sLog.Warning(" Server Profiling","Disabled.");
     }
@@ -764,6 +785,15 @@ int main( int argc, char* argv[] )
     /* create the MarketMgr singleton */
     sLog.Green("       ServerInit", "Starting Market Manager");
     sMktMgr.Initialize(newSvcMgr);
+    /* create the ContractIndex singleton */
+    sLog.Green("       ServerInit", "Starting Contract Index");
+    sContractIdx.Initialize();
+    /* create the SkillQueueMgr singleton */
+    sLog.Green("       ServerInit", "Starting Skill Queue Manager");
+    sSkillQueueMgr.Initialize();
+    /* create the RamJobMgr singleton */
+    sLog.Green("       ServerInit", "Starting R.A.M. Job Manager");
+    sRamJobMgr.Initialize();
     sLog.Green("       ServerInit", "Starting Statistics Manager");
     sStatMgr.Initialize();
     /* create console command interperter singleton */
@@ -813,6 +843,10 @@ int main( int argc, char* argv[] )
     std::printf("\n");     // spacer
     sMapData.Initialize();
     std::printf("\n");     // spacer
+    sMapGraph.Initialize();
+    std::printf("\n");     // spacer
+    sSearchIndex.Initialize();
+    std::printf("\n");     // spacer
     sDunDataMgr.Initialize();
     std::printf("\n");     // spacer
     sPlanetDataMgr.Initialize();
@@ -869,6 +903,7 @@ int main( int argc, char* argv[] )
     */
 
     uint32 start(0);
+    double tickStart(0);
     EVETCPConnection* tcpc(nullptr);
 
     if (sConfig.debug.UseProfiling) {
@@ -899,9 +934,13 @@ int main( int argc, char* argv[] )
     while (m_run) {
         Timer::SetCurrentTime();
         start = GetTickCount();
+        tickStart = (sConfig.debug.UseProfiling ? GetTimeUSeconds() : 0);
 
         sAllocators.tickAllocator.Reset();
 
+        /* run scheduled timers that are due */
+        sTimerWheel.Process(Timer::Now());
+
         /* Freeze Detector Code */
         //++m_worldLoopCounter;
 
@@ -910,9 +949,16 @@ int main( int argc, char* argv[] )
 
         sEntityList.Process();
 
+        if (sConfig.debug.UseProfiling)
+            sProfiler.Process();
+
         /*  process console commands, if any, and check for 'exit' command */
         m_run = sConsole.Process();
 
+        /* time spent working this tick, for the profiler (and load testing) */
+        if (tickStart > 0)
+            sProfiler.AddTime(Profile::server, GetTimeUSeconds() - tickStart);
+
         /* do the stuff for thread sleeping */
         start = GetTickCount() - start;
         if (m_sleepTime > start)
@@ -940,12 +986,17 @@ int main( int argc, char* argv[] )
     sLog.Warning("   ServerShutdown", "Image Server stopped." );
     /* Close the MarketMgr */
     sMktMgr.Close();
+    sContractIdx.Close();
+    sSkillQueueMgr.Close();
+    sRamJobMgr.Close();
     /* Close the bulk data manager */
     sBulkDB.Close();
     /* Close the station data manager */
     stDataMgr.Close();
     /* Close the map data manager */
     sMapData.Close();
+    sMapGraph.Close();
+    sSearchIndex.Close();
     /* Close the static data manager */
     sDataMgr.Close();
     /* Close the statistics manager */
@@ -974,6 +1025,8 @@ int main( int argc, char* argv[] )
     /* join open threads */
     sThread.EndThreads();
     sLog.Warning("   ServerShutdown", "EVEmu is Offline.");
+    /* write out queued log messages */
+    sAsyncLog.Stop();
     /* close logfile */
     log_close_logfile();
     exit(EXIT_SUCCESS);
@@ -1047,6 +1100,9 @@ static void CleanUp() {
     /* Close the MarketMgr */
     sLog.Warning("   ServerShutdown", "Shutting down Market Manager." );
     sMktMgr.Close();
+    sContractIdx.Close();
+    sSkillQueueMgr.Close();
+    sRamJobMgr.Close();
     /* Close the bulk data manager */
     sLog.Warning("   ServerShutdown", "Closing the BulkData Manager." );
     sBulkDB.Close();
@@ -1084,6 +1140,8 @@ static void CleanUp() {
     /* join open threads */
     sThread.EndThreads();
     sLog.Warning("   ServerShutdown", "EVEmu is Offline.");
+    /* write out queued log messages */
+    sAsyncLog.Stop();
     /* close logfile */
     log_close_logfile();
 }
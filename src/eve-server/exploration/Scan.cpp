@@ -104,34 +104,22 @@ PyRep* Scan::ConeScan(Call_ConeScan args) {
     /* to find if a point is inside a cone.     (-allan 10Aug20)
      * U = unit vector along cone axis (sent from client, decoded as x,y,z)
      * VR = vector from cone vertex(V) to test point(R).
-     * Uvr = unit vector of cone vertex to test point (normalized VR)
-     * DP = Uvr dot U (dot product of Uvr and U).  this will give cosine of angle between VR and U
-     * acDP = arc cosine of DP to give angle
-     * test acDP < cone angle = point is inside cone.
+     * point is inside cone when  U.VR > cos(cone angle / 2) * |VR|
+     * this test is done by SystemManager over its dscan cache (see DScanCache::ConeQuery() for details)
      */
-    bool test(false);
-    float dot(0), acDP(0), angle(args.ScanAngle/2);
     std::vector<SystemEntity*> seVec;
     const GPoint vertex(m_client->GetShipSE()->GetPosition());
-    const GPoint U(args.x, args.y, args.z);
-    m_client->SystemMgr()->DScan(args.range, vertex, seVec);
-    _log(SCAN__TRACE, "ConeScan() - query returned %u objects within range.  angle is %.3f", seVec.size(), angle);
+    const GVector U(args.x, args.y, args.z);
+    m_client->SystemMgr()->ConeScan(args.range, vertex, U, args.ScanAngle, seVec);
+    _log(SCAN__TRACE, "ConeScan() - query returned %u objects within range and angle %.3f", seVec.size(), args.ScanAngle);
     PyList* list = new PyList();
     for (auto cur : seVec ) {
-        GVector VR(vertex, cur->GetPosition());
-        VR.normalize();
-        dot = U.dotProduct(VR);
-        acDP = acos(dot);
-        if (acDP < angle) {
-            test = true;
-            DirectionScanResult res;
-            res.id         = cur->GetID();
-            res.typeID     = cur->GetSelf()->typeID();
-            res.groupID    = cur->GetSelf()->groupID();
-            list->AddItem(res.Encode());
-        }
-        _log(SCAN__TRACE, "ConeScan() - tested %s(%u).  dot %.5f, acDP %.5f, result %s", cur->GetName(), cur->GetID(), dot, acDP, test?"true":"false");
-        test = false;
+        DirectionScanResult res;
+        res.id         = cur->GetID();
+        res.typeID     = cur->GetSelf()->typeID();
+        res.groupID    = cur->GetSelf()->groupID();
+        list->AddItem(res.Encode());
+        _log(SCAN__TRACE, "ConeScan() - found %s(%u)", cur->GetName(), cur->GetID());
     }
 
     return list;
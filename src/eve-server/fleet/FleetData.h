@@ -73,6 +73,13 @@ struct BoostData {
     int8 mining;   // mining yield
     int8 siege;    // shield capacity
     int8 skirmish; // agility
+
+    bool operator==(const BoostData& rhs) const {
+        return ((armored == rhs.armored) and (leader == rhs.leader) and (info == rhs.info)
+            and (mining == rhs.mining) and (siege == rhs.siege) and (skirmish == rhs.skirmish));
+    }
+    bool operator!=(const BoostData& rhs) const     { return !(*this == rhs); }
+    bool IsEmpty() const                            { return (*this == BoostData()); }
 };
 
 class Client;
@@ -103,6 +110,8 @@ struct FleetData {
     bool isLootLogging :1;
     int8 squads;
     int64 dateCreated;
+    BoostData boost;    // FC's own boost, including leadership
+    BoostData skills;   // booster's warfare skills, cached by UpdateBoost()
     Client* creator;
     Client* leader;
     Client* booster;
@@ -116,6 +125,7 @@ struct FleetData {
 struct WingData {
     uint32 fleetID;
     BoostData boost;
+    BoostData skills;   // booster's warfare skills, cached by UpdateBoost()
     Client* leader;
     Client* booster;
     std::string name;
@@ -126,6 +136,7 @@ struct SquadData {
     uint32 fleetID;
     uint32 wingID;
     BoostData boost;
+    BoostData skills;   // booster's warfare skills, cached by UpdateBoost()
     Client* leader;
     Client* booster;
     std::string name;
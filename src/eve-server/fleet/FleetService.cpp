@@ -86,6 +86,7 @@ uint32 FleetService::CreateFleet(Client *pClient)
         fData.isExcludedFromMuting.clear();
         fData.squads = 1;
         fData.dateCreated = GetFileTimeNow();
+    GetBoosterSkills(pClient, fData.skills);
     m_fleetDataMap.emplace(m_fleetID, fData);
 
     WingData wData = WingData();
@@ -126,6 +127,7 @@ uint32 FleetService::CreateFleet(Client *pClient)
 
     // update the fleet member map with new member for this fleet.
     m_fleetMembers.emplace(m_fleetID, pClient);
+    AddSystemMember(m_fleetID, pClient);
 
     _log(FLEET__INFO, "FleetService::CreateFleet() - fleetID: %u, wingID: %u, squadID: %u, leaderID: %u", m_fleetID, m_wingID, m_squadID, pChar->itemID());
 
@@ -253,6 +255,7 @@ bool FleetService::AddMember(Client* pClient, uint32 fleetID, int32 wingID, int3
 
     // add new member to fleet data
     m_fleetMembers.emplace(fleetID, pClient);
+    AddSystemMember(fleetID, pClient);
 
     // set char fleet data and send to client
     CharFleetData fData = CharFleetData();
@@ -556,237 +559,238 @@ bool FleetService::UpdateMember(uint32 charID, uint32 fleetID, int32 newWingID,
 void FleetService::UpdateBoost(uint32 fleetID, bool fleet, std::list<int32>& wing, std::list<int32>& squad)
 {
     double start = GetTimeUSeconds();
-    /*  this needs to check all boosters to update squad boost levels
-     *   we will also check current levels to see if members need to be updated
+    /*  boosts are passed down the fleet tree (fleet -> wing -> squad -> members), with each level taking the best of its own
+     *   booster and what is passed down to it.  each node caches its booster's skills and its resulting boost, so only the
+     *   changed nodes re-read skills, and only the subtrees below them are recomputed.
+     *   ships are only updated when their effective boost actually changes.
      */
-    std::vector< uint32 > wingIDs, squadIDs;
-    std::map<ShipSE*, BoostData> memberUpdateMap;
-
-    bool fBoost(false);
-    int8 armored(0), info(0), leader(0), mining(0), siege(0), skirmish(0);
-
-    BoostData fData = BoostData();
-    BoostData bData = BoostData();
-
     std::map<uint32, FleetData>::iterator fItr = m_fleetDataMap.find(fleetID);
-    if (fItr != m_fleetDataMap.end()) {
-        // set base boost data from FB
-        if ((fItr->second.leader != nullptr) and (fItr->second.leader->IsInSpace()))
-            if (m_fleetWings.count(fleetID) <= fItr->second.leader->GetChar()->GetSkillLevel(EvESkill::FleetCommand)) {
-                if ((fItr->second.booster != nullptr) and (fItr->second.booster->IsInSpace()))
-                    if (fItr->second.leader->GetSystemID() == fItr->second.booster->GetSystemID()) {
-                        Character* pChar = fItr->second.booster->GetChar().get();
-                        if (pChar != nullptr) {
-                            if (pChar->HasSkillTrainedToLevel(EvESkill::ArmoredWarfare, 1))
-                                fData.armored   = pChar->GetSkillLevel(EvESkill::ArmoredWarfare);
-                            if (pChar->HasSkillTrainedToLevel(EvESkill::InformationWarfare, 1))
-                                fData.info      = pChar->GetSkillLevel(EvESkill::InformationWarfare);
-                            if (pChar->HasSkillTrainedToLevel(EvESkill::SiegeWarfare, 1))
-                                fData.siege     = pChar->GetSkillLevel(EvESkill::SiegeWarfare);
-                            if (pChar->HasSkillTrainedToLevel(EvESkill::SkirmishWarfare, 1))
-                                fData.skirmish  = pChar->GetSkillLevel(EvESkill::SkirmishWarfare);
-                            if (pChar->HasSkillTrainedToLevel(EvESkill::MiningForeman, 1))
-                                fData.mining    = pChar->GetSkillLevel(EvESkill::MiningForeman);
-                            if (fData.armored or fData.info or fData.leader or fData.mining or fData.siege or fData.skirmish)
-                                fBoost = true;
-                        }
-                    }
-                // this is for FC only.  will always get own skill, and here they get their fleet boost, also
-                fData.leader = fItr->second.leader->GetChar()->GetSkillLevel(EvESkill::Leadership);
-                if (fItr->second.leader->IsInSpace())
-                    fItr->second.leader->GetShipSE()->ApplyBoost(fData);
-            }
+    if (fItr == m_fleetDataMap.end())
+        return;
+
+    wing.sort();
+    wing.unique();
+    squad.sort();
+    squad.unique();
+
+    // refresh cached booster skills for changed nodes
+    if (fleet)
+        GetBoosterSkills(fItr->second.booster, fItr->second.skills);
+    for (auto wingID : wing) {
+        std::map<uint32, WingData>::iterator wItr = m_wingDataMap.find(wingID);
+        if (wItr != m_wingDataMap.end())
+            GetBoosterSkills(wItr->second.booster, wItr->second.skills);
+    }
+    for (auto squadID : squad) {
+        std::map<uint32, SquadData>::iterator sItr = m_squadDataMap.find(squadID);
+        if (sItr != m_squadDataMap.end())
+            GetBoosterSkills(sItr->second.booster, sItr->second.skills);
     }
 
-    _log( FLEET__TRACE, "UpdateBoost - FB: %s, leader: %i, armored: %i, info: %i, siege: %i, skirmish: %i, mining: %i", \
-            (fBoost ? "true" : "false"), fData.leader, fData.armored, fData.info, fData.siege, fData.skirmish, fData.mining);
+    std::map<ShipSE*, BoostData> memberUpdateMap;
+
+    // fleet node is always rechecked, as it depends on FC and FB locations
+    BoostData fData = BoostData();
+    SetFleetBoostData(fleetID, fItr->second, fData, memberUpdateMap);
 
-    // check squad boost updates....sb overwriting higher boosts
     if (fleet) {
         // update all fleet members due to fleet booster update
-        wingIDs.clear();
-        GetWingIDs(fleetID, wingIDs);
-        for (auto wingID : wingIDs) {
-            if (!IsWingID(wingID))        // if WingID is invalid, remove it from map!!
+        auto range = m_fleetWings.equal_range(fleetID);
+        for (auto itr = range.first; itr != range.second; ++itr)
+            UpdateWingBoost(itr->second, fData, memberUpdateMap);
+    } else {
+        for (auto wingID : wing)
+            if (IsWingID(wingID))
+                UpdateWingBoost(wingID, fData, memberUpdateMap);
+
+        for (auto squadID : squad) {
+            if (!IsSquadID(squadID))
                 continue;
-            bData = BoostData();
-            if (fBoost) {
-                bData.armored   = fData.armored;
-                bData.info      = fData.info;
-                bData.mining    = fData.mining;
-                bData.siege     = fData.siege;
-                bData.skirmish  = fData.skirmish;
-            }
-            SetWingBoostData(wingID, bData);
-
-            squadIDs.clear();
-            GetSquadIDs(wingID, squadIDs);
-            for (auto squadID : squadIDs) {
-                if (!IsSquadID(squadID))
-                    continue;
-                bool sboost(false);
-                SetSquadBoostData(squadID, bData, sboost);
-                SquadData sData = SquadData();
-                GetSquadData(squadID, sData);
-                for (auto cur : sData.members)  // SC is a member
-                    if ((sboost) and (cur.second->GetSystemID() == sData.booster->GetSystemID()))
-                        memberUpdateMap.emplace(cur.second->GetShipSE(), sData.boost);
-            }
-        }
-    } else if (!wing.empty()) {
-        wing.sort();
-        wing.unique();
-        for (auto wingID : wing) {
-            if (!IsWingID(wingID))
+            std::map<uint32, SquadData>::iterator sItr = m_squadDataMap.find(squadID);
+            if (sItr == m_squadDataMap.end())
                 continue;
-            bData = BoostData();
-            if (fBoost) {
-                bData.armored   = fData.armored;
-                bData.info      = fData.info;
-                bData.mining    = fData.mining;
-                bData.siege     = fData.siege;
-                bData.skirmish  = fData.skirmish;
-            }
-            SetWingBoostData(wingID, bData);
-
-            squadIDs.clear();
-            GetSquadIDs(wingID, squadIDs);
-            for (auto squadID : squadIDs) {
-                if (!IsSquadID(squadID))
-                    continue;
-                bool sboost(false);
-                SetSquadBoostData(squadID, bData, sboost);
-                SquadData sData = SquadData();
-                GetSquadData(squadID, sData);
-                for (auto cur : sData.members)
-                    if ((sboost) and (cur.second->GetSystemID() == sData.booster->GetSystemID()))
-                        memberUpdateMap.emplace(cur.second->GetShipSE(), sData.boost);
-            }
-        }
-    } else if (!squad.empty()) {
-        squad.sort();
-        squad.unique();
-        for (auto squadID : squad) {
-            if (!IsSquadID(squadID))       // if squadID is invalid, remove it from map!!
+            // squads in an updated wing are already done
+            if (std::find(wing.begin(), wing.end(), sItr->second.wingID) != wing.end())
                 continue;
-            bData = BoostData();
-            if (fBoost) {
-                bData.armored   = fData.armored;
-                bData.info      = fData.info;
-                bData.mining    = fData.mining;
-                bData.siege     = fData.siege;
-                bData.skirmish  = fData.skirmish;
-            }
-            SquadData sData = SquadData();
-            GetSquadData(squadID, sData);
-            SetWingBoostData(sData.wingID, bData);
-            bool sboost(false);
-            SetSquadBoostData(squadID, bData, sboost);
-            for (auto cur : sData.members)
-                if (sboost and (cur.second->GetSystemID() == sData.booster->GetSystemID()))
-                    memberUpdateMap.emplace(cur.second->GetShipSE(), sData.boost);
+            std::map<uint32, WingData>::iterator wItr = m_wingDataMap.find(sItr->second.wingID);
+            if (wItr == m_wingDataMap.end())
+                continue;
+            BoostData bData(fData);
+            SetWingBoostData(wItr->first, wItr->second, bData, memberUpdateMap);
+            SetSquadBoostData(squadID, sItr->second, bData, memberUpdateMap);
         }
     }
 
     // update boost effects on these members' ships using updated boost levels
     // this is for fleet boost only, as modules will apply/remove their effects using the FxSystem
-    for (auto cur : memberUpdateMap)
-        cur.first->ApplyBoost(cur.second);
+    for (const auto& cur : memberUpdateMap) {
+        if (cur.second.IsEmpty()) {
+            cur.first->RemoveBoost();
+        } else {
+            cur.first->ApplyBoost(cur.second);
+        }
+    }
 
     _log( FLEET__TRACE, "FleetService::UpdateBoost() - Updated %lu members of fleetID: %u in %.2fus.  fleet: %s, wing: %s, squad: %s", \
             memberUpdateMap.size(), fleetID, GetTimeUSeconds() - start, (fleet ? "true" : "false"), (wing.empty() ? "false" : "true"), (squad.empty() ? "false" : "true"));
 }
 
-void FleetService::SetWingBoostData(uint32 wingID, BoostData& bData)
+void FleetService::UpdateWingBoost(uint32 wingID, BoostData bData, std::map<ShipSE*, BoostData>& updates)
 {
-    bool boost(false);
-    int8 leader(0), armored(0), info(0), mining(0), siege(0), skirmish(0);
     std::map<uint32, WingData>::iterator wItr = m_wingDataMap.find(wingID);
     if (wItr == m_wingDataMap.end())
         return;
-    if ((wItr->second.leader != nullptr) and (wItr->second.leader->IsInSpace()))
-        if (m_wingSquads.count(wingID) <= wItr->second.leader->GetChar()->GetSkillLevel(EvESkill::WingCommand)) {
-            if ((wItr->second.booster != nullptr) and (wItr->second.booster->IsInSpace()))
-                if (wItr->second.leader->GetSystemID() == wItr->second.booster->GetSystemID()) {
-                    Character* pChar = wItr->second.booster->GetChar().get();
-                    if (pChar != nullptr) {
-                        leader = wItr->second.leader->GetChar()->GetSkillLevel(EvESkill::Leadership);    // this applies ONLY to self
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::ArmoredWarfare, 1))
-                            armored     = pChar->GetSkillLevel(EvESkill::ArmoredWarfare);
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::InformationWarfare, 1))
-                            info        = pChar->GetSkillLevel(EvESkill::InformationWarfare);
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::SiegeWarfare, 1))
-                            siege       = pChar->GetSkillLevel(EvESkill::SiegeWarfare);
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::SkirmishWarfare, 1))
-                            skirmish    = pChar->GetSkillLevel(EvESkill::SkirmishWarfare);
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::MiningForeman, 1))
-                            mining      = pChar->GetSkillLevel(EvESkill::MiningForeman);
-                    }
+
+    SetWingBoostData(wingID, wItr->second, bData, updates);
+
+    auto range = m_wingSquads.equal_range(wingID);
+    for (auto itr = range.first; itr != range.second; ++itr) {
+        std::map<uint32, SquadData>::iterator sItr = m_squadDataMap.find(itr->second);
+        if (sItr != m_squadDataMap.end())
+            SetSquadBoostData(itr->second, sItr->second, bData, updates);
+    }
+}
+
+void FleetService::SetFleetBoostData(uint32 fleetID, FleetData& fData, BoostData& bData, std::map<ShipSE*, BoostData>& updates)
+{
+    bool fBoost(false);
+    bData = BoostData();
+    fData.boost = BoostData();
+    if ((fData.leader != nullptr) and (fData.leader->IsInSpace()))
+        if (m_fleetWings.count(fleetID) <= fData.leader->GetChar()->GetSkillLevel(EvESkill::FleetCommand)) {
+            if ((fData.booster != nullptr) and (fData.booster->IsInSpace()))
+                if (fData.leader->GetSystemID() == fData.booster->GetSystemID()) {
+                    bData = fData.skills;
+                    fBoost = !bData.IsEmpty();
+                }
+            // this is for FC only.  will always get own skill, and here they get their fleet boost, also
+            fData.boost = bData;
+            fData.boost.leader = fData.leader->GetChar()->GetSkillLevel(EvESkill::Leadership);
+            QueueBoost(fData.leader, fData.boost, updates);
+        }
+
+    _log( FLEET__TRACE, "UpdateBoost - FB: %s, leader: %i, armored: %i, info: %i, siege: %i, skirmish: %i, mining: %i", \
+            (fBoost ? "true" : "false"), fData.boost.leader, fData.boost.armored, fData.boost.info, fData.boost.siege, \
+            fData.boost.skirmish, fData.boost.mining);
+}
+
+void FleetService::SetWingBoostData(uint32 wingID, WingData& wData, BoostData& bData, std::map<ShipSE*, BoostData>& updates)
+{
+    bool boost(false);
+    wData.boost = BoostData();
+    if ((wData.leader != nullptr) and (wData.leader->IsInSpace()))
+        if (m_wingSquads.count(wingID) <= wData.leader->GetChar()->GetSkillLevel(EvESkill::WingCommand)) {
+            if ((wData.booster != nullptr) and (wData.booster->IsInSpace()))
+                if (wData.leader->GetSystemID() == wData.booster->GetSystemID()) {
                     boost = true;
-                    wItr->second.boost.armored  = ((armored < bData.armored)   ? bData.armored   : armored);
-                    wItr->second.boost.info     = ((info < bData.info)         ? bData.info      : info);
-                    wItr->second.boost.mining   = ((mining < bData.mining)     ? bData.mining    : mining);
-                    wItr->second.boost.siege    = ((siege < bData.siege)       ? bData.siege     : siege);
-                    wItr->second.boost.skirmish = ((skirmish < bData.skirmish) ? bData.skirmish  : skirmish);
-                } else {
-                    wItr->second.boost = BoostData();
+                    wData.boost.armored  = std::max(wData.skills.armored,  bData.armored);
+                    wData.boost.info     = std::max(wData.skills.info,     bData.info);
+                    wData.boost.mining   = std::max(wData.skills.mining,   bData.mining);
+                    wData.boost.siege    = std::max(wData.skills.siege,    bData.siege);
+                    wData.boost.skirmish = std::max(wData.skills.skirmish, bData.skirmish);
+                    // squads in this wing get the better of wing and fleet boost
+                    bData = wData.boost;
                 }
             // this is for WC only.  will always get own skill, and here they get their wing boost, also
-            wItr->second.boost.leader   = leader;
-            wItr->second.leader->GetShipSE()->ApplyBoost(wItr->second.boost);
+            wData.boost.leader = wData.leader->GetChar()->GetSkillLevel(EvESkill::Leadership);
+            QueueBoost(wData.leader, wData.boost, updates);
         }
 
-    if (!boost)
-        wItr->second.boost = BoostData();
-
     _log( FLEET__TRACE, "BoostData - WB: %s, wingID: %u - leader: %i, armored: %i, info: %i, siege: %i, skirmish: %i, mining: %i", \
-            (boost ? "true" : "false"), wingID, wItr->second.boost.leader, wItr->second.boost.armored, wItr->second.boost.info, \
-            wItr->second.boost.siege, wItr->second.boost.skirmish, wItr->second.boost.mining);
+            (boost ? "true" : "false"), wingID, wData.boost.leader, wData.boost.armored, wData.boost.info, \
+            wData.boost.siege, wData.boost.skirmish, wData.boost.mining);
 }
 
-void FleetService::SetSquadBoostData(uint32 squadID, BoostData bData, bool& sboost)
+void FleetService::SetSquadBoostData(uint32 squadID, SquadData& sData, const BoostData& bData, std::map<ShipSE*, BoostData>& updates)
 {
-    int8 leader(0), armored(0), info(0), mining(0), siege(0), skirmish(0);
-    std::map<uint32, SquadData>::iterator sItr = m_squadDataMap.find(squadID);
-    if (sItr == m_squadDataMap.end())
-        return;
-    if ((sItr->second.leader != nullptr) and (sItr->second.leader->IsInSpace()))
-        if (sItr->second.members.size() <= (sItr->second.leader->GetChar()->GetSkillLevel(EvESkill::Leadership) * 2)) {
-            if ((sItr->second.booster != nullptr) and (sItr->second.booster->IsInSpace()))
-                if (sItr->second.leader->GetSystemID() == sItr->second.booster->GetSystemID()) {
-                    Character* pChar = sItr->second.booster->GetChar().get();
-                    if (pChar != nullptr) {
-                        leader = sItr->second.leader->GetChar()->GetSkillLevel(EvESkill::Leadership);    // this applies ONLY to self
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::ArmoredWarfare, 1))
-                            armored     = pChar->GetSkillLevel(EvESkill::ArmoredWarfare);
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::InformationWarfare, 1))
-                            info        = pChar->GetSkillLevel(EvESkill::InformationWarfare);
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::SiegeWarfare, 1))
-                            siege       = pChar->GetSkillLevel(EvESkill::SiegeWarfare);
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::SkirmishWarfare, 1))
-                            skirmish    = pChar->GetSkillLevel(EvESkill::SkirmishWarfare);
-                        if (pChar->HasSkillTrainedToLevel(EvESkill::MiningForeman, 1))
-                            mining      = pChar->GetSkillLevel(EvESkill::MiningForeman);
-                    }
-                    sItr->second.boost.armored  = ((armored < bData.armored)   ? bData.armored   : armored);
-                    sItr->second.boost.info     = ((info < bData.info)         ? bData.info      : info);
-                    sItr->second.boost.mining   = ((mining < bData.mining)     ? bData.mining    : mining);
-                    sItr->second.boost.siege    = ((siege < bData.siege)       ? bData.siege     : siege);
-                    sItr->second.boost.skirmish = ((skirmish < bData.skirmish) ? bData.skirmish  : skirmish);
-                } else {
-                    sItr->second.boost = BoostData();
+    bool sboost(false);
+    sData.boost = BoostData();
+    if ((sData.leader != nullptr) and (sData.leader->IsInSpace()))
+        if (sData.members.size() <= (sData.leader->GetChar()->GetSkillLevel(EvESkill::Leadership) * 2)) {
+            if ((sData.booster != nullptr) and (sData.booster->IsInSpace()))
+                if (sData.leader->GetSystemID() == sData.booster->GetSystemID()) {
+                    sData.boost.armored  = std::max(sData.skills.armored,  bData.armored);
+                    sData.boost.info     = std::max(sData.skills.info,     bData.info);
+                    sData.boost.mining   = std::max(sData.skills.mining,   bData.mining);
+                    sData.boost.siege    = std::max(sData.skills.siege,    bData.siege);
+                    sData.boost.skirmish = std::max(sData.skills.skirmish, bData.skirmish);
                 }
             // squad will always get this if SC is skilled
             sboost = true;
-            sItr->second.boost.leader = leader;
+            sData.boost.leader = sData.leader->GetChar()->GetSkillLevel(EvESkill::Leadership);
         }
 
-    if (!sboost)
-        sItr->second.boost = BoostData();
+    // members in SC's system get the squad boost.  anyone else has none
+    for (auto cur : sData.members) {   // SC is a member
+        if (sboost and (cur.second->GetSystemID() == sData.leader->GetSystemID())) {
+            QueueBoost(cur.second, sData.boost, updates);
+        } else {
+            QueueBoost(cur.second, BoostData(), updates);
+        }
+    }
 
     _log( FLEET__TRACE, "BoostData - SB: %s, squadID: %u - leader: %i, armored: %i, info: %i, siege: %i, skirmish: %i, mining: %i", \
-            (sboost ? "true" : "false"), squadID, sItr->second.boost.leader, sItr->second.boost.armored, sItr->second.boost.info, \
-            sItr->second.boost.siege, sItr->second.boost.skirmish, sItr->second.boost.mining);
+            (sboost ? "true" : "false"), squadID, sData.boost.leader, sData.boost.armored, sData.boost.info, \
+            sData.boost.siege, sData.boost.skirmish, sData.boost.mining);
+}
+
+void FleetService::GetBoosterSkills(Client* pBooster, BoostData& data)
+{
+    data = BoostData();
+    if (pBooster == nullptr)
+        return;
+    Character* pChar = pBooster->GetChar().get();
+    if (pChar == nullptr)
+        return;
+    if (pChar->HasSkillTrainedToLevel(EvESkill::ArmoredWarfare, 1))
+        data.armored    = pChar->GetSkillLevel(EvESkill::ArmoredWarfare);
+    if (pChar->HasSkillTrainedToLevel(EvESkill::InformationWarfare, 1))
+        data.info       = pChar->GetSkillLevel(EvESkill::InformationWarfare);
+    if (pChar->HasSkillTrainedToLevel(EvESkill::SiegeWarfare, 1))
+        data.siege      = pChar->GetSkillLevel(EvESkill::SiegeWarfare);
+    if (pChar->HasSkillTrainedToLevel(EvESkill::SkirmishWarfare, 1))
+        data.skirmish   = pChar->GetSkillLevel(EvESkill::SkirmishWarfare);
+    if (pChar->HasSkillTrainedToLevel(EvESkill::MiningForeman, 1))
+        data.mining     = pChar->GetSkillLevel(EvESkill::MiningForeman);
+}
+
+void FleetService::QueueBoost(Client* pClient, const BoostData& bData, std::map<ShipSE*, BoostData>& updates)
+{
+    if ((pClient == nullptr) or !pClient->IsInSpace())
+        return;
+    ShipSE* pShipSE = pClient->GetShipSE();
+    if (pShipSE == nullptr)
+        return;
+    // skip ships that already have this boost
+    if (pShipSE->IsBoosted() ? (pShipSE->GetBoost() == bData) : bData.IsEmpty()) {
+        updates.erase(pShipSE);
+        return;
+    }
+    updates[pShipSE] = bData;
+}
+
+void FleetService::GetBoostData(Client* pClient, BoostData& data)
+{
+    data = BoostData();
+    Character* pChar = pClient->GetChar().get();
+    if (pChar == nullptr)
+        return;
+
+    if (IsSquadID(pChar->squadID())) {
+        std::map<uint32, SquadData>::iterator sItr = m_squadDataMap.find(pChar->squadID());
+        if (sItr == m_squadDataMap.end())
+            return;
+        if ((sItr->second.leader != nullptr) and (sItr->second.leader->GetSystemID() == pClient->GetSystemID()))
+            data = sItr->second.boost;
+    } else if (IsWingID(pChar->wingID())) {
+        std::map<uint32, WingData>::iterator wItr = m_wingDataMap.find(pChar->wingID());
+        if (wItr != m_wingDataMap.end())
+            data = wItr->second.boost;
+    } else if (IsFleetID(pChar->fleetID())) {
+        std::map<uint32, FleetData>::iterator fItr = m_fleetDataMap.find(pChar->fleetID());
+        if (fItr != m_fleetDataMap.end())
+            data = fItr->second.boost;
+    }
 }
 
 void FleetService::UpdateOptions(uint32 fleetID, bool isFreeMove, bool isRegistered, bool isVoiceEnabled)
@@ -1190,37 +1194,50 @@ void FleetService::RemoveMember(Client* pClient)
 
     uint32 fleetID = pChar->fleetID();
 
+    bool fleet(false);
+    std::list<int32> wing, squad;
+
     // update fleet data
     if (fleetID) {
         std::map<uint32, FleetData>::iterator fItr = m_fleetDataMap.find(fleetID);
         if (fItr != m_fleetDataMap.end()) {
-            if (pChar->fleetBooster() == Fleet::Booster::Fleet)
+            if (fItr->second.booster == pClient) {
                 fItr->second.booster = nullptr;
-            if (pChar->fleetBooster() == Fleet::Role::FleetLeader)
+                fleet = true;
+            }
+            if (fItr->second.leader == pClient) {
                 fItr->second.leader = nullptr;
+                fleet = true;
+            }
         }
     }
 
     // update wing data
-    if (pChar->wingID()) {
+    if (pChar->wingID() > 0) {
         std::map<uint32, WingData>::iterator itr = m_wingDataMap.find(pChar->wingID());
         if (itr != m_wingDataMap.end()) {
-            if (pChar->fleetBooster() == Fleet::Booster::Wing)
+            if (itr->second.booster == pClient) {
                 itr->second.booster = nullptr;
-            if (pChar->fleetBooster() == Fleet::Role::WingLeader)
+                wing.emplace(wing.end(), pChar->wingID());
+            }
+            if (itr->second.leader == pClient) {
                 itr->second.leader = nullptr;
+                wing.emplace(wing.end(), pChar->wingID());
+            }
         }
     }
 
     // update squad data
-    if (pChar->squadID()) {
+    if (pChar->squadID() > 0) {
         std::map<uint32, SquadData>::iterator itr = m_squadDataMap.find(pChar->squadID());
         if (itr != m_squadDataMap.end()) {
             itr->second.members.erase(pChar->itemID());
-            if (pChar->fleetBooster() == Fleet::Booster::Squad)
+            if (itr->second.booster == pClient)
                 itr->second.booster = nullptr;
-            if (pChar->fleetBooster() == Fleet::Role::SquadLeader)
+            if (itr->second.leader == pClient)
                 itr->second.leader = nullptr;
+            // squad size is part of SC's limit, so always recheck this squad
+            squad.emplace(squad.end(), pChar->squadID());
         }
     }
 
@@ -1230,6 +1247,13 @@ void FleetService::RemoveMember(Client* pClient)
             m_fleetMembers.erase(itr);
             break;
         }
+    RemoveSystemMember(pClient);
+
+    // a leaving member keeps no fleet boost
+    if (pClient->IsInSpace() and (pClient->GetShipSE() != nullptr) and pClient->GetShipSE()->IsBoosted())
+        pClient->GetShipSE()->RemoveBoost();
+
+    UpdateBoost(fleetID, fleet, wing, squad);
 }
 
 PyRep* FleetService::GetWings(uint32 fleetID)
@@ -1344,80 +1368,60 @@ void FleetService::FleetBroadcast(Client* pFrom, uint32 itemID, int8 scope, int8
         return;
     }
 
-    uint16 scopeID(0);
-    std::vector<Client*> members;
-    switch (scope) {
-        case Fleet::BCast::Scope::System: {
-            scopeID = pFrom->GetSystemID();
-        } break;
-        case Fleet::BCast::Scope::Bubble: {
-            scopeID = pFrom->GetShipSE()->SysBubble()->GetID();
-        } break;
+    uint32 systemID(pFrom->GetSystemID());
+    uint16 bubbleID(0);
+    if (scope == Fleet::BCast::Scope::Bubble) {
+        if (!pFrom->IsInSpace() or (pFrom->GetShipSE() == nullptr) or (pFrom->GetShipSE()->SysBubble() == nullptr)) {
+            _log(FLEET__WARNING, "%s called FleetBroadcast with scope Bubble while not in space for fleet %u.", pFrom->GetName(), fleetID);
+            return;
+        }
+        bubbleID = pFrom->GetShipSE()->SysBubble()->GetID();
     }
+
+    std::vector<Client*> members;
     switch (group) {
         case Fleet::BCast::Group::All: {
-            auto range = m_fleetMembers.equal_range(fleetID);
-            for (auto fItr = range.first; fItr != range.second; ++fItr) {
-                if (scope == Fleet::BCast::Scope::Universe) {
-                    members.push_back(fItr->second);
-                } else if (scope == Fleet::BCast::Scope::System) {
-                    if (fItr->second->GetSystemID() == scopeID)
-                        members.push_back(fItr->second);
-                } else if (scope == Fleet::BCast::Scope::Bubble) {
-                    if (fItr->second->GetShipSE()->SysBubble()->GetID() == scopeID)
-                        members.push_back(fItr->second);
-                }
+            if (scope == Fleet::BCast::Scope::Universe) {
+                members = GetFleetClients(fleetID);
+            } else {
+                std::vector<Client*> system;
+                GetSystemMembers(fleetID, systemID, system);
+                for (auto cur : system)
+                    if (InScope(cur, scope, systemID, bubbleID))
+                        members.push_back(cur);
             }
         } break;
         // these 2 need to check fleet hierarchy for proper member list
         case Fleet::BCast::Group::Down: {
             if (wingID == -1) {
-                auto range = m_fleetMembers.equal_range(fleetID);
-                for (auto fItr = range.first; fItr != range.second; ++fItr) {
-                    if (scope == Fleet::BCast::Scope::Universe) {
-                        members.push_back(fItr->second);
-                    } else if (scope == Fleet::BCast::Scope::System) {
-                        if (fItr->second->GetSystemID() == scopeID)
-                            members.push_back(fItr->second);
-                    } else if (scope == Fleet::BCast::Scope::Bubble) {
-                        if (fItr->second->GetShipSE()->SysBubble()->GetID() == scopeID)
-                            members.push_back(fItr->second);
-                    }
+                if (scope == Fleet::BCast::Scope::Universe) {
+                    members = GetFleetClients(fleetID);
+                } else {
+                    std::vector<Client*> system;
+                    GetSystemMembers(fleetID, systemID, system);
+                    for (auto cur : system)
+                        if (InScope(cur, scope, systemID, bubbleID))
+                            members.push_back(cur);
                 }
             } else {
                 if (squadID == -1) {
-                    std::vector<uint32> squads;
-                    GetSquadIDs(wingID, squads);
                     std::map<uint32, SquadData>::iterator itr;
-                    for (auto cur : squads) {
-                        itr = m_squadDataMap.find(cur);
+                    auto range = m_wingSquads.equal_range(wingID);
+                    for (auto wItr = range.first; wItr != range.second; ++wItr) {
+                        itr = m_squadDataMap.find(wItr->second);
                         if (itr == m_squadDataMap.end())
                             continue;
                         for (auto member : itr->second.members)
-                            if (scope == Fleet::BCast::Scope::Universe) {
+                            if (InScope(member.second, scope, systemID, bubbleID))
                                 members.push_back(member.second);
-                            } else if (scope == Fleet::BCast::Scope::System) {
-                                if (member.second->GetSystemID() == scopeID)
-                                    members.push_back(member.second);
-                            } else if (scope == Fleet::BCast::Scope::Bubble) {
-                                if (member.second->GetShipSE()->SysBubble()->GetID() == scopeID)
-                                    members.push_back(member.second);
-                            }
                     }
                 } else {
                     std::map<uint32, SquadData>::iterator itr = m_squadDataMap.find(squadID);
                     if (itr == m_squadDataMap.end())
                         break;
                     for (auto member : itr->second.members)
-                        if (scope == Fleet::BCast::Scope::Universe) {
+                        if (InScope(member.second, scope, systemID, bubbleID))
                             members.push_back(member.second);
-                        } else if (scope == Fleet::BCast::Scope::System) {
-                            if (member.second->GetSystemID() == scopeID)
-                                members.push_back(member.second);
-                        } else if (scope == Fleet::BCast::Scope::Bubble) {
-                            if (member.second->GetShipSE()->SysBubble()->GetID() == scopeID)
-                                members.push_back(member.second);
-                        }
                 }
             }
         } break;
@@ -1443,7 +1447,7 @@ void FleetService::FleetBroadcast(Client* pFrom, uint32 itemID, int8 scope, int8
     //OnFleetBroadcast(name, group, charID, solarSystemID, itemID):
     //   ('HealCapacitor', 3, 95895066, 30003500, 1019274373727L, None)))
 
-    PyTuple* payload = new PyTuple(5);
+    PyTuple* payload = new PyTuple(6);
         payload->SetItem(0, new PyString(msg));
         payload->SetItem(1, new PyInt(group));
         payload->SetItem(2, new PyInt(pFrom->GetCharacterID()));
@@ -1504,50 +1508,91 @@ void FleetService::SendFleetUpdate(uint32 fleetID, const char* notifyType, PyTup
 
 void FleetService::GetFleetMembersOnGrid(Client* pClient, std::vector< uint32 >& data)
 {
+    if ((pClient->GetShipSE() == nullptr) or (pClient->GetShipSE()->SysBubble() == nullptr))
+        return;
     std::vector<Client*> members;
-    uint16 scopeID = pClient->GetShipSE()->SysBubble()->GetID();
-    auto range = m_fleetMembers.equal_range(pClient->GetFleetID());
-    for (auto fItr = range.first; fItr != range.second; ++fItr)
-        members.push_back(fItr->second);
-
-    for (auto cur : members) {
-        if (cur == nullptr)
-            continue;
-        if (cur->GetShipSE()->SysBubble()->GetID() == scopeID)
+    uint16 bubbleID = pClient->GetShipSE()->SysBubble()->GetID();
+    GetSystemMembers(pClient->GetFleetID(), pClient->GetSystemID(), members);
+    for (auto cur : members)
+        if (InScope(cur, Fleet::BCast::Scope::Bubble, pClient->GetSystemID(), bubbleID))
             data.push_back(cur->GetCharacterID());
-    }
 }
 
 void FleetService::GetFleetMembersInSystem(Client* pClient, std::vector< uint32 >& data)
 {
     std::vector<Client*> members;
-    uint16 scopeID = pClient->GetShipSE()->SystemMgr()->GetID();
-    auto range = m_fleetMembers.equal_range(pClient->GetFleetID());
-    for (auto fItr = range.first; fItr != range.second; ++fItr)
-        members.push_back(fItr->second);
+    GetSystemMembers(pClient->GetFleetID(), pClient->GetSystemID(), members);
+    for (auto cur : members)
+        data.push_back(cur->GetCharacterID());
+}
 
-    for (auto cur : members) {
-        if (cur == nullptr)
-            continue;
-        if (cur->GetShipSE()->SystemMgr()->GetID() == scopeID)
-            data.push_back(cur->GetCharacterID());
+void FleetService::GetFleetClientsInSystem(Client* pClient, std::vector< Client* >& data)
+{
+    GetSystemMembers(pClient->GetFleetID(), pClient->GetSystemID(), data);
+}
+
+void FleetService::GetSystemMembers(uint32 fleetID, uint32 systemID, std::vector< Client* >& data)
+{
+    std::map<uint32, std::multimap<uint32, Client*>>::iterator fItr = m_systemMembers.find(fleetID);
+    if (fItr == m_systemMembers.end())
+        return;
+    auto range = fItr->second.equal_range(systemID);
+    for (auto itr = range.first; itr != range.second; ++itr)
+        data.push_back(itr->second);
+}
+
+bool FleetService::InScope(Client* pClient, int8 scope, uint32 systemID, uint16 bubbleID)
+{
+    if (pClient == nullptr)
+        return false;
+    switch (scope) {
+        case Fleet::BCast::Scope::Universe:
+            return true;
+        case Fleet::BCast::Scope::System:
+            return (pClient->GetSystemID() == systemID);
+        case Fleet::BCast::Scope::Bubble: {
+            if (!pClient->IsInSpace() or (pClient->GetShipSE() == nullptr) or (pClient->GetShipSE()->SysBubble() == nullptr))
+                return false;
+            return ((pClient->GetSystemID() == systemID) and (pClient->GetShipSE()->SysBubble()->GetID() == bubbleID));
+        }
     }
+    return false;
 }
 
-void FleetService::GetFleetClientsInSystem(Client* pClient, std::vector< Client* >& data)
+void FleetService::AddSystemMember(uint32 fleetID, Client* pClient)
 {
-    std::vector<Client*> members;
-    uint32 scopeID = pClient->GetShipSE()->SystemMgr()->GetID();
-    auto range = m_fleetMembers.equal_range(pClient->GetFleetID());
-    for (auto fItr = range.first; fItr != range.second; ++fItr)
-        members.push_back(fItr->second);
+    RemoveSystemMember(pClient);
+    m_systemMembers[fleetID].emplace(pClient->GetSystemID(), pClient);
+    m_memberSystem[pClient] = std::make_pair(fleetID, pClient->GetSystemID());
+}
 
-    for (auto cur : members) {
-        if (cur == nullptr)
-            continue;
-        if (cur->GetShipSE()->SystemMgr()->GetID() == scopeID)
-            data.push_back(cur);
+void FleetService::RemoveSystemMember(Client* pClient)
+{
+    std::map<Client*, std::pair<uint32, uint32>>::iterator itr = m_memberSystem.find(pClient);
+    if (itr == m_memberSystem.end())
+        return;
+    std::map<uint32, std::multimap<uint32, Client*>>::iterator fItr = m_systemMembers.find(itr->second.first);
+    if (fItr != m_systemMembers.end()) {
+        auto range = fItr->second.equal_range(itr->second.second);
+        for (auto sItr = range.first; sItr != range.second; ++sItr)
+            if (sItr->second == pClient) {
+                fItr->second.erase(sItr);
+                break;
+            }
+        if (fItr->second.empty())
+            m_systemMembers.erase(fItr);
     }
+    m_memberSystem.erase(itr);
+}
+
+void FleetService::UpdateMemberSystem(Client* pClient)
+{
+    std::map<Client*, std::pair<uint32, uint32>>::iterator itr = m_memberSystem.find(pClient);
+    if (itr == m_memberSystem.end())
+        return;
+    if (itr->second.second == pClient->GetSystemID())
+        return;
+    AddSystemMember(itr->second.first, pClient);
 }
 
 std::vector<Client *> FleetService::GetFleetClients(uint32 fleetID) {
@@ -59,7 +59,10 @@ public:
     void RenameWing(uint32 wingID, std::string name);
     void RenameSquad(uint32 squadID, std::string name);
 
+    // recomputes boosts below the changed fleet, wings and squads, and updates ships whose boost changed
     void UpdateBoost(uint32 fleetID, bool fleet, std::list< int32 >& wing, std::list< int32 >& squad);
+    // cached boost for this member's position in the fleet
+    void GetBoostData(Client* pClient, BoostData& data);
     void UpdateOptions(uint32 fleetID, bool isFreeMove, bool isRegistered, bool isVoiceEnabled);
 
     bool AddMember(Client* pClient, uint32 fleetID, int32 wingID, int32 squadID, int8 job, int8 role, int8 booster);
@@ -112,14 +115,28 @@ public:
     void GetFleetClientsInSystem(Client* pClient, std::vector<Client*>& data);
     std::vector<Client *> GetFleetClients(uint32 fleetID);
 
+    // called on location change to keep the per-system member index current
+    void UpdateMemberSystem(Client* pClient);
+
 protected:
     void RemoveMember(Client* pClient);
 
     void IncFleetSquads(uint32 fleetID, uint32 wingID);
     void DecFleetSquads(uint32 fleetID, uint32 wingID);
 
-    void SetWingBoostData(uint32 wingID, BoostData& bData);
-    void SetSquadBoostData(uint32 squadID, BoostData bData, bool& sboost);
+    // these set the node's cached boost and queue changed ships.  bData is the boost passed down from above,
+    //  and Fleet/Wing set it to the boost passed down to the next level
+    void SetFleetBoostData(uint32 fleetID, FleetData& fData, BoostData& bData, std::map<ShipSE*, BoostData>& updates);
+    void SetWingBoostData(uint32 wingID, WingData& wData, BoostData& bData, std::map<ShipSE*, BoostData>& updates);
+    void SetSquadBoostData(uint32 squadID, SquadData& sData, const BoostData& bData, std::map<ShipSE*, BoostData>& updates);
+    void UpdateWingBoost(uint32 wingID, BoostData bData, std::map<ShipSE*, BoostData>& updates);
+    void GetBoosterSkills(Client* pBooster, BoostData& data);
+    void QueueBoost(Client* pClient, const BoostData& bData, std::map<ShipSE*, BoostData>& updates);
+
+    void AddSystemMember(uint32 fleetID, Client* pClient);
+    void RemoveSystemMember(Client* pClient);
+    void GetSystemMembers(uint32 fleetID, uint32 systemID, std::vector<Client*>& data);
+    bool InScope(Client* pClient, int8 scope, uint32 systemID, uint16 bubbleID);
 
     uint32 m_fleetID;
     uint32 m_wingID;
@@ -141,6 +158,9 @@ private:
     std::multimap<uint32, Client*>      m_fleetMembers;     // fleetID/Client*
     std::multimap<uint32, uint32>       m_fleetWings;       // fleetID/wingIDs
     std::multimap<uint32, uint32>       m_wingSquads;       // wingID/squadIDs
+
+    std::map<uint32, std::multimap<uint32, Client*>>    m_systemMembers;    // fleetID/(systemID/Client*)
+    std::map<Client*, std::pair<uint32, uint32>>        m_memberSystem;     // Client*/(fleetID, systemID) as indexed
 };
 
 //Singleton
@@ -25,6 +25,13 @@
 
 /** @todo  boost is the only system in this code that does NOT leak */
 
+#include <sys/stat.h>
+
+#ifdef HAVE_JPEG
+#  include <csetjmp>
+#  include <jpeglib.h>
+#endif
+
 #include "imageserver/ImageServer.h"
 #include "imageserver/ImageServerListener.h"
 
@@ -39,7 +46,114 @@ const char *const ImageServer::Categories[] = {
 
 const uint32 ImageServer::CategoryCount = 5;
 
+// portrait sizes made from the 512px image
+static const uint32 PortraitSizes[] = { 256, 128, 64, 40, 32 };
+
+#ifdef HAVE_JPEG
+namespace {
+    // libjpeg's default error handler exits the process
+    struct JpegError {
+        jpeg_error_mgr mgr;
+        jmp_buf jump;
+    };
+
+    void JpegErrorExit(j_common_ptr cinfo)
+    {
+        char buf[JMSG_LENGTH_MAX];
+        (*cinfo->err->format_message)(cinfo, buf);
+        sLog.Error("      ImageServer", "JPEG error: %s", buf);
+        longjmp(((JpegError*)cinfo->err)->jump, 1);
+    }
+
+    bool ReadJpeg(FILE* fp, std::vector<uint8>& pixels, uint32& width, uint32& height)
+    {
+        jpeg_decompress_struct cinfo;
+        JpegError err;
+        cinfo.err = jpeg_std_error(&err.mgr);
+        err.mgr.error_exit = JpegErrorExit;
+        if (setjmp(err.jump)) {
+            jpeg_destroy_decompress(&cinfo);
+            return false;
+        }
+
+        jpeg_create_decompress(&cinfo);
+        jpeg_stdio_src(&cinfo, fp);
+        jpeg_read_header(&cinfo, TRUE);
+        cinfo.out_color_space = JCS_RGB;
+        jpeg_start_decompress(&cinfo);
+        width = cinfo.output_width;
+        height = cinfo.output_height;
+        pixels.resize(width * height * 3);
+        JSAMPROW row(nullptr);
+        while (cinfo.output_scanline < height) {
+            row = &pixels[cinfo.output_scanline * width * 3];
+            jpeg_read_scanlines(&cinfo, &row, 1);
+        }
+        jpeg_finish_decompress(&cinfo);
+        jpeg_destroy_decompress(&cinfo);
+        return true;
+    }
+
+    bool WriteJpeg(FILE* fp, std::vector<uint8>& pixels, uint32 size)
+    {
+        jpeg_compress_struct cinfo;
+        JpegError err;
+        cinfo.err = jpeg_std_error(&err.mgr);
+        err.mgr.error_exit = JpegErrorExit;
+        if (setjmp(err.jump)) {
+            jpeg_destroy_compress(&cinfo);
+            return false;
+        }
+
+        jpeg_create_compress(&cinfo);
+        jpeg_stdio_dest(&cinfo, fp);
+        cinfo.image_width = size;
+        cinfo.image_height = size;
+        cinfo.input_components = 3;
+        cinfo.in_color_space = JCS_RGB;
+        jpeg_set_defaults(&cinfo);
+        jpeg_set_quality(&cinfo, 90, TRUE);
+        jpeg_start_compress(&cinfo, TRUE);
+        JSAMPROW row(nullptr);
+        while (cinfo.next_scanline < size) {
+            row = &pixels[cinfo.next_scanline * size * 3];
+            jpeg_write_scanlines(&cinfo, &row, 1);
+        }
+        jpeg_finish_compress(&cinfo);
+        jpeg_destroy_compress(&cinfo);
+        return true;
+    }
+
+    // box filter of an RGB image down to size x size
+    void Shrink(std::vector<uint8>& src, uint32 width, uint32 height, std::vector<uint8>& dst, uint32 size)
+    {
+        dst.resize(size * size * 3);
+        for (uint32 y = 0; y < size; ++y) {
+            uint32 y0(y * height / size), y1(std::max((y + 1) * height / size, y0 + 1));
+            for (uint32 x = 0; x < size; ++x) {
+                uint32 x0(x * width / size), x1(std::max((x + 1) * width / size, x0 + 1));
+                uint32 r(0), g(0), b(0), count((y1 - y0) * (x1 - x0));
+                for (uint32 sy = y0; sy < y1; ++sy) {
+                    uint8* p(&src[((sy * width) + x0) * 3]);
+                    for (uint32 sx = x0; sx < x1; ++sx, p += 3) {
+                        r += p[0];
+                        g += p[1];
+                        b += p[2];
+                    }
+                }
+                uint8* d(&dst[((y * size) + x) * 3]);
+                d[0] = (r + count / 2) / count;
+                d[1] = (g + count / 2) / count;
+                d[2] = (b + count / 2) / count;
+            }
+        }
+    }
+}
+#endif
+
 ImageServer::ImageServer()
+: _cacheBytes(0),
+_cacheLimit(sConfig.net.imageCacheSize * 1024 * 1024)
 {
     std::stringstream urlBuilder;
     urlBuilder << "http://" << sConfig.net.imageServer << ":" << sConfig.net.imageServerPort << "/";
@@ -51,6 +165,7 @@ ImageServer::ImageServer()
 
     sLog.Cyan("      ImageServer", "Image Server URL: %s", _url.c_str());
     sLog.Cyan("      ImageServer", "Image Server path: %s", _basePath.c_str());
+    sLog.Cyan("      ImageServer", "Image Server cache: %uMb", sConfig.net.imageCacheSize);
 
     if (CreateDirectory( _basePath.c_str(), NULL ) == 0) {
         for (int i = 0; i < CategoryCount; i++) {
@@ -91,6 +206,10 @@ void ImageServer::ReportNewCharacter(uint32 creatorAccountID, uint32 characterID
     std::string dirName = "Character";
     std::string path(GetFilePath(dirName, characterID, 512));
     FILE * fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr) {
+        sLog.Error("      ImageServer"," Unable to open %s for characterID %u.", path.c_str(), characterID);
+        return;
+    }
 
     //stream.open(path, std::ios::binary | std::ios::trunc | std::ios::out);
     std::shared_ptr<std::vector<char> > data = _limboImages[creatorAccountID];
@@ -102,9 +221,12 @@ void ImageServer::ReportNewCharacter(uint32 creatorAccountID, uint32 characterID
     //stream.flush();
     //stream.close();
 
-    /** @todo  we will need to make size 64 and size 40 images, and possibably 128/256 of char portaits */
-    // github.com/nothings/stb/blob/master/stb_image_resize.h
-    // github.com/nothings/stb/blob/master/stb_image.h
+    // anything cached for this id is from an earlier portrait
+    CacheRemove(path);
+    for (auto cur : PortraitSizes)
+        CacheRemove(GetFilePath(dirName, characterID, cur));
+    if (!MakePortraitSizes(characterID))
+        sLog.Warning("      ImageServer", "Unable to make portrait sizes for characterID %u.  The 512px image will be sent for all sizes.", characterID);
 
     // and delete it from our limbo map
     _limboImages.erase(creatorAccountID);
@@ -112,49 +234,157 @@ void ImageServer::ReportNewCharacter(uint32 creatorAccountID, uint32 characterID
     sLog.Green("      ImageServer", "Received image from %u and saved as %s", creatorAccountID, path.c_str());
 }
 
-std::shared_ptr<std::vector<char> > ImageServer::GetImage(std::string& category, uint32 id, uint32 size)
+std::shared_ptr<const ImageServer::Image> ImageServer::GetImage(std::string& category, uint32 id, uint32 size)
 {
-    sLog.Cyan("      ImageServer"," GetImage() called. Cat: %s, id: %u, size:%u", category.c_str(), id, size);
-
     if (!ValidateCategory(category) || !ValidateSize(category, size))
-        return std::shared_ptr<std::vector<char> >();
+        return std::shared_ptr<const Image>();
 
-    //std::ifstream stream;
     std::string path(GetFilePath(category, id, size));
+    {
+        Lock lock(_cacheLock);
+        std::unordered_map<std::string, CacheEntry>::iterator itr = _cache.find(path);
+        if (itr != _cache.end()) {
+            _lru.splice(_lru.begin(), _lru, itr->second.lru);
+            return itr->second.image;
+        }
+    }
+
+    sLog.Cyan("      ImageServer"," GetImage() cache miss. Cat: %s, id: %u, size:%u", category.c_str(), id, size);
+
+    std::shared_ptr<const Image> image(LoadImage(category, path));
+    if (!image and (size != 512)) {
+        if ((category == "Character") and (size < 512)) {
+            // portrait saved before its sizes were made
+            Lock lock(_limboLock);
+            if (MakePortraitSizes(id))
+                image = LoadImage(category, path);
+        }
+        // otherwise we only have the 512px image
+        if (!image)
+            image = LoadImage(category, GetFilePath(category, id, 512));
+    }
+    if (image)
+        CacheAdd(path, image);
+
+    return image;
+}
+
+std::shared_ptr<const ImageServer::Image> ImageServer::LoadImage(std::string& category, const std::string& path)
+{
+    struct stat st;
+    if ((stat(path.c_str(), &st) != 0) or (st.st_size < 1))
+        return std::shared_ptr<const Image>();
+
+    FILE * fp = fopen(path.c_str(), "rb");
+    if (fp == nullptr)
+        return std::shared_ptr<const Image>();
+
+    std::shared_ptr<Image> image(new Image());
+    image->data = std::shared_ptr<std::vector<char> >(new std::vector<char>(st.st_size));
+    size_t length = fread(&((*image->data)[0]), 1, st.st_size, fp);
+    fclose(fp);
+    if (length != (size_t)st.st_size)
+        return std::shared_ptr<const Image>();
+
+    // mtime and length is enough to tell a changed file
+    char buf[64];
+    snprintf(buf, sizeof(buf), "\"%lx-%lx\"", (unsigned long)st.st_mtime, (unsigned long)length);
+    image->etag = buf;
+    time_t modified(st.st_mtime);
+    strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", gmtime(&modified));
+    image->lastModified = buf;
+
+    std::stringstream builder;
+    builder << "ETag: " << image->etag << "\r\nLast-Modified: " << image->lastModified << "\r\n\r\n";
+    image->notModified = "HTTP/1.0 304 Not Modified\r\n" + builder.str();
+    std::stringstream header;
+    header << "HTTP/1.0 200 OK\r\nContent-Type: image/" << (category == "Character" ? "jpeg" : "png");
+    header << "\r\nContent-Length: " << length << "\r\n" << builder.str();
+    image->header = header.str();
+
+    return image;
+}
+
+bool ImageServer::MakePortraitSizes(uint32 characterID)
+{
+#ifdef HAVE_JPEG
+    std::string category("Character");
+    std::string path(GetFilePath(category, characterID, 512));
     FILE * fp = fopen(path.c_str(), "rb");
-    if (fp == NULL)
-        return std::shared_ptr<std::vector<char> >();
-    fseek(fp, 0, SEEK_END);
-    size_t length = ftell(fp);
-    fseek(fp, 0, SEEK_SET);
+    if (fp == nullptr)
+        return false;
+
+    std::vector<uint8> pixels, shrunk;
+    uint32 width(0), height(0);
+    bool ok(ReadJpeg(fp, pixels, width, height));
+    fclose(fp);
+    if (!ok)
+        return false;
+
+    for (auto size : PortraitSizes) {
+        Shrink(pixels, width, height, shrunk, size);
+        // written aside and renamed, so a partly written file is never sent
+        std::string sizePath(GetFilePath(category, characterID, size));
+        std::string tmpPath(sizePath + ".tmp");
+        fp = fopen(tmpPath.c_str(), "wb");
+        if (fp == nullptr)
+            return false;
+        ok = WriteJpeg(fp, shrunk, size);
+        fclose(fp);
+        if (!ok or (rename(tmpPath.c_str(), sizePath.c_str()) != 0)) {
+            remove(tmpPath.c_str());
+            return false;
+        }
+    }
 
-    //stream.open(path, std::ios::binary | std::ios::in);
-    // not found or other error
-    //if (stream.fail())
-    //    return std::shared_ptr<std::vector<char> >();
+    sLog.Green("      ImageServer", "Made portrait sizes for characterID %u from %ux%u image.", characterID, width, height);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ImageServer::CacheAdd(const std::string& key, std::shared_ptr<const Image> image)
+{
+    if (image->data->size() > _cacheLimit)
+        return;
 
-    // get length
-    //stream.seekg(0, std::ios::end);
-    //int length = stream.tellg();
-    //stream.seekg(0, std::ios::beg);
+    Lock lock(_cacheLock);
+    if (_cache.find(key) != _cache.end())
+        return;
 
-    std::shared_ptr<std::vector<char> > ret = std::shared_ptr<std::vector<char> >(new std::vector<char>());
-    ret->resize(length);
+    _lru.push_front(key);
+    CacheEntry& entry = _cache[key];
+    entry.image = image;
+    entry.lru = _lru.begin();
+    _cacheBytes += image->data->size();
+
+    // drop least recently used
+    std::unordered_map<std::string, CacheEntry>::iterator itr;
+    while (_cacheBytes > _cacheLimit) {
+        itr = _cache.find(_lru.back());
+        _cacheBytes -= itr->second.image->data->size();
+        _cache.erase(itr);
+        _lru.pop_back();
+    }
+}
 
-    // HACK
-    //stream.read(&((*ret)[0]), length);
-    fread(&((*ret)[0]), 1, length, fp);
+void ImageServer::CacheRemove(const std::string& key)
+{
+    Lock lock(_cacheLock);
+    std::unordered_map<std::string, CacheEntry>::iterator itr = _cache.find(key);
+    if (itr == _cache.end())
+        return;
 
-    return ret;
+    _cacheBytes -= itr->second.image->data->size();
+    _lru.erase(itr->second.lru);
+    _cache.erase(itr);
 }
 
 std::string ImageServer::GetFilePath(std::string& category, uint32 id, uint32 size)
 {
     std::string extension = category == "Character" ? "jpg" : "png";
 
-    // HACK: We don't have any other
-    size = 512;
-
     std::stringstream builder;
     builder << _basePath << category << "/" << id << "_" << size << "." << extension;
     return builder.str();
@@ -26,6 +26,7 @@
 #ifndef __IMAGESERVER__H__INCL__
 #define __IMAGESERVER__H__INCL__
 
+#include <list>
 #include <memory>
 
 #include "eve-common.h"
@@ -42,6 +43,11 @@ class ImageServerListener;
  * A very limited HTTP server that can efficiently deliver character and other images to clients
  * Uses asio for efficient asynchronous network communication
  *
+ * Images are kept in a bounded LRU cache, keyed by file (category, id and size), along with
+ * their response headers, so repeat requests are served from shared buffers without touching the disk.
+ * Character portraits are saved at 512px; the smaller sizes are made from it when it is saved,
+ * or on the first request for a size that is missing.
+ *
  * @author caytchen
  * @date April 2011
  */
@@ -57,8 +63,17 @@ public:
     void ReportNewImage(uint32 accountID, std::shared_ptr<std::vector<char> > imageData);
     void ReportNewCharacter(uint32 creatorAccountID, uint32 characterID);
 
+    /* an encoded image and its canned responses.  shared by the cache and every connection sending it */
+    struct Image {
+        std::shared_ptr<std::vector<char> > data;
+        std::string header;         // 200 response header, including ETag and Last-Modified
+        std::string notModified;    // 304 response
+        std::string etag;
+        std::string lastModified;
+    };
+
     std::string GetFilePath(std::string& category, uint32 id, uint32 size);
-    std::shared_ptr<std::vector<char> > GetImage(std::string& category, uint32 id, uint32 size);
+    std::shared_ptr<const Image> GetImage(std::string& category, uint32 id, uint32 size);
 
     static const char *const Categories[];
     static const uint32 CategoryCount;
@@ -72,6 +87,13 @@ private:
     bool ValidateCategory(std::string& category);
     bool ValidateSize(std::string& category, uint32 size);
 
+    // reads an image file and builds its responses.  returns null if the file can't be read
+    std::shared_ptr<const Image> LoadImage(std::string& category, const std::string& path);
+    // writes the smaller portrait files from the 512px one.  returns false if they can't be made
+    bool MakePortraitSizes(uint32 characterID);
+    void CacheAdd(const std::string& key, std::shared_ptr<const Image> image);
+    void CacheRemove(const std::string& key);
+
     std::unordered_map<uint32 /*accountID*/, std::shared_ptr<std::vector<char> > /*imageData*/> _limboImages;
     std::shared_ptr<boost::asio::detail::thread> _ioThread;
     std::shared_ptr<boost::asio::io_context> _io;
@@ -80,6 +102,18 @@ private:
     std::string _basePath;
     boost::asio::detail::mutex _limboLock;
 
+    // image cache.  keyed by file path, most recently used at the front of _lru
+    typedef std::list<std::string> LRUList;
+    struct CacheEntry {
+        std::shared_ptr<const Image> image;
+        LRUList::iterator lru;
+    };
+    std::unordered_map<std::string, CacheEntry> _cache;
+    LRUList _lru;
+    size_t _cacheBytes;
+    size_t _cacheLimit;
+    boost::asio::detail::mutex _cacheLock;
+
     class Lock
     {
     public:
@@ -25,7 +25,6 @@
 
 #include "imageserver/ImageServerConnection.h"
 
-boost::asio::const_buffers_1 ImageServerConnection::_responseOK = boost::asio::buffer("HTTP/1.0 200 OK\r\nContent-Type: image/jpeg\r\n\r\n", 45);
 boost::asio::const_buffers_1 ImageServerConnection::_responseNotFound = boost::asio::buffer("HTTP/1.0 404 Not Found\r\n\r\n", 26);
 boost::asio::const_buffers_1 ImageServerConnection::_responseRedirectBegin = boost::asio::buffer("HTTP/1.0 301 Moved Permanently\r\nLocation: ", 42);
 boost::asio::const_buffers_1 ImageServerConnection::_responseRedirectEnd = boost::asio::buffer("\r\n\r\n", 4);
@@ -100,8 +99,8 @@ void ImageServerConnection::ProcessHeaders()
     _id = atoi(idStr.c_str());
     _size = atoi(sizeStr.c_str());
 
-    _imageData = sImageServer.GetImage(_category, _id, _size);
-    if (!_imageData) {
+    _image = sImageServer.GetImage(_category, _id, _size);
+    if (!_image) {
         if (IsPlayerItem(_id)) {
             sLog.Error("     Image Server","Image for itemID %u not found.", _id);
             NotFound();
@@ -115,13 +114,46 @@ void ImageServerConnection::ProcessHeaders()
         return;
     }
 
-    // first we have to send the responseOK, then our actual result
-    boost::asio::async_write(_socket, _responseOK, boost::asio::transfer_all(), std::bind(&ImageServerConnection::SendImage, shared_from_this()));
+    if (NotModified(stream)) {
+        boost::asio::async_write(_socket, boost::asio::buffer(_image->notModified), boost::asio::transfer_all(), std::bind(&ImageServerConnection::Close, shared_from_this()));
+        return;
+    }
+
+    // header and image straight from the cached buffers, in one write
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.push_back(boost::asio::buffer(_image->header));
+    buffers.push_back(boost::asio::buffer(*_image->data));
+    boost::asio::async_write(_socket, buffers, boost::asio::transfer_all(), std::bind(&ImageServerConnection::Close, shared_from_this()));
 }
 
-void ImageServerConnection::SendImage()
+bool ImageServerConnection::NotModified(std::istream& stream)
 {
-    boost::asio::async_write(_socket, boost::asio::buffer(*_imageData, _imageData->size()), boost::asio::transfer_all(), std::bind(&ImageServerConnection::Close, shared_from_this()));
+    std::string line, name, ifNoneMatch, ifModifiedSince;
+    // skip the '\n' of the request line, then read each header up to the blank line
+    stream.ignore(1);
+    while (std::getline(stream, line, '\r')) {
+        stream.ignore(1);
+        if (line.empty())
+            break;
+        size_t colon = line.find(':');
+        if (colon == std::string::npos)
+            continue;
+        name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        size_t start = line.find_first_not_of(' ', colon + 1);
+        if (start == std::string::npos)
+            continue;
+        if (name == "if-none-match") {
+            ifNoneMatch = line.substr(start);
+        } else if (name == "if-modified-since") {
+            ifModifiedSince = line.substr(start);
+        }
+    }
+
+    // If-None-Match takes precedence.  the date is only compared to what we sent, as clients send it back unchanged
+    if (!ifNoneMatch.empty())
+        return ((ifNoneMatch == "*") or (ifNoneMatch.find(_image->etag) != std::string::npos));
+    return (ifModifiedSince == _image->lastModified);
 }
 
 void ImageServerConnection::NotFound()
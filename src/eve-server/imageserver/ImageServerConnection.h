@@ -48,7 +48,8 @@ public:
 private:
     ImageServerConnection(boost::asio::io_context& io);
     void ProcessHeaders();
-    void SendImage();
+    // true if the client's copy (If-None-Match/If-Modified-Since) is current
+    bool NotModified(std::istream& stream);
     void NotFound();
     void Close();
     void Redirect();
@@ -65,9 +66,8 @@ private:
 
     boost::asio::streambuf _buffer;
     boost::asio::ip::tcp::socket _socket;
-    std::shared_ptr<std::vector<char> > _imageData;
+    std::shared_ptr<const ImageServer::Image> _image;
 
-    static boost::asio::const_buffers_1 _responseOK;
     static boost::asio::const_buffers_1 _responseNotFound;
     static boost::asio::const_buffers_1 _responseRedirectBegin;
     static boost::asio::const_buffers_1 _responseRedirectEnd;
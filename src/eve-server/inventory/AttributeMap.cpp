@@ -30,6 +30,7 @@
 #include "Client.h"
 #include "EntityList.h"
 #include "StaticDataMgr.h"
+#include "effects/EffectsGraph.h"
 #include "inventory/AttributeMap.h"
 #include "inventory/InventoryItem.h"
 
@@ -46,7 +47,8 @@
 
 
 AttributeMap::AttributeMap( InventoryItem& item)
-: mItem(item)
+: mItem(item),
+m_pFxGraph(nullptr)
 {
     mAttributes.clear();
 }
@@ -223,6 +225,8 @@ void AttributeMap::SetAttribute(uint16 attrID, EvilNumber& num, bool notify/*tru
         //ResetAttribute(attrID, notify);
         return;
     }
+    if (m_pFxGraph != nullptr)
+        m_pFxGraph->SetBase(&mItem, attrID, num);
     AttrMapItr itr = mAttributes.find(attrID);
     if (itr == mAttributes.end()) {
         mAttributes.emplace(attrID, num);
@@ -303,6 +307,8 @@ void AttributeMap::MultiplyAttribute(uint16 attrID, EvilNumber& num, bool notify
 
     EvilNumber oldValue(itr->second);
     itr->second *= num;
+    if (m_pFxGraph != nullptr)
+        m_pFxGraph->SetBase(&mItem, attrID, itr->second);
 
     if (notify)
         Change(attrID, oldValue, itr->second);
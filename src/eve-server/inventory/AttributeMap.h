@@ -36,6 +36,7 @@ typedef std::map<uint16, EvilNumber>    AttrMap;
 typedef AttrMap::iterator               AttrMapItr;
 typedef AttrMap::const_iterator         AttrMapConstItr;
 
+class FxGraph;
 class PyTuple;
 
 class AttributeMap
@@ -67,6 +68,9 @@ public:
     void ResetAttribute(uint16 attrID, bool notify=false);
     void CopyAttributes(std::map<uint16, EvilNumber>& attrMap);
 
+    // graph tracking modifiers on this item.  writes are reported to it, so they become the unmodified value
+    void SetFxGraph(FxGraph* pGraph)                    { m_pFxGraph = pGraph; }
+
     /**
      * @brief return the begin iterator of the AttributeMap
      * @return the begin iterator of the AttributeMap
@@ -120,6 +124,7 @@ protected:
 
 private:
     InventoryDB m_db;
+    FxGraph* m_pFxGraph;
 
 };
 
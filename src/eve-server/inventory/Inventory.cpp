@@ -301,13 +301,13 @@ void Inventory::List(CRowSet* into, EVEItemFlags flag, uint32 ownerID) const {
     PyPackedRow* row(nullptr);
     // office hangars list ALL items.  client separates by division flag
     if (IsOfficeID(m_myID) or IsCharacterID(m_myID)) {
-        for (auto cur : mContents) {
+        for (auto& cur : mContents) {
             row = into->NewRow();
             cur.second->GetItemRow(row);
         }
     } else if (m_self->categoryID() == EVEDB::invCategories::Ship) {
         bool space = sDataMgr.IsSolarSystem(m_self->locationID());
-        for (auto cur : mContents) {
+        for (auto& cur : mContents) {
             // this also fills module/charges in fit window when docked.
             //  charges not sent like this in space (uses subLocation sent via shipInfo())
             if (space and IsFittingSlot(cur.second->flag()))
@@ -317,7 +317,7 @@ void Inventory::List(CRowSet* into, EVEItemFlags flag, uint32 ownerID) const {
             cur.second->GetItemRow(row);
         }
     } else {
-        for (auto cur : mContents) {
+        for (auto& cur : mContents) {
             if (((ownerID == 0)        or (cur.second->ownerID() == ownerID))
             and ((flag == flagNone) or (cur.second->flag() == flag))) {
                 row = into->NewRow();
@@ -328,13 +328,13 @@ void Inventory::List(CRowSet* into, EVEItemFlags flag, uint32 ownerID) const {
 }
 
 void Inventory::GetCargoList(std::multimap< uint8, InventoryItemRef >& cargoMap) {
-    for (auto cur : mContents)
+    for (auto& cur : mContents)
         cargoMap.emplace(cur.second->flag(), cur.second);
 }
 
 float Inventory::GetCorpHangerCapyUsed() const {
     float totalVolume(0.0f);
-    for (auto cur : mContents)
+    for (auto& cur : mContents)
         if (IsHangarFlag(cur.second->flag()))
             totalVolume += cur.second->quantity() * cur.second->GetAttribute(AttrVolume).get_float();
     return totalVolume;
@@ -343,7 +343,7 @@ float Inventory::GetCorpHangerCapyUsed() const {
 void Inventory::GetInventoryVec(std::vector<InventoryItemRef> &itemVec) {
     std::vector<InventoryItemRef> itemVecTmp;
     itemVecTmp.clear();
-    for (auto cur : mContents)
+    for (auto& cur : mContents)
         itemVecTmp.push_back(cur.second);
     /* sorting method to put modules first, charges second, and cargo last
      *  this is needed to correctly fit modules BEFORE trying to load charges
@@ -426,13 +426,13 @@ void Inventory::GetInvForOwner(uint32 ownerID, std::vector< InventoryItemRef >&
         _log(INV__ERROR, "GetInvForOwner called on non-station item %s(%u)", m_self->name(), m_myID);
         EvE::traceStack();
     }
-    for (auto cur : mContents)
+    for (auto& cur : mContents)
         if (cur.second->ownerID() == ownerID)
             items.push_back(cur.second);
 }
 
 InventoryItemRef Inventory::FindFirstByFlag(EVEItemFlags flag) const {
-    for (auto cur : mContents)
+    for (auto& cur : mContents)
         if (cur.second->flag() == flag)
             return cur.second;
 
@@ -449,7 +449,7 @@ InventoryItemRef Inventory::GetByTypeFlag(uint16 typeID, EVEItemFlags flag) cons
 }
 
 void Inventory::GetInventoryMap( std::map< uint32, InventoryItemRef >& invMap ) {
-    for (auto cur : mContents)
+    for (auto& cur : mContents)
         invMap.emplace(cur.first, cur.second);
 }
 
@@ -473,13 +473,10 @@ bool Inventory::GetTypesByFlag(EVEItemFlags flag, std::map< uint16, InventoryIte
 
 InventoryItemRef Inventory::GetItemByTypeFlag(uint16 typeID, EVEItemFlags flag)
 {
-    std::vector<InventoryItemRef> items;
-    if (GetItemsByFlag(flag, items) < 1)
-        return InventoryItemRef(nullptr);
-
-    for (auto cur : items)
-        if (cur->typeID() == typeID )
-            return cur;
+    auto range = m_contentsByFlag.equal_range(flag);
+    for ( auto itr = range.first; itr != range.second; ++itr )
+        if (itr->second->typeID() == typeID )
+            return itr->second;
 
     return InventoryItemRef(nullptr);
 }
@@ -501,7 +498,7 @@ uint32 Inventory::GetItemsByFlagRange(EVEItemFlags lowflag, EVEItemFlags highfla
 {
     // i dont yet see a better way to do this one...
     uint32 count = 0;
-    for (auto cur : mContents)
+    for (auto& cur : mContents)
         if (cur.second->flag() >= lowflag && cur.second->flag() <= highflag) {
             items.push_back(cur.second);
             ++count;
@@ -513,7 +510,7 @@ uint32 Inventory::GetItemsByFlagSet(std::set<EVEItemFlags> flags, std::vector<In
 {
     // i dont yet see a better way to do this one...
     uint32 count = 0;
-    for (auto cur : mContents)
+    for (auto& cur : mContents)
         if (flags.find(cur.second->flag()) != flags.end()) {
             items.push_back(cur.second);
             ++count;
@@ -524,7 +521,7 @@ uint32 Inventory::GetItemsByFlagSet(std::set<EVEItemFlags> flags, std::vector<In
 bool Inventory::ContainsTypeQty(uint16 typeID, uint32 qty/*0*/) const
 {
     uint32 count(0);
-    for (auto cur : mContents) {
+    for (auto& cur : mContents) {
         if (cur.second->typeID() == typeID ) {
             if (cur.second->quantity() >= qty) {
                 return true;
@@ -540,16 +537,13 @@ bool Inventory::ContainsTypeQty(uint16 typeID, uint32 qty/*0*/) const
 bool Inventory::ContainsTypeQtyByFlag(uint16 typeID, EVEItemFlags flag, uint32 qty) const
 {
     uint32 count(0);
-    std::vector<InventoryItemRef> itemVec;
-    if (GetItemsByFlag(flag, itemVec) < 1)
-        return false;
-
-    for (auto cur : itemVec) {
-        if (cur->typeID() == typeID) {
-            if (cur->quantity() >= qty) {
+    auto range = m_contentsByFlag.equal_range(flag);
+    for ( auto itr = range.first; itr != range.second; ++itr ) {
+        if (itr->second->typeID() == typeID) {
+            if (itr->second->quantity() >= qty) {
                 return true;
             } else {
-                count += cur->quantity();
+                count += itr->second->quantity();
             }
         }
     }
@@ -567,13 +561,10 @@ bool Inventory::ContainsTypeQtyByFlag(uint16 typeID, EVEItemFlags flag, uint32 q
  */
 int Inventory::ContainsTypeStackQtyByFlag(uint16 typeID, EVEItemFlags flag, uint32 qty) const
 {
-    std::vector<InventoryItemRef> itemVec;
-    if (GetItemsByFlag(flag, itemVec) < 1)
-        return 0;
-
-    for (auto cur : itemVec) {
-        if (cur->typeID() == typeID && cur->quantity() >= qty) {
-            return cur->itemID();
+    auto range = m_contentsByFlag.equal_range(flag);
+    for ( auto itr = range.first; itr != range.second; ++itr ) {
+        if (itr->second->typeID() == typeID && itr->second->quantity() >= qty) {
+            return itr->second->itemID();
         }
     }
 
@@ -582,12 +573,9 @@ int Inventory::ContainsTypeStackQtyByFlag(uint16 typeID, EVEItemFlags flag, uint
 
 bool Inventory::ContainsTypeByFlag(uint16 typeID, EVEItemFlags flag) const
 {
-    std::vector<InventoryItemRef> itemVec;
-    if (GetItemsByFlag(flag, itemVec) < 1)
-        return false;
-
-    for (auto cur : itemVec)
-        if (cur->typeID() == typeID)
+    auto range = m_contentsByFlag.equal_range(flag);
+    for ( auto itr = range.first; itr != range.second; ++itr )
+        if (itr->second->typeID() == typeID)
             return true;
 
     return false;
@@ -632,7 +620,7 @@ float Inventory::GetStoredVolume(EVEItemFlags flag, bool combined/*true*/) const
 {
     float totalVolume(0.0f);
     if (IsHangarFlag(flag) and combined) {
-        for (auto cur : mContents)
+        for (auto& cur : mContents)
             if (IsHangarFlag(cur.second->flag()))
                 totalVolume += cur.second->quantity() * cur.second->GetAttribute(AttrVolume).get_float();
     } else {
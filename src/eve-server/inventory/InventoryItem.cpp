@@ -1470,6 +1470,7 @@ bool InventoryItem::SkillCheck(InventoryItemRef refItem)
 // new effects system  -allan 4Feb17
 void InventoryItem::AddModifier(fxData &data)
 {
+    data.remove = false;
     ModifierContainer* modifierContainer = static_cast<ModifierContainer*>(m_modifierContainer);
     modifierContainer->modifiers.emplace(data.math, data);
     if (is_log_enabled(EFFECTS__TRACE))
@@ -1482,17 +1483,8 @@ void InventoryItem::AddModifier(fxData &data)
 
 void InventoryItem::RemoveModifier(fxData &data)
 {
-    switch (data.math) {
-        case FX::Math::PreMul:         data.math = FX::Math::PreDiv;          break;
-        case FX::Math::PreDiv:         data.math = FX::Math::PreMul;          break;
-        case FX::Math::ModAdd:         data.math = FX::Math::ModSub;          break;
-        case FX::Math::ModSub:         data.math = FX::Math::ModAdd;          break;
-        case FX::Math::PostMul:        data.math = FX::Math::PostDiv;         break;
-        case FX::Math::PostDiv:        data.math = FX::Math::PostMul;         break;
-        case FX::Math::PostPercent:    data.math = FX::Math::RevPostPercent;  break;
-        case FX::Math::PreAssignment:  data.math = FX::Math::PostAssignment;  break;
-        case FX::Math::PostAssignment: data.math = FX::Math::PreAssignment;   break;
-    }
+    data.math = sFxProc.GetInverseMath(data.math);
+    data.remove = true;
 
     ModifierContainer* modifierContainer = static_cast<ModifierContainer*>(m_modifierContainer);
     modifierContainer->modifiers.emplace(data.math, data);
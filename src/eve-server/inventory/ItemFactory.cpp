@@ -96,7 +96,7 @@ void ItemFactory::SaveItems() {
     double startTime = GetTimeMSeconds();
     std::vector<Inv::SaveData> items;
     items.clear();
-    for (auto cur : m_items) {
+    for (auto& cur : m_items) {
         if (IsPlayerItem(cur.first)) { // this is a hack for now.  will eventually move to static/dynamic item maps
             cur.second->SaveAttributes();
             Inv::SaveData data = Inv::SaveData();
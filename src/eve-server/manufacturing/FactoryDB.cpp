@@ -24,6 +24,7 @@
 #include "EVEServerConfig.h"
 #include "character/Character.h"
 #include "manufacturing/FactoryDB.h"
+#include "standing/StandingMgr.h"
 
 /** @todo  is there is a better way to do this??  */
 bool FactoryDB::IsProducableBy(const uint32 assemblyLineID, const ItemType *pType) {
@@ -253,6 +254,81 @@ PyRep *FactoryDB::GetJobs2(const int32 ownerID, const bool completed)
     return DBResultToRowset(res);
 }
 
+bool FactoryDB::LoadJobs(std::vector<EvERam::JobData>& into, const uint32 jobID/*0*/)
+{
+    // same data as GetJobs2(), for running jobs
+    std::string filter;
+    if (jobID > 0) {
+        filter = " AND job.jobID = ";
+        filter += std::to_string(jobID);
+    }
+
+    DBQueryResult res;
+    if (!sDatabase.RunQuery(res,
+        "SELECT"
+        " job.jobID, job.assemblyLineID, assemblyLine.containerID, job.installedItemID, installedItem.typeID,"
+        " installedItem.ownerID, blueprint.pLevel, blueprint.mLevel,"
+        " IF(assemblyLine.activityID = 1, blueprintType.productTypeID, installedItem.typeID),"
+        " job.outputFlag, job.installerID, assemblyLine.activityID, job.runs, job.installTime,"
+        " job.beginProductionTime, job.pauseProductionTime, job.endProductionTime, job.licensedProductionRuns,"
+        " station.solarSystemID, job.completedStatusID, station.stationTypeID, job.ownerID, job.eventID"
+        " FROM ramJobs AS job"
+        " LEFT JOIN entity AS installedItem ON job.installedItemID = installedItem.itemID"
+        " LEFT JOIN ramAssemblyLines AS assemblyLine ON job.assemblyLineID = assemblyLine.assemblyLineID"
+        " LEFT JOIN invBlueprints AS blueprint ON installedItem.itemID = blueprint.itemID"
+        " LEFT JOIN invBlueprintTypes AS blueprintType ON installedItem.typeID = blueprintType.blueprintTypeID"
+        " LEFT JOIN ramAssemblyLineStations AS station ON assemblyLine.containerID = station.stationID"
+        " WHERE job.completedStatusID = 0%s"
+        " GROUP BY job.jobID",
+        filter.c_str()))
+    {
+        _log(DATABASE__ERROR, "Failed to load running jobs: %s", res.error.c_str());
+        return false;
+    }
+
+    DBResultRow row;
+    while (res.GetRow(row)) {
+        EvERam::JobData data = EvERam::JobData();
+            data.jobID                  = row.GetUInt(0);
+            data.assemblyLineID         = row.GetUInt(1);
+            data.containerID            = (row.IsNull(2) ? 0 : row.GetUInt(2));
+            data.installedItemID        = row.GetUInt(3);
+            data.installedTypeID        = (row.IsNull(4) ? 0 : row.GetUInt(4));
+            data.installedItemOwnerID   = (row.IsNull(5) ? 0 : row.GetUInt(5));
+            data.pLevel                 = (row.IsNull(6) ? 0 : row.GetInt(6));
+            data.mLevel                 = (row.IsNull(7) ? 0 : row.GetInt(7));
+            data.outputTypeID           = (row.IsNull(8) ? 0 : row.GetUInt(8));
+            data.outputFlag             = row.GetUInt(9);
+            data.installerID            = row.GetUInt(10);
+            data.activity               = (row.IsNull(11) ? 0 : row.GetInt(11));
+            data.runs                   = row.GetInt(12);
+            data.installTime            = row.GetInt64(13);
+            data.beginTime              = row.GetInt64(14);
+            data.pauseTime              = (row.IsNull(15) ? 0 : row.GetInt64(15));
+            data.endTime                = row.GetInt64(16);
+            data.licensedRuns           = row.GetInt(17);
+            data.solarSystemID          = (row.IsNull(18) ? 0 : row.GetUInt(18));
+            data.status                 = row.GetInt(19);
+            data.containerTypeID        = (row.IsNull(20) ? 0 : row.GetUInt(20));
+            data.ownerID                = row.GetUInt(21);
+            data.eventID                = row.GetUInt(22);
+        into.push_back(data);
+    }
+
+    return true;
+}
+
+bool FactoryDB::CompleteJob(const uint32 jobID, const int8 completedStatus) {
+    DBerror err;
+
+    if (!sDatabase.RunQuery(err, "UPDATE ramJobs SET completedStatusID = %i WHERE jobID = %u", completedStatus, jobID)) {
+        _log(DATABASE__ERROR, "Failed to complete job %u (status = %i): %s.", jobID, completedStatus, err.c_str());
+        return false;
+    }
+
+    return true;
+}
+
 PyRep *FactoryDB::AssemblyLinesSelectPublic(const uint32 regionID) {
     DBQueryResult res;
 
@@ -470,8 +546,8 @@ bool FactoryDB::GetAssemblyLineProperties(const uint32 assemblyLineID, Character
     uint32 factionID(sDataMgr.GetCorpFaction(row.GetInt(5)));
     if (isCorpJob) {
         // this is only for PC corps.  take higher of (npc faction to pc corp)/2 or npc corp to pc corp
-        float cStanding(StandingDB::GetStanding(row.GetInt(5), pChar->corporationID()));
-        float fStanding(StandingDB::GetStanding(factionID, pChar->corporationID()));
+        float cStanding(sStandingMgr.GetStanding(row.GetInt(5), pChar->corporationID()));
+        float fStanding(sStandingMgr.GetStanding(factionID, pChar->corporationID()));
         fStanding /= 2;
         // this works for negative standings also
         if (cStanding > fStanding) {
@@ -482,10 +558,10 @@ bool FactoryDB::GetAssemblyLineProperties(const uint32 assemblyLineID, Character
 
         /** @todo  this shit will have to be verified for negative standings */
         // modify end result by 25% for char standings with station owner
-        standing *= (1 - (0.025f * StandingDB::GetStanding(row.GetInt(5), pChar->itemID())));
+        standing *= (1 - (0.025f * sStandingMgr.GetStanding(row.GetInt(5), pChar->itemID())));
     } else {
         // else take personal standings with station corp only
-        standing = StandingDB::GetStanding(row.GetInt(5), pChar->itemID());
+        standing = sStandingMgr.GetStanding(row.GetInt(5), pChar->itemID());
     }
 
     if (standing < 0) {
@@ -580,55 +656,6 @@ uint32 FactoryDB::InstallJob(const uint32 ownerID, const uint32 installerID, Cal
     return jobID;
 }
 
-uint32 FactoryDB::CountManufacturingJobs(const uint32 installerID) {
-    DBQueryResult res;
-
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        " COUNT(job.jobID)"
-        " FROM ramJobs AS job"
-        " LEFT JOIN ramAssemblyLines AS line USING (assemblyLineID)"
-        " WHERE job.installerID = %u"
-        " AND job.completedStatusID = 0"
-        " AND line.activityID = 1",
-        installerID))
-    {
-        _log(DATABASE__ERROR, "Failed to count manufacturing jobs for installer %u.", installerID);
-        return 0;
-    }
-
-    DBResultRow row;
-    if (!res.GetRow(row)) {
-        _log(DATABASE__ERROR, "No rows returned while counting manufacturing jobs for installer %u.", installerID);
-        return 0;
-    }
-
-    return row.GetUInt(0);
-}
-uint32 FactoryDB::CountResearchJobs(const uint32 installerID) {
-    DBQueryResult res;
-
-    if (!sDatabase.RunQuery(res,
-        "SELECT"
-        " COUNT(job.jobID)"
-        " FROM ramJobs AS job"
-        " LEFT JOIN ramAssemblyLines AS line USING (assemblyLineID)"
-        " WHERE job.installerID = %u"
-        " AND job.completedStatusID = 0"
-        " AND line.activityID != 1",    // is this accurate?
-        installerID))
-    {
-        _log(DATABASE__ERROR, "Failed to count research jobs for installer %u.", installerID);
-        return 0;
-    }
-
-    DBResultRow row;
-    if (!res.GetRow(row))
-        return 0;
-
-    return row.GetUInt(0);
-}
-
 bool FactoryDB::GetJobProperties(const uint32 jobID, EvERam::JobProperties &data) {
     DBQueryResult res;
     if (!sDatabase.RunQuery(res,
@@ -662,17 +689,6 @@ bool FactoryDB::GetJobProperties(const uint32 jobID, EvERam::JobProperties &data
     return true;
 }
 
-bool FactoryDB::CompleteJob(const uint32 jobID, const int8 completedStatus) {
-    DBerror err;
-
-    if (!sDatabase.RunQuery(err, "UPDATE ramJobs SET completedStatusID = %i WHERE jobID = %u", completedStatus, jobID)) {
-        _log(DATABASE__ERROR, "Failed to complete job %u (status = %i): %s.", jobID, completedStatus, err.c_str());
-        return false;
-    }
-
-    return true;
-}
-
 uint32 FactoryDB::GetTech2Blueprint(const uint32 blueprintTypeID) {
     DBQueryResult res;
 
@@ -688,22 +704,6 @@ uint32 FactoryDB::GetTech2Blueprint(const uint32 blueprintTypeID) {
     return row.GetUInt(0);
 }
 
-int64 FactoryDB::GetNextFreeTime(const uint32 assemblyLineID) {
-    DBQueryResult res;
-    if (!sDatabase.RunQuery(res, "SELECT nextFreeTime FROM ramAssemblyLines WHERE assemblyLineID = %u", assemblyLineID)) {
-        _log(DATABASE__ERROR, "Failed to query next free time for assembly line %u: %s.", assemblyLineID, res.error.c_str());
-        return 0;
-    }
-
-    DBResultRow row;
-    if (!res.GetRow(row)) {
-        _log(DATABASE__ERROR, "Assembly line %u not found.", assemblyLineID);
-        return 0;
-    }
-
-    return (row.IsNull(0) ? 0 : row.GetInt64(0));
-}
-
 bool FactoryDB::GetMultipliers(const uint32 assemblyLineID, const ItemType* pType, Rsp_InstallJob& into) {
     DBQueryResult res;
     // check Category first
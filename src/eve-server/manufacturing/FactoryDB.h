@@ -54,6 +54,9 @@ public:
 
     // CompleteJob stuff
     static bool GetJobProperties(const uint32 jobID, EvERam::JobProperties& data);
+
+    // for RamJobMgr.  loads all running jobs, or only this job if jobID is set
+    static bool LoadJobs(std::vector<EvERam::JobData>& into, const uint32 jobID=0);
     static bool CompleteJob(const uint32 jobID, const int8 completedStatus);
 
     // misc queries
@@ -63,12 +66,8 @@ public:
     static bool IsProducableBy(const uint32 assemblyLineID, const ItemType *pType);
     static bool GetMultipliers(const uint32 assemblyLineID, const ItemType *pType, Rsp_InstallJob &into);
 
-    static uint32 CountManufacturingJobs(const uint32 installerID);
-    static uint32 CountResearchJobs(const uint32 installerID);
     static uint32 GetTech2Blueprint(const uint32 blueprintTypeID);
 
-    static int64 GetNextFreeTime(const uint32 assemblyLineID);
-
     // for calendar events
     static void SetJobEventID(const uint32 jobID, const uint32 eventID);
 
@@ -0,0 +1,282 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name RamJobMgr.cpp
+ *   in-memory tracking of running R.A.M. jobs
+ */
+
+#include "Client.h"
+#include "EntityList.h"
+#include "manufacturing/FactoryDB.h"
+#include "manufacturing/RamJobMgr.h"
+#include "manufacturing/RamMethods.h"
+
+/*
+ * MANUF__ERROR
+ * MANUF__WARNING
+ * MANUF__MESSAGE
+ * MANUF__INFO
+ * MANUF__TRACE
+ */
+
+RamJobMgr::RamJobMgr()
+{
+    m_jobs.clear();
+    m_byOwner.clear();
+    m_byInstaller.clear();
+    m_byLine.clear();
+    m_running.clear();
+}
+
+int RamJobMgr::Initialize()
+{
+    double start(GetTimeMSeconds());
+    std::vector<EvERam::JobData> jobs;
+    if (!FactoryDB::LoadJobs(jobs))
+        return 0;
+
+    for (auto cur : jobs)
+        Add(cur);
+
+    sLog.Blue("        RamJobMgr", "R.A.M. Job Manager loaded %u running jobs in %.3fms.", (uint32)m_jobs.size(), (GetTimeMSeconds() - start));
+    return 1;
+}
+
+void RamJobMgr::Close()
+{
+    m_jobs.clear();
+    m_byOwner.clear();
+    m_byInstaller.clear();
+    m_byLine.clear();
+    m_running.clear();
+    sLog.Warning("        RamJobMgr", "R.A.M. Job Manager has been closed." );
+}
+
+void RamJobMgr::Process()
+{
+    int64 curTime(GetFileTimeNow());
+    Client* pClient(nullptr);
+    std::unordered_map<uint32, EvERam::JobData>::iterator itr = m_jobs.end();
+    while (!m_running.empty() and (m_running.begin()->first <= curTime)) {
+        itr = m_jobs.find(m_running.begin()->second);
+        m_running.erase(m_running.begin());
+        if (itr == m_jobs.end())
+            continue;
+
+        _log(MANUF__INFO, "RamJobMgr - %s job %u for %u is ready.", sRamMthd.GetActivityName(itr->second.activity), itr->first, itr->second.ownerID);
+        pClient = sEntityList.FindClientByCharID(itr->second.installerID);
+        if (pClient != nullptr)
+            pClient->SendNotifyMsg("Your %s job is ready for delivery.", sRamMthd.GetActivityName(itr->second.activity));
+    }
+}
+
+void RamJobMgr::Add(EvERam::JobData& data)
+{
+    m_jobs[data.jobID] = data;
+    m_byOwner.emplace(data.ownerID, data.jobID);
+    m_byInstaller.emplace(data.installerID, data.jobID);
+    m_byLine.emplace(data.assemblyLineID, data.jobID);
+    if (data.endTime > GetFileTimeNow())
+        m_running.emplace(data.endTime, data.jobID);
+}
+
+void RamJobMgr::Remove(uint32 jobID)
+{
+    std::unordered_map<uint32, EvERam::JobData>::iterator itr = m_jobs.find(jobID);
+    if (itr == m_jobs.end())
+        return;
+
+    auto range = m_byOwner.equal_range(itr->second.ownerID);
+    for (auto it = range.first; it != range.second; ++it)
+        if (it->second == jobID) {
+            m_byOwner.erase(it);
+            break;
+        }
+    range = m_byInstaller.equal_range(itr->second.installerID);
+    for (auto it = range.first; it != range.second; ++it)
+        if (it->second == jobID) {
+            m_byInstaller.erase(it);
+            break;
+        }
+    range = m_byLine.equal_range(itr->second.assemblyLineID);
+    for (auto it = range.first; it != range.second; ++it)
+        if (it->second == jobID) {
+            m_byLine.erase(it);
+            break;
+        }
+    auto rrange = m_running.equal_range(itr->second.endTime);
+    for (auto it = rrange.first; it != rrange.second; ++it)
+        if (it->second == jobID) {
+            m_running.erase(it);
+            break;
+        }
+
+    m_jobs.erase(itr);
+}
+
+void RamJobMgr::AddJob(uint32 jobID)
+{
+    std::vector<EvERam::JobData> jobs;
+    if (!FactoryDB::LoadJobs(jobs, jobID))
+        return;
+    for (auto cur : jobs)
+        Add(cur);
+}
+
+void RamJobMgr::SetEventID(uint32 jobID, uint32 eventID)
+{
+    std::unordered_map<uint32, EvERam::JobData>::iterator itr = m_jobs.find(jobID);
+    if (itr != m_jobs.end())
+        itr->second.eventID = eventID;
+}
+
+bool RamJobMgr::CompleteJob(uint32 jobID, int8 status)
+{
+    // saved now, before anything is handed out, so the job can't be delivered twice
+    if (!FactoryDB::CompleteJob(jobID, status))
+        return false;
+    Remove(jobID);
+    return true;
+}
+
+bool RamJobMgr::GetJobProperties(uint32 jobID, EvERam::JobProperties& data)
+{
+    std::unordered_map<uint32, EvERam::JobData>::iterator itr = m_jobs.find(jobID);
+    if (itr == m_jobs.end())
+        return false;
+
+    data.itemID         = itr->second.installedItemID;
+    data.ownerID        = itr->second.ownerID;
+    data.outputFlag     = (EVEItemFlags)itr->second.outputFlag;
+    data.jobRuns        = itr->second.runs;
+    data.licensedRuns   = itr->second.licensedRuns;
+    data.endTime        = itr->second.endTime;
+    data.status         = itr->second.status;
+    data.activity       = itr->second.activity;
+    data.eventID        = itr->second.eventID;
+    return true;
+}
+
+uint32 RamJobMgr::CountJobs(uint32 installerID, bool manufacturing)
+{
+    uint32 count(0);
+    auto range = m_byInstaller.equal_range(installerID);
+    for (auto it = range.first; it != range.second; ++it) {
+        std::unordered_map<uint32, EvERam::JobData>::iterator itr = m_jobs.find(it->second);
+        if (itr == m_jobs.end())
+            continue;
+        if ((itr->second.activity == EvERam::Activity::Manufacturing) == manufacturing)
+            ++count;
+    }
+    return count;
+}
+
+int64 RamJobMgr::GetNextFreeTime(uint32 assemblyLineID)
+{
+    int64 nextFree(0);
+    auto range = m_byLine.equal_range(assemblyLineID);
+    for (auto it = range.first; it != range.second; ++it) {
+        std::unordered_map<uint32, EvERam::JobData>::iterator itr = m_jobs.find(it->second);
+        if (itr == m_jobs.end())
+            continue;
+        if (itr->second.endTime > nextFree)
+            nextFree = itr->second.endTime;
+    }
+    return nextFree;
+}
+
+PyRep* RamJobMgr::GetJobs(uint32 ownerID, bool completed)
+{
+    if (completed) {
+        // history is only kept in db
+        return FactoryDB::GetJobs2(ownerID, true);
+    }
+
+    // same columns as FactoryDB::GetJobs2()
+    PyList* header = new PyList(23);
+    header->SetItemString(0,  "jobID");
+    header->SetItemString(1,  "assemblyLineID");
+    header->SetItemString(2,  "containerID");
+    header->SetItemString(3,  "installedItemID");
+    header->SetItemString(4,  "installedItemTypeID");
+    header->SetItemString(5,  "installedItemOwnerID");
+    header->SetItemString(6,  "installedItemProductivityLevel");
+    header->SetItemString(7,  "installedItemMaterialLevel");
+    header->SetItemString(8,  "outputTypeID");
+    header->SetItemString(9,  "outputFlag");
+    header->SetItemString(10, "installerID");
+    header->SetItemString(11, "activityID");
+    header->SetItemString(12, "runs");
+    header->SetItemString(13, "installTime");
+    header->SetItemString(14, "beginProductionTime");
+    header->SetItemString(15, "pauseProductionTime");
+    header->SetItemString(16, "endProductionTime");
+    header->SetItemString(17, "completed");
+    header->SetItemString(18, "licensedProductionRuns");
+    header->SetItemString(19, "installedInSolarSystemID");
+    header->SetItemString(20, "completedStatus");
+    header->SetItemString(21, "containerTypeID");
+    header->SetItemString(22, "containerLocationID");
+
+    PyList* lines = new PyList();
+    auto range = m_byOwner.equal_range(ownerID);
+    for (auto it = range.first; it != range.second; ++it) {
+        std::unordered_map<uint32, EvERam::JobData>::iterator itr = m_jobs.find(it->second);
+        if (itr == m_jobs.end())
+            continue;
+        EvERam::JobData& data = itr->second;
+        PyList* line = new PyList(23);
+        line->SetItem(0,  new PyInt(data.jobID));
+        line->SetItem(1,  new PyInt(data.assemblyLineID));
+        line->SetItem(2,  (data.containerID ? (PyRep*)new PyInt(data.containerID) : PyStatic.NewNone()));
+        line->SetItem(3,  new PyInt(data.installedItemID));
+        line->SetItem(4,  new PyInt(data.installedTypeID));
+        line->SetItem(5,  new PyInt(data.installedItemOwnerID));
+        line->SetItem(6,  new PyInt(data.pLevel));
+        line->SetItem(7,  new PyInt(data.mLevel));
+        line->SetItem(8,  new PyInt(data.outputTypeID));
+        line->SetItem(9,  new PyInt(data.outputFlag));
+        line->SetItem(10, new PyInt(data.installerID));
+        line->SetItem(11, new PyInt(data.activity));
+        line->SetItem(12, new PyInt(data.runs));
+        line->SetItem(13, new PyLong(data.installTime));
+        line->SetItem(14, new PyLong(data.beginTime));
+        line->SetItem(15, (data.pauseTime ? (PyRep*)new PyLong(data.pauseTime) : PyStatic.NewNone()));
+        line->SetItem(16, new PyLong(data.endTime));
+        line->SetItem(17, new PyInt(0));
+        line->SetItem(18, new PyInt(data.licensedRuns));
+        line->SetItem(19, (data.solarSystemID ? (PyRep*)new PyInt(data.solarSystemID) : PyStatic.NewNone()));
+        line->SetItem(20, new PyInt(data.status));
+        line->SetItem(21, (data.containerTypeID ? (PyRep*)new PyInt(data.containerTypeID) : PyStatic.NewNone()));
+        line->SetItem(22, (data.solarSystemID ? (PyRep*)new PyInt(data.solarSystemID) : PyStatic.NewNone()));
+        lines->AddItem(line);
+    }
+
+    PyDict* args = new PyDict();
+    args->SetItemString("header", header);
+    args->SetItemString("RowClass", new PyToken("util.Row"));
+    args->SetItemString("lines", lines);
+    return new PyObject("util.Rowset", args);
+}
@@ -0,0 +1,92 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name RamJobMgr.h
+ *   in-memory tracking of running R.A.M. jobs
+ */
+
+#ifndef EVE_MANUF_RAMJOBMGR_H
+#define EVE_MANUF_RAMJOBMGR_H
+
+
+#include "eve-server.h"
+
+#include "../eve-common/EVE_RAM.h"
+
+/*
+ * all running (undelivered) jobs are loaded at boot and kept here, indexed by owner (char or corp),
+ *   installer and assembly line, and queued by endTime.
+ * job lists, slot counts and line free times are answered from memory.
+ * Process() is called at 1Hz and tells online installers when their jobs are ready.
+ * delivered/cancelled jobs have their status saved at once, and are dropped from memory.
+ */
+class RamJobMgr
+: public Singleton< RamJobMgr >
+{
+public:
+    RamJobMgr();
+    ~RamJobMgr()                                        { /* do nothing here */ }
+
+    int Initialize();
+    void Close();
+    // called at 1Hz.  sends ready notice for jobs finished by now
+    void Process();
+
+    // loads new job from db after it has been installed
+    void AddJob(uint32 jobID);
+    void SetEventID(uint32 jobID, uint32 eventID);
+    // saves job status and removes job from memory.  returns false if the status couldn't be saved
+    bool CompleteJob(uint32 jobID, int8 status);
+
+    // returns false if job is not running
+    bool GetJobProperties(uint32 jobID, EvERam::JobProperties& data);
+    // returns util.Rowset as used by ramProxy.GetJobs2.  completed jobs are read from db
+    PyRep* GetJobs(uint32 ownerID, bool completed);
+    // running manufacturing or research jobs installed by this character
+    uint32 CountJobs(uint32 installerID, bool manufacturing);
+    // time the last job on this line will finish
+    int64 GetNextFreeTime(uint32 assemblyLineID);
+
+private:
+    void Add(EvERam::JobData& data);
+    void Remove(uint32 jobID);
+
+    std::unordered_map<uint32, EvERam::JobData> m_jobs;
+
+    // indexes of m_jobs.  ownerID/jobID, installerID/jobID, assemblyLineID/jobID
+    std::unordered_multimap<uint32, uint32> m_byOwner;
+    std::unordered_multimap<uint32, uint32> m_byInstaller;
+    std::unordered_multimap<uint32, uint32> m_byLine;
+
+    // jobs still running.  endTime/jobID
+    std::multimap<int64, uint32> m_running;
+};
+
+//Singleton
+#define sRamJobMgr \
+( RamJobMgr::get() )
+
+
+#endif  // EVE_MANUF_RAMJOBMGR_H
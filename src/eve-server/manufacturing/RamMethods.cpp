@@ -13,7 +13,9 @@
 #include "Client.h"
 #include "inventory/Inventory.h"
 #include "manufacturing/Blueprint.h"
+#include "manufacturing/RamJobMgr.h"
 #include "manufacturing/RamMethods.h"
+#include "standing/StandingMgr.h"
 #include "station/StationDataMgr.h"
 
 static const uint32 RAM_PRODUCTION_TIME_LIMIT = 60*60*24*30;   //30 days
@@ -109,7 +111,7 @@ void RamMethods::ActivityCheck(Client* const pClient, const Call_InstallJob& arg
 void RamMethods::JobsCheck(Character* pChar, const Call_InstallJob& args)
 {
     if (args.activityID == EvERam::Activity::Manufacturing) {
-        uint32 jobCount = FactoryDB::CountManufacturingJobs(pChar->itemID());
+        uint32 jobCount = sRamJobMgr.CountJobs(pChar->itemID(), true);
         uint charMaxJobs = 1+ pChar->GetSkillLevel(EvESkill::MassProduction)
                             + pChar->GetSkillLevel(EvESkill::AdvancedMassProduction);
 
@@ -121,7 +123,7 @@ void RamMethods::JobsCheck(Character* pChar, const Call_InstallJob& args)
         uint charMaxJobs = 1+ pChar->GetSkillLevel(EvESkill::LaboratoryOperation)
                             + pChar->GetSkillLevel(EvESkill::AdvancedLaboratoryOperation);
 
-        uint32 jobCount = FactoryDB::CountResearchJobs(pChar->itemID());
+        uint32 jobCount = sRamJobMgr.CountJobs(pChar->itemID(), false);
         if (charMaxJobs <= jobCount)
             throw UserError ("MaxResearchFacilitySlotUsageReached")
                     .AddAmount ("current", jobCount)
@@ -202,7 +204,7 @@ void RamMethods::LinePermissionCheck(Client*const pClient, const Call_InstallJob
     if (data.rMask & EvERam::RestrictionMask::ByStanding) {
         // get standings
         if (args.isCorpJob) {
-            if (data.minStanding > StandingDB::GetStanding(data.ownerID, pClient->GetCorporationID()))
+            if (data.minStanding > sStandingMgr.GetStanding(data.ownerID, pClient->GetCorporationID()))
                 throw UserError ("RamAccessDeniedCorpStandingTooLow");
         } else {
             if (data.minStanding > pClient->GetChar()->GetStandingModified(data.ownerID))
@@ -494,7 +496,7 @@ bool RamMethods::Calculate(const Call_InstallJob &args, BlueprintRef bpRef, Char
     }
     
 
-    into.maxJobStartTime = FactoryDB::GetNextFreeTime(args.AssemblyLineID);
+    into.maxJobStartTime = sRamJobMgr.GetNextFreeTime(args.AssemblyLineID);
 
     return true;
 }
@@ -38,6 +38,7 @@
 #include "StaticDataMgr.h"
 #include "account/AccountService.h"
 #include "manufacturing/Blueprint.h"
+#include "manufacturing/RamJobMgr.h"
 #include "manufacturing/RamMethods.h"
 #include "manufacturing/RamProxyService.h"
 #include "station/StationDataMgr.h"
@@ -119,7 +120,7 @@ PyResult RamProxyService::GetJobs2(PyCallArgs &call, PyInt* ownerID, PyBool* com
             return nullptr;
         }
 
-    return FactoryDB::GetJobs2(ownerID->value(), completed->value());
+    return sRamJobMgr.GetJobs(ownerID->value(), completed->value());
 }
 
 /** @todo update this for corp usage */
@@ -360,6 +361,7 @@ PyResult RamProxyService::InstallJob(PyCallArgs &call, PyRep* locationData, PyRe
         // make client error here...
         return nullptr;
     }
+    sRamJobMgr.AddJob(jobID);
 
     if (bpRef->quantity() > 1) {
         BlueprintRef iRef = bpRef->SplitBlueprint(1);
@@ -535,6 +537,7 @@ PyResult RamProxyService::InstallJob(PyCallArgs &call, PyRep* locationData, PyRe
                                                      Calendar::AutoEvent::RAMJob, title, description);
 
         FactoryDB::SetJobEventID(jobID, eventID);
+        sRamJobMgr.SetEventID(jobID, eventID);
 
         //force calendar reload (if corp job, update all online members, also)
         if (args.isCorpJob) {
@@ -577,13 +580,16 @@ PyResult RamProxyService::CompleteJob(PyCallArgs &call, PyRep* info, PyRep* jobI
     }
 
     EvERam::JobProperties data = EvERam::JobProperties();
-    if (!FactoryDB::GetJobProperties(args.jobID, data))
-        throw UserError ("RamCompletionNoSuchJob");
+    // jobs not in memory are already finished, so db is only checked for the error to send
+    if (!sRamJobMgr.GetJobProperties(args.jobID, data))
+        if (!FactoryDB::GetJobProperties(args.jobID, data))
+            throw UserError ("RamCompletionNoSuchJob");
 
     sRamMthd.VerifyCompleteJob(args, data, call.client);
 
     // does an aborted job return the installed item immediately or after time expiry?
-    FactoryDB::CompleteJob(args.jobID, (args.cancel ? EvERam::Status::Abort : EvERam::Status::Delivered));
+    if (!sRamJobMgr.CompleteJob(args.jobID, (args.cancel ? EvERam::Status::Abort : EvERam::Status::Delivered)))
+        throw UserError ("RamCompletionNoSuchJob");
 
     // return item
     InventoryItemRef installedItem = sItemFactory.GetItemRef(data.itemID);
@@ -11,6 +11,7 @@
 #include "agents/Agent.h"
 #include "map/MapData.h"
 #include "map/MapDB.h"
+#include "map/MapGraph.h"
 #include "station/StationDataMgr.h"
 #include "system/SystemManager.h"
 #include "system/SystemEntity.h"
@@ -191,18 +192,35 @@ void MapData::GetMissionDestination(Agent* pAgent, uint8 misionType, MissionOffe
         //may have to create data objects based on constellation to do ranges in neighboring constellation
         // could use data from mapSolarSystemJumps - fromRegionID, fromConstellationID, fromSolarSystemID, toSolarSystemID, toConstellationID, toRegionID
 
-        /** @todo  make function to find route from origin to constellation/region jump point.  */
         case SameOrNeighboringSystem:  //3
         case NeighboringSystem: {  //5
             uint32 systemID = pAgent->GetSystemID();
-            if (IsEven(MakeRandomInt(0, 100))) {
-                // same constellation
-            } else {
-                // neighboring constellation
-                systemID = 0;
+            if ((destRange == NeighboringSystem) or (IsEven(MakeRandomInt(0, 100)))) {
+                // any system one jump out, in this or a neighboring constellation
+                std::vector<uint32> sysList, stList;
+                sMapGraph.GetNeighbours(systemID, sysList);
+                for (auto cur : sysList)
+                    if (!station or (sDataMgr.GetStationCount(cur) > 0))
+                        stList.push_back(cur);
+                if (!stList.empty())
+                    systemID = stList.at(MakeRandomInt(0, (stList.size() -1)));
             }
-            if (ship) {
+            if (station) {
+                std::vector<uint32> list;
+                sDataMgr.GetStationList(systemID, list);
+                if (list.empty()) {
+                    offer.destinationID = 0;
+                    _log(AGENT__ERROR, "Agent::GetMissionDestination() - no station found in %u.", systemID);
+                    return;
+                }
+                offer.destinationID = list.at(MakeRandomInt(0, (list.size() -1)));
+                if ((offer.destinationID == pAgent->GetStationID()) and (list.size() > 1))
+                    while (offer.destinationID == pAgent->GetStationID())
+                        offer.destinationID = list.at(MakeRandomInt(0, (list.size() -1)));
+            } else if (ship) {
                 ;  // code here for agent in ship
+            } else {
+                offer.destinationID = systemID;
             }
         } break;
         case SameOrNeighboringConstellationSameRegion:   //7
@@ -0,0 +1,275 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name MapGraph.cpp
+ *   stargate graph of k-space with precomputed jump counts and route queries
+ */
+
+#include "../StaticDataMgr.h"
+#include "map/MapDB.h"
+#include "map/MapGraph.h"
+
+
+MapGraph::MapGraph()
+{
+    m_systems.clear();
+    m_index.clear();
+    m_offset.clear();
+    m_edges.clear();
+    m_security.clear();
+    m_jumps.clear();
+}
+
+void MapGraph::Close()
+{
+    m_systems.clear();
+    m_index.clear();
+    m_offset.clear();
+    m_edges.clear();
+    m_security.clear();
+    m_jumps.clear();
+    sLog.Warning("         MapGraph", "Map Graph has been closed." );
+}
+
+int MapGraph::Initialize()
+{
+    double start(GetTimeMSeconds());
+    DBQueryResult res;
+    MapDB::GetSystemJumps(res);
+
+    // gate list, in both directions.  fromSys/toSys
+    std::vector<std::pair<uint32, uint32>> gates;
+    DBResultRow row;
+    while (res.GetRow(row)) {
+        //SELECT ctype, fromsol, tosol FROM mapConnections
+        uint32 fromSys(row.GetUInt(1)), toSys(row.GetUInt(2));
+        if (!IsKSpaceID(fromSys) or !IsKSpaceID(toSys))
+            continue;
+        gates.push_back(std::make_pair(fromSys, toSys));
+        gates.push_back(std::make_pair(toSys, fromSys));
+    }
+    std::sort(gates.begin(), gates.end());
+    gates.erase(std::unique(gates.begin(), gates.end()), gates.end());
+
+    SystemData data = SystemData();
+    for (auto cur : gates) {
+        if (m_index.find(cur.first) != m_index.end())
+            continue;
+        m_index[cur.first] = (uint16)m_systems.size();
+        m_systems.push_back(cur.first);
+        data.securityRating = 0;
+        sDataMgr.GetSystemData(cur.first, data);
+        m_security.push_back(data.securityRating);
+    }
+
+    // gates are sorted by fromSys, but dense index is not, so count first
+    uint16 count(m_systems.size());
+    m_offset.assign(count + 1, 0);
+    for (auto cur : gates)
+        ++m_offset[m_index[cur.first] + 1];
+    for (uint16 i = 0; i < count; ++i)
+        m_offset[i + 1] += m_offset[i];
+    m_edges.resize(gates.size());
+    std::vector<uint32> fill(m_offset.begin(), m_offset.end() - 1);
+    for (auto cur : gates)
+        m_edges[fill[m_index[cur.first]]++] = m_index[cur.second];
+
+    sLog.Cyan("         MapGraph", "%u systems and %u gates loaded in %.3fms.", count, (uint32)m_edges.size(), (GetTimeMSeconds() - start));
+
+    start = GetTimeMSeconds();
+    BuildMatrix();
+    sLog.Cyan("         MapGraph", "%lu jump counts (%.2fMb) built in %.3fms.", m_jumps.size(), (m_jumps.size() / 1048576.0), (GetTimeMSeconds() - start));
+
+    sLog.Blue("         MapGraph", "Map Graph Initialized.");
+    return 1;
+}
+
+void MapGraph::BuildMatrix()
+{
+    size_t count(m_systems.size());
+    if (count < 2)
+        return;
+    m_jumps.assign(count * (count - 1) / 2, Unreachable);
+
+    std::vector<uint8> dist;
+    std::vector<uint16> queue(count);
+    uint16 head(0), tail(0), cur(0);
+    for (uint16 i = 0; i < count; ++i) {
+        dist.assign(count, Unreachable);
+        dist[i] = 0;
+        head = tail = 0;
+        queue[tail++] = i;
+        while (head < tail) {
+            cur = queue[head++];
+            // anything this far out is reported as unreachable
+            if (dist[cur] >= Unreachable - 1)
+                continue;
+            for (uint32 e = m_offset[cur]; e < m_offset[cur + 1]; ++e)
+                if (dist[m_edges[e]] == Unreachable) {
+                    dist[m_edges[e]] = dist[cur] + 1;
+                    queue[tail++] = m_edges[e];
+                }
+        }
+        // only the upper triangle is kept
+        size_t base(i * (2 * count - i - 1) / 2);
+        for (uint16 j = i + 1; j < count; ++j)
+            m_jumps[base + (j - i - 1)] = dist[j];
+    }
+}
+
+bool MapGraph::GetIndex(uint32 sysID, uint16& index)
+{
+    std::unordered_map<uint32, uint16>::iterator itr = m_index.find(sysID);
+    if (itr == m_index.end())
+        return false;
+    index = itr->second;
+    return true;
+}
+
+uint8 MapGraph::Jumps(uint16 from, uint16 to)
+{
+    if (from == to)
+        return 0;
+    if (from > to)
+        std::swap(from, to);
+    size_t count(m_systems.size());
+    return m_jumps[(from * (2 * count - from - 1) / 2) + (to - from - 1)];
+}
+
+uint8 MapGraph::GetJumps(uint32 fromSysID, uint32 toSysID)
+{
+    if (fromSysID == toSysID)
+        return 0;
+    uint16 from(0), to(0);
+    if (!GetIndex(fromSysID, from) or !GetIndex(toSysID, to))
+        return Unreachable;
+    return Jumps(from, to);
+}
+
+void MapGraph::GetSystemsInRange(uint32 sysID, uint8 minJumps, uint8 maxJumps, std::vector<uint32>& into)
+{
+    uint16 from(0);
+    if (!GetIndex(sysID, from)) {
+        if (minJumps == 0)
+            into.push_back(sysID);
+        return;
+    }
+
+    uint8 jumps(0);
+    for (uint16 i = 0; i < m_systems.size(); ++i) {
+        jumps = Jumps(from, i);
+        if ((jumps >= minJumps) and (jumps <= maxJumps) and (jumps != Unreachable))
+            into.push_back(m_systems[i]);
+    }
+}
+
+void MapGraph::GetNeighbours(uint32 sysID, std::vector<uint32>& into)
+{
+    uint16 from(0);
+    if (!GetIndex(sysID, from))
+        return;
+
+    for (uint32 i = m_offset[from]; i < m_offset[from + 1]; ++i)
+        into.push_back(m_systems[m_edges[i]]);
+}
+
+bool MapGraph::GetRoute(uint32 fromSysID, uint32 toSysID, std::vector<uint32>& route, uint8 type/*Map::Route::Shortest*/, const std::set<uint32>* avoid/*nullptr*/)
+{
+    route.clear();
+    if (fromSysID == toSysID) {
+        route.push_back(fromSysID);
+        return true;
+    }
+
+    uint16 from(0), to(0);
+    if (!GetIndex(fromSysID, from) or !GetIndex(toSysID, to))
+        return false;
+    if (Jumps(from, to) == Unreachable)
+        return false;
+
+    if ((type == Map::Route::Shortest) and ((avoid == nullptr) or avoid->empty())) {
+        // every step along a shortest route is one jump closer to the destination
+        uint16 cur(from);
+        route.push_back(m_systems[cur]);
+        while (cur != to) {
+            uint8 jumps(Jumps(cur, to));
+            for (uint32 e = m_offset[cur]; e < m_offset[cur + 1]; ++e)
+                if (Jumps(m_edges[e], to) == jumps - 1) {
+                    cur = m_edges[e];
+                    break;
+                }
+            route.push_back(m_systems[cur]);
+        }
+        return true;
+    }
+
+    // a system in unwanted security costs as much as this many jumps, so it is only used when there is no way around it
+    static const uint32 penalty(1000);
+    uint16 count(m_systems.size());
+    std::vector<uint32> cost(count, UINT32_MAX);
+    std::vector<uint16> prev(count, UINT16_MAX);
+    // cost/index
+    std::priority_queue<std::pair<uint32, uint16>, std::vector<std::pair<uint32, uint16>>, std::greater<std::pair<uint32, uint16>>> open;
+    cost[from] = 0;
+    open.push(std::make_pair(0, from));
+
+    uint16 cur(0), next(0);
+    uint32 step(0);
+    while (!open.empty()) {
+        cur = open.top().second;
+        if (open.top().first > cost[cur]) {
+            open.pop();
+            continue;
+        }
+        open.pop();
+        if (cur == to)
+            break;
+
+        for (uint32 e = m_offset[cur]; e < m_offset[cur + 1]; ++e) {
+            next = m_edges[e];
+            if ((next != to) and (avoid != nullptr) and (avoid->find(m_systems[next]) != avoid->end()))
+                continue;
+            step = 1;
+            if ((type == Map::Route::Safe) and (m_security[next] < 0.45f))
+                step += penalty;
+            else if ((type == Map::Route::LessSafe) and (m_security[next] >= 0.45f))
+                step += penalty;
+            if (cost[cur] + step < cost[next]) {
+                cost[next] = cost[cur] + step;
+                prev[next] = cur;
+                open.push(std::make_pair(cost[next], next));
+            }
+        }
+    }
+
+    if (cost[to] == UINT32_MAX)
+        return false;
+
+    for (cur = to; cur != from; cur = prev[cur])
+        route.push_back(m_systems[cur]);
+    route.push_back(m_systems[from]);
+    std::reverse(route.begin(), route.end());
+    return true;
+}
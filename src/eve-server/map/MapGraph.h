@@ -0,0 +1,103 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name MapGraph.h
+ *   stargate graph of k-space with precomputed jump counts and route queries
+ */
+
+#ifndef _EVE_MAP_MAPGRAPH_H_
+#define _EVE_MAP_MAPGRAPH_H_
+
+#include "../eve-server.h"
+
+
+namespace Map {
+    namespace Route {
+        enum {
+            Shortest = 0,
+            Safe     = 1,   // avoid low and null sec
+            LessSafe = 2    // avoid high sec
+        };
+    }
+}
+
+/*
+ * all gate-connected systems are given a dense index, and their jumps are kept in CSR form
+ *   (one offset per system into a single neighbor array).
+ * jump counts between every pair of systems are found with a BFS from each system at boot,
+ *   and kept as uint8 in a triangular matrix (jumps are symmetric), so GetJumps() is a single lookup.
+ * shortest routes are walked straight off the matrix.  safe/less-safe routes and routes
+ *   with systems to avoid use dijkstra over the CSR arrays with a penalty for unwanted security.
+ * w-space has no gates, so is not in the graph.
+ */
+class MapGraph
+: public Singleton< MapGraph >
+{
+public:
+    MapGraph();
+    ~MapGraph()                                         { /* do nothing here */ }
+
+    int Initialize();
+    void Close();
+
+    static constexpr uint8 Unreachable = 0xFF;
+
+    // jumps between these systems.  Unreachable if no gate route (or more than 254 jumps)
+    uint8 GetJumps(uint32 fromSysID, uint32 toSysID);
+    // all systems within 'maxJumps' of this system, but at least 'minJumps' away
+    void GetSystemsInRange(uint32 sysID, uint8 minJumps, uint8 maxJumps, std::vector<uint32>& into);
+    // systems one jump from this system, read straight from its neighbor list
+    void GetNeighbours(uint32 sysID, std::vector<uint32>& into);
+    // fills route with systems from origin to destination, inclusive.  returns false if no route
+    bool GetRoute(uint32 fromSysID, uint32 toSysID, std::vector<uint32>& route, uint8 type = Map::Route::Shortest, const std::set<uint32>* avoid = nullptr);
+
+    uint16 Count()                                      { return (uint16)m_systems.size(); }
+
+private:
+    // returns false if this system is not in the graph
+    bool GetIndex(uint32 sysID, uint16& index);
+    uint8 Jumps(uint16 from, uint16 to);
+    void BuildMatrix();
+
+    // dense index/systemID
+    std::vector<uint32> m_systems;
+    // systemID/dense index
+    std::unordered_map<uint32, uint16> m_index;
+    // neighbors of index i are m_edges[m_offset[i]] to m_edges[m_offset[i+1]]
+    std::vector<uint32> m_offset;
+    std::vector<uint16> m_edges;
+    // security rating by dense index
+    std::vector<float> m_security;
+    // jump counts for i < j, at (i * (2n - i - 1) / 2) + (j - i - 1)
+    std::vector<uint8> m_jumps;
+};
+
+
+//Singleton
+#define sMapGraph \
+( MapGraph::get() )
+
+
+#endif  // _EVE_MAP_MAPGRAPH_H_
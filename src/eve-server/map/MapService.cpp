@@ -30,6 +30,7 @@
 #include "StaticDataMgr.h"
 #include "map/MapData.h"
 #include "map/MapService.h"
+#include "standing/StandingMgr.h"
 #include "system/SystemManager.h"
 #include "system/sov/SovereigntyDataMgr.h"
 
@@ -74,7 +75,7 @@ PyResult MapService::GetSolarSystemVisits(PyCallArgs &call)
 
 PyResult MapService::GetMyExtraMapInfoAgents(PyCallArgs &call)
 {
-    return StandingDB::GetMyStandings(call.client->GetCharacterID());
+    return sStandingMgr.GetMyStandings(call.client->GetCharacterID());
 }
 
 PyResult MapService::GetMyExtraMapInfo(PyCallArgs &call)
@@ -12,6 +12,7 @@
 #include "market/MarketBotConf.h"
 #include "market/MarketBotMgr.h"
 #include "market/MarketMgr.h"
+#include "market/MarketOrderBook.h"
 #include "market/MarketProxyService.h"
 
 // ---marketbot update; everything past this point has been completely changed.
@@ -208,7 +209,7 @@ int MarketBotMgr::ExpireOldOrders() {
 
     while (res.GetRow(row)) {
         uint32 orderID = row.GetUInt(0);
-        MarketDB::DeleteOrder(orderID);
+        sOrderBook.DeleteOrder(orderID);
         ++expiredCount;
         codelog(MARKET__TRACE, "Expired Trader Joe order %u", orderID);
     }
@@ -280,7 +281,7 @@ int MarketBotMgr::PlaceBuyOrders(uint32 systemID) {
         order.memberID = 0;       // default value for who placed the order (0 for char order)
         order.accountKey = 1000;  // default value for corp account key
 
-        bool success = MarketDB::StoreOrder(order);
+        bool success = sOrderBook.StoreOrder(order);
         if (success) {
             ++orderCount;
             codelog(MARKET__TRACE, "%s order created for typeID %u, qty %u, price %.2f ISK, station %u",
@@ -362,7 +363,7 @@ int MarketBotMgr::PlaceSellOrders(uint32 systemID) {
 
         codelog(MARKET__TRACE, "Trader Joe: Storing sell order with orderRange = %u", order.orderRange);
 
-        bool success = MarketDB::StoreOrder(order);
+        bool success = sOrderBook.StoreOrder(order);
         if (success) {
             ++orderCount;
             codelog(MARKET__TRACE, "Trader Joe: Creating %s order for typeID %u, qty %u, price %.2f, station %u, region %u",
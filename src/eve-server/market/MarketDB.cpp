@@ -145,6 +145,33 @@ PyRep *MarketDB::GetOrders( uint32 regionID, uint16 typeID )
     return tup;
 }
 
+bool MarketDB::GetOrderBook(DBQueryResult& res, uint32 regionID, uint16 typeID)
+{
+    if (!sDatabase.RunQuery(res,
+        "SELECT"
+        "   orderID, ownerID, memberID, stationID, solarSystemID, orderRange, bid, price, minVolume,"
+        "   volEntered, volRemaining, issued, duration, jumps, isCorp, accountKey"
+        " FROM mktOrders "
+        " WHERE regionID=%u AND typeID=%u", regionID, typeID))
+    {
+        codelog( MARKET__DB_ERROR, "Error in query: %s", res.error.c_str() );
+        return false;
+    }
+    return true;
+}
+
+void MarketDB::GetOrderColumns(DBQueryResult& res)
+{
+    // only used for column names and types of GetOrders() rows
+    if (!sDatabase.RunQuery(res,
+        "SELECT"
+        "    price, volRemaining, typeID, orderRange AS `range`, orderID,"
+        "   volEntered, minVolume, bid, issued as issueDate, duration,"
+        "   stationID, regionID, solarSystemID, jumps"
+        " FROM mktOrders LIMIT 0"))
+        codelog( MARKET__DB_ERROR, "Error in query: %s", res.error.c_str() );
+}
+
 PyRep* MarketDB::GetOrdersForOwner(uint32 ownerID)
 {
     DBQueryResult res;
@@ -310,6 +337,15 @@ bool MarketDB::AlterOrderPrice(uint32 orderID, double new_price) {
     return true;
 }
 
+bool MarketDB::UpdateOrder(uint32 orderID, uint32 new_qty, double new_price) {
+    DBerror err;
+    if (!sDatabase.RunQuery(err, "UPDATE mktOrders SET volRemaining = %u, price = %.2f WHERE orderID = %u", new_qty, new_price, orderID)) {
+        _log(MARKET__DB_ERROR, "Error in query: %s.", err.c_str());
+        return false;
+    }
+    return true;
+}
+
 bool MarketDB::DeleteOrder(uint32 orderID) {
     DBerror err;
     if (!sDatabase.RunQuery(err, "DELETE FROM mktOrders WHERE orderID = %u", orderID)) {
@@ -522,6 +558,55 @@ void MarketDB::UpdateHistory()
                    " FROM mktData");
 }
 
+bool MarketDB::GetHistory(DBQueryResult& res, uint32 regionID, uint16 typeID, uint16 limit)
+{
+    if (!sDatabase.RunQuery(res,
+        "SELECT historyDate, lowPrice, highPrice, avgPrice, volume, orders"
+        " FROM mktHistory"
+        " WHERE regionID=%u AND typeID=%u"
+        " ORDER BY historyDate DESC LIMIT %u",
+        regionID, typeID, limit))
+    {
+        codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MarketDB::SaveHistory(std::vector<Market::HistoryData>& data)
+{
+    if (data.empty())
+        return true;
+
+    std::ostringstream Inserts;
+    Inserts << "INSERT INTO mktHistory";
+    Inserts << " (regionID, typeID, historyDate, lowPrice, highPrice, avgPrice, volume, orders)";
+    Inserts << " VALUES ";
+    Inserts.precision(17);
+    bool first = true;
+    for (auto cur : data) {
+        if (first) {
+            first = false;
+        } else {
+            Inserts << ", ";
+        }
+        Inserts << "(" << cur.regionID << ", " << cur.typeID << ", " << cur.historyDate << ", " << cur.lowPrice << ", ";
+        Inserts << cur.highPrice << ", " << cur.avgPrice << ", " << cur.volume << ", " << cur.orders << ")";
+    }
+    Inserts << " ON DUPLICATE KEY UPDATE";
+    Inserts << " lowPrice=VALUES(lowPrice),";
+    Inserts << " highPrice=VALUES(highPrice),";
+    Inserts << " avgPrice=VALUES(avgPrice),";
+    Inserts << " volume=VALUES(volume),";
+    Inserts << " orders=VALUES(orders)";
+
+    DBerror err;
+    if (!sDatabase.RunQuery(err, Inserts.str().c_str())) {
+        codelog(MARKET__DB_ERROR, "SaveHistory - unable to save %u days: %s", (uint32)data.size(), err.c_str());
+        return false;
+    }
+    return true;
+}
 
 /*  data retrieval for updating base pricing */
 
@@ -617,12 +702,21 @@ void MarketDB::UpdateMktPrice(std::map< uint16, Market::matlData >& data)
 
 void MarketDB::GetCruPriceAvg(std::map< uint16, Inv::TypeData >& data)
 {
+    // one pass over the price table instead of a query per type
     DBQueryResult res;
+    if (!sDatabase.RunQuery(res, "SELECT typeID, AVG(avgPrice) FROM CruciblePriceHistory GROUP BY typeID")) {
+        codelog(MARKET__DB_ERROR, "Error in query: %s", res.error.c_str());
+        return;
+    }
+
+    for (auto& cur : data)
+        cur.second.basePrice = 0;
+
     DBResultRow row;
     std::map< uint16, Inv::TypeData>::iterator itr;
-    for (itr = data.begin(); itr != data.end(); ++itr) {
-        sDatabase.RunQuery(res, "SELECT AVG(avgPrice) FROM CruciblePriceHistory WHERE typeID = %u", itr->first);
-        if (res.GetRow(row))
-            itr->second.basePrice = (row.IsNull(0) ? 0 : row.GetFloat(0));
+    while (res.GetRow(row)) {
+        itr = data.find(row.GetUInt(0));
+        if (itr != data.end())
+            itr->second.basePrice = (row.IsNull(1) ? 0 : row.GetFloat(1));
     }
 }
@@ -52,6 +52,11 @@ public:
     static bool AlterOrderPrice(uint32 orderID, double new_price);
     static bool RecordTransaction(Market::TxData &data);
     static bool AlterOrderQuantity(uint32 orderID, uint32 new_qty);
+    static bool UpdateOrder(uint32 orderID, uint32 new_qty, double new_price);
+
+    /* for MarketOrderBook */
+    static bool GetOrderBook(DBQueryResult& res, uint32 regionID, uint16 typeID);
+    static void GetOrderColumns(DBQueryResult& res);
 
     static uint32 FindBuyOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price);
     static uint32 FindSellOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price);
@@ -74,6 +79,10 @@ public:
     static void SetUpdateTime(int64 setTime);
 
     static void UpdateHistory();
+
+    /* for MarketHistory */
+    static bool GetHistory(DBQueryResult& res, uint32 regionID, uint16 typeID, uint16 limit);
+    static bool SaveHistory(std::vector<Market::HistoryData>& data);
 };
 
 #endif
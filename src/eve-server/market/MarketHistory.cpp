@@ -0,0 +1,257 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name MarketHistory.cpp
+ *   in-memory daily market price history, aggregated as transactions happen
+ */
+
+#include "EVEServerConfig.h"
+#include "market/MarketHistory.h"
+
+/*
+ * MARKET__ERROR
+ * MARKET__WARNING
+ * MARKET__MESSAGE
+ * MARKET__DEBUG
+ * MARKET__TRACE
+ * MARKET__DB_ERROR
+ * MARKET__DB_TRACE
+ */
+
+MarketHistory::MarketHistory()
+{
+    m_series.clear();
+    m_dirty.clear();
+}
+
+int MarketHistory::Initialize()
+{
+    sLog.Blue("    MarketHistory", "Market History Initialized.");
+    return 1;
+}
+
+void MarketHistory::Close()
+{
+    SaveHistory();
+    m_series.clear();
+    sLog.Warning("    MarketHistory", "Market History has been closed." );
+}
+
+void MarketHistory::Process()
+{
+    SaveHistory();
+
+    std::unordered_map<int64, Series>::iterator itr = m_series.begin();
+    while (itr != m_series.end()) {
+        // series still waiting to be saved are kept
+        if ((++itr->second.idle < sConfig.market.BookIdleTime) or (m_dirty.find(itr->first) != m_dirty.end())) {
+            ++itr;
+            continue;
+        }
+        itr = m_series.erase(itr);
+    }
+}
+
+void MarketHistory::SaveHistory()
+{
+    if (m_dirty.empty())
+        return;
+
+    double start(GetTimeMSeconds());
+    std::vector<Market::HistoryData> data;
+    std::unordered_map<int64, Series>::iterator itr = m_series.end();
+    for (auto cur : m_dirty) {
+        itr = m_series.find(cur);
+        if (itr == m_series.end())
+            continue;
+        // only the newest days change, so walk back until a clean one
+        for (std::vector<Day>::reverse_iterator day = itr->second.days.rbegin(); day != itr->second.days.rend(); ++day) {
+            if (!day->dirty)
+                break;
+            Market::HistoryData hist = Market::HistoryData();
+            hist.regionID       = (uint32)(cur >> 32);
+            hist.typeID         = (uint16)(cur & 0xFFFFFFFF);
+            hist.historyDate    = day->date;
+            hist.lowPrice       = day->low;
+            hist.highPrice      = day->high;
+            hist.avgPrice       = day->avg;
+            hist.volume         = day->volume;
+            hist.orders         = day->orders;
+            data.push_back(hist);
+        }
+    }
+
+    // keep everything dirty if the save failed, so it is tried again next time
+    if (!MarketDB::SaveHistory(data))
+        return;
+
+    for (auto cur : m_dirty) {
+        itr = m_series.find(cur);
+        if (itr == m_series.end())
+            continue;
+        for (std::vector<Day>::reverse_iterator day = itr->second.days.rbegin(); day != itr->second.days.rend(); ++day) {
+            if (!day->dirty)
+                break;
+            day->dirty = false;
+        }
+    }
+    _log(MARKET__DB_TRACE, "SaveHistory() - Saved %u days in %u series in %.3fms", (uint32)data.size(), (uint32)m_dirty.size(), (GetTimeMSeconds() - start));
+    m_dirty.clear();
+}
+
+MarketHistory::Series* MarketHistory::GetSeries(uint32 regionID, uint16 typeID)
+{
+    int64 key(MakeKey(regionID, typeID));
+    std::unordered_map<int64, Series>::iterator itr = m_series.find(key);
+    if (itr != m_series.end()) {
+        itr->second.idle = 0;
+        return &itr->second;
+    }
+
+    DBQueryResult res;
+    if (!MarketDB::GetHistory(res, regionID, typeID, sConfig.market.NewPriceLimit + sConfig.market.OldPriceLimit))
+        return nullptr;
+
+    Series* pSeries = &m_series[key];
+    pSeries->idle = 0;
+    pSeries->days.reserve(res.GetRowCount());
+
+    // results are newest first
+    DBResultRow row;
+    while (res.GetRow(row)) {
+        //SELECT historyDate, lowPrice, highPrice, avgPrice, volume, orders
+        Day day = Day();
+        day.date    = row.GetInt64(0);
+        day.low     = row.GetDouble(1);
+        day.high    = row.GetDouble(2);
+        day.avg     = row.GetDouble(3);
+        day.volume  = row.GetUInt(4);
+        day.orders  = row.GetUInt(5);
+        pSeries->days.push_back(day);
+    }
+    std::reverse(pSeries->days.begin(), pSeries->days.end());
+
+    _log(MARKET__DB_TRACE, "GetSeries() - Loaded %u days for type %u in region %u", (uint32)pSeries->days.size(), typeID, regionID);
+    return pSeries;
+}
+
+void MarketHistory::AddTransaction(uint32 regionID, uint16 typeID, double price, uint32 quantity)
+{
+    Series* pSeries = GetSeries(regionID, typeID);
+    if (pSeries == nullptr)
+        return;
+
+    int64 today(GetFileTimeNow());
+    today -= today % EvE::Time::Day;
+
+    if (pSeries->days.empty() or (pSeries->days.back().date < today)) {
+        Day day = Day();
+        day.date    = today;
+        day.low     = price;
+        day.high    = price;
+        pSeries->days.push_back(day);
+        // keep only what the client can ask for
+        uint16 limit(sConfig.market.NewPriceLimit + sConfig.market.OldPriceLimit);
+        if (pSeries->days.size() > limit)
+            pSeries->days.erase(pSeries->days.begin(), pSeries->days.end() - limit);
+    }
+
+    Day& day = pSeries->days.back();
+    if (price < day.low)
+        day.low = price;
+    if (price > day.high)
+        day.high = price;
+    // avg is per order, same as AVG(price) over the day's transactions
+    day.avg = ((day.avg * day.orders) + price) / (day.orders + 1);
+    day.volume += quantity;
+    ++day.orders;
+    day.dirty = true;
+
+    m_dirty.insert(MakeKey(regionID, typeID));
+}
+
+PyRep* MarketHistory::GetNewHistory(uint32 regionID, uint16 typeID)
+{
+    Series* pSeries = GetSeries(regionID, typeID);
+    if (pSeries == nullptr)
+        return nullptr;
+
+    int64 cutoff(GetFileTimeNow());
+    cutoff -= cutoff % EvE::Time::Day;
+    cutoff -= EvE::Time::Day;
+
+    std::vector<Day>::const_iterator begin = pSeries->days.end();
+    while ((begin != pSeries->days.begin()) and ((begin - 1)->date >= cutoff)
+    and ((pSeries->days.end() - begin) < sConfig.market.NewPriceLimit))
+        --begin;
+
+    return MakeRowset(begin, pSeries->days.end());
+}
+
+PyRep* MarketHistory::GetOldHistory(uint32 regionID, uint16 typeID)
+{
+    Series* pSeries = GetSeries(regionID, typeID);
+    if (pSeries == nullptr)
+        return nullptr;
+
+    int64 cutoff(GetFileTimeNow());
+    cutoff -= cutoff % EvE::Time::Day;
+    cutoff -= EvE::Time::Day;
+
+    std::vector<Day>::const_iterator end = pSeries->days.end();
+    while ((end != pSeries->days.begin()) and ((end - 1)->date >= cutoff))
+        --end;
+    std::vector<Day>::const_iterator begin = end;
+    if ((end - pSeries->days.begin()) > sConfig.market.OldPriceLimit)
+        begin -= sConfig.market.OldPriceLimit;
+    else
+        begin = pSeries->days.begin();
+
+    return MakeRowset(begin, end);
+}
+
+PyRep* MarketHistory::MakeRowset(std::vector<Day>::const_iterator begin, std::vector<Day>::const_iterator end)
+{
+    // same column types as the mktHistory query this replaces
+    DBRowDescriptor* header = new DBRowDescriptor();
+    header->AddColumn("historyDate",    DBTYPE_I8);
+    header->AddColumn("lowPrice",       DBTYPE_R8);
+    header->AddColumn("highPrice",      DBTYPE_R8);
+    header->AddColumn("avgPrice",       DBTYPE_R8);
+    header->AddColumn("volume",         DBTYPE_UI4);
+    header->AddColumn("orders",         DBTYPE_UI4);
+
+    CRowSet* rowset = new CRowSet(&header);
+    for (; begin != end; ++begin) {
+        PyPackedRow* row = rowset->NewRow();
+        row->SetField((uint32)0, new PyLong(begin->date));
+        row->SetField(1, new PyFloat(begin->low));
+        row->SetField(2, new PyFloat(begin->high));
+        row->SetField(3, new PyFloat(begin->avg));
+        row->SetField(4, new PyInt(begin->volume));
+        row->SetField(5, new PyInt(begin->orders));
+    }
+    return rowset;
+}
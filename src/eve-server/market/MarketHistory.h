@@ -0,0 +1,98 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name MarketHistory.h
+ *   in-memory daily market price history, aggregated as transactions happen
+ */
+
+#ifndef _EVE_SERVER_MARKET_HISTORY_H__
+#define _EVE_SERVER_MARKET_HISTORY_H__
+
+
+#include "eve-server.h"
+
+#include "market/MarketDB.h"
+
+/*
+ * history is kept per {regionID/typeID}, as a series of days oldest to newest.
+ * a series is loaded from mktHistory the first time it is used, and each sale then updates
+ *   low/high/avg/volume/orders for the current day in place.
+ * changed days are saved in one batch on Process(), so there is no periodic rebuild from mktTransactions.
+ * series not used for BookIdleTime minutes are dropped from memory.
+ */
+class MarketHistory
+: public Singleton< MarketHistory >
+{
+public:
+    MarketHistory();
+    ~MarketHistory()                                    { /* do nothing here */ }
+
+    int Initialize();
+    void Close();
+    // called every minute.  saves changed days and drops idle series
+    void Process();
+
+    void SaveHistory();
+
+    // adds a sale to today's history for this region/type
+    void AddTransaction(uint32 regionID, uint16 typeID, double price, uint32 quantity);
+
+    // returns CRowset of history, as used by marketProxy.  new is today and yesterday, old is the days before that
+    PyRep* GetNewHistory(uint32 regionID, uint16 typeID);
+    PyRep* GetOldHistory(uint32 regionID, uint16 typeID);
+
+private:
+    struct Day {
+        bool dirty;
+        uint32 volume;
+        uint32 orders;
+        int64 date;
+        double low;
+        double high;
+        double avg;
+    };
+    struct Series {
+        uint16 idle;        // minutes since last use
+        std::vector<Day> days;
+    };
+
+    static int64 MakeKey(uint32 regionID, uint32 typeID)  { return ((int64)regionID << 32) | typeID; }
+
+    // returns series, loading it from db if needed
+    Series* GetSeries(uint32 regionID, uint16 typeID);
+    // builds rowset from days in [begin, end)
+    PyRep* MakeRowset(std::vector<Day>::const_iterator begin, std::vector<Day>::const_iterator end);
+
+    std::unordered_map<int64, Series> m_series;
+    // keys of series with days to save
+    std::unordered_set<int64> m_dirty;
+};
+
+//Singleton
+#define sMktHistory \
+( MarketHistory::get() )
+
+
+#endif  // _EVE_SERVER_MARKET_HISTORY_H__
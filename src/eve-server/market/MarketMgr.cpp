@@ -19,6 +19,8 @@
 #include "cache/ObjCacheService.h"
 #include "inventory/InventoryItem.h"
 #include "market/MarketMgr.h"
+#include "market/MarketHistory.h"
+#include "market/MarketOrderBook.h"
 #include "station/StationDataMgr.h"
 
 /*
@@ -44,7 +46,8 @@ MarketMgr::~MarketMgr()
 
 void MarketMgr::Close()
 {
-    /** @todo put a save method here which will save anything changed before shutdown */
+    sOrderBook.Close();
+    sMktHistory.Close();
     PyDecRef(m_marketGroups);
     sLog.Warning("        MarketMgr", "Market Manager has been closed." );
 }
@@ -66,8 +69,10 @@ void MarketMgr::Populate()
 
     Process();
 
-    // market orders stored as {regionID/typeID}    --do we want to store orders in memory for loaded region??
-    // MarketDB::GetOrders(call.client->GetRegionID(), args.arg);
+    // market orders stored as {regionID/typeID}, loaded on first use
+    sOrderBook.Initialize();
+    // price history stored as {regionID/typeID}, updated as items sell
+    sMktHistory.Initialize();
 
     sLog.Cyan("        MarketMgr", "Market Manager Updates Price History every %u hours.", sConfig.market.HistoryUpdateTime);
     sLog.Blue("        MarketMgr", "Market Manager loaded in %.3fms.", (GetTimeMSeconds() - start));
@@ -101,31 +106,12 @@ void MarketMgr::UpdatePriceHistory()
     m_timeStamp = GetFileTimeNow() + (EvE::Time::Hour * sConfig.market.HistoryUpdateTime);
     MarketDB::SetUpdateTime(m_timeStamp);
 
+    // history itself is aggregated by MarketHistory as each sale is recorded
     DBerror err;
     int64 cutoff_time = m_timeStamp;
     cutoff_time -= cutoff_time % EvE::Time::Day;    //round down to an even day boundary.
     cutoff_time -= EvE::Time::Day * 2;  //the cutoff between "new" and "old" price history in days
 
-    /** @todo  this doesnt belong here...  */
-    //build the history record from the recent market transactions.
-    sDatabase.RunQuery(err,
-            "INSERT INTO"
-            "    mktHistory"
-            "     (regionID, typeID, historyDate, lowPrice, highPrice, avgPrice, volume, orders)"
-            " SELECT"
-            "    regionID,"
-            "    typeID,"
-            "    transactionDate,"
-            "    MIN(price),"
-            "    MAX(price),"
-            "    AVG(price),"
-            "    SUM(quantity),"
-            "    COUNT(transactionID)"
-            " FROM mktTransactions"
-            " WHERE transactionType=%u AND transactionDate < %lli",
-            //" GROUP BY regionID, typeID, transactionDate",
-            Market::Type::Sell, cutoff_time);
-
     /** @todo  this doesnt belong here...  */
     // remove the transactions which have been aged out?
     if (sConfig.market.DeleteOldTransactions)
@@ -153,22 +139,7 @@ PyRep *MarketMgr::GetNewPriceHistory(uint32 regionID, uint32 typeID) {
     //check to see if this method is in the cache already.
     if (!this->m_cache->IsCacheLoaded(method_id)) {
         //this method is not in cache yet, load up the contents and cache it
-        DBQueryResult res;
-
-        /** @todo  this doesnt belong here...  */
-        if (!sDatabase.RunQuery(res,
-            "SELECT historyDate, lowPrice, highPrice, avgPrice, volume, orders"
-            " FROM mktHistory "
-            " WHERE regionID=%u AND typeID=%u"
-            " AND historyDate > %lli  LIMIT %u",
-            regionID, typeID, (m_timeStamp - EvE::Time::Day), sConfig.market.NewPriceLimit))
-        {
-            _log(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
-            return nullptr;
-        }
-        _log(MARKET__DB_TRACE, "MarketMgr::GetNewPriceHistory() - Fetched %u buy orders for type %u in region %u from mktTransactions", res.GetRowCount(), typeID, regionID);
-
-        result = DBResultToCRowset(res);
+        result = sMktHistory.GetNewHistory(regionID, typeID);
         if (result == nullptr) {
             _log(MARKET__DB_ERROR, "Failed to load cache, generating empty contents.");
             result = PyStatic.NewNone();
@@ -195,21 +166,7 @@ PyRep *MarketMgr::GetOldPriceHistory(uint32 regionID, uint32 typeID) {
     //check to see if this method is in the cache already.
     if (!this->m_cache->IsCacheLoaded(method_id)) {
         //this method is not in cache yet, load up the contents and cache it
-        DBQueryResult res;
-
-        /** @todo  this doesnt belong here...  */
-        if (!sDatabase.RunQuery(res,
-            "SELECT historyDate, lowPrice, highPrice, avgPrice, volume, orders"
-            " FROM mktHistory WHERE regionID=%u AND typeID=%u"
-            " AND historyDate > %lli AND historyDate < %lli LIMIT %u",
-            regionID, typeID, (m_timeStamp - (EvE::Time::Day *3)), (m_timeStamp - EvE::Time::Day), sConfig.market.OldPriceLimit))
-        {
-            _log(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
-            return nullptr;
-        }
-        _log(MARKET__DB_TRACE, "MarketMgr::GetOldPriceHistory() - Fetched %u orders for type %u in region %u from mktHistory", res.GetRowCount(), typeID, regionID);
-
-        result = DBResultToCRowset(res);
+        result = sMktHistory.GetOldHistory(regionID, typeID);
         if (result == nullptr) {
             _log(MARKET__DB_ERROR, "Failed to load cache, generating empty contents.");
             result = PyStatic.NewNone();
@@ -233,7 +190,7 @@ void MarketMgr::SendOnOwnOrderChanged(Client* pClient, uint32 orderID, uint8 act
     if (order != nullptr) {
         ooc.order = order;
     } else {
-        ooc.order = MarketDB::GetOrderRow(orderID);
+        ooc.order = sOrderBook.GetOrderRow(orderID);
     }
 
     switch (action) {
@@ -259,6 +216,25 @@ void MarketMgr::SendOnOwnOrderChanged(Client* pClient, uint32 orderID, uint8 act
 }
 
 
+void MarketMgr::RecordSale(Market::TxData& data) {
+    // history is built from the sell side only, so each trade is counted once
+    sMktHistory.AddTransaction(data.regionID, data.typeID, data.price, data.quantity);
+
+    std::string method_name ("GetNewHistory_");
+    method_name += std::to_string(data.regionID);
+    method_name += "_";
+    method_name += std::to_string(data.typeID);
+    ObjectCachedMethodID new_id("marketProxy", method_name.c_str());
+    this->m_cache->InvalidateCache(new_id);
+    // a sale on a new day moves yesterday into old history
+    method_name = "GetOldHistory_";
+    method_name += std::to_string(data.regionID);
+    method_name += "_";
+    method_name += std::to_string(data.typeID);
+    ObjectCachedMethodID old_id("marketProxy", method_name.c_str());
+    this->m_cache->InvalidateCache(old_id);
+}
+
 void MarketMgr::InvalidateOrdersCache(uint32 regionID, uint32 typeID) {
     std::string method_name ("GetOrders_");
     method_name += std::to_string(regionID);
@@ -302,7 +278,7 @@ void MarketMgr::InvalidateOrdersCache(uint32 regionID, uint32 typeID) {
  */
 bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef iRef, uint32 quantity, bool useCorp, uint32 typeID, uint32 stationID, double price, uint16 accountKey/*Account::KeyType::Cash*/) {
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!MarketDB::GetOrderInfo(orderID, oInfo)) {
+    if (!sOrderBook.GetOrderInfo(orderID, oInfo)) {
         _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to get order info for #%u.", orderID);
 
         return false;
@@ -463,9 +439,9 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
 
     // this is fulfilling a buy order.  seller will receive isk from escrow if buyer is player or corp
     if (isPlayer or isCorp) {
-        // give the money to the seller from the escrow acct at station
+        // give the money to the seller from the escrow acct at the buy order's station
         AccountService::TransferFunds(
-            stDataMgr.GetOwnerID(stationID),
+            stDataMgr.GetOwnerID(oInfo.stationID),
             seller->GetCharacterID(),
             money,
             reason.c_str(),
@@ -507,6 +483,7 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
     if (!MarketDB::RecordTransaction(data)) {
         _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to record sale side of transaction.");
     }
+    RecordSale(data);
 
     // record the other side of the transaction
     data.isBuy          = Market::Type::Buy;
@@ -524,7 +501,7 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
 
         _log(MARKET__TRACE, "ExecuteBuyOrder - Partially satisfied order #%u, altering quantity to %u.", orderID, newQty);
 
-        if (!MarketDB::AlterOrderQuantity(orderID, newQty)) {
+        if (!sOrderBook.AlterOrderQuantity(orderID, newQty)) {
             _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to alter quantity of order #%u.", orderID);
             return false;
         }
@@ -540,8 +517,8 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
 
     _log(MARKET__TRACE, "ExecuteBuyOrder - Satisfied order #%u, deleting.", orderID);
 
-    PyRep* order = MarketDB::GetOrderRow(orderID);
-    if (!MarketDB::DeleteOrder(orderID)) {
+    PyRep* order = sOrderBook.GetOrderRow(orderID);
+    if (!sOrderBook.DeleteOrder(orderID)) {
         _log(MARKET__ERROR, "ExecuteBuyOrder - Failed to delete order #%u.", orderID);
         return false;
     }
@@ -559,7 +536,7 @@ bool MarketMgr::ExecuteBuyOrder(Client* seller, uint32 orderID, InventoryItemRef
 void MarketMgr::ExecuteSellOrder(Client* buyer, uint32 orderID, uint32 sellQuantity, float price, uint32 stationID, uint32 typeID, bool useCorp) {
     // attempt to retrieve information about the sell order, fail if not found
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!MarketDB::GetOrderInfo(orderID, oInfo)) {
+    if (!sOrderBook.GetOrderInfo(orderID, oInfo)) {
         _log(MARKET__ERROR,
             "ExecuteSellOrder - Failed to get info about sell order %u.",
             orderID
@@ -659,8 +636,8 @@ void MarketMgr::ExecuteSellOrder(Client* buyer, uint32 orderID, uint32 sellQuant
     if (orderConsumed) {
         _log(MARKET__TRACE, "ExecuteSellOrder - satisfied order #%u, deleting.", orderID);
 
-        PyRep* order = MarketDB::GetOrderRow(orderID);
-        if (!MarketDB::DeleteOrder(orderID)) {
+        PyRep* order = sOrderBook.GetOrderRow(orderID);
+        if (!sOrderBook.DeleteOrder(orderID)) {
             _log(MARKET__ERROR, "ExecuteSellOrder - Failed to delete order #%u.", orderID);
             return;
         }
@@ -673,7 +650,7 @@ void MarketMgr::ExecuteSellOrder(Client* buyer, uint32 orderID, uint32 sellQuant
 
         _log(MARKET__TRACE, "ExecuteSellOrder - Partially satisfied order #%u, altering quantity to %u.", orderID, newQty);
 
-        if (!MarketDB::AlterOrderQuantity(orderID, newQty)) {
+        if (!sOrderBook.AlterOrderQuantity(orderID, newQty)) {
             _log(MARKET__ERROR, "ExecuteSellOrder - Failed to alter quantity of order #%u.", orderID);
             return;
         }
@@ -708,6 +685,7 @@ void MarketMgr::ExecuteSellOrder(Client* buyer, uint32 orderID, uint32 sellQuant
     if (!MarketDB::RecordTransaction(data)) {
         _log(MARKET__ERROR, "ExecuteSellOrder - Failed to record sell side of transaction.");
     }
+    RecordSale(data);
 }
 
 
@@ -70,6 +70,8 @@ public:
 
 protected:
     void Populate();
+    // adds sell side of a transaction to price history and drops the cached history for it
+    void RecordSale(Market::TxData& data);
 
 private:
     MarketDB m_db;
@@ -0,0 +1,463 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name MarketOrderBook.cpp
+ *   in-memory regional market order books, with write-behind saves to mktOrders
+ */
+
+#include "EVEServerConfig.h"
+#include "StaticDataMgr.h"
+#include "map/MapGraph.h"
+#include "market/MarketOrderBook.h"
+
+/*
+ * MARKET__ERROR
+ * MARKET__WARNING
+ * MARKET__MESSAGE
+ * MARKET__DEBUG
+ * MARKET__TRACE
+ * MARKET__DB_ERROR
+ * MARKET__DB_TRACE
+ */
+
+MarketOrderBook::MarketOrderBook()
+{
+    m_books.clear();
+    m_orders.clear();
+    m_pending.clear();
+    m_colNames.clear();
+    m_colTypes.clear();
+}
+
+int MarketOrderBook::Initialize()
+{
+    // GetOrders() sends the column types the db reports, so get them from the db instead of guessing
+    DBQueryResult res;
+    MarketDB::GetOrderColumns(res);
+    for (uint32 i = 0; i < res.ColumnCount(); ++i) {
+        m_colNames.push_back(res.ColumnName(i));
+        m_colTypes.push_back(res.ColumnType(i));
+    }
+    if (m_colTypes.size() != 14) {
+        sLog.Error("  MarketOrderBook", "GetOrders() returned %u columns.  Order lists will be read from db.", (uint32)m_colTypes.size());
+        m_colNames.clear();
+        m_colTypes.clear();
+    }
+
+    sLog.Blue("  MarketOrderBook", "Market Order Book Initialized.");
+    return 1;
+}
+
+void MarketOrderBook::Close()
+{
+    SaveOrders();
+    m_books.clear();
+    m_orders.clear();
+    sLog.Warning("  MarketOrderBook", "Market Order Book has been closed." );
+}
+
+void MarketOrderBook::Process()
+{
+    SaveOrders();
+
+    std::unordered_map<int64, Book>::iterator itr = m_books.begin();
+    while (itr != m_books.end()) {
+        if (++itr->second.idle < sConfig.market.BookIdleTime) {
+            ++itr;
+            continue;
+        }
+        std::unordered_map<int64, Book>::iterator cur = itr++;
+        UnloadBook(cur);
+    }
+}
+
+void MarketOrderBook::SaveOrders()
+{
+    if (m_pending.empty())
+        return;
+
+    double start(GetTimeMSeconds());
+    std::unordered_map<uint32, Order>::iterator itr = m_orders.end();
+    for (auto cur : m_pending) {
+        if (cur.second) {
+            MarketDB::DeleteOrder(cur.first);
+            continue;
+        }
+        itr = m_orders.find(cur.first);
+        if (itr != m_orders.end())
+            MarketDB::UpdateOrder(cur.first, itr->second.volRemaining, itr->second.price);
+    }
+
+    _log(MARKET__DB_TRACE, "SaveOrders() - Saved %u changed orders in %.3fms", (uint32)m_pending.size(), (GetTimeMSeconds() - start));
+    m_pending.clear();
+}
+
+MarketOrderBook::Book* MarketOrderBook::GetBook(uint32 regionID, uint16 typeID)
+{
+    int64 key(MakeKey(regionID, typeID));
+    std::unordered_map<int64, Book>::iterator itr = m_books.find(key);
+    if (itr != m_books.end()) {
+        itr->second.idle = 0;
+        return &itr->second;
+    }
+
+    DBQueryResult res;
+    if (!MarketDB::GetOrderBook(res, regionID, typeID))
+        return nullptr;
+
+    Book* pBook = &m_books[key];
+    pBook->idle = 0;
+
+    DBResultRow row;
+    while (res.GetRow(row)) {
+        //SELECT orderID, ownerID, memberID, stationID, solarSystemID, orderRange, bid, price, minVolume,
+        // volEntered, volRemaining, issued, duration, jumps, isCorp, accountKey
+        Order order = Order();
+        order.orderID       = row.GetUInt(0);
+        order.ownerID       = row.GetUInt(1);
+        order.memberID      = row.GetUInt(2);
+        order.stationID     = row.GetUInt(3);
+        order.solarSystemID = row.GetUInt(4);
+        order.range         = row.GetInt(5);
+        order.bid           = row.GetBool(6);
+        order.price         = row.GetDouble(7);
+        order.minVolume     = row.GetUInt(8);
+        order.volEntered    = row.GetUInt(9);
+        order.volRemaining  = row.GetUInt(10);
+        order.issued        = row.GetInt64(11);
+        order.duration      = row.GetUInt(12);
+        order.jumps         = row.GetUInt(13);
+        order.isCorp        = row.GetBool(14);
+        order.accountKey    = row.GetUInt(15);
+        order.regionID      = regionID;
+        order.typeID        = typeID;
+        AddToBook(pBook, &(m_orders[order.orderID] = order));
+    }
+
+    _log(MARKET__DB_TRACE, "GetBook() - Loaded %u bids and %u asks for type %u in region %u", \
+            (uint32)pBook->bids.size(), (uint32)pBook->asks.size(), typeID, regionID);
+    return pBook;
+}
+
+void MarketOrderBook::AddToBook(Book* pBook, Order* pOrder)
+{
+    Entry entry = Entry();
+    entry.range = pOrder->range;
+    entry.stationID = pOrder->stationID;
+    entry.solarSystemID = pOrder->solarSystemID;
+    entry.pOrder = pOrder;
+    if (pOrder->bid) {
+        pBook->bids.emplace(pOrder->price, entry);
+    } else {
+        pBook->asks.emplace(pOrder->price, entry);
+    }
+}
+
+void MarketOrderBook::RemoveFromBook(Order* pOrder)
+{
+    std::unordered_map<int64, Book>::iterator book = m_books.find(MakeKey(pOrder->regionID, pOrder->typeID));
+    if (book == m_books.end())
+        return;
+
+    if (pOrder->bid) {
+        auto range = book->second.bids.equal_range(pOrder->price);
+        for (auto itr = range.first; itr != range.second; ++itr)
+            if (itr->second.pOrder == pOrder) {
+                book->second.bids.erase(itr);
+                return;
+            }
+    } else {
+        auto range = book->second.asks.equal_range(pOrder->price);
+        for (auto itr = range.first; itr != range.second; ++itr)
+            if (itr->second.pOrder == pOrder) {
+                book->second.asks.erase(itr);
+                return;
+            }
+    }
+}
+
+void MarketOrderBook::UnloadBook(std::unordered_map<int64, Book>::iterator itr)
+{
+    // pending changes must be saved before this is called
+    for (const auto& cur : itr->second.bids)
+        m_orders.erase(cur.second.pOrder->orderID);
+    for (const auto& cur : itr->second.asks)
+        m_orders.erase(cur.second.pOrder->orderID);
+
+    _log(MARKET__TRACE, "UnloadBook() - Unloaded idle book for type %u in region %u", (uint32)(itr->first & 0xFFFFFFFF), (uint32)(itr->first >> 32));
+    m_books.erase(itr);
+}
+
+bool MarketOrderBook::InRange(const Entry& bid, uint32 stationID, uint32 systemID)
+{
+    if (bid.stationID == stationID)
+        return true;
+    if (!sConfig.market.UseOrderRange)
+        return false;
+
+    switch (bid.range) {
+        case Market::Range::Station:
+            return false;
+        case Market::Range::Region:
+            return true;    // books are per-region
+    }
+    // range is jumps from the bid's system.  system range is 0 jumps
+    return (sMapGraph.GetJumps(bid.solarSystemID, systemID) <= bid.range);
+}
+
+uint32 MarketOrderBook::StoreOrder(Market::SaveData& data)
+{
+    uint32 orderID(MarketDB::StoreOrder(data));
+    if (orderID == 0)
+        return 0;
+
+    // only add to a loaded book.  unloaded books will get this from the db when loaded
+    std::unordered_map<int64, Book>::iterator book = m_books.find(MakeKey(data.regionID, data.typeID));
+    if (book == m_books.end())
+        return orderID;
+
+    Order order = Order();
+    order.orderID       = orderID;
+    order.ownerID       = data.ownerID;
+    order.memberID      = data.memberID;
+    order.regionID      = data.regionID;
+    order.stationID     = data.stationID;
+    order.solarSystemID = data.solarSystemID;
+    order.typeID        = data.typeID;
+    order.range         = data.orderRange;
+    order.bid           = data.bid;
+    order.isCorp        = data.isCorp;
+    order.accountKey    = data.accountKey;
+    order.minVolume     = data.minVolume;
+    order.volEntered    = data.volEntered;
+    order.volRemaining  = data.volRemaining;
+    order.issued        = data.issued;
+    order.duration      = data.duration;
+    order.jumps         = data.jumps;
+    // db stores price to 2 places
+    order.price         = std::round(data.price * 100.0) / 100.0;
+    AddToBook(&book->second, &(m_orders[orderID] = order));
+
+    return orderID;
+}
+
+bool MarketOrderBook::GetOrderInfo(uint32 orderID, Market::OrderInfo& oInfo)
+{
+    std::unordered_map<uint32, Order>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return MarketDB::GetOrderInfo(orderID, oInfo);
+
+    const Order& order = itr->second;
+    oInfo.quantity   = order.volRemaining;
+    oInfo.price      = order.price;
+    oInfo.typeID     = order.typeID;
+    oInfo.stationID  = order.stationID;
+    oInfo.regionID   = order.regionID;
+    oInfo.ownerID    = order.ownerID;
+    oInfo.isBuy      = order.bid;
+    oInfo.isCorp     = order.isCorp;
+    oInfo.memberID   = order.memberID;
+    oInfo.accountKey = order.accountKey;
+    return true;
+}
+
+bool MarketOrderBook::AlterOrderQuantity(uint32 orderID, uint32 newQty)
+{
+    std::unordered_map<uint32, Order>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return MarketDB::AlterOrderQuantity(orderID, newQty);
+
+    itr->second.volRemaining = newQty;
+    m_pending[orderID] = false;
+    return true;
+}
+
+bool MarketOrderBook::AlterOrderPrice(uint32 orderID, double newPrice)
+{
+    std::unordered_map<uint32, Order>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return MarketDB::AlterOrderPrice(orderID, newPrice);
+
+    // price is the ladder key, so move the entry
+    RemoveFromBook(&itr->second);
+    itr->second.price = std::round(newPrice * 100.0) / 100.0;
+    AddToBook(GetBook(itr->second.regionID, itr->second.typeID), &itr->second);
+    m_pending[orderID] = false;
+    return true;
+}
+
+bool MarketOrderBook::DeleteOrder(uint32 orderID)
+{
+    std::unordered_map<uint32, Order>::iterator itr = m_orders.find(orderID);
+    if (itr == m_orders.end())
+        return MarketDB::DeleteOrder(orderID);
+
+    RemoveFromBook(&itr->second);
+    m_orders.erase(itr);
+    m_pending[orderID] = true;
+    return true;
+}
+
+void MarketOrderBook::RemoveOwnerOrders(uint32 ownerID)
+{
+    std::unordered_map<uint32, Order>::iterator itr = m_orders.begin();
+    while (itr != m_orders.end()) {
+        if (itr->second.ownerID != ownerID) {
+            ++itr;
+            continue;
+        }
+        m_pending.erase(itr->first);
+        RemoveFromBook(&itr->second);
+        itr = m_orders.erase(itr);
+    }
+}
+
+uint32 MarketOrderBook::FindBuyOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price)
+{
+    Book* pBook = GetBook(sDataMgr.GetStationRegion(stationID), typeID);
+    if (pBook == nullptr)
+        return 0;
+
+    uint32 systemID(sDataMgr.GetStationSystem(stationID));
+    // bids are sorted high to low, so the first in range is the best
+    for (const auto& cur : pBook->bids) {
+        if (cur.first <= price - 0.1)
+            break;
+        if (cur.second.pOrder->volRemaining < quantity)
+            continue;
+        if (InRange(cur.second, stationID, systemID))
+            return cur.second.pOrder->orderID;
+    }
+
+    return 0;    //no order found.
+}
+
+uint32 MarketOrderBook::FindSellOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price)
+{
+    Book* pBook = GetBook(sDataMgr.GetStationRegion(stationID), typeID);
+    if (pBook == nullptr)
+        return 0;
+
+    // asks are sorted low to high, and are only filled at their station
+    for (const auto& cur : pBook->asks) {
+        if (cur.first >= price + 0.1)
+            break;
+        if (cur.second.stationID != stationID)
+            continue;
+        if (cur.second.pOrder->volRemaining >= quantity)
+            return cur.second.pOrder->orderID;
+    }
+
+    return 0;
+}
+
+PyRep* MarketOrderBook::GetOrders(uint32 regionID, uint16 typeID)
+{
+    // returns a tuple (sell, buy) of PyObjectEx with data in PyPackedRows
+    if (m_colTypes.empty())
+        return MarketDB::GetOrders(regionID, typeID);
+
+    Book* pBook = GetBook(regionID, typeID);
+    if (pBook == nullptr)
+        return nullptr;
+
+    /** @todo Mem leak.  `header` never freed  (same as DBResultToCRowset()) */
+    DBRowDescriptor* header = MakeHeader();
+    CRowSet* sell = new CRowSet(&header);
+    for (const auto& cur : pBook->asks)
+        FillRow(*cur.second.pOrder, sell->NewRow());
+    header = MakeHeader();
+    CRowSet* buy = new CRowSet(&header);
+    for (const auto& cur : pBook->bids)
+        FillRow(*cur.second.pOrder, buy->NewRow());
+
+    PyTuple* tup = new PyTuple(2);
+    tup->SetItem(0, sell);
+    tup->SetItem(1, buy);
+
+    _log(MARKET__TRACE, "GetOrders() - Built %u sell and %u buy orders for type %u", (uint32)pBook->asks.size(), (uint32)pBook->bids.size(), typeID);
+
+    if (is_log_enabled(MARKET__DUMP))
+        tup->Dump(MARKET__DUMP, "    ");
+    return tup;
+}
+
+PyRep* MarketOrderBook::GetOrderRow(uint32 orderID)
+{
+    std::unordered_map<uint32, Order>::iterator itr = m_orders.find(orderID);
+    if ((itr == m_orders.end()) or m_colTypes.empty())
+        return MarketDB::GetOrderRow(orderID);
+
+    PyPackedRow* row = new PyPackedRow(MakeHeader());
+    FillRow(itr->second, row);
+    return row;
+}
+
+DBRowDescriptor* MarketOrderBook::MakeHeader()
+{
+    DBRowDescriptor* header = new DBRowDescriptor();
+    for (uint8 i = 0; i < m_colNames.size(); ++i)
+        header->AddColumn(m_colNames[i].c_str(), m_colTypes[i]);
+    return header;
+}
+
+// builds field of the type the db would have sent for this column
+static PyRep* NewField(DBTYPE type, int64 value)
+{
+    switch (type) {
+        case DBTYPE_I8:
+        case DBTYPE_UI8:
+        case DBTYPE_CY:
+        case DBTYPE_FILETIME:
+            return new PyLong(value);
+        case DBTYPE_R4:
+        case DBTYPE_R8:
+            return new PyFloat((double)value);
+        case DBTYPE_BOOL:
+            return new PyBool(value != 0);
+        default:
+            return new PyInt((int32)value);
+    }
+}
+
+void MarketOrderBook::FillRow(const Order& order, PyPackedRow* into)
+{
+    //price, volRemaining, typeID, range, orderID, volEntered, minVolume, bid, issueDate, duration,
+    // stationID, regionID, solarSystemID, jumps
+    into->SetField((uint32)0,  new PyFloat(order.price));
+    into->SetField(1,  NewField(m_colTypes[1],  order.volRemaining));
+    into->SetField(2,  NewField(m_colTypes[2],  order.typeID));
+    into->SetField(3,  NewField(m_colTypes[3],  order.range));
+    into->SetField(4,  NewField(m_colTypes[4],  order.orderID));
+    into->SetField(5,  NewField(m_colTypes[5],  order.volEntered));
+    into->SetField(6,  NewField(m_colTypes[6],  order.minVolume));
+    into->SetField(7,  NewField(m_colTypes[7],  order.bid));
+    into->SetField(8,  NewField(m_colTypes[8],  order.issued));
+    into->SetField(9,  NewField(m_colTypes[9],  order.duration));
+    into->SetField(10, NewField(m_colTypes[10], order.stationID));
+    into->SetField(11, NewField(m_colTypes[11], order.regionID));
+    into->SetField(12, NewField(m_colTypes[12], order.solarSystemID));
+    into->SetField(13, NewField(m_colTypes[13], order.jumps));
+}
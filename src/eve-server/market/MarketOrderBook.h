@@ -0,0 +1,148 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name MarketOrderBook.h
+ *   in-memory regional market order books, with write-behind saves to mktOrders
+ */
+
+#ifndef _EVE_SERVER_MARKET_ORDERBOOK_H__
+#define _EVE_SERVER_MARKET_ORDERBOOK_H__
+
+
+#include "eve-server.h"
+
+#include "market/MarketDB.h"
+
+/*
+ * orders are kept per book of {regionID/typeID}, the same key the client asks for in GetOrders()
+ * books are loaded from the db the first time they are used, and are authoritative after that.
+ * each book has a price-sorted ladder per side (bids high to low, asks low to high) holding the
+ *   station, system and range of each order, so matching walks the ladder without touching the db.
+ * changes to loaded orders are saved on Process() (or before anything reads mktOrders directly).
+ *   new orders are still inserted immediately, as the orderID comes from the db.
+ * books not used for BookIdleTime minutes are saved and dropped from memory.
+ */
+class MarketOrderBook
+: public Singleton< MarketOrderBook >
+{
+public:
+    MarketOrderBook();
+    ~MarketOrderBook()                                  { /* do nothing here */ }
+
+    int Initialize();
+    void Close();
+    // called every minute.  saves changed orders and drops idle books
+    void Process();
+
+    // writes all pending order changes to the db.  call before querying mktOrders directly
+    void SaveOrders();
+
+    /* these replace the MarketDB methods of the same name.
+     * orders in books not loaded are read from and written to the db directly
+     */
+    uint32 StoreOrder(Market::SaveData& data);
+    bool GetOrderInfo(uint32 orderID, Market::OrderInfo& oInfo);
+    bool AlterOrderQuantity(uint32 orderID, uint32 newQty);
+    bool AlterOrderPrice(uint32 orderID, double newPrice);
+    bool DeleteOrder(uint32 orderID);
+    // drops all loaded orders for this owner.  caller deletes them from the db (character delete)
+    void RemoveOwnerOrders(uint32 ownerID);
+
+    // highest bid in range of stationID with at least quantity remaining, priced above price
+    uint32 FindBuyOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price);
+    // lowest ask at stationID with at least quantity remaining, priced below price
+    uint32 FindSellOrder(uint32 typeID, uint32 stationID, uint32 quantity, double price);
+
+    // returns tuple of (sell, buy) CRowsets for this book
+    PyRep* GetOrders(uint32 regionID, uint16 typeID);
+    // returns packed row for this order, as used in OnOwnOrderChanged
+    PyRep* GetOrderRow(uint32 orderID);
+
+private:
+    struct Order {
+        bool bid :1;
+        bool isCorp :1;
+        uint8 jumps;
+        int16 range;
+        uint16 typeID;
+        uint16 accountKey;
+        uint32 orderID;
+        uint32 ownerID;
+        uint32 memberID;
+        uint32 regionID;
+        uint32 stationID;
+        uint32 solarSystemID;
+        uint32 minVolume;
+        uint32 volEntered;
+        uint32 volRemaining;
+        uint32 duration;
+        int64 issued;
+        double price;
+    };
+    // ladder entries carry what range checks need, so only a possible match touches the order
+    struct Entry {
+        int16 range;
+        uint32 stationID;
+        uint32 solarSystemID;
+        Order* pOrder;
+    };
+    typedef std::multimap<double, Entry, std::greater<double>> BidLadder;
+    typedef std::multimap<double, Entry> AskLadder;
+    struct Book {
+        uint16 idle;        // minutes since last use
+        BidLadder bids;
+        AskLadder asks;
+    };
+
+    static int64 MakeKey(uint32 regionID, uint32 typeID)  { return ((int64)regionID << 32) | typeID; }
+
+    // returns book, loading it from db if needed
+    Book* GetBook(uint32 regionID, uint16 typeID);
+    void AddToBook(Book* pBook, Order* pOrder);
+    void RemoveFromBook(Order* pOrder);
+    void UnloadBook(std::unordered_map<int64, Book>::iterator itr);
+
+    void FillRow(const Order& order, PyPackedRow* into);
+    DBRowDescriptor* MakeHeader();
+
+    // true if a bid with this range can be filled by a seller at stationID in systemID
+    static bool InRange(const Entry& bid, uint32 stationID, uint32 systemID);
+
+    std::unordered_map<int64, Book> m_books;
+    std::unordered_map<uint32, Order> m_orders;
+    // orderIDs changed since last save.  value is true for delete, false for update
+    std::unordered_map<uint32, bool> m_pending;
+
+    // GetOrders() column names and types, as the db reports them
+    std::vector<std::string> m_colNames;
+    std::vector<DBTYPE> m_colTypes;
+};
+
+//Singleton
+#define sOrderBook \
+( MarketOrderBook::get() )
+
+
+#endif  // _EVE_SERVER_MARKET_ORDERBOOK_H__
@@ -32,10 +32,11 @@
 #include "cache/ObjCacheService.h"
 #include "inventory/Inventory.h"
 #include "market/MarketMgr.h"
+#include "market/MarketOrderBook.h"
 #include "market/MarketProxyService.h"
 #include "station/StationDataMgr.h"
 #include "system/SystemManager.h"
-#include "standing/StandingDB.h"
+#include "standing/StandingMgr.h"
 
 /*
  * MARKET__ERROR
@@ -82,24 +83,29 @@ PyResult MarketProxyService::StartupCheck(PyCallArgs &call) {
 }
 
 PyResult MarketProxyService::GetCharOrders(PyCallArgs &call) {
+    sOrderBook.SaveOrders();
     return MarketDB::GetOrdersForOwner(call.client->GetCharacterID());
 }
 
 PyResult MarketProxyService::GetCorporationOrders(PyCallArgs &call) {
+    sOrderBook.SaveOrders();
     return MarketDB::GetOrdersForOwner(call.client->GetCorporationID());
 }
 
 /** @todo update these to use market manager and cache instead of hitting db? */
 // station, system, region based on selection in market window
 PyResult MarketProxyService::GetStationAsks(PyCallArgs &call) {
+    sOrderBook.SaveOrders();
     return MarketDB::GetStationAsks(call.client->GetStationID());
 }
 
 PyResult MarketProxyService::GetSystemAsks(PyCallArgs &call) {
+    sOrderBook.SaveOrders();
     return MarketDB::GetSystemAsks(call.client->GetSystemID());
 }
 
 PyResult MarketProxyService::GetRegionBest(PyCallArgs &call) {
+    sOrderBook.SaveOrders();
     return MarketDB::GetRegionBest(call.client->GetRegionID());
 }
 
@@ -151,7 +157,7 @@ PyResult MarketProxyService::GetOrders(PyCallArgs &call, PyInt* typeID) {
     if (!this->m_cache->IsCacheLoaded(method_id))
     {
         //this method is not in cache yet, load up the contents and cache it.
-        result = MarketDB::GetOrders(call.client->GetRegionID(), typeID->value());
+        result = sOrderBook.GetOrders(call.client->GetRegionID(), typeID->value());
         if (result == nullptr) {
             _log(MARKET__DB_ERROR, "Failed to load cache, generating empty contents.");
             result = PyStatic.NewNone();
@@ -239,7 +245,7 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
         if (duration->value() == 0) {
             // immediate. look for open sell order that matches all reqs (price, qty, distance, etc)
             // check distance, set order range and make station list.
-            uint32 orderID(MarketDB::FindSellOrder(
+            uint32 orderID(sOrderBook.FindSellOrder(
                 typeID->value(),
                 stationID->value(),
                 quantity->value(),
@@ -313,7 +319,7 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
         data.jumps = 1;     // not sure if this is used....
 
         // create buy order
-        uint32 orderID(MarketDB::StoreOrder(data));
+        uint32 orderID(sOrderBook.StoreOrder(data));
         if (orderID == 0) {
             _log(MARKET__ERROR, "PlaceCharOrder - Failed to record buy order in the DB.");
             call.client->SendErrorMsg("Failed to record the order.");
@@ -326,11 +332,11 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
         uint8 lvl(call.client->GetChar()->GetSkillLevel(EvESkill::BrokerRelations));
         //call.client->GetChar()->GetStandingModified();
         uint32 stationOwnerID = stDataMgr.GetOwnerID (call.client->GetStationID ());
-        float ownerStanding = StandingDB::GetStanding (stationOwnerID, call.client->GetCharacterID ());
+        float ownerStanding = sStandingMgr.GetStanding (stationOwnerID, call.client->GetCharacterID ());
         float factionStanding = 0.0f;
 
         if (IsNPCCorp (stationOwnerID))
-            factionStanding = StandingDB::GetStanding(sDataMgr.GetCorpFaction (stationOwnerID), call.client->GetCharacterID());
+            factionStanding = sStandingMgr.GetStanding(sDataMgr.GetCorpFaction (stationOwnerID), call.client->GetCharacterID());
 
         float fee = EvEMath::Market::BrokerFee(lvl, factionStanding, ownerStanding, money);
         _log(MARKET__DEBUG, "PlaceCharOrder(buy) - %s: Escrow: %.2f, Fee: %.2f", useCorp->value() ?"Corp":"Player", money, fee);
@@ -469,10 +475,11 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
             for (int i = 0; i < 1000; i++) {
                 _log(MARKET__DUMP, "Mkt::PlaceCharOrder(): finding buy order: %i, %i, %i, %.2f", typeID->value(), stationID->value(), quantity->value(), price->value());
 
-                orderID = MarketDB::FindBuyOrder(typeID->value(), stationID->value(), quantity->value(), price->value());
+                orderID = sOrderBook.FindBuyOrder(typeID->value(), stationID->value(), quantity->value(), price->value());
 
+                // nothing changed since the last search, so another try wont find one either
                 if (!orderID) {
-                    continue;
+                    break;
                 }
 
                 _log(MARKET__TRACE,
@@ -569,11 +576,11 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
         //call.client->GetChar()->GetStandingModified();
         uint32 stationOwnerID = stDataMgr.GetOwnerID (call.client->GetStationID ());
 
-        float ownerStanding = StandingDB::GetStanding (stationOwnerID, call.client->GetCharacterID ());
+        float ownerStanding = sStandingMgr.GetStanding (stationOwnerID, call.client->GetCharacterID ());
         float factionStanding = 0.0f;
 
         if (IsNPCCorp (stationOwnerID)) {
-            factionStanding = StandingDB::GetStanding(sDataMgr.GetCorpFaction (stationOwnerID), call.client->GetCharacterID());
+            factionStanding = sStandingMgr.GetStanding(sDataMgr.GetCorpFaction (stationOwnerID), call.client->GetCharacterID());
         }
 
         float fee = EvEMath::Market::BrokerFee(lvl, factionStanding, ownerStanding, total);
@@ -605,7 +612,7 @@ PyResult MarketProxyService::PlaceCharOrder(PyCallArgs &call, PyInt* stationID,
         }
 
         // store the order in the DB.
-        uint32 orderID(MarketDB::StoreOrder(data));
+        uint32 orderID(sOrderBook.StoreOrder(data));
         if (orderID == 0) {
             _log(MARKET__ERROR, "PlaceCharOrder - Failed to record sell order in the DB.");
             call.client->SendErrorMsg("Failed to record the order in the DB!");
@@ -641,7 +648,7 @@ PyResult MarketProxyService::ModifyCharOrder(PyCallArgs &call, PyInt* orderID, P
     // client coded to throw error if price > 9223372036854.0
     // we need to pull data from db for typeID and isCorp...
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!MarketDB::GetOrderInfo(orderID->value(), oInfo)) {
+    if (!sOrderBook.GetOrderInfo(orderID->value(), oInfo)) {
         _log(MARKET__ERROR, "ModifyCharOrder - Failed to get info about order #%i.", orderID->value());
         return nullptr;
     }
@@ -664,7 +671,7 @@ PyResult MarketProxyService::ModifyCharOrder(PyCallArgs &call, PyInt* orderID, P
         Account::KeyType::Escrow
     );
 
-    if (!MarketDB::AlterOrderPrice(orderID->value(), newPrice->value())) {
+    if (!sOrderBook.AlterOrderPrice(orderID->value(), newPrice->value())) {
         _log(MARKET__ERROR, "ModifyCharOrder - Failed to modify price for order #%i.", orderID->value());
         return nullptr;
     }
@@ -677,7 +684,7 @@ PyResult MarketProxyService::ModifyCharOrder(PyCallArgs &call, PyInt* orderID, P
 
 PyResult MarketProxyService::CancelCharOrder(PyCallArgs &call, PyInt* orderID, PyInt* regionID) {
     Market::OrderInfo oInfo = Market::OrderInfo();
-    if (!MarketDB::GetOrderInfo(orderID->value(), oInfo)) {
+    if (!sOrderBook.GetOrderInfo(orderID->value(), oInfo)) {
         _log(MARKET__ERROR, "CancelCharOrder - Failed to get info about order #%i.", orderID->value());
         return nullptr;
     }
@@ -706,8 +713,8 @@ PyResult MarketProxyService::CancelCharOrder(PyCallArgs &call, PyInt* orderID, P
             iRef->Donate(call.client->GetCharacterID(), oInfo.stationID, flagHangar, true);
     }
 
-    PyRep* order(MarketDB::GetOrderRow(orderID->value()));
-    if (!MarketDB::DeleteOrder(orderID->value())) {
+    PyRep* order(sOrderBook.GetOrderRow(orderID->value()));
+    if (!sOrderBook.DeleteOrder(orderID->value())) {
         _log(MARKET__ERROR, "CancelCharOrder - Failed to delete order #%i.", orderID->value());
         return nullptr;
     }
@@ -642,12 +642,15 @@ void ConcordAI::AttackTarget(SystemEntity* pTarget) {
              m_npc->GetThermal(),
              m_npc->GetEM(),
              m_npc->GetExplosive(),
-             m_formula.GetNPCToHit(m_npc, pTarget),
+             0,     // set from to-hit when shot is resolved
              EVEEffectID::targetAttack
             );
 
     d *= m_npc->GetSelf()->GetAttribute(AttrDamageMultiplier).get_float();
-    pTarget->ApplyDamage(d);
+
+    TurretStats stats;
+    m_formula.GetNPCStats(m_npc, stats);
+    m_npc->SystemMgr()->GetCombatPass()->Queue(m_npc, pTarget, d, stats);
 }
 
 double ConcordAI::GetTargetTime()
@@ -350,13 +350,16 @@ void DroneAIMgr::AttackTarget(SystemEntity* pTarget) {
              m_pDrone->GetThermal(),
              m_pDrone->GetEM(),
              m_pDrone->GetExplosive(),
-             m_formula.GetDroneToHit(m_pDrone, pTarget),
+             0,     // set from to-hit when shot is resolved
              EVEEffectID::targetAttack
             );
 
     d *= m_pDrone->GetSelf()->GetAttribute(AttrDamageMultiplier).get_float();
     d *= sConfig.rates.damageRate;      /** @todo this should be a separate config value */
-    pTarget->ApplyDamage(d);
+
+    TurretStats stats;
+    m_formula.GetDroneStats(m_pDrone, stats);
+    m_pDrone->SystemMgr()->GetCombatPass()->Queue(m_pDrone, pTarget, d, stats);
 }
 
 
@@ -32,6 +32,7 @@
 #include "map/MapDB.h"
 #include "npc/NPC.h"
 #include "npc/NPCAI.h"
+#include "npc/NPCAIPass.h"
 #include "system/Container.h"
 #include "system/Damage.h"
 #include "system/SystemManager.h"
@@ -40,7 +41,8 @@
 NPC::NPC(InventoryItemRef self, EVEServiceManager& services, SystemManager* system, const FactionData& data, SpawnMgr* spawnMgr)
 : DynamicSystemEntity(self, services, system),
 m_spawnMgr(spawnMgr),
-m_AI(new NPCAIMgr(this))
+m_AI(new NPCAIMgr(this)),
+m_aiPassIdx(-1)
 {
     m_allyID = data.allianceID;
     m_warID = data.factionID;
@@ -72,9 +74,15 @@ m_AI(new NPCAIMgr(this))
     _log(NPC__TRACE, "Created NPC object for %s (%u) - Data: O:%u, C:%u, A:%u, W:%u", \
             m_self.get()->name(), m_self.get()->itemID(), \
             m_ownerID, m_corpID, m_allyID, m_warID);
+
+    // idle target scans are run for all npcs in the system at once
+    if (m_system != nullptr)
+        m_system->GetNPCAIPass()->Add(this);
 }
 
 NPC::~NPC() {
+    if (m_system != nullptr)
+        m_system->GetNPCAIPass()->Remove(this);
     SafeDelete(m_AI);
 }
 
@@ -81,6 +81,10 @@ public:
     NPCAIMgr* GetAIMgr()                                { return m_AI; }
     SpawnMgr* GetSpawnMgr()                             { return m_spawnMgr; }
 
+    // slot in our system's NPCAIPass, so it can remove us without a search.  -1 when not in it
+    int32 GetAIPassIndex()                              { return m_aiPassIdx; }
+    void SetAIPassIndex(int32 idx)                      { m_aiPassIdx = idx; }
+
     /* for command dropLoot - commands all npcs in bubble to jettison loot */
     void CmdDropLoot();
 
@@ -99,6 +103,8 @@ private:
     float m_armorDamage;
     float m_shieldCharge;
     float m_shieldCapacity;
+
+    int32 m_aiPassIdx;
 };
 
 #endif
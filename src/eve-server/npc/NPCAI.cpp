@@ -59,7 +59,6 @@ NPCAIMgr::NPCAIMgr(NPC* who)
   m_warpOutTimer(0),
   m_shieldBoosterTimer(0),
   m_armorRepairTimer(0),
-  m_beginFindTarget(0),
   m_warpScramblerTimer(0),
   m_webifierTimer(0),
   m_missileTypeID(0),
@@ -287,42 +286,7 @@ void NPCAIMgr::Process() {
      */
     switch(m_state) {
         case NPCAI::State::Idle: {
-            if (m_beginFindTarget.Check()) {
-                std::vector<Client*> clientVec;
-                clientVec.clear();
-                DestinyManager* pDestiny(nullptr);
-                m_npc->SysBubble()->GetPlayers(clientVec); // what about player drones?  yes...later
-                for (auto cur : clientVec) {
-                    if (cur->IsInvul())
-                        continue;
-                    if (cur->GetShipSE() == nullptr)
-                        continue;
-                    if (cur->InPod()) {
-                        if (sConfig.npc.TargetPod) {
-                            if (m_npc->SystemMgr()->GetSystemSecurityRating() > sConfig.npc.TargetPodSec)
-                                continue;
-                        } else {
-                            continue;
-                        }
-                    }
-                    pDestiny = cur->GetShipSE()->DestinyMgr();
-                    if (pDestiny == nullptr)   // this shouldnt be needed, but whatever...
-                        continue;
-                    if (pDestiny->IsCloaked() or pDestiny->IsWarping())
-                        continue;
-                    if (m_npc->GetPosition().distance(cur->GetShipSE()->GetPosition()) > m_sightRange)
-                        continue;
-
-                    Target(cur->GetShipSE());
-                    return;
-                }
-                if (sConfig.npc.IdleWander)
-                    if (!m_isWandering)
-                        SetWander();
-            } else {
-                if (!m_beginFindTarget.Enabled())
-                    m_beginFindTarget.Start(m_attackSpeed);  //find target is based on npc attack speed.
-            }
+            // idle target scans are batched per bubble by NPCAIPass, which calls Target() or FoundNoTarget()
         } break;
         case NPCAI::State::Chasing:
         case NPCAI::State::Following:
@@ -439,6 +403,12 @@ void NPCAIMgr::SetWander()
     }
 }
 
+void NPCAIMgr::FoundNoTarget() {
+    if (sConfig.npc.IdleWander)
+        if (!m_isWandering)
+            SetWander();
+}
+
 void NPCAIMgr::SetIdle() {
     if (m_state == NPCAI::State::Idle)
         return;
@@ -453,7 +423,6 @@ void NPCAIMgr::SetIdle() {
 
     m_missileTimer.Disable();
     m_webifierTimer.Disable();
-    m_beginFindTarget.Disable();
     m_mainAttackTimer.Disable();
     m_armorRepairTimer.Disable();
     m_warpScramblerTimer.Disable();
@@ -597,7 +566,6 @@ void NPCAIMgr::Target(SystemEntity* pSE) {
         }
         return;
     }
-    m_beginFindTarget.Disable();
     CheckDistance(pSE);
 
     if (!m_mainAttackTimer.Enabled())
@@ -633,7 +601,6 @@ void NPCAIMgr::Targeted(SystemEntity* pSE) {
                     SetIdle();
                 }
             }
-            m_beginFindTarget.Disable();
             //CheckDistance(pAgressor);
         } break;
 
@@ -745,7 +712,7 @@ void NPCAIMgr::AttackTarget(SystemEntity* pSE) {
              m_npc->GetThermal(),
              m_npc->GetEM(),
              m_npc->GetExplosive(),
-             m_formula.GetNPCToHit(m_npc, pSE),
+             0,     // set from to-hit when shot is resolved
              EVEEffectID::targetAttack
             );
 
@@ -753,7 +720,9 @@ void NPCAIMgr::AttackTarget(SystemEntity* pSE) {
         if (m_damageMultiplier > 0)
             d *= m_damageMultiplier;
 
-    pSE->ApplyDamage(d);
+    TurretStats stats;
+    m_formula.GetNPCStats(m_npc, stats);
+    m_npc->SystemMgr()->GetCombatPass()->Queue(m_npc, pSE, d, stats);
 }
 
 /* missile shit..
@@ -796,13 +765,8 @@ void NPCAIMgr::LaunchMissile(uint16 typeID, SystemEntity* pSE)
     Missile* pMissile = new Missile(missileRef, pSystem->GetServiceMgr(),  pSystem, m_self, pSE, m_npc);
     if (pMissile == nullptr)
         return; // make error here
-    double distance = pMissile->GetPosition().distance(pSE->GetPosition());
-    double missileSpeed = missileRef->GetAttribute(AttrMaxVelocity).get_float();
-    double travelTime = (distance/missileSpeed);
-    if (travelTime < 1)
-        travelTime = 1;
-    pMissile->SetSpeed(missileSpeed);
-    pMissile->SetHitTimer(travelTime *1000);
+    // flight time and hit are worked out by the system's MissileVolleyMgr
+    pMissile->SetSpeed(missileRef->GetAttribute(AttrMaxVelocity).get_float());
     pMissile->DestinyMgr()->MakeMissile(pMissile);
 
     // tell target a missile has been launched at them.. (defender missile trigger for ship, tower, pos, npc, others?)
@@ -73,11 +73,15 @@ public:
     uint16 GetSigRes()                                  { return m_sigResolution; }
     uint32 GetFalloff()                                 { return m_falloff; }
     uint32 GetAttackRange()                             { return m_maxAttackRange; }
+    uint32 GetSightRange()                              { return m_sightRange; }
+    uint16 GetAttackSpeed()                             { return m_attackSpeed; }
     double GetTrackingSpeed()                           { return m_trackingSpeed; }
 
     // npcAI methods
     void DisableWarpOutTimer()                          { m_warpOutTimer.Disable(); }
     void WarpOutComplete()                              { m_warpOutTimer.Disable(); m_state = NPCAI::State::Idle; }
+    // called by NPCAIPass when an idle scan finds nothing in sight
+    void FoundNoTarget();
 
     void LaunchMissile(uint16 typeID, SystemEntity* pTargSE);   // us to them
     void MissileLaunched(Missile* pMissile); // them to us
@@ -153,7 +157,6 @@ private:
     Timer m_missileTimer;
     Timer m_shieldBoosterTimer;
     Timer m_armorRepairTimer;
-    Timer m_beginFindTarget;
     Timer m_warpOutTimer;
     Timer m_warpScramblerTimer;
     Timer m_webifierTimer;
@@ -0,0 +1,194 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#include "eve-server.h"
+
+#include "Client.h"
+#include "npc/NPC.h"
+#include "npc/NPCAI.h"
+#include "npc/NPCAIPass.h"
+#include "system/DestinyManager.h"
+#include "system/SystemBubble.h"
+#include "system/SystemManager.h"
+
+void NPCTargetList::Clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_se.clear();
+}
+
+void NPCTargetList::Add(SystemEntity* pSE, const GPoint& pos)
+{
+    m_x.push_back(pos.x);
+    m_y.push_back(pos.y);
+    m_z.push_back(pos.z);
+    m_se.push_back(pSE);
+}
+
+int32 NPCTargetList::Nearest(const GPoint& pos, double range)
+{
+    const size_t count(m_se.size());
+    m_dist.resize(count);
+    const double px(pos.x), py(pos.y), pz(pos.z);
+    const double* x(m_x.data());
+    const double* y(m_y.data());
+    const double* z(m_z.data());
+    double* dist(m_dist.data());
+    for (size_t i = 0; i < count; ++i) {
+        const double dx(x[i] - px), dy(y[i] - py), dz(z[i] - pz);
+        dist[i] = dx * dx + dy * dy + dz * dz;
+    }
+
+    int32 idx(-1);
+    double best(range * range);
+    for (size_t i = 0; i < count; ++i)
+        if (dist[i] <= best) {
+            best = dist[i];
+            idx = i;
+        }
+    return idx;
+}
+
+bool NPCTargetList::InRange(int32 idx, const GPoint& pos, double range)
+{
+    const double dx(m_x[idx] - pos.x), dy(m_y[idx] - pos.y), dz(m_z[idx] - pos.z);
+    return ((dx * dx + dy * dy + dz * dz) <= (range * range));
+}
+
+
+NPCAIPass::NPCAIPass(SystemManager* pSystem)
+: m_system(pSystem)
+{
+    m_npcs.clear();
+    m_due.clear();
+}
+
+void NPCAIPass::Add(NPC* pNPC)
+{
+    if (pNPC->GetAIPassIndex() > -1)
+        return;
+    pNPC->SetAIPassIndex((int32)m_npcs.size());
+    m_npcs.push_back(pNPC);
+}
+
+void NPCAIPass::Remove(NPC* pNPC)
+{
+    int32 idx(pNPC->GetAIPassIndex());
+    if ((idx < 0) or ((size_t)idx >= m_npcs.size()) or (m_npcs[idx] != pNPC))
+        return;
+    // move last npc into this slot
+    m_npcs[idx] = m_npcs.back();
+    m_npcs[idx]->SetAIPassIndex(idx);
+    m_npcs.pop_back();
+    pNPC->SetAIPassIndex(-1);
+}
+
+void NPCAIPass::Process(uint32 stamp)
+{
+    if (m_npcs.empty())
+        return;
+
+    for (auto& cur : m_due)
+        cur.second.clear();
+
+    bool due(false);
+    NPCAIMgr* pAI(nullptr);
+    for (auto cur : m_npcs) {
+        if (cur->IsDead())
+            continue;
+        if (cur->SysBubble() == nullptr)
+            continue;
+        pAI = cur->GetAIMgr();
+        if (!pAI->IsIdle())
+            continue;
+        if ((stamp + cur->GetID()) % GetScanCycle(pAI->GetAttackSpeed()))
+            continue;
+        if (cur->DestinyMgr()->IsWarping())
+            continue;
+        m_due[cur->SysBubble()->GetID()].push_back(cur);
+        due = true;
+    }
+
+    if (!due)
+        return;
+
+    int32 idx(-1), groupIdx(-1);
+    for (auto& cur : m_due) {
+        if (cur.second.empty())
+            continue;
+
+        FillTargets(cur.second.front()->SysBubble());
+        groupIdx = -1;
+        for (auto pNPC : cur.second) {
+            pAI = pNPC->GetAIMgr();
+            idx = -1;
+            if (!m_targets.IsEmpty()) {
+                if ((groupIdx > -1) and m_targets.InRange(groupIdx, pNPC->GetPosition(), pAI->GetSightRange())) {
+                    idx = groupIdx;
+                } else {
+                    idx = m_targets.Nearest(pNPC->GetPosition(), pAI->GetSightRange());
+                }
+            }
+
+            if (idx < 0) {
+                pAI->FoundNoTarget();
+                continue;
+            }
+
+            if (groupIdx < 0)
+                groupIdx = idx;
+            pAI->Target(m_targets.Get(idx));
+        }
+    }
+}
+
+void NPCAIPass::FillTargets(SystemBubble* pBubble)
+{
+    m_targets.Clear();
+    if (!pBubble->HasPlayers())
+        return;
+
+    // pods are only attacked in systems at or below the configured security
+    bool targetPod(sConfig.npc.TargetPod and (m_system->GetSystemSecurityRating() <= sConfig.npc.TargetPodSec));
+
+    pBubble->GetPlayers(m_clients); // what about player drones?  yes...later
+    DestinyManager* pDestiny(nullptr);
+    for (auto cur : m_clients) {
+        if (cur->IsInvul())
+            continue;
+        if (cur->GetShipSE() == nullptr)
+            continue;
+        if (cur->InPod() and !targetPod)
+            continue;
+        pDestiny = cur->GetShipSE()->DestinyMgr();
+        if (pDestiny == nullptr)   // this shouldnt be needed, but whatever...
+            continue;
+        if (pDestiny->IsCloaked() or pDestiny->IsWarping())
+            continue;
+        m_targets.Add(cur->GetShipSE(), cur->GetShipSE()->GetPosition());
+    }
+}
@@ -0,0 +1,98 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#ifndef EVEMU_NPC_NPCAIPASS_H__
+#define EVEMU_NPC_NPCAIPASS_H__
+
+#include "../eve-server.h"
+
+class Client;
+class NPC;
+class SystemBubble;
+class SystemEntity;
+class SystemManager;
+
+/*  structure-of-arrays list of attackable player ships in one bubble.
+ *  filled once per bubble per tic, then queried by every idle npc in that bubble.
+ */
+class NPCTargetList {
+public:
+    NPCTargetList()                                     { /* do nothing here */ }
+    ~NPCTargetList()                                    { /* do nothing here */ }
+
+    void Clear();
+    void Add(SystemEntity* pSE, const GPoint& pos);
+
+    bool IsEmpty()                                      { return m_se.empty(); }
+    size_t Size()                                       { return m_se.size(); }
+    SystemEntity* Get(int32 idx)                        { return m_se[idx]; }
+
+    // index of nearest entry within range of pos, or -1 if there are none
+    int32 Nearest(const GPoint& pos, double range);
+    bool InRange(int32 idx, const GPoint& pos, double range);
+
+private:
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    std::vector<SystemEntity*> m_se;
+    std::vector<double> m_dist;     // scratch for query results
+};
+
+/*  system-level pass over idle npc ai.  owned by SystemManager and run once per tic, before entities are processed.
+ *  npcs register themselves on creation.  non-idle npcs are left to NPCAIMgr::Process().
+ *  each idle npc looks for targets once per attack cycle, on a tic slot set by its itemID, so a spawn doesn't all look at once.
+ *  npcs due this tic are grouped by bubble, and each bubble with players builds one NPCTargetList for all of them.
+ *  npcs in a bubble are one spawn group, so they take the group's target when they can see it, else the nearest they can see.
+ *  only npcs that change state (target found, or begin wandering) get any further per-npc work.
+ */
+class NPCAIPass {
+public:
+    NPCAIPass(SystemManager* pSystem);
+    ~NPCAIPass()                                        { /* do nothing here */ }
+
+    void Add(NPC* pNPC);
+    void Remove(NPC* pNPC);
+    size_t Size()                                       { return m_npcs.size(); }
+
+    void Process(uint32 stamp);
+
+    // attack cycle in tics.  idle npcs look for targets when (stamp + itemID) % cycle is 0
+    static uint32 GetScanCycle(uint32 attackSpeed)      { return ((attackSpeed < 2000) ? 1 : (attackSpeed / 1000)); }
+
+protected:
+    void FillTargets(SystemBubble* pBubble);
+
+private:
+    SystemManager* m_system;
+
+    std::vector<NPC*> m_npcs;
+    // bubbleID/idle npcs due this tic.  vectors are kept between tics to keep their allocation
+    std::map<uint16, std::vector<NPC*>> m_due;
+    NPCTargetList m_targets;
+    std::vector<Client*> m_clients;
+};
+
+#endif  // EVEMU_NPC_NPCAIPASS_H__
@@ -317,12 +317,15 @@ void SentryAI::AttackTarget(SystemEntity* pTarget) {
              m_npc->GetThermal(),
              m_npc->GetEM(),
              m_npc->GetExplosive(),
-             m_formula.GetSentryToHit(m_npc, pTarget),
+             0,     // set from to-hit when shot is resolved
              EVEEffectID::targetAttack
     );
 
     d *= m_damageMultiplier;
-    pTarget->ApplyDamage(d);
+
+    TurretStats stats;
+    m_formula.GetSentryStats(m_npc, stats);
+    m_npc->SystemMgr()->GetCombatPass()->Queue(m_npc, pTarget, d, stats);
 }
 
 double SentryAI::GetTargetTime()
@@ -109,8 +109,7 @@ P4          1,200,000 ISK
 Colony::Colony(EVEServiceManager& mgr, Client* pClient, SystemEntity* pSE)
 :m_svcMgr(mgr),
 m_client(pClient),
-m_pSE(pSE->GetPlanetSE()),
-m_colonyTimer(0)
+m_pSE(pSE->GetPlanetSE())
 {
     ccPin = new PI_CCPin();
 
@@ -124,6 +123,7 @@ m_colonyTimer(0)
     m_pLevel = 5;
     m_colonyID = 0;
     m_procTime = 0; // process check.  init to zero and stores last proc time, which is lastRunTime in command center
+    m_nextEvent = 0;
     tempPinIDs.clear();
     _log(COLONY__DEBUG, "Colony::Colony() c'tor called for %s(%u) by %s(%u)", pSE->GetName(), pSE->GetID(), pClient->GetName(), pClient->GetCharacterID());
 }
@@ -198,13 +198,17 @@ void Colony::Save()
     m_db.UpdatePlanetPins(m_colonyID, ccPin->pins.size());
 }
 
-// called by PlanetSE::Process() for loaded colony.
+// called by PlanetSE::Process() @ 1m for loaded colony.
 //  NOTE: colony is only loaded AFTER client calls for it.
 void Colony::Process()
 {
-    if (m_colonyTimer.Check()) { //  this will process colony data every 30 mins. (typical cycle time)
+    /* colony only runs when its next ecu or plant cycle ends.
+     * Update() fast-forwards everything from the last run, so nothing is lost between events,
+     *  and client calls (GetColony) run it on demand.
+     */
+    if ((m_nextEvent > 0) and (m_nextEvent <= GetFileTimeNow())) {
         if (ccPin->pins.empty()) {
-            m_colonyTimer.Disable();
+            m_nextEvent = 0;
             return;
         }
 
@@ -218,33 +222,44 @@ void Colony::Process()
 
     if (m_toUpdate) {
         //  this is part of clever code to avoid db hits on every update.
-        //  this method will check for updated contents and save to db as needed.
-        std::map<uint32, PI_Pin>::iterator itr;
-        for (auto cur : ccPin->pins)
-            if (cur.second.update) {
-                m_db.RemoveContents(cur.first);
-                m_db.SavePinContents(m_colonyID, cur.first, cur.second.contents);
-                cur.second.update = false;
-                if (cur.second.isProcess) {
-                    itr = ccPin->pins.find(cur.first);
-                    if (itr != ccPin->pins.end()) {
-                        itr->second.state                   = cur.second.state;
-                        itr->second.cycleTime               = cur.second.cycleTime;
-                        itr->second.installTime             = cur.second.installTime;
-                        itr->second.lastRunTime             = cur.second.lastRunTime;
-                        itr->second.schematicID             = cur.second.schematicID;
-                        itr->second.qtyPerCycle             = cur.second.qtyPerCycle;
-                        itr->second.hasReceivedInputs       = cur.second.hasReceivedInputs;
-                        itr->second.receivedInputsLastCycle = cur.second.receivedInputsLastCycle;
-                    }
-                }
-            }
+        //  changed pin contents are saved in one batch, then plant data is copied to pins and saved with them.
+        m_db.SaveChangedContents(ccPin);
+        for (auto& cur : ccPin->pins)
+            cur.second.update = false;
 
-        m_db.UpdatePins(0, ccPin);
+        UpdatePlantPins();
         m_toUpdate = false;
     }
 }
 
+void Colony::ScheduleNextEvent()
+{
+    m_nextEvent = 0;
+    int64 time(0);
+    for (auto& cur : ccPin->pins) {
+        if (!cur.second.isECU or (cur.second.cycleTime < 1))
+            continue;
+        time = (cur.second.lastRunTime < EvE::Time::Hour ? cur.second.installTime : cur.second.lastRunTime);
+        time += cur.second.cycleTime;
+        // program has ended
+        if (time > cur.second.expiryTime)
+            continue;
+        if ((m_nextEvent == 0) or (time < m_nextEvent))
+            m_nextEvent = time;
+    }
+    // idle plants are checked each cycle also, as inputs may be added to storage by the client
+    for (auto& cur : ccPin->plants) {
+        if ((cur.second.schematicID == 0) or (cur.second.cycleTime < 1))
+            continue;
+        time = cur.second.lastRunTime + cur.second.cycleTime;
+        if ((m_nextEvent == 0) or (time < m_nextEvent))
+            m_nextEvent = time;
+    }
+
+    if (is_log_enabled(COLONY__DEBUG))
+        _log(COLONY__DEBUG, "Colony::ScheduleNextEvent() - next event for colony %u in %lli seconds.", m_colonyID, (m_nextEvent > 0 ? (m_nextEvent - GetFileTimeNow()) / EvE::Time::Second : 0));
+}
+
 uint32 Colony::GetOwner()
 {
     return m_client->GetCharacterID();
@@ -291,12 +306,10 @@ void Colony::LoadPlants()
         }
     }
 
-    // set process timer to 30m
-    if (!m_colonyTimer.Enabled())
-        m_colonyTimer.Start(30*60*1000);
-
     if (update)
         UpdatePlantPins();
+
+    ScheduleNextEvent();
 }
 
 void Colony::UpdatePlantPins(uint32 pinID/*0*/)
@@ -354,7 +367,7 @@ void Colony::AbandonColony()
     SafeDelete(ccPin);
     ccPin = new PI_CCPin();
     m_colonyID = 0;
-    m_colonyTimer.Disable();
+    m_nextEvent = 0;
 }
 
 void Colony::CreateCommandPin(uint32 itemID, uint32 typeID, double latitude, double longitude) {
@@ -778,9 +791,6 @@ void Colony::SetSchematic(uint32 pinID, uint8 schematicID/*0*/)
 
         m_pLevel = (uint8)EvE::min(m_pLevel, itr->second.pLevel);
 
-        // set process timer to 30m
-        if (!m_colonyTimer.Enabled())
-            m_colonyTimer.Start(30*60*1000);
         _log(COLONY__INFO, "Colony::SetSchematic() - Set Schematic %u in plantID %u", schematicID, pinID);
     } else {
         itr->second = PI_Plant();
@@ -790,6 +800,7 @@ void Colony::SetSchematic(uint32 pinID, uint8 schematicID/*0*/)
     }
     // save schematic update
     UpdatePlantPins(pinID); // this MUST be called before Save() and GetColony() to update plant pin with current data
+    ScheduleNextEvent();
 }
 
 void Colony::InstallProgram(uint32 ecuID, uint16 typeID, float headRadius, PlanetMgr* pPMgr)
@@ -850,9 +861,7 @@ void Colony::SetProgramResults(uint32 ecuID, uint16 typeID, uint16 numCycles, fl
     // save extraction quantity in ecu attrib    this doesnt check for invalid item
     sItemFactory.GetItemRef(ecuID)->SetAttribute(AttrPinExtractionQuantity, qtyPerCycle, false);
 
-    // set process timer to 30m
-    if (!m_colonyTimer.Enabled())
-        m_colonyTimer.Start(30*60*1000);
+    ScheduleNextEvent();
 }
 /*{'FullPath': u'UI/Messages', 'messageID': 256790, 'label': u'PlanetBlackListedBody'}(u'{planet} is not available for the general public.', None, {u'{planet}': {'conditionalValues': [], 'variableType': 10, 'propertyName': None, 'args': 0, 'kwargs': {}, 'variableName': 'planet'}})
  * {'FullPath': u'UI/Messages', 'messageID': 256791, 'label': u'CannotInstallWithoutScanResultsBody'}(u'Your mining foreman reports that an intern seems to have misplaced the necessary mineral survey results. You will need to order a fresh deposit scan before this {typeName} can begin operating.', None, {u'{typeName}': {'conditionalValues': [], 'variableType': 10, 'propertyName': None, 'args': 0, 'kwargs': {}, 'variableName': 'typeName'}})
@@ -1364,15 +1373,15 @@ void Colony::Update(bool updateTimes/*false*/)
     if (is_log_enabled(COLONY__DEBUG))
         _log(COLONY__DEBUG, "Colony::Update() - Starting Update for colony %u on %s.", m_colonyID, m_pSE->GetName());
 
+    // update colony time to current time, so this update runs everything up to now (prior to sending out current colony status)
+    m_procTime = GetFileTimeNow();
+
     // first, process ecus for raw matls.
     ProcessECUs(updateTimes);
     // second, process plants for production.
     ProcessPlants(updateTimes);
     // third, update plants for matl's received
 
-    // update colony time to current time (based on this update, prior to sending out current colony status)
-    m_procTime = GetFileTimeNow();
-
     // update CommandCenter pin times
     if (updateTimes) {
         std::map<uint32, PI_Pin>::iterator itr = ccPin->pins.find(m_colonyID);
@@ -1382,6 +1391,8 @@ void Colony::Update(bool updateTimes/*false*/)
         m_toUpdate = true;
     }
 
+    ScheduleNextEvent();
+
     // empty colony runs in 47 - 80 us
     _log(COLONY__INFO, "Colony::Update() - Update completed in %.3fus with %lu links, %lu pins, %lu plants, and %lu routes (s:%lu, d:%lu) ", \
                     GetTimeUSeconds() - profileStartTime, ccPin->links.size(), ccPin->pins.size(), ccPin->plants.size(), ccPin->routes.size(), \
@@ -1391,29 +1402,29 @@ void Colony::Update(bool updateTimes/*false*/)
 void Colony::ProcessECUs(bool& updateTimes)
 {
     /** @todo  this needs complete review/overhaul...many errors here */
-    double delta = 0;
-    uint16 cycles = 0, quantity = 0, amount = 0, count = 0;
+    int64 endTime = 0;
+    uint32 amount = 0, cycles = 0, done = 0;
+    double yield = 0;
     std::map<uint16, uint32>::iterator itemItr;
     std::map<uint32, PI_Pin>::iterator destPin;
     std::map<uint32, PI_Plant>::iterator plant;
-    for (auto ecu : ccPin->pins) {
+    for (auto& ecu : ccPin->pins) {
         if (!ecu.second.isECU)
             continue;
 
-        if ((ecu.second.expiryTime < EvE::Time::Second ) or (ecu.second.expiryTime > m_procTime)) {
+        if (ecu.second.expiryTime < EvE::Time::Second) {
             if (is_log_enabled(COLONY__DEBUG))
-                _log(COLONY__DEBUG, "Colony::ProcessECUs() - expiryTime (%lli) > m_procTime (%lli).", \
-                        ecu.second.expiryTime, m_procTime);
+                _log(COLONY__DEBUG, "Colony::ProcessECUs() - no program installed in ECU %u.", ecu.first);
             continue;
         }
-        if (ecu.second.cycleTime < 0.0f) {
+        if (ecu.second.cycleTime < 1) {
             if (is_log_enabled(COLONY__DEBUG))
-                _log(COLONY__DEBUG, "Colony::ProcessECUs() - cycleTime < 0.");
+                _log(COLONY__DEBUG, "Colony::ProcessECUs() - cycleTime < 1.");
             continue;
         }
 
         if (ecu.second.lastRunTime < EvE::Time::Hour)
-            ecu.second.lastRunTime = ecu.second.expiryTime - ecu.second.cycleTime;
+            ecu.second.lastRunTime = ecu.second.installTime;
 
         /** @todo  as i dont have data on planet resources, and am not tracking depletion, extraction qtys used here are
          * sent from the client during 'survey program' installation, and do not simulate the diminishing returns as shown in
@@ -1427,37 +1438,37 @@ void Colony::ProcessECUs(bool& updateTimes)
          * but it could get messy later....
          */
 
-        // dont loop...get #cycles to 'run' and set amounts accordingly
-        delta = (m_procTime - ecu.second.expiryTime) / EvE::Time::Hour;
-        cycles = delta / (ecu.second.cycleTime / EvE::Time::Hour);
+        // dont loop...get #cycles completed since last run, up to end of program
+        endTime = std::min(m_procTime, ecu.second.expiryTime);
+        if (endTime <= ecu.second.lastRunTime)
+            continue;
+        cycles = (endTime - ecu.second.lastRunTime) / ecu.second.cycleTime;
+        if (cycles < 1)
+            continue;
 
-        /** @todo  verify cycles isnt over program cycle count */
+        /* diminishing returns are 95% of the previous cycle, counted from program install.
+         * cycle n yields qty * 0.95^n, so the cycles from done+1 to done+cycles sum to
+         *   qty * 0.95^(done+1) * (1 - 0.95^cycles) / 0.05
+         */
+        done = (ecu.second.lastRunTime - ecu.second.installTime) / ecu.second.cycleTime;
+        yield = std::pow(0.95, done + 1) * (1 - std::pow(0.95, cycles)) / 0.05;
 
         // first - see if this ecu has a route and move contents per route.  this will simulate aquisition of raw matls from heads to storage
         if (is_log_enabled(COLONY__DEBUG))
-            _log(COLONY__DEBUG, "Colony::ProcessECUs() - ECU pin %u - begin processing with %u cycles (%0.2f / %0.2f)", \
-                    ecu.first, cycles, delta, (ecu.second.cycleTime / EvE::Time::Hour));
-        auto destRouteItr = m_destRoutes.equal_range(plant->first);  // sum ting wong
-        for (auto it = destRouteItr.first; it != destRouteItr.second; ++it) {
-            // verify this route begins at this pin.
-            //if (it->second.srcPinID != ecu.first)
-            //    continue;
-
+            _log(COLONY__DEBUG, "Colony::ProcessECUs() - ECU pin %u - begin processing with %u cycles (%u done, yield %.3f)", \
+                    ecu.first, cycles, done, yield);
+        auto srcRouteItr = m_srcRoutes.equal_range(ecu.first);
+        for (auto it = srcRouteItr.first; it != srcRouteItr.second; ++it) {
             // second - update current contents per route movement as noted above (there are no stored contents to update in the ECU)
             // get route destination pin and update qty
-            destPin = ccPin->pins.find(it->first);
+            destPin = ccPin->pins.find(it->second.destPinID);
             if (destPin == ccPin->pins.end()) {
-                _log(COLONY__ERROR, "Colony::ProcessECUs() - Dest pinID %u not found in ccPin.pins map", it->first);
+                _log(COLONY__ERROR, "Colony::ProcessECUs() - Dest pinID %u not found in ccPin.pins map", it->second.destPinID);
                 continue;
             }
-            //  loop thru cycles to apply diminishing returns
-            count = cycles;
-            quantity = it->second.commodityQuantity;
-            while (count) {
-                quantity *= 0.95;
-                amount += quantity;
-                --count;
-            }
+            amount = it->second.commodityQuantity * yield;
+            if (amount < 1)
+                continue;
             // contents are stored in each pin.  PI_Pin.contents(std::map<uint16, uint32>(typeID, qty))
             itemItr = destPin->second.contents.find(it->second.commodityTypeID);
             /** @todo  set/implement storage capy for pin - PI_Pin.capacity, PI_Pin.quantity */
@@ -1491,11 +1502,8 @@ void Colony::ProcessECUs(bool& updateTimes)
             }
         }
 
-        // third - reset cycle times.
-        // set expiryTime to previous runtime plus cycleTime to simulate end of cycle
-        ecu.second.expiryTime = ecu.second.lastRunTime + ecu.second.cycleTime * cycles;
-        // set lastRunTime to last-processed cycle's expire time.
-        ecu.second.lastRunTime = ecu.second.expiryTime;
+        // third - set lastRunTime to end of last-processed cycle.  partial cycles are run on the next update
+        ecu.second.lastRunTime += ecu.second.cycleTime * cycles;
         updateTimes = true;
 
         if (is_log_enabled(COLONY__DEBUG))
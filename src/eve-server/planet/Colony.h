@@ -91,6 +91,8 @@ public:
 
     int8 GetLevel()                                     { return ccPin->level; }
     int64 GetSimTime()                                  { return m_procTime; }
+    // filetime of next extractor or plant cycle end.  0 if nothing is running
+    int64 GetNextEvent()                                { return m_nextEvent; }
 
 private:
     EVEServiceManager& m_svcMgr;
@@ -98,8 +100,6 @@ private:
     PI_CCPin* ccPin;
     Client* m_client;
 
-    Timer m_colonyTimer;
-
     PlanetDB m_db;
 
     bool m_active;
@@ -113,6 +113,10 @@ private:
     uint32 m_colonyID;
 
     int64 m_procTime;
+    int64 m_nextEvent;
+
+    // sets m_nextEvent from current ecu and plant cycle times
+    void ScheduleNextEvent();
 
     std::vector<uint32> tempECUs;
     std::map<uint8, uint32> tempPinIDs;
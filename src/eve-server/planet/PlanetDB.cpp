@@ -794,6 +794,48 @@ void PlanetDB::SavePinContents(uint32 ccPinID, uint32 pinID, std::map< uint16, u
     }
 }
 
+void PlanetDB::SaveChangedContents(PI_CCPin* ccPin)
+{
+    // replaces contents of all pins marked for update, in one delete and one insert
+    std::ostringstream Deletes, Inserts;
+    Deletes << "DELETE FROM piPinContents WHERE pinID IN (";
+    Inserts << "INSERT INTO piPinContents";
+    Inserts << " (ccPinID, pinID, typeID, itemQty)";
+
+    bool first = true, firstPin = true;
+    uint32 ccPinID = ccPin->ccPinID;
+    std::map<uint16, uint32>::iterator itr;
+    for (auto& cur : ccPin->pins) {
+        if (!cur.second.update)
+            continue;
+        if (firstPin) {
+            firstPin = false;
+        } else {
+            Deletes << ", ";
+        }
+        Deletes << cur.first;
+        for (itr = cur.second.contents.begin(); itr != cur.second.contents.end(); ++itr) {
+            if (first) {
+                Inserts << " VALUES ";
+                first = false;
+            } else {
+                Inserts << ", ";
+            }
+            Inserts << "(" << ccPinID << ", " << cur.first << ", " << itr->first << ", " << itr->second << ")";
+        }
+    }
+    if (firstPin)
+        return;
+
+    Deletes << ")";
+    DBerror err;
+    if (!sDatabase.RunQuery(err, Deletes.str().c_str()))
+        _log(DATABASE__ERROR, "SaveChangedContents - unable to remove contents - %s", err.c_str());
+    if (!first)
+        if (!sDatabase.RunQuery(err, Inserts.str().c_str()))
+            _log(DATABASE__ERROR, "SaveChangedContents - unable to save contents - %s", err.c_str());
+}
+
 void PlanetDB::RemovePin(uint32 pinID)
 {
     DBerror err;
@@ -58,6 +58,8 @@ public:
     void SaveRoutes(PI_CCPin* ccPin);
     void SaveContents(PI_CCPin* ccPin);
     void SavePinContents(uint32 ccPinID, uint32 pinID, std::map< uint16, uint32 >& contents);
+    // saves contents of pins with update set, in one batch
+    void SaveChangedContents(PI_CCPin* ccPin);
     void RemovePin(uint32 pinID);
     void RemoveHead(uint32 ecuID, uint32 headID);
     void RemoveLink(uint32 linkID);
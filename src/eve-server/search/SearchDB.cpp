@@ -26,6 +26,7 @@
 #include "eve-server.h"
 
 #include "search/SearchDB.h"
+#include "search/SearchIndex.h"
 
 /**   search runs thru these types...even inventory (type 10)
 searchResultAgent = 1
@@ -45,103 +46,40 @@ searchMinWildcardLength = 3
 */
 
 PyRep *SearchDB::Query(std::string string, std::vector<int> *searchID, uint32 charID) {
-    std::string id = "";
-
     PyDict *dict = new PyDict();
     DBQueryResult res;
+    std::vector<uint32> ids;
 
     for (uint8 i=0; i < searchID->size(); i++) {
+        ids.clear();
         switch(searchID->at(i)) {
-            case 1: //searchResultAgent = 1
-                sDatabase.RunQuery(res,
-                    "SELECT"
-                    "   characterID AS agentID"
-                    " FROM chrNPCCharacters"
-                    " WHERE characterName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "agentID";
-                break;
-            case 2: //searchResultCharacter = 2
-                sDatabase.RunQuery(res,
-                    "SELECT"
-                    "   characterID AS ownerID"
-                    " FROM chrCharacters"
-                    " WHERE characterName LIKE '%s' ", string.c_str() );
-                id = "ownerID";
-                break;
-            case 3: //searchResultCorporation = 3
-                sDatabase.RunQuery(res,
-                    "SELECT"
-                    "   corporationID AS ownerID"
-                    " FROM crpCorporation"
-                    " WHERE corporationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "ownerID";
-                break;
-            case 4: //searchResultAlliance = 4
-                sDatabase.RunQuery(res,
-                    "SELECT allianceID AS ownerID"
-                    " FROM alnAlliance"
-                    " WHERE shortName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "ownerID";
-                break;
-            case 5: //searchResultFaction = 5
-                sDatabase.RunQuery(res,
-                    "SELECT factionID AS ownerID"
-                    " FROM facFactions"
-                    " WHERE factionName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "ownerID";
-                break;
-            case 6: //searchResultConstellation = 6
-                sDatabase.RunQuery(res,
-                    "SELECT"
-                    "   constellationID AS itemID"
-                    " FROM mapConstellations"
-                    " WHERE constellationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "itemID";
-                break;
-            case 7: //searchResultSolarSystem = 7
-                sDatabase.RunQuery(res,
-                    "SELECT "
-                    "   solarSystemID AS itemID"
-                    " FROM mapSolarSystems "
-                    " WHERE solarSystemName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "itemID";
-                break;
-            case 8: //searchResultRegion = 8
-                sDatabase.RunQuery(res,
-                    "SELECT "
-                    "   regionID AS itemID"
-                    " FROM mapRegions"
-                    " WHERE regionName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "itemID";
-                break;
-            case 9: //searchResultStation = 9
-                sDatabase.RunQuery(res,
-                    "SELECT "
-                    "   stationID AS itemID"
-                    " FROM staStations "
-                    " WHERE stationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                id = "itemID";
-                break;
-            case 10:    //searchResultInventoryType = 10
+            case searchResultInventoryType: {
+                // items owned by this character.  not indexed
                 sDatabase.RunQuery(res,
                     "SELECT"
                     "   typeID"
                     " FROM entity"
                     " WHERE itemName LIKE '%s'"
-                    " AND ownerID = %u", string.c_str(), charID );
-                id = "typeID";
-                break;
+                    " AND ownerID = %u"
+                    " LIMIT 0, %u", string.c_str(), charID, searchMaxResults );
+                DBResultRow row;
+                while (res.GetRow(row))
+                    ids.push_back(row.GetUInt(0));
+            } break;
+            case searchResultCharacter: {
+                sSearchIndex.Find(searchID->at(i), string, ids, searchMaxResults);
+            } break;
+            default: {
+                sSearchIndex.Find(searchID->at(i), string, ids, 10);
+            } break;
         }
-        if (res.GetRowCount())
-            dict->SetItem(new PyInt(searchID->at(i)),DBResultToIntIntDict(res));
+        if (ids.empty())
+            continue;
+
+        PyDict *group = new PyDict();
+        for (auto cur : ids)
+            group->SetItem(new PyInt(cur), PyStatic.NewNone());
+        dict->SetItem(new PyInt(searchID->at(i)), group);
     }
 
     return dict;
@@ -156,84 +94,47 @@ PyRep *SearchDB::QuickQuery(std::string string, std::vector<int> *searchID, uint
     }
 
     PyList *result = new PyList();
-    DBQueryResult res;
-    DBResultRow row;
+    std::vector<uint32> ids;
 
     for (uint8 i=0; i < searchID->size(); i++) {
+        ids.clear();
         switch(searchID->at(i)) {
-            case 1: //searchResultAgent = 1
-                sDatabase.RunQuery(res,
-                    "SELECT characterID"
-                    " FROM chrNPCCharacters"
-                    " WHERE characterName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 2: //searchResultCharacter = 2
-                sDatabase.RunQuery(res,
-                    "SELECT characterID"
-                    " FROM chrCharacters"
-                    " WHERE characterName LIKE '%s' ", string.c_str() );
-                break;
-            case 3: //searchResultCorporation = 3
-                sDatabase.RunQuery(res,
-                    "SELECT corporationID"
-                    " FROM crpCorporation"
-                    " WHERE corporationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 4: //searchResultAlliance = 4
-                sDatabase.RunQuery(res,
-                    "SELECT allianceID"
-                    " FROM alnAlliance"
-                    " WHERE shortName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 5: //searchResultFaction = 5
-                sDatabase.RunQuery(res,
-                    "SELECT factionID"
-                    " FROM facFactions"
-                    " WHERE factionName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 6: //searchResultConstellation = 6
-                sDatabase.RunQuery(res,
-                    "SELECT constellationID"
-                    " FROM mapConstellations"
-                    " WHERE constellationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 7: //searchResultSolarSystem = 7
-                sDatabase.RunQuery(res,
-                    "SELECT solarSystemID"
-                    " FROM mapSolarSystems "
-                    " WHERE solarSystemName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 8: //searchResultRegion = 8
-                sDatabase.RunQuery(res,
-                    "SELECT regionID"
-                    " FROM mapRegions"
-                    " WHERE regionName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 9: //searchResultStation = 9
-                sDatabase.RunQuery(res,
-                    "SELECT stationID"
-                    " FROM staStations "
-                    " WHERE stationName LIKE '%s' "
-                    " LIMIT 0, 10", string.c_str() );
-                break;
-            case 10:    //searchResultInventoryType = 10
-                sDatabase.RunQuery(res,
-                    "SELECT typeID"
-                    " FROM invTypes"
-                    " WHERE typeName LIKE '%s'", string.c_str() );
-                break;
-        }
-        while (res.GetRow(row)) {
-            result->AddItem( new PyInt(row.GetUInt(0) ));
+            case searchResultCharacter:
+            case searchResultInventoryType: {
+                sSearchIndex.Find(searchID->at(i), string, ids, searchMaxResults);
+            } break;
+            default: {
+                sSearchIndex.Find(searchID->at(i), string, ids, 10);
+            } break;
         }
+        for (auto cur : ids)
+            result->AddItem( new PyInt(cur) );
     }
 
     return result;
 }
+
+bool SearchDB::LoadNames(uint8 group, DBQueryResult& res)
+{
+    std::string query;
+    switch(group) {
+        case searchResultAgent:         query = "SELECT characterID, characterName FROM chrNPCCharacters"; break;
+        case searchResultCharacter:     query = "SELECT characterID, characterName FROM chrCharacters"; break;
+        case searchResultCorporation:   query = "SELECT corporationID, corporationName FROM crpCorporation"; break;
+        case searchResultAlliance:      query = "SELECT allianceID, allianceName, shortName FROM alnAlliance"; break;
+        case searchResultFaction:       query = "SELECT factionID, factionName FROM facFactions"; break;
+        case searchResultConstellation: query = "SELECT constellationID, constellationName FROM mapConstellations"; break;
+        case searchResultSolarSystem:   query = "SELECT solarSystemID, solarSystemName FROM mapSolarSystems"; break;
+        case searchResultRegion:        query = "SELECT regionID, regionName FROM mapRegions"; break;
+        case searchResultStation:       query = "SELECT stationID, stationName FROM staStations"; break;
+        case searchResultInventoryType: query = "SELECT typeID, typeName FROM invTypes"; break;
+        default:
+            return false;
+    }
+
+    if (!sDatabase.RunQuery(res, query.c_str())) {
+        codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
+        return false;
+    }
+    return true;
+}
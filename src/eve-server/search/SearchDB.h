@@ -54,6 +54,9 @@ public:
     PyRep* Query(std::string string, std::vector<int> *searchID, uint32 charID);
     PyRep* QuickQuery(std::string string, std::vector<int> *searchID, uint32 charID, bool hideNPC = false, bool onlyAltName = false);
 
+    // id, name[, altName] for every entry in this search group, for SearchIndex
+    static bool LoadNames(uint8 group, DBQueryResult& res);
+
 };
 
 
@@ -0,0 +1,283 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name SearchIndex.cpp
+ *   in-memory name index for the search service
+ */
+
+#include "eve-server.h"
+
+#include "search/SearchIndex.h"
+
+namespace {
+    // LIKE pattern split on '%'
+    struct Pattern {
+        bool anchorStart;
+        bool anchorEnd;
+        std::vector<std::string> pieces;
+    };
+
+    void Split(const std::string& pattern, Pattern& into)
+    {
+        into.anchorStart = (!pattern.empty() and (pattern.front() != '%'));
+        into.anchorEnd = (!pattern.empty() and (pattern.back() != '%'));
+        into.pieces.clear();
+        size_t begin(0), end(0);
+        while (begin < pattern.size()) {
+            end = pattern.find('%', begin);
+            if (end == std::string::npos)
+                end = pattern.size();
+            if (end > begin)
+                into.pieces.push_back(pattern.substr(begin, end - begin));
+            begin = end + 1;
+        }
+    }
+
+    bool Match(const std::string& name, const Pattern& pattern)
+    {
+        if (pattern.pieces.empty())
+            return !pattern.anchorStart;
+
+        size_t pos(0), found(0), last(pattern.pieces.size() - 1);
+        for (size_t i = 0; i < pattern.pieces.size(); ++i) {
+            const std::string& piece = pattern.pieces[i];
+            if ((i == last) and pattern.anchorEnd) {
+                // must end the name, and not overlap earlier pieces
+                if ((name.size() < piece.size()) or (name.size() - piece.size() < pos))
+                    return false;
+                if (name.compare(name.size() - piece.size(), piece.size(), piece) != 0)
+                    return false;
+                if ((i == 0) and pattern.anchorStart and (name.size() != piece.size()))
+                    return false;
+                return true;
+            }
+            if ((i == 0) and pattern.anchorStart) {
+                if (name.compare(0, piece.size(), piece) != 0)
+                    return false;
+                pos = piece.size();
+                continue;
+            }
+            found = name.find(piece, pos);
+            if (found == std::string::npos)
+                return false;
+            pos = found + piece.size();
+        }
+        return true;
+    }
+}
+
+std::string NameIndex::ToLower(const std::string& str)
+{
+    std::string lower(str);
+    for (auto& c : lower)
+        if ((c >= 'A') and (c <= 'Z'))
+            c += 'a' - 'A';
+    return lower;
+}
+
+bool NameIndex::Match(const std::string& name, const std::string& pattern)
+{
+    Pattern pat;
+    Split(pattern, pat);
+    return ::Match(name, pat);
+}
+
+void NameIndex::Add(uint32 id, const std::string& name)
+{
+    if (name.empty())
+        return;
+
+    Entry entry = Entry();
+        entry.alive = true;
+        entry.id = id;
+        entry.name = ToLower(name);
+    uint32 index(m_entries.size());
+    m_entries.push_back(entry);
+    m_byID.emplace(id, index);
+    m_prefix.emplace(entry.name, index);
+
+    // each trigram once per name
+    std::vector<uint32> grams;
+    for (size_t i = 0; i + 2 < entry.name.size(); ++i)
+        grams.push_back(Trigram(&entry.name[i]));
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    for (auto cur : grams)
+        m_trigrams[cur].push_back(index);
+}
+
+void NameIndex::Remove(uint32 id)
+{
+    auto range = m_byID.equal_range(id);
+    for (auto itr = range.first; itr != range.second; ++itr) {
+        Entry& entry = m_entries[itr->second];
+        entry.alive = false;
+        auto prange = m_prefix.equal_range(entry.name);
+        for (auto it = prange.first; it != prange.second; ++it)
+            if (it->second == itr->second) {
+                m_prefix.erase(it);
+                break;
+            }
+    }
+    m_byID.erase(id);
+}
+
+void NameIndex::Clear()
+{
+    m_entries.clear();
+    m_byID.clear();
+    m_prefix.clear();
+    m_trigrams.clear();
+}
+
+void NameIndex::Find(const std::string& pattern, std::vector<uint32>& into, uint32 limit)
+{
+    Pattern pat;
+    Split(ToLower(pattern), pat);
+    if (pattern.empty() or (limit == 0))
+        return;
+
+    uint32 count(0);
+    size_t first(into.size());
+    // ids with more than one name may match twice
+    auto Add = [&](uint32 id) {
+        if ((m_byID.count(id) > 1) and (std::find(into.begin() + first, into.end(), id) != into.end()))
+            return;
+        into.push_back(id);
+        ++count;
+    };
+
+    if (pat.anchorStart and !pat.pieces.empty()) {
+        const std::string& prefix = pat.pieces.front();
+        for (auto itr = m_prefix.lower_bound(prefix); itr != m_prefix.end(); ++itr) {
+            if (itr->first.compare(0, prefix.size(), prefix) != 0)
+                break;
+            if (!::Match(itr->first, pat))
+                continue;
+            Add(m_entries[itr->second].id);
+            if (count >= limit)
+                break;
+        }
+        return;
+    }
+
+    // longest fixed piece gives the fewest candidates
+    static const std::string none;
+    const std::string* pPiece(&none);
+    for (auto& cur : pat.pieces)
+        if (cur.size() > pPiece->size())
+            pPiece = &cur;
+
+    if (pPiece->size() < 3) {
+        // too short for trigrams.  check everything
+        for (auto& cur : m_entries) {
+            if (!cur.alive or !::Match(cur.name, pat))
+                continue;
+            Add(cur.id);
+            if (count >= limit)
+                break;
+        }
+        return;
+    }
+
+    // intersect trigram lists, smallest first
+    std::vector<const std::vector<uint32>*> lists;
+    for (size_t i = 0; i + 2 < pPiece->size(); ++i) {
+        std::unordered_map<uint32, std::vector<uint32>>::iterator itr = m_trigrams.find(Trigram(&(*pPiece)[i]));
+        if (itr == m_trigrams.end())
+            return;
+        lists.push_back(&itr->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](const std::vector<uint32>* a, const std::vector<uint32>* b) { return a->size() < b->size(); });
+
+    std::vector<uint32> candidates(*lists.front()), next;
+    for (size_t i = 1; (i < lists.size()) and !candidates.empty(); ++i) {
+        next.clear();
+        std::set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(), std::back_inserter(next));
+        candidates.swap(next);
+    }
+
+    for (auto cur : candidates) {
+        Entry& entry = m_entries[cur];
+        if (!entry.alive or !::Match(entry.name, pat))
+            continue;
+        Add(entry.id);
+        if (count >= limit)
+            break;
+    }
+}
+
+int SearchIndex::Initialize()
+{
+    double start(GetTimeMSeconds());
+    uint32 count(0);
+    DBQueryResult res;
+    DBResultRow row;
+    for (uint8 group = searchResultAgent; group <= searchResultInventoryType; ++group) {
+        if (!SearchDB::LoadNames(group, res))
+            continue;
+        while (res.GetRow(row)) {
+            if (!row.IsNull(1))
+                m_groups[group].Add(row.GetUInt(0), row.GetText(1));
+            // alliances are found by name or ticker
+            if ((row.ColumnCount() > 2) and !row.IsNull(2))
+                m_groups[group].Add(row.GetUInt(0), row.GetText(2));
+        }
+        count += m_groups[group].Count();
+    }
+
+    sLog.Cyan("      SearchIndex", "%u names indexed in %.3fms.", count, (GetTimeMSeconds() - start));
+    sLog.Blue("      SearchIndex", "Search Index Initialized.");
+    return 1;
+}
+
+void SearchIndex::Close()
+{
+    for (auto& cur : m_groups)
+        cur.Clear();
+    sLog.Warning("      SearchIndex", "Search Index has been closed." );
+}
+
+void SearchIndex::Add(uint8 group, uint32 id, const std::string& name)
+{
+    if ((group < searchResultAgent) or (group > searchResultInventoryType))
+        return;
+    m_groups[group].Add(id, name);
+}
+
+void SearchIndex::Remove(uint8 group, uint32 id)
+{
+    if ((group < searchResultAgent) or (group > searchResultInventoryType))
+        return;
+    m_groups[group].Remove(id);
+}
+
+bool SearchIndex::Find(uint8 group, const std::string& pattern, std::vector<uint32>& into, uint32 limit)
+{
+    if ((group < searchResultAgent) or (group > searchResultInventoryType))
+        return false;
+    m_groups[group].Find(pattern, into, limit);
+    return true;
+}
@@ -0,0 +1,114 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name SearchIndex.h
+ *   in-memory name index for the search service
+ */
+
+#ifndef EVEMU_SYSTEM_SEARCHINDEX_H_
+#define EVEMU_SYSTEM_SEARCHINDEX_H_
+
+#include "eve-server.h"
+
+#include "search/SearchDB.h"
+
+/*
+ * case-insensitive index of names for one search group.
+ * patterns use the sql LIKE wildcard (%), as the search service already converts the client's '*'.
+ *   patterns with a fixed start are found from a sorted name list.
+ *   others use a trigram index (every 3-char run of every name) on their longest fixed piece,
+ *   so only names containing all of that piece's trigrams are checked.
+ * removed names are only marked dead, so entry indexes (and trigram lists) stay valid.
+ */
+class NameIndex
+{
+public:
+    NameIndex()                                         { /* do nothing here */ }
+    ~NameIndex()                                        { /* do nothing here */ }
+
+    void Add(uint32 id, const std::string& name);
+    // removes all names for this id
+    void Remove(uint32 id);
+    void Clear();
+
+    // adds ids of up to 'limit' names matching pattern
+    void Find(const std::string& pattern, std::vector<uint32>& into, uint32 limit);
+
+    uint32 Count()                                      { return (uint32)m_prefix.size(); }
+
+    static std::string ToLower(const std::string& str);
+    // returns true if lowercase name matches lowercase LIKE pattern
+    static bool Match(const std::string& name, const std::string& pattern);
+
+private:
+    struct Entry {
+        bool alive;
+        uint32 id;
+        std::string name;   // lowercase
+    };
+
+    static uint32 Trigram(const char* str)              { return ((uint8)str[0] << 16) | ((uint8)str[1] << 8) | (uint8)str[2]; }
+
+    std::vector<Entry> m_entries;
+    // id/entry index
+    std::unordered_multimap<uint32, uint32> m_byID;
+    // lowercase name/entry index, for prefix lookups
+    std::multimap<std::string, uint32> m_prefix;
+    // trigram/entry indexes, in ascending order
+    std::unordered_map<uint32, std::vector<uint32>> m_trigrams;
+};
+
+/*
+ * one NameIndex per search group, loaded at boot and kept current as characters,
+ *   corporations and alliances are created or deleted.
+ * group ids are the client's searchResult* values.  items owned by a character (Query() on
+ *   searchResultInventoryType) are not indexed here.
+ */
+class SearchIndex
+: public Singleton< SearchIndex >
+{
+public:
+    SearchIndex()                                       { /* do nothing here */ }
+    ~SearchIndex()                                      { /* do nothing here */ }
+
+    int Initialize();
+    void Close();
+
+    void Add(uint8 group, uint32 id, const std::string& name);
+    void Remove(uint8 group, uint32 id);
+
+    // adds ids from this group matching pattern.  returns false if group is not indexed
+    bool Find(uint8 group, const std::string& pattern, std::vector<uint32>& into, uint32 limit);
+
+private:
+    NameIndex m_groups[searchResultInventoryType + 1];
+};
+
+//Singleton
+#define sSearchIndex \
+( SearchIndex::get() )
+
+
+#endif      // EVEMU_SYSTEM_SEARCHINDEX_H_
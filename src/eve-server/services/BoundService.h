@@ -54,6 +54,8 @@ public:
      * @brief Builds a string with information about calling a method in this service
      */
     virtual std::string DebugDispatch (const std::string& name) = 0;
+    /** @returns The method table for this bound object, with per-method call counters */
+    virtual const CallTable& GetCallTable() const = 0;
     /**
      * @brief Increases the number of references to this bound object
      */
@@ -202,7 +204,8 @@ protected:
      */
     template <class H, class... Args>
     void Add(const std::string& name, PyResult(H::*callHandler)(PyCallArgs&, Args...)) {
-        this->mHandlers.push_back(std::make_pair(std::string(name), new CallHandler <H> (callHandler)));
+        // the table is shared by all instances, so only the first one actually adds anything
+        sHandlers.add(name, new CallHandler <H> (callHandler));
     }
 
 public:
@@ -213,40 +216,24 @@ public:
         if (this->CanClientCall(args.client) == false)
             throw CustomError("This client is not allowed to call this bound service");
 
-        for (auto handler : this->mHandlers) {
-            if (handler.first != name)
-                continue;
+        CallHandlerBase* handler = sHandlers.find(name, args);
 
-            try
-            {
-                return (*handler.second)(reinterpret_cast <void*> (this), args);
-            }
-            catch (std::invalid_argument)
-            {
-                // ignored, this just means the function does not match the possible calls
-            }
-        }
+        if (handler == nullptr)
+            throw method_not_found ();
 
-        throw method_not_found ();
+        return (*handler)(reinterpret_cast <void*> (this), args);
     }
 
     /**
      * @brief Builds a string with information about calling a method in this service
      */
     std::string DebugDispatch (const std::string& name) override {
-        std::string result = name + " candidates: \n";
-
-        for (auto handler : this->mHandlers) {
-            if (handler.first != name)
-                continue;
-
-            result += "\t(" + handler.second->getSignature () + ")";
-            result += "\n";
-        }
-
-        return result;
+        return name + " candidates: \n" + sHandlers.debug (name);
     }
 
+    /** @returns The method table for this bound object, with per-method call counters */
+    const CallTable& GetCallTable() const override { return sHandlers; }
+
     /**
      * @brief Increases the number of references to this bound object
      */
@@ -313,8 +300,8 @@ private:
     BoundServiceParent<Bound>& mParent;
     /** @var The numeric ID of the bound service */
     BoundID mBoundId;
-    /** @var The map of handlers for this service */
-    std::vector <std::pair <std::string, CallHandlerBase*>> mHandlers;
+    /** @var The map of handlers for this bound object type.  shared by all instances */
+    static inline CallTable sHandlers;
     /** @var The clients that have access to this bound service */
     std::map <Client*, bool> mClients;
 };
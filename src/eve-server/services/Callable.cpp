@@ -69,3 +69,58 @@ PyResult& PyResult::operator=(const PyResult& oth)
 
     return *this;
 }
+
+/* CallTable */
+CallTable::~CallTable()
+{
+    for (auto& cur : this->mMethods)
+        for (auto handler : cur.second.handlers)
+            delete handler;
+}
+
+void CallTable::add(const std::string& name, CallHandlerBase* handler)
+{
+    Method& method = this->mMethods[name];
+
+    for (auto cur : method.handlers) {
+        if (cur->getSignature () == handler->getSignature ()) {
+            delete handler;
+            return;
+        }
+    }
+
+    method.handlers.push_back (handler);
+}
+
+CallHandlerBase* CallTable::find(const std::string& name, PyCallArgs& args)
+{
+    auto it = this->mMethods.find (name);
+
+    if (it == this->mMethods.end ())
+        return nullptr;
+
+    ++it->second.calls;
+
+    for (auto handler : it->second.handlers)
+        if (handler->matches (args))
+            return handler;
+
+    ++it->second.mismatches;
+    return nullptr;
+}
+
+std::string CallTable::debug(const std::string& name) const
+{
+    std::string result;
+    auto it = this->mMethods.find (name);
+
+    if (it == this->mMethods.end ())
+        return result;
+
+    for (auto handler : it->second.handlers) {
+        result += "\t(" + handler->getSignature () + ")";
+        result += "\n";
+    }
+
+    return result;
+}
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <optional>
+#include <unordered_map>
 
 #include "eve-server.h"
 
@@ -63,7 +64,11 @@ template <class T> struct is_optional<std::optional<T>> : std::true_type {};
 
 struct CallHandlerBase {
 public:
+    virtual ~CallHandlerBase() = default;
+    /** @brief Calls the handler.  The arguments MUST be checked with matches() first */
     virtual PyResult operator() (void* service, PyCallArgs& args) const = 0;
+    /** @returns Whether the call arguments match this handler's signature.  Does not throw */
+    virtual bool matches (PyCallArgs& args) = 0;
     virtual const std::string& getSignature () = 0;
 };
 
@@ -76,20 +81,23 @@ struct CallHandler : public CallHandlerBase {
                     auto handler = reinterpret_cast <PyResult(S::*)(PyCallArgs&, Args...)> (erasedHandler);
 
                     if constexpr (sizeof...(Args) == 0) {
-                        // ensure there's no arguments in the data
-                        if (args.tuple->size() != 0)
-                            throw std::invalid_argument("expected 0 arguments");
-
                         // all the functions must have the PyCallArgs to know important info about the call
                         // like the client that sent it
                         return (service->*handler) (args);
                     } else {
-                        if (this->validateArgs <std::decay_t<Args>...>(args) == false)
-                            throw std::invalid_argument("arguments do not match");
-
                         return this->apply(service, handler, args);
                     }
                 }
+            },
+            matchImpl {
+                [](CallHandler <S>* self, PyCallArgs& args) -> bool {
+                    if constexpr (sizeof...(Args) == 0) {
+                        // ensure there's no arguments in the data
+                        return args.tuple->size() == 0;
+                    } else {
+                        return self->template validateArgs <std::decay_t<Args>...>(args);
+                    }
+                }
             }
     {
         this->generateSignature <std::decay_t <Args>...> ();
@@ -99,6 +107,10 @@ struct CallHandler : public CallHandlerBase {
         return handlerImpl(reinterpret_cast <S*> (service), erasedHandler, args);
     }
 
+    bool matches (PyCallArgs& args) override {
+        return matchImpl(this, args);
+    }
+
     const std::string& getSignature () {
         return this->signature;
     }
@@ -322,7 +334,46 @@ private:
 
     PyResult(S::*erasedHandler)() = nullptr;
     std::function <PyResult(S* service, PyResult(S::* erasedHandler)(), PyCallArgs& args)> handlerImpl;
+    bool (*matchImpl) (CallHandler <S>* self, PyCallArgs& args);
     std::string signature;
 };
 
+/**
+ * @brief Method table used by Service and EVEBoundObject to dispatch calls
+ *
+ * Overloads are grouped under their method name, so a call is a single hash lookup followed by
+ * a non-throwing signature check of each overload.  Also keeps per-method call counters.
+ */
+class CallTable {
+public:
+    struct Method {
+        std::vector <CallHandlerBase*> handlers;
+        uint32 calls = 0;
+        uint32 mismatches = 0;     // calls where no overload matched the arguments
+    };
+    typedef std::unordered_map <std::string, Method> MethodMap;
+
+    CallTable() = default;
+    CallTable(const CallTable&) = delete;
+    CallTable& operator=(const CallTable&) = delete;
+    ~CallTable();
+
+    /**
+     * @brief Registers a handler under the given name.  We own the handler
+     *
+     * Handlers with a signature already registered under this name are dropped, so tables
+     * shared between instances (bound objects) can be filled by every constructor
+     */
+    void add (const std::string& name, CallHandlerBase* handler);
+    /** @returns The handler matching the arguments, or nullptr.  Counts the call */
+    CallHandlerBase* find (const std::string& name, PyCallArgs& args);
+    /** @brief Builds a string with the signatures registered for this method */
+    std::string debug (const std::string& name) const;
+
+    const MethodMap& methods () const { return this->mMethods; }
+
+private:
+    MethodMap mMethods;
+};
+
 #endif //EVEMU_CALLABLE_H
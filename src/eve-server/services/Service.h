@@ -58,6 +58,8 @@ public:
      * @brief Builds a string with information about calling a method in this service
      */
     virtual std::string DebugDispatch (const std::string& name) = 0;
+    /** @returns The method table for this service, with per-method call counters */
+    virtual const CallTable& GetCallTable() const = 0;
 };
 
 /**
@@ -79,7 +81,7 @@ protected:
      */
     template <class H, class... Args>
     void Add(const std::string& name, PyResult(H::*callHandler)(PyCallArgs&, Args...)) {
-        this->mHandlers.push_back(std::make_pair(std::string(name), new CallHandler <H> (callHandler)));
+        this->mHandlers.add(name, new CallHandler <H> (callHandler));
     }
 
 public:
@@ -92,47 +94,31 @@ public:
      * @brief Handles dispatching a call to this service
      */
     PyResult Dispatch(const std::string& name, PyCallArgs& args) override {
-        for (auto handler : this->mHandlers) {
-            if (handler.first != name)
-                continue;
-
-            try
-            {
-                return (*handler.second)(reinterpret_cast <void*> (this), args);
-            }
-            catch (std::invalid_argument)
-            {
-                // ignored, this just means the function does not match the possible calls
-            }
-        }
-
-        throw method_not_found ();
+        CallHandlerBase* handler = this->mHandlers.find(name, args);
+
+        if (handler == nullptr)
+            throw method_not_found ();
+
+        return (*handler)(reinterpret_cast <void*> (this), args);
     }
 
     /**
      * @brief Builds a string with information about calling a method in this service
      */
     std::string DebugDispatch (const std::string& name) override {
-        std::string result = GetName () + "::" + name + " candidates: \n";
-
-        for (auto handler : this->mHandlers) {
-            if (handler.first != name)
-                continue;
-
-            result += "\t(" + handler.second->getSignature () + ")";
-            result += "\n";
-        }
-
-        return result;
+        return GetName () + "::" + name + " candidates: \n" + this->mHandlers.debug (name);
     }
 
+    /** @returns The method table for this service, with per-method call counters */
+    const CallTable& GetCallTable() const override { return this->mHandlers; }
+
 private:
     /** @var The name of the service */
     std::string mName;
     /** @var The access level required to access this service */
     AccessLevel mAccessLevel;
     /** @var The map of handlers for this service */
-    std::vector <std::pair <std::string, CallHandlerBase*>> mHandlers;
+    CallTable mHandlers;
 };
 
 #endif /* !__SERVICE_H__ */
\ No newline at end of file
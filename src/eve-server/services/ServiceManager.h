@@ -105,6 +105,11 @@ public:
      */
     const ServicesMap& GetServices() const;
 
+    /**
+     * @brief Gives access to the bound object list
+     */
+    const BoundServicesMap& GetBoundServices() const { return this->mBound; }
+
     /** @returns int The nodeID for the server */
     NodeID GetNodeID() { return this->mNodeId; }
 
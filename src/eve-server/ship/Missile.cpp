@@ -27,7 +27,6 @@
 
 #include "Client.h"
 #include "EVEServerConfig.h"
-#include "Profiler.h"
 #include "character/Character.h"
 #include "inventory/AttributeEnum.h"
 #include "system/DestinyManager.h"
@@ -41,13 +40,16 @@ Missile::Missile( InventoryItemRef self, EVEServiceManager& services, SystemMana
   m_modRef(modRef),
   m_targetSE(tSE),
   m_fromSE(pSE),
-  m_hitTimer(0),
-  m_lifeTimer(0),
   m_damageMod(1),
   m_alive(true),
+  m_targetID(tSE->GetID()),
   m_orbitingID(0),
   m_speed(0),
-  m_hullHP(self->GetAttribute(AttrHP).get_int())
+  m_hullHP(self->GetAttribute(AttrHP).get_int()),
+  m_flightTime(0),
+  m_launchTime(0),
+  m_launchPos(NULL_ORIGIN),
+  m_flightVel(NULL_ORIGIN_V)
 {
     if (pSE->HasPilot()) {
         m_ownerID = pSE->GetPilot()->GetChar()->itemID();
@@ -138,42 +140,40 @@ Missile::Missile( InventoryItemRef self, EVEServiceManager& services, SystemMana
             m_hullHP *= mod;
         }
 
-    m_lifeTimer.Start(flightTime);
+    m_flightTime = flightTime;
 
     //_log(DAMAGE__MESSAGE, "Created Missile object for %s (%u)", self.get()->name(), self.get()->itemID());
 }
 
 void Missile::Process() {
-    if (!m_alive) {
-        Delete();
-        return;
-    }
-    if (m_lifeTimer.Check(false)) {
-        EndOfLife();
-        return;
-    }
-    double profileStartTime(GetTimeUSeconds());
-    /*  Enable base call to Process Targeting and Movement  */
-    SystemEntity::Process();
+    /* missiles are not in the system's tic list.  MissileVolleyMgr hits and removes them when due */
+}
 
-    if (m_hitTimer.Check(false)) {
-        m_hitTimer.Disable();
-        HitTarget();
-    }
-    if (sConfig.debug.UseProfiling)
-        sProfiler.AddTime(Profile::missile, GetTimeUSeconds() - profileStartTime);
+void Missile::SetFlight(const GVector& velocity, double launchTime)
+{
+    m_launchPos = GetPosition();
+    m_flightVel = velocity;
+    m_launchTime = launchTime;
+}
+
+GPoint Missile::GetFlightPosition()
+{
+    double time((GetTimeMSeconds() - m_launchTime) / 1000);
+    return GPoint(m_launchPos.x + m_flightVel.x * time, m_launchPos.y + m_flightVel.y * time, m_launchPos.z + m_flightVel.z * time);
 }
 
 void Missile::EncodeDestiny( Buffer& into )
 {
     using namespace Destiny;
+    // item position stays at launch point
+    GPoint pos(GetFlightPosition());
     BallHeader head = BallHeader();
         head.entityID = GetID();
         head.mode = Ball::Mode::MISSILE;
         head.radius = GetRadius();
-        head.posX = x();
-        head.posY = y();
-        head.posZ = z();
+        head.posX = pos.x;
+        head.posY = pos.y;
+        head.posZ = pos.z;
         head.flags = Ball::Flag::IsFree;
     into.Append( head );
     MassSector mass = MassSector();
@@ -185,9 +185,9 @@ void Missile::EncodeDestiny( Buffer& into )
     into.Append( mass );
     DataSector data = DataSector();
         data.maxSpeed = m_speed;
-        data.velX = m_destiny->GetVelocity().x;
-        data.velY = m_destiny->GetVelocity().y;
-        data.velZ = m_destiny->GetVelocity().z;
+        data.velX = m_flightVel.x;
+        data.velY = m_flightVel.y;
+        data.velZ = m_flightVel.z;
         data.inertia = m_destiny->GetInertia();
         data.speedfraction = m_destiny->GetSpeedFraction();
     into.Append( data );
@@ -197,9 +197,9 @@ void Missile::EncodeDestiny( Buffer& into )
         miss.effectStamp = m_destiny->GetStateStamp();
         miss.targetID = m_destiny->GetTargetID();
         miss.followRange = (float)m_destiny->GetFollowDistance();
-        miss.x = x();
-        miss.y = y();
-        miss.z = z();
+        miss.x = pos.x;
+        miss.y = pos.y;
+        miss.z = pos.z;
     into.Append(miss);
 
     _log(SE__DESTINY, "Missile::EncodeDestiny(): %s - id:%lli, mode:%u, flags:0x%X", GetName(), head.entityID, head.mode, head.flags);
@@ -233,6 +233,10 @@ void Missile::MakeDamageState(DoDestinyDamageState &into) {
 }
 
 void Missile::HitTarget() {
+    // target may have died, jumped or docked since launch
+    m_targetSE = m_system->GetSE(m_targetID);
+    if (m_targetSE == nullptr)
+        return;
     // Create Damage object:
     Damage d(m_fromSE, m_modRef, m_self, EVEEffectID::missileLaunching);
 
@@ -55,35 +55,50 @@ public:
 
     /* specific functions handled here. */
     uint32 GetLauncherID()                              { return m_fromSE->GetID(); }
+    uint32 GetTargetID()                                { return m_targetID; }
+    // only valid at launch.  target may be gone by the time we get there
     SystemEntity* GetTargetSE()                         { return m_targetSE; }
 
-    void SetHitTimer(uint32 setTime)                    { m_hitTimer.Start(setTime); }
     void SetSpeed(double speed)                         { m_speed = speed; }
 
     bool IsAlive()                                      { return m_alive; }
     bool IsOverloaded()                                 { return false; }
 
     double GetSpeed()                                   { return m_speed; }
+    // ms
+    double GetFlightTime()                              { return m_flightTime; }
 
-protected:
-    SystemEntity* m_targetSE;
-    SystemEntity* m_fromSE;
-    InventoryItemRef m_modRef;
+    /* missiles are not moved by the server.  MissileVolleyMgr sets a straight flight line to the intercept point
+     *  at launch, and these give where the missile is along it.  launchTime is GetTimeMSeconds()
+     */
+    void SetFlight(const GVector& velocity, double launchTime);
+    GPoint GetFlightPosition();
+    const GVector& GetFlightVelocity()                  { return m_flightVel; }
 
+    // called by MissileVolleyMgr when this missile is due
     void HitTarget();
     void EndOfLife();
 
-    Timer m_hitTimer;
-    Timer m_lifeTimer;
+protected:
+    SystemEntity* m_targetSE;
+    SystemEntity* m_fromSE;
+    InventoryItemRef m_modRef;
 
     bool m_alive;
 
+    uint32 m_targetID;
+
     uint32 m_orbitingID;
 
     float m_damageMod;
 
     double m_speed;
     double m_hullHP;
+    double m_flightTime;
+    double m_launchTime;
+
+    GPoint m_launchPos;
+    GVector m_flightVel;
 
 };
 
@@ -6,6 +6,7 @@
 #include "StaticDataMgr.h"
 #include "account/AccountService.h"
 #include "character/Character.h"
+#include "effects/EffectsGraph.h"
 #include "effects/EffectsProcessor.h"
 #include "inventory/Inventory.h"
 #include "npc/Drone.h"
@@ -26,6 +27,7 @@ ShipItem::ShipItem(uint32 shipID, const ItemType &type, const ItemData &data)
 m_pilot(nullptr),
 m_targetRef(InventoryItemRef(nullptr)),
 m_ModuleManager(new ModuleManager(this)),
+m_fxGraph(new FxGraph(this)),
 m_loaded(false),
 m_isActive(false),
 m_isPopped(false),
@@ -42,6 +44,7 @@ ShipItem::~ShipItem()
 {
     SafeDelete(pInventory);
     SafeDelete(m_ModuleManager);
+    SafeDelete(m_fxGraph);
 }
 
 ShipItemRef ShipItem::Load( uint32 shipID)
@@ -86,6 +89,8 @@ void ShipItem::LogOut()
 {
     SetAttribute(AttrOnline, EvilZero, false);
     SaveShip();
+    // graph holds refs to this ship and its contents
+    m_fxGraph->Clear();
 
     pInventory->Unload();
 
@@ -331,6 +336,7 @@ void ShipItem::InitAttribs()
 }
 
 void ShipItem::Delete() {
+    m_fxGraph->Clear();
     pInventory->DeleteContents();
     InventoryItem::Delete();
 }
@@ -475,9 +481,15 @@ void ShipItem::AddItem(InventoryItemRef iRef)
 
     // add item mass to ship's mass if set in options (additive...loaded ship should be heavy)
     if (sConfig.server.CargoMassAdditive) {
-        uint32 mass = GetAttribute(AttrMass).get_uint32();
         uint32 addition = iRef->type().mass() * iRef->quantity();
-        SetAttribute(AttrMass, mass + addition, HasPilot());
+        // when mass is modified thru the graph, cargo adds to the unmodified value
+        EvilNumber mass(EvilZero);
+        if (m_fxGraph->GetBase(this, AttrMass, mass)) {
+            m_fxGraph->SetBase(this, AttrMass, mass + addition);
+            m_fxGraph->Recalculate(HasPilot());
+        } else {
+            SetAttribute(AttrMass, GetAttribute(AttrMass).get_uint32() + addition, HasPilot());
+        }
     }
 
     /** @todo update destiny mass after adding item */
@@ -552,11 +564,22 @@ void ShipItem::RemoveItem(InventoryItemRef iRef)
         //m_ModuleManager->UpdateModules(iRef->flag());
     }
 
+    // drop anything left in graph for this item (and modifiers it was source of)
+    if (sConfig.testing.IncrementalFx) {
+        m_fxGraph->RemoveItem(iRef->itemID());
+        m_fxGraph->Recalculate(true);
+    }
+
     // remove item mass to ship's mass if set in options (additive...loaded ship should be heavy)
     if (sConfig.server.CargoMassAdditive) {
-        uint32 mass = GetAttribute(AttrMass).get_uint32();
         uint32 addition = iRef->type().mass() * iRef->quantity();
-        SetAttribute(AttrMass, mass - addition, HasPilot());
+        EvilNumber mass(EvilZero);
+        if (m_fxGraph->GetBase(this, AttrMass, mass)) {
+            m_fxGraph->SetBase(this, AttrMass, mass - addition);
+            m_fxGraph->Recalculate(HasPilot());
+        } else {
+            SetAttribute(AttrMass, GetAttribute(AttrMass).get_uint32() - addition, HasPilot());
+        }
     }
 }
 
@@ -1808,6 +1831,7 @@ void ShipItem::ProcessEffects(bool add/*false*/, bool update/*false*/)
         m_pilot->GetChar()->ProcessEffects(this);
         ProcessShipEffects(update);
     } else {
+        m_fxGraph->Clear();
         ClearModifiers();
         pAttributeMap->SaveShipState();      // save ship damage as it's removed on next call
         ResetAttributes();
@@ -1815,11 +1839,11 @@ void ShipItem::ProcessEffects(bool add/*false*/, bool update/*false*/)
         m_pilot->GetChar()->ResetModifiers();
         std::vector< InventoryItemRef > modVec;
         m_ModuleManager->GetModuleListOfRefsAsc(modVec);
-        for (auto cur : modVec)
+        for (auto& cur : modVec)
             cur->ResetAttributes();
         std::map<EVEItemFlags, InventoryItemRef> charges;
         m_ModuleManager->GetLoadedCharges(charges);
-        for (auto cur : charges)
+        for (auto& cur : charges)
             cur.second->ResetAttributes();
 
         // do we remove fx here?  nah, we've reset everything at this point.
@@ -1835,7 +1859,7 @@ void ShipItem::ProcessShipEffects(bool update/*false*/)
         fxData data = fxData();
         data.action = FX::Action::Invalid;
         data.srcRef = static_cast<InventoryItemRef>(this);
-        sFxProc.ParseExpression(this, sFxDataMgr.GetExpression(it.second.preExpression), data);
+        sFxProc.ExecuteProgram(this, it.second.preExpression, data);
     }
 
     if (m_isUndocking) {
@@ -1859,11 +1883,11 @@ void ShipItem::ClearModuleModifiers()
     //m_ModuleManager->OfflineAll();
     std::vector< InventoryItemRef > modVec;
     m_ModuleManager->GetModuleListOfRefsAsc(modVec);
-    for (auto cur : modVec)
+    for (auto& cur : modVec)
         cur->ClearModifiers();
     std::map<EVEItemFlags, InventoryItemRef> charges;
     m_ModuleManager->GetLoadedCharges(charges);
-    for (auto cur : charges)
+    for (auto& cur : charges)
         cur.second->ClearModifiers();
 }
 
@@ -1874,16 +1898,17 @@ void ShipItem::ResetEffects() {
     m_ModuleManager->OfflineAll();
 
     // reset attributes on char, ship, all modules and charges
+    m_fxGraph->Clear();
     pAttributeMap->SaveShipState();      // save ship damage as it's removed on next call
     ResetAttributes();
     m_pilot->GetChar()->ResetModifiers();
     std::vector< InventoryItemRef > modVec;
     m_ModuleManager->GetModuleListOfRefsAsc(modVec);
-    for (auto cur : modVec)
+    for (auto& cur : modVec)
         cur->ResetAttributes();
     std::map<EVEItemFlags, InventoryItemRef> charges;
     m_ModuleManager->GetLoadedCharges(charges);
-    for (auto cur : charges)
+    for (auto& cur : charges)
         cur.second->ResetAttributes();
 
     ProcessEffects(true, true/*sDataMgr.IsSolarSystem(locationID())*/);
@@ -2760,10 +2785,14 @@ void ShipSE::RemoveBoost()
     ClearBoostData();
 }
 
-void ShipSE::ApplyBoost(BoostData& bData)
+void ShipSE::ApplyBoost(const BoostData& bData)
 {
     // note:  mining boost applied in mining module code
 
+    // nothing to do if this boost is already applied
+    if (m_boosted and (m_boost == bData))
+        return;
+
     // remove existing boost
     if (m_boosted)
         RemoveBoost();
@@ -41,6 +41,7 @@
  * InventoryItem which represents ShipItem.
  */
 class Client;
+class FxGraph;
 class GenericModule;
 
 class ShipItem
@@ -78,6 +79,7 @@ public:
 
     bool HasModuleManager()                             { return (m_ModuleManager != nullptr); }
     ModuleManager* GetModuleManager()                   { return m_ModuleManager; }
+    FxGraph* GetFxGraph()                               { return m_fxGraph; }
 
     virtual void Delete();
 
@@ -274,6 +276,8 @@ private:
 
     //the ship's module manager.  We own this
     ModuleManager* m_ModuleManager;
+    // modifier graph for incremental effects processing.  We own this
+    FxGraph* m_fxGraph;
 
     InventoryItemRef m_targetRef;       // this is only used for module effects that require a target.  is here because of the ease of aquiring/sending (common code)
 
@@ -339,9 +343,10 @@ public:
     // fleet
     void ClearBoostData();
     bool IsBoosted()                                    { return m_boosted; }
+    const BoostData& GetBoost()                         { return m_boost; }
     void SetBoost(bool set=false)                       { m_boosted = set; }
     void RemoveBoost();
-    void ApplyBoost(BoostData& bData);
+    void ApplyBoost(const BoostData& bData);
     uint8 GetMiningBoostAmount()                        { return m_boost.mining; }
 
     // misc
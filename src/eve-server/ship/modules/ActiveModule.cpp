@@ -890,7 +890,7 @@ void ActiveModule::LoadCharge(InventoryItemRef chargeRef)
             fxData data = fxData();
             data.action = FX::Action::Invalid;
             data.srcRef = chargeRef;
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.preExpression), data, this);
+            sFxProc.ExecuteProgram(m_modRef.get(), it.second.preExpression, data);
         }
         if (pClient->IsInSpace()) {
             /*  **** this sets "reload blink" status on weapon button
@@ -949,7 +949,7 @@ void ActiveModule::UnloadCharge()
             fxData data = fxData();
             data.action = FX::Action::Invalid;
             data.srcRef = m_chargeRef;
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.postExpression), data, this);
+            sFxProc.ExecuteProgram(m_modRef.get(), it.second.postExpression, data);
         }
 
         // apply to containing module to properly remove effects  -this doesnt work right for scripts.
@@ -1418,13 +1418,8 @@ void ActiveModule::LaunchMissile()
         return;
     }
 
-    float distance = pMissile->GetSelf()->position().distance(m_targetSE->GetPosition());
-    float missileSpeed = pMissile->GetSelf()->GetAttribute(AttrMaxVelocity).get_float();
-    float travelTime = (distance/missileSpeed);
-    if (travelTime < 1)
-        travelTime = 1;
-    pMissile->SetSpeed(missileSpeed);
-    pMissile->SetHitTimer(travelTime *1000);
+    // flight time and hit are worked out by the system's MissileVolleyMgr
+    pMissile->SetSpeed(pMissile->GetSelf()->GetAttribute(AttrMaxVelocity).get_float());
     pMissile->DestinyMgr()->MakeMissile(pMissile);
 
     // Reduce ammo charge by 1 unit:
@@ -138,7 +138,7 @@ void GenericModule::Online()
                 fxData data = fxData();
                 data.action = FX::Action::Invalid;
                 data.srcRef = m_chargeRef;
-                sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.preExpression), data, this);
+                sFxProc.ExecuteProgram(m_modRef.get(), it.second.preExpression, data);
             }
         }
     }
@@ -204,7 +204,7 @@ void GenericModule::Offline()
                 fxData data = fxData();
                 data.action = FX::Action::Invalid;
                 data.srcRef = m_chargeRef;
-                sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.postExpression), data, this);
+                sFxProc.ExecuteProgram(m_modRef.get(), it.second.postExpression, data);
             }
         }
     }
@@ -248,9 +248,9 @@ void GenericModule::ProcessEffects(int8 state, bool active/*false*/)
          * active/overload/gang/other effects will be applied and removed when called.
          */
         if (active) {
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.preExpression), data, this);
+            sFxProc.ExecuteProgram(m_modRef.get(), it.second.preExpression, data);
         } else {
-            sFxProc.ParseExpression(m_modRef.get(), sFxDataMgr.GetExpression(it.second.postExpression), data, this);
+            sFxProc.ExecuteProgram(m_modRef.get(), it.second.postExpression, data);
         }
     }
 }
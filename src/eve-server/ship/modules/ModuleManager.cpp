@@ -1360,7 +1360,7 @@ void ModuleManager::GetModuleListByReqSkill(uint16 skillID, std::vector< Invento
 {
     std::vector<InventoryItemRef> moduleList;
     GetModuleListOfRefsAsc(moduleList);
-    for (auto cur : moduleList)
+    for (auto& cur : moduleList)
         if (cur->HasReqSkill(skillID))
             modVec.push_back(cur);
 }
@@ -10,18 +10,23 @@
 #define _EVE_SHIP_MOD_FORMULAS_H_
 
 #include "ship/Ship.h"
+#include "system/CombatPass.h"
 
 class NPC;
 class DroneSE;
 class TurretModule;
+
 class TurretFormulas {
 public:
+    void GetTurretStats(TurretModule* pMod, TurretStats& into);
+    void GetNPCStats(NPC* pNPC, TurretStats& into);
+    void GetDroneStats(DroneSE* pDrone, TurretStats& into);
+    void GetSentryStats(Sentry* pSentry, TurretStats& into);
+
     //  returns damage modifier from hit, based on calculations made about source, item, and target.
     //    return 0 is missed
-    float GetToHit(ShipItemRef shipRef, TurretModule* pMod, SystemEntity* pTarget);
-    float GetNPCToHit(NPC* pNPC, SystemEntity* pTarget);
-    float GetDroneToHit(DroneSE* pDrone, SystemEntity* pTarget);
-    float GetSentryToHit(Sentry* pSentry, SystemEntity* pTarget);
+    //  transversal is length of relative velocity.  rNum is 0-1.  called by CombatPass
+    static float GetToHit(const TurretStats& stats, float distance, float transversal, float targSig, float rNum);
 };
 
 
@@ -71,7 +71,7 @@ void TurretModule::ApplyDamage()
             m_chargeRef->GetAttribute(AttrThermalDamage).get_float(),
             m_chargeRef->GetAttribute(AttrEmDamage).get_float(),
             m_chargeRef->GetAttribute(AttrExplosiveDamage).get_float(),
-            m_formula.GetToHit(m_shipRef, this, m_targetSE),
+            0,      // set from to-hit when shot is resolved
             m_effectID
     );
 
@@ -81,7 +81,10 @@ void TurretModule::ApplyDamage()
     if (m_linkMaster)
         d *= m_shipRef->GetLoadedLinkedCount(this);   // only loaded weapons add to damage.
 
-    m_targetSE->ApplyDamage(d);
+    TurretStats stats;
+    m_formula.GetTurretStats(this, stats);
+    ShipSE* pShip(m_shipRef->GetPilot()->GetShipSE());
+    pShip->SystemMgr()->GetCombatPass()->Queue(pShip, m_targetSE, d, stats);
 
     switch (m_modRef->groupID()) {
         case EVEDB::invGroups::Projectile_Weapon:
@@ -54,11 +54,11 @@ Standing::Standing() :
 }
 
 PyResult Standing::GetCharStandings(PyCallArgs &call) {
-    return m_db.GetCharStandings(call.client);
+    return sStandingMgr.GetOwnerStandings(call.client->GetCharacterID());
 }
 
 PyResult Standing::GetCorpStandings(PyCallArgs &call) {
-    return m_db.GetCorpStandings(call.client);
+    return sStandingMgr.GetOwnerStandings(call.client->GetCorporationID());
 }
 
 PyResult Standing::GetNPCNPCStandings(PyCallArgs &call) {
@@ -100,6 +100,8 @@ PyResult Standing::GetStandingTransactions(PyCallArgs &call, PyInt* fromID, PyIn
     _log(STANDING__MESSAGE,  "Standing::Handle_GetStandingTransactions()");
     call.Dump(STANDING__DUMP);
 
+    // change log is written behind
+    sStandingMgr.SaveChanges();
     return m_db.GetStandingTransactions(fromID->value(), toID->value());
 }
 
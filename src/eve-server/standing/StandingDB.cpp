@@ -61,33 +61,43 @@ PyObjectEx *StandingDB::GetFactionStandings()
     return DBResultToCRowset(res);
 }
 
-PyRep *StandingDB::GetMyStandings(uint32 charID)
+void StandingDB::GetStandings(DBQueryResult& res)
 {
-    DBQueryResult res;
-    sDatabase.RunQuery(res, "SELECT fromID, standing AS rank FROM repStandings WHERE toID = %u", charID);
-    return DBResultToCRowset(res);
+    if (!sDatabase.RunQuery(res, "SELECT fromID, toID, standing FROM repStandings"))
+        codelog(DATABASE__ERROR, "Error in GetStandings query: %s", res.error.c_str());
 }
 
-PyRep *StandingDB::GetCharStandings(Client *pClient)
+void StandingDB::GetNPCStandings(DBQueryResult& res)
 {
-    DBQueryResult res;
-    sDatabase.RunQuery(res, "SELECT fromID, toID, standing FROM repStandings WHERE toID = %u OR fromID = %u",
-                       pClient->GetCharacterID(), pClient->GetCharacterID());
-    return DBResultToCRowset(res);
+    if (!sDatabase.RunQuery(res, "SELECT fromID, toID, standing FROM chrNPCStandings"))
+        codelog(DATABASE__ERROR, "Error in GetNPCStandings query: %s", res.error.c_str());
 }
 
-PyRep *StandingDB::GetCorpStandings(Client *pClient)
+bool StandingDB::SaveStandings(std::vector<StandingData>& data)
 {
-    DBQueryResult res;
-    sDatabase.RunQuery(res, "SELECT fromID, toID, standing FROM repStandings WHERE toID = %u OR fromID = %u", pClient->GetCorporationID(), pClient->GetCorporationID());
-    return DBResultToCRowset(res);
-}
+    if (data.empty())
+        return true;
+
+    std::ostringstream Inserts;
+    Inserts << "INSERT INTO repStandings (fromID, toID, standing) VALUES ";
+    Inserts.precision(9);
+    bool first = true;
+    for (auto cur : data) {
+        if (first) {
+            first = false;
+        } else {
+            Inserts << ", ";
+        }
+        Inserts << "(" << cur.fromID << ", " << cur.toID << ", " << cur.standing << ")";
+    }
+    Inserts << " ON DUPLICATE KEY UPDATE standing=VALUES(standing)";
 
-PyRep *StandingDB::GetCharNPCStandings(uint32 charID)
-{
-    DBQueryResult res;
-    sDatabase.RunQuery(res, "SELECT fromID, toID, standing FROM chrNPCStandings WHERE toID = %u", charID);
-    return DBResultToCRowset(res);
+    DBerror err;
+    if (!sDatabase.RunQuery(err, "%s", Inserts.str().c_str())) {
+        codelog(DATABASE__ERROR, "SaveStandings - unable to save %u standings: %s", (uint32)data.size(), err.c_str());
+        return false;
+    }
+    return true;
 }
 
 /** @todo not sure about this yet.... wip   ....not used? */
@@ -139,46 +149,35 @@ PyRep *StandingDB::GetStandingTransactions(uint32 fromID, uint32 toID)
     return DBResultToRowset(res);
 }
 
-float StandingDB::GetStanding(uint32 fromID, uint32 toID)
-{
-    DBQueryResult res;
-    sDatabase.RunQuery(res, "SELECT standing FROM repStandings WHERE fromID=%u AND toID=%u", fromID, toID);
-    DBResultRow row;
-    if (res.GetRow(row))
-    {
-        return row.GetFloat(0);
-    }
-    else
-    {
-        return 0.0f;
-    }
-}
-
-void StandingDB::SetStanding(uint32 fromID, uint32 toID, float standing)
-{
-    DBerror err;
-    sDatabase.RunQuery(err, "INSERT INTO repStandings (fromID, toID, standing) VALUES (%u,%u,%f)", fromID, toID, standing);
-}
-
-void StandingDB::UpdateStanding(uint32 fromID, uint32 toID, float standing)
-{
-    DBerror err;
-    sDatabase.RunQuery(err,
-                       "INSERT INTO repStandings (fromID, toID, standing)"
-                       " VALUES (%u,%u,%f)"
-                       " ON DUPLICATE KEY UPDATE standing = standing + %f",
-                       fromID, toID, standing, standing);
-}
-
 /** @todo  implement repStandingChanges after standing system is working  */
-void StandingDB::SaveStandingChanges(uint32 fromID, uint32 toID, uint16 eventType, float amount, std::string msg)
+bool StandingDB::SaveStandingChanges(std::vector<StandingChange>& data)
 {
+    if (data.empty())
+        return true;
+
     /* eventTypeID,eventDateTime,fromID,toID,modification,originalFromID,originalToID,int_1,int_2,int_3,msg */
+    std::ostringstream Inserts;
+    Inserts << "INSERT INTO repStandingChanges (eventTypeID, eventDateTime, fromID, toID, modification, msg) VALUES ";
+    Inserts.precision(17);
+    std::string msg;
+    bool first = true;
+    for (auto cur : data) {
+        if (first) {
+            first = false;
+        } else {
+            Inserts << ", ";
+        }
+        sDatabase.DoEscapeString(msg, cur.msg);
+        Inserts << "(" << cur.eventType << ", " << cur.eventTime << ", " << cur.fromID << ", " << cur.toID << ", ";
+        Inserts << cur.amount << ", '" << msg << "')";
+    }
+
     DBerror err;
-    sDatabase.RunQuery(err,
-                       "INSERT INTO repStandingChanges (eventTypeID, eventDateTime, fromID, toID, modification, msg)"
-                       " VALUES (%u, %f, %u, %u, %f, '%s' )",
-                       eventType, GetFileTimeNow(), fromID, toID, amount, msg.c_str());
+    if (!sDatabase.RunQuery(err, "%s", Inserts.str().c_str())) {
+        codelog(DATABASE__ERROR, "SaveStandingChanges - unable to save %u changes: %s", (uint32)data.size(), err.c_str());
+        return false;
+    }
+    return true;
 }
 
 PyRep *StandingDB::GetStandingCompositions(uint32 fromID, uint32 toID)
@@ -34,34 +34,37 @@
 class PyRep;
 class Client;
 
+struct StandingData {
+    uint32 fromID;
+    uint32 toID;
+    float standing;
+};
+
+// a repStandingChanges row
+struct StandingChange {
+    uint32 fromID;
+    uint32 toID;
+    uint16 eventType;
+    float amount;
+    double eventTime;
+    std::string msg;
+};
+
+/* standings are read once by StandingMgr, which serves all lookups and saves changes here */
 class StandingDB
 : public ServiceDB
 {
 public:
     static PyObjectEx* GetFactionStandings();
-    PyRep* GetCorpStandings(Client* pClient);
-    PyRep* GetCharStandings(Client* pClient);
     PyRep* PrimeCharStandings(uint32 charID);
-    PyRep* GetCharNPCStandings(uint32 charID);
     PyRep* GetStandingTransactions(uint32 fromID, uint32 toID);
     PyRep* GetStandingCompositions(uint32 fromID, uint32 toID);
 
+    static void GetStandings(DBQueryResult& res);
+    static void GetNPCStandings(DBQueryResult& res);
 
-    /*  all standings are in same table now, but follow identical rules
-     * NPC Faction<-->NPC Faction - populated, hard-coded  -- cant change
-     * agent-->char, agent-->PC corp  -- changed by missions status'
-     * corporation<-->alliance, alliance<-->alliance  -- changed thru Corp window
-     * corporation-->character, corporation<-->corporation  -- changed thru Corp window
-     * character<-->character, character-->corporation  -- changed thru PnP window
-     * NPC corp-->char, NPC corp-->PC corp  -- changed by missions and faction kills
-     */
-    static float GetStanding(uint32 fromID, uint32 toID);
-
-    static void SetStanding(uint32 fromID, uint32 toID, float standing);
-    static void UpdateStanding(uint32 fromID, uint32 toID, float standing);
-    static void SaveStandingChanges(uint32 fromID, uint32 toID, uint16 eventType, float amount, std::string msg);
-
-    static PyRep* GetMyStandings(uint32 charID);
+    static bool SaveStandings(std::vector<StandingData>& data);
+    static bool SaveStandingChanges(std::vector<StandingChange>& data);
 };
 
 #endif
@@ -27,7 +27,8 @@
 StandingMgr::StandingMgr()
 : m_factionStandings(nullptr)
 {
-
+    m_pending.clear();
+    m_changes.clear();
 }
 
 StandingMgr::~StandingMgr()
@@ -38,6 +39,17 @@ StandingMgr::~StandingMgr()
 void StandingMgr::Clear()
 {
     PySafeDecRef(m_factionStandings);
+    m_factionStandings = nullptr;
+    m_standings.Clear();
+    m_npcStandings.Clear();
+    m_pending.clear();
+    m_changes.clear();
+}
+
+void StandingMgr::Close()
+{
+    SaveChanges();
+    Clear();
 }
 
 int StandingMgr::Initialize()
@@ -49,20 +61,249 @@ int StandingMgr::Initialize()
 
 void StandingMgr::GetInfo()
 {
-
+    sLog.Cyan("      StandingMgr", "%u standings, %u NPC standings, %u unsaved standings, %u unsaved changes.", \
+              (uint32)m_standings.Size(), (uint32)m_npcStandings.Size(), (uint32)m_pending.size(), (uint32)m_changes.size());
 }
 
 void StandingMgr::Populate()
 {
+    double start(GetTimeMSeconds());
     m_factionStandings = StandingDB::GetFactionStandings();
     if (m_factionStandings == nullptr)
         sLog.Error("      StandingMgr", "m_factionStandings is null");
 
+    DBQueryResult res;
+    DBResultRow row;
+    StandingDB::GetStandings(res);
+    while (res.GetRow(row))
+        m_standings.Set(row.GetUInt(0), row.GetUInt(1), row.GetFloat(2));
+
+    StandingDB::GetNPCStandings(res);
+    while (res.GetRow(row))
+        m_npcStandings.Set(row.GetUInt(0), row.GetUInt(1), row.GetFloat(2));
+
+    sLog.Cyan("      StandingMgr", "%u standings and %u NPC standings loaded in %.3fms.", \
+              (uint32)m_standings.Size(), (uint32)m_npcStandings.Size(), (GetTimeMSeconds() - start));
+}
+
+void StandingMgr::Process()
+{
+    SaveChanges();
+}
+
+void StandingMgr::SaveChanges()
+{
+    if (m_pending.empty() and m_changes.empty())
+        return;
+
+    double start(GetTimeMSeconds());
+    std::vector<StandingData> data;
+    data.reserve(m_pending.size());
+    StandingData entry = StandingData();
+    for (auto cur : m_pending) {
+        entry.fromID = (uint32)(cur >> 32);
+        entry.toID = (uint32)cur;
+        entry.standing = m_standings.Get(entry.fromID, entry.toID);
+        data.push_back(entry);
+    }
+    // anything that failed to save is kept, and tried again next time
+    uint32 standings(0), changes(0);
+    if (StandingDB::SaveStandings(data)) {
+        standings = m_pending.size();
+        m_pending.clear();
+    }
+    if (StandingDB::SaveStandingChanges(m_changes)) {
+        changes = m_changes.size();
+        m_changes.clear();
+    }
+
+    _log(STANDING__TRACE, "SaveChanges() - Saved %u standings and %u changes in %.3fms", \
+         standings, changes, (GetTimeMSeconds() - start));
+}
+
+float StandingMgr::GetStanding(uint32 fromID, uint32 toID)
+{
+    return m_standings.Get(fromID, toID);
+}
+
+void StandingMgr::SetStanding(uint32 fromID, uint32 toID, float standing)
+{
+    m_standings.Set(fromID, toID, standing);
+    m_pending.insert(Graph::MakeKey(fromID, toID));
 }
 
 void StandingMgr::UpdateStandings(uint32 fromID, uint32 toID, uint16 eventType, double amount, std::string msg)
 {
-    StandingDB::UpdateStanding(fromID, toID, amount);
-    StandingDB::SaveStandingChanges(fromID, toID, eventType, amount, msg);
+    SetStanding(fromID, toID, m_standings.Get(fromID, toID) + amount);
+
+    StandingChange change = StandingChange();
+    change.fromID = fromID;
+    change.toID = toID;
+    change.eventType = eventType;
+    change.amount = amount;
+    change.eventTime = GetFileTimeNow();
+    change.msg = msg;
+    m_changes.push_back(change);
+}
+
+void StandingMgr::RemoveOwner(uint32 ownerID)
+{
+    std::vector<int64> removed;
+    m_standings.Remove(ownerID, removed);
+    for (auto cur : removed)
+        m_pending.erase(cur);
+    removed.clear();
+    m_npcStandings.Remove(ownerID, removed);
+
+    std::vector<StandingChange>::iterator itr = m_changes.begin();
+    while (itr != m_changes.end()) {
+        if ((itr->fromID == ownerID) or (itr->toID == ownerID)) {
+            itr = m_changes.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
+
+PyRep* StandingMgr::GetMyStandings(uint32 charID)
+{
+    DBRowDescriptor* header = new DBRowDescriptor();
+    header->AddColumn("fromID", DBTYPE_I4);
+    header->AddColumn("rank", DBTYPE_R8);
+    CRowSet* rowset = new CRowSet(&header);
+
+    const std::vector<uint32>* from(m_standings.To(charID));
+    if (from == nullptr)
+        return rowset;
+
+    PyPackedRow* row(nullptr);
+    for (auto cur : *from) {
+        row = rowset->NewRow();
+        row->SetField("fromID", new PyInt(cur));
+        row->SetField("rank", new PyFloat(m_standings.Get(cur, charID)));
+    }
+    return rowset;
+}
+
+PyRep* StandingMgr::GetOwnerStandings(uint32 ownerID)
+{
+    DBRowDescriptor* header = new DBRowDescriptor();
+    header->AddColumn("fromID", DBTYPE_I4);
+    header->AddColumn("toID", DBTYPE_I4);
+    header->AddColumn("standing", DBTYPE_R8);
+    CRowSet* rowset = new CRowSet(&header);
+
+    PyPackedRow* row(nullptr);
+    const std::vector<uint32>* ids(m_standings.To(ownerID));
+    if (ids != nullptr)
+        for (auto cur : *ids) {
+            row = rowset->NewRow();
+            row->SetField("fromID", new PyInt(cur));
+            row->SetField("toID", new PyInt(ownerID));
+            row->SetField("standing", new PyFloat(m_standings.Get(cur, ownerID)));
+        }
+
+    ids = m_standings.From(ownerID);
+    if (ids != nullptr)
+        for (auto cur : *ids) {
+            // already sent above
+            if (cur == ownerID)
+                continue;
+            row = rowset->NewRow();
+            row->SetField("fromID", new PyInt(ownerID));
+            row->SetField("toID", new PyInt(cur));
+            row->SetField("standing", new PyFloat(m_standings.Get(ownerID, cur)));
+        }
+
+    return rowset;
+}
+
+PyRep* StandingMgr::GetCharNPCStandings(uint32 charID)
+{
+    DBRowDescriptor* header = new DBRowDescriptor();
+    header->AddColumn("fromID", DBTYPE_I4);
+    header->AddColumn("toID", DBTYPE_I4);
+    header->AddColumn("standing", DBTYPE_R8);
+    CRowSet* rowset = new CRowSet(&header);
+
+    const std::vector<uint32>* from(m_npcStandings.To(charID));
+    if (from == nullptr)
+        return rowset;
+
+    PyPackedRow* row(nullptr);
+    for (auto cur : *from) {
+        row = rowset->NewRow();
+        row->SetField("fromID", new PyInt(cur));
+        row->SetField("toID", new PyInt(charID));
+        row->SetField("standing", new PyFloat(m_npcStandings.Get(cur, charID)));
+    }
+    return rowset;
+}
+
+float StandingMgr::Graph::Get(uint32 fromID, uint32 toID) const
+{
+    std::unordered_map<int64, float>::const_iterator itr = m_standings.find(MakeKey(fromID, toID));
+    if (itr == m_standings.end())
+        return 0.0f;
+    return itr->second;
 }
 
+bool StandingMgr::Graph::Set(uint32 fromID, uint32 toID, float standing)
+{
+    std::pair<std::unordered_map<int64, float>::iterator, bool> res = m_standings.emplace(MakeKey(fromID, toID), standing);
+    if (!res.second) {
+        res.first->second = standing;
+        return false;
+    }
+    m_from[fromID].push_back(toID);
+    m_to[toID].push_back(fromID);
+    return true;
+}
+
+void StandingMgr::Graph::Remove(uint32 ownerID, std::vector<int64>& removed)
+{
+    std::unordered_map<uint32, std::vector<uint32>>::iterator itr = m_from.find(ownerID);
+    if (itr != m_from.end()) {
+        for (auto cur : itr->second) {
+            removed.push_back(MakeKey(ownerID, cur));
+            m_standings.erase(MakeKey(ownerID, cur));
+            std::vector<uint32>& ids = m_to[cur];
+            ids.erase(std::remove(ids.begin(), ids.end(), ownerID), ids.end());
+        }
+        m_from.erase(itr);
+    }
+
+    itr = m_to.find(ownerID);
+    if (itr != m_to.end()) {
+        for (auto cur : itr->second) {
+            removed.push_back(MakeKey(cur, ownerID));
+            m_standings.erase(MakeKey(cur, ownerID));
+            std::vector<uint32>& ids = m_from[cur];
+            ids.erase(std::remove(ids.begin(), ids.end(), ownerID), ids.end());
+        }
+        m_to.erase(itr);
+    }
+}
+
+void StandingMgr::Graph::Clear()
+{
+    m_standings.clear();
+    m_from.clear();
+    m_to.clear();
+}
+
+const std::vector<uint32>* StandingMgr::Graph::From(uint32 fromID) const
+{
+    std::unordered_map<uint32, std::vector<uint32>>::const_iterator itr = m_from.find(fromID);
+    if (itr == m_from.end())
+        return nullptr;
+    return &itr->second;
+}
+
+const std::vector<uint32>* StandingMgr::Graph::To(uint32 toID) const
+{
+    std::unordered_map<uint32, std::vector<uint32>>::const_iterator itr = m_to.find(toID);
+    if (itr == m_to.end())
+        return nullptr;
+    return &itr->second;
+}
@@ -20,6 +20,10 @@
 #include "standing/StandingDB.h"
 
 
+/*
+ * all of repStandings and chrNPCStandings are kept here, and all standings reads are served from memory.
+ * changes are applied here and saved on Process() (1m), or before anything reads the tables directly.
+ */
 class StandingMgr
 : public Singleton< StandingMgr >
 {
@@ -30,21 +34,69 @@ public:
     int                 Initialize();
 
     void                Clear();
-    void                Close()                         { Clear(); }
+    void                Close();
     void                GetInfo();
+    // save changed standings and queued change log entries
+    void                Process();
+    void                SaveChanges();
 
     PyObjectEx*         GetFactionStandings()           { PyIncRef(m_factionStandings); return m_factionStandings; }
 
-
-
+    /*  all standings are in same table now, but follow identical rules
+     * NPC Faction<-->NPC Faction - populated, hard-coded  -- cant change  (repFactions, see GetFactionStandings())
+     * agent-->char, agent-->PC corp  -- changed by missions status'
+     * corporation<-->alliance, alliance<-->alliance  -- changed thru Corp window
+     * corporation-->character, corporation<-->corporation  -- changed thru Corp window
+     * character<-->character, character-->corporation  -- changed thru PnP window
+     * NPC corp-->char, NPC corp-->PC corp  -- changed by missions and faction kills
+     */
+    // raw standing of fromID towards toID.  0 if none has been set
+    float               GetStanding(uint32 fromID, uint32 toID);
+    void                SetStanding(uint32 fromID, uint32 toID, float standing);
     void                UpdateStandings(uint32 fromID, uint32 toID, uint16 eventType, double amount, std::string msg);
+    // drops all standings to and from this owner.  the caller deletes the rows
+    void                RemoveOwner(uint32 ownerID);
+
+    // rowsets for the client.  built from memory
+    PyRep*              GetMyStandings(uint32 charID);      // fromID, rank.  standings towards charID
+    PyRep*              GetOwnerStandings(uint32 ownerID);  // fromID, toID, standing.  standings to and from ownerID
+    PyRep*              GetCharNPCStandings(uint32 charID); // fromID, toID, standing
 
 protected:
     void                Populate();
 
+    /* one standings table.  (fromID, toID)/standing, with the ids each owner has standings to and from */
+    class Graph {
+    public:
+        float Get(uint32 fromID, uint32 toID) const;
+        // returns true if this is a new pair
+        bool Set(uint32 fromID, uint32 toID, float standing);
+        // removes every pair ownerID is in, adding their keys to removed
+        void Remove(uint32 ownerID, std::vector<int64>& removed);
+        void Clear();
+
+        const std::vector<uint32>* From(uint32 fromID) const;  // toIDs fromID has standings towards
+        const std::vector<uint32>* To(uint32 toID) const;      // fromIDs with standings towards toID
+        size_t Size() const                             { return m_standings.size(); }
+
+        static int64 MakeKey(uint32 fromID, uint32 toID) { return ((int64)fromID << 32) | toID; }
+
+    private:
+        std::unordered_map<int64, float> m_standings;
+        std::unordered_map<uint32, std::vector<uint32>> m_from;
+        std::unordered_map<uint32, std::vector<uint32>> m_to;
+    };
+
 private:
     PyObjectEx*         m_factionStandings;
 
+    Graph               m_standings;        // repStandings
+    Graph               m_npcStandings;     // chrNPCStandings
+
+    // repStandings keys changed since the last save
+    std::unordered_set<int64> m_pending;
+    // repStandingChanges rows to save
+    std::vector<StandingChange> m_changes;
 };
 
 
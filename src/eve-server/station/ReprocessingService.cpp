@@ -46,6 +46,7 @@
 #include "Station.h"
 #include "system/SystemManager.h"
 #include "services/ServiceManager.h"
+#include "standing/StandingMgr.h"
 
 ReprocessingService::ReprocessingService(EVEServiceManager& mgr) :
     BindableService("reprocessingSvc", mgr)
@@ -355,14 +356,14 @@ PyRep *ReprocessingServiceBound::GetQuote(uint32 itemID, Client* pClient) {
 /** @todo  should this be moved to standings code?   yes!! */
 float ReprocessingServiceBound::GetStanding(const Client* pClient) const
 {
-    float standing = StandingDB::GetStanding(m_stationCorpID, pClient->GetCharacterID());
+    float standing = sStandingMgr.GetStanding(m_stationCorpID, pClient->GetCharacterID());
     if (standing < 0.0f) {
         standing += ((10.0f + standing) * 0.04f * pClient->GetChar()->GetSkillLevel(EvESkill::Diplomacy));
     } else {
         standing += ((10.0f - standing) * 0.04f * pClient->GetChar()->GetSkillLevel(EvESkill::Connections));
     }
 
-    return EvE::max(standing, StandingDB::GetStanding(m_stationCorpID, pClient->GetCorporationID()));
+    return EvE::max(standing, sStandingMgr.GetStanding(m_stationCorpID, pClient->GetCorporationID()));
 }
 
 // this should be moved to eve math or eve calc's or w/e
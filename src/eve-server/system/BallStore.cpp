@@ -0,0 +1,190 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#include "system/BallStore.h"
+#include "system/DestinyManager.h"
+
+void BallStore::Clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_hx.clear();
+    m_hy.clear();
+    m_hz.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_vz.clear();
+    m_tx.clear();
+    m_ty.clear();
+    m_tz.clear();
+    m_maxSpeed.clear();
+    m_from.clear();
+    m_to.clear();
+    m_agility.clear();
+    m_moveTime.clear();
+    m_tf.clear();
+    m_frac.clear();
+    m_ramp.clear();
+    m_seek.clear();
+    m_active.clear();
+    m_owner.clear();
+}
+
+int32 BallStore::Add(DestinyManager* pDestiny, const GPoint& pos)
+{
+    m_x.push_back(pos.x);
+    m_y.push_back(pos.y);
+    m_z.push_back(pos.z);
+    m_hx.push_back(0);
+    m_hy.push_back(0);
+    m_hz.push_back(0);
+    m_vx.push_back(0);
+    m_vy.push_back(0);
+    m_vz.push_back(0);
+    m_tx.push_back(0);
+    m_ty.push_back(0);
+    m_tz.push_back(0);
+    m_maxSpeed.push_back(0);
+    m_from.push_back(0);
+    m_to.push_back(0);
+    m_agility.push_back(1);
+    m_moveTime.push_back(0);
+    m_tf.push_back(0);
+    m_frac.push_back(0);
+    m_ramp.push_back(0);
+    m_seek.push_back(0);
+    m_active.push_back(1);
+    m_owner.push_back(pDestiny);
+    return m_owner.size() - 1;
+}
+
+void BallStore::SetLinear(int32 idx, const GVector& heading, double maxSpeed, float from, float to, bool ramp, float tf, double agility, double moveTime)
+{
+    m_hx[idx] = heading.x;
+    m_hy[idx] = heading.y;
+    m_hz[idx] = heading.z;
+    m_maxSpeed[idx] = maxSpeed;
+    m_from[idx] = from;
+    m_to[idx] = (ramp ? to : from);
+    m_ramp[idx] = (ramp ? 1 : 0);
+    m_tf[idx] = tf;
+    m_agility[idx] = agility;
+    m_moveTime[idx] = moveTime;
+    m_seek[idx] = 0;
+}
+
+void BallStore::SetSeek(int32 idx, const GPoint& target, double speed)
+{
+    m_tx[idx] = target.x;
+    m_ty[idx] = target.y;
+    m_tz[idx] = target.z;
+    m_maxSpeed[idx] = speed;
+    m_from[idx] = 1;
+    m_to[idx] = 1;
+    m_ramp[idx] = 0;
+    m_tf[idx] = 1;
+    m_seek[idx] = 1;
+}
+
+void BallStore::Drop(int32 idx)
+{
+    m_active[idx] = 0;
+    m_owner[idx] = nullptr;
+}
+
+void BallStore::Integrate(double nowMs)
+{
+    const size_t count(m_owner.size());
+    if (count == 0)
+        return;
+
+    double* x(m_x.data());
+    double* y(m_y.data());
+    double* z(m_z.data());
+    double* hx(m_hx.data());
+    double* hy(m_hy.data());
+    double* hz(m_hz.data());
+    double* vx(m_vx.data());
+    double* vy(m_vy.data());
+    double* vz(m_vz.data());
+    const double* tx(m_tx.data());
+    const double* ty(m_ty.data());
+    const double* tz(m_tz.data());
+    const double* maxSpeed(m_maxSpeed.data());
+    const double* from(m_from.data());
+    const double* to(m_to.data());
+    const double* agility(m_agility.data());
+    const double* moveTime(m_moveTime.data());
+    const double* ramp(m_ramp.data());
+    const double* seek(m_seek.data());
+    const double* active(m_active.data());
+    double* tf(m_tf.data());
+    double* frac(m_frac.data());
+
+    /* speed fraction, as MoveObject() had it.  t is seconds since the speed change began
+     *   tf = 1 - e^(-t / agility)
+     *   asf = from + (to - from) * tf
+     * rows that are not ramping keep their tf, and have to == from
+     */
+    for (size_t i = 0; i < count; ++i) {
+        const double t((nowMs - moveTime[i]) * 0.001);
+        const double newTF(1.0 - std::exp(-t / agility[i]));
+        tf[i] = ((ramp[i] > 0) ? newTF : tf[i]);
+        frac[i] = from[i] + (to[i] - from[i]) * tf[i];
+    }
+
+    // seek rows turn to face their target point.  zero length leaves a zero heading, as GVector::normalize() does
+    for (size_t i = 0; i < count; ++i) {
+        const double dx(tx[i] - x[i]), dy(ty[i] - y[i]), dz(tz[i] - z[i]);
+        const double len(std::sqrt(dx * dx + dy * dy + dz * dz));
+        const double inv(seek[i] / ((len > 0) ? len : 1.0));
+        const double keep(1.0 - seek[i]);
+        hx[i] = hx[i] * keep + dx * inv;
+        hy[i] = hy[i] * keep + dy * inv;
+        hz[i] = hz[i] * keep + dz * inv;
+    }
+
+    // one second of movement.  dropped rows have no speed
+    for (size_t i = 0; i < count; ++i) {
+        const double speed(maxSpeed[i] * frac[i] * active[i]);
+        vx[i] = hx[i] * speed;
+        vy[i] = hy[i] * speed;
+        vz[i] = hz[i] * speed;
+        x[i] += vx[i];
+        y[i] += vy[i];
+        z[i] += vz[i];
+    }
+}
+
+void BallStore::Commit()
+{
+    // PostMove() may drop other rows (bump), but never adds them
+    for (size_t i = 0; i < m_owner.size(); ++i)
+        if (m_owner[i] != nullptr)
+            m_owner[i]->PostMove(this, i);
+
+    Clear();
+}
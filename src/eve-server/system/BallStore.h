@@ -0,0 +1,106 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#ifndef EVEMU_SYSTEM_BALLSTORE_H__
+#define EVEMU_SYSTEM_BALLSTORE_H__
+
+#include "../eve-server.h"
+
+class DestinyManager;
+
+/*  structure-of-arrays movement state for balls that move this tic.  owned by SystemManager.
+ *  DestinyManager does its steering (turns, speed changes, orbit and follow headings) in Process() as before,
+ *  then queues the ball here instead of moving it.  the row index is its handle until the end of the tic.
+ *  after all entities are processed, Integrate() moves every queued ball in one pass, and Commit() hands
+ *  the results back to each DestinyManager for the per-ball work (item position, bump, debug).
+ *
+ *  linear rows are goto, stop, follow, orbit and warp align.  speed fraction ramps from -> to as 1-e^(-t/agility).
+ *  seek rows head straight at their target point at full speed (missile ball mode).  missiles in flight
+ *  are not ticked (see MissileVolleyMgr), so these only come from a MISSILE mode ball being processed.
+ *  warp itself is not here; it is a function of time in warp, and DestinyManager sets that position directly.
+ */
+class BallStore {
+public:
+    BallStore()                                         { Clear(); }
+    ~BallStore()                                        { /* do nothing here */ }
+
+    void Clear();
+
+    bool IsEmpty()                                      { return m_owner.empty(); }
+    size_t Size()                                       { return m_owner.size(); }
+
+    // returns row for this ball
+    int32 Add(DestinyManager* pDestiny, const GPoint& pos);
+    // ramp=false keeps fraction at 'from' and timeFraction at tf
+    void SetLinear(int32 idx, const GVector& heading, double maxSpeed, float from, float to, bool ramp, float tf, double agility, double moveTime);
+    void SetSeek(int32 idx, const GPoint& target, double speed);
+    // ball was moved, stopped or deleted after it was queued.  row is skipped
+    void Drop(int32 idx);
+
+    // nowMs is GetTimeMSeconds()
+    void Integrate(double nowMs);
+    // calls DestinyManager::PostMove() for each row, then clears
+    void Commit();
+
+    // results, for PostMove()
+    GPoint GetPosition(int32 idx)                       { return GPoint(m_x[idx], m_y[idx], m_z[idx]); }
+    GVector GetVelocity(int32 idx)                      { return GVector(m_vx[idx], m_vy[idx], m_vz[idx]); }
+    GVector GetHeading(int32 idx)                       { return GVector(m_hx[idx], m_hy[idx], m_hz[idx]); }
+    float GetTimeFraction(int32 idx)                    { return m_tf[idx]; }
+    float GetSpeedFraction(int32 idx)                   { return m_frac[idx]; }
+    bool IsSeek(int32 idx)                              { return (m_seek[idx] > 0); }
+
+private:
+    // position, heading and velocity
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    std::vector<double> m_hx;
+    std::vector<double> m_hy;
+    std::vector<double> m_hz;
+    std::vector<double> m_vx;
+    std::vector<double> m_vy;
+    std::vector<double> m_vz;
+    // seek target point
+    std::vector<double> m_tx;
+    std::vector<double> m_ty;
+    std::vector<double> m_tz;
+
+    std::vector<double> m_maxSpeed;
+    std::vector<double> m_from;
+    std::vector<double> m_to;
+    std::vector<double> m_agility;
+    std::vector<double> m_moveTime;
+    std::vector<double> m_tf;
+    std::vector<double> m_frac;
+    // masks, as 0.0/1.0 so the loops stay branch-free
+    std::vector<double> m_ramp;
+    std::vector<double> m_seek;
+    std::vector<double> m_active;
+
+    std::vector<DestinyManager*> m_owner;
+};
+
+#endif  // EVEMU_SYSTEM_BALLSTORE_H__
@@ -0,0 +1,181 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#include "EVEServerConfig.h"
+#include "Profiler.h"
+#include "ship/modules/TurretFormulas.h"
+#include "system/CombatPass.h"
+#include "system/Damage.h"
+#include "system/SystemEntity.h"
+#include "system/SystemManager.h"
+
+CombatPass::CombatPass(SystemManager* pSystem)
+: m_system(pSystem)
+{
+    Clear();
+}
+
+void CombatPass::Clear()
+{
+    m_shooterID.clear();
+    m_target.clear();
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_vz.clear();
+    m_stats.clear();
+    m_toHit.clear();
+    m_kinetic.clear();
+    m_thermal.clear();
+    m_em.clear();
+    m_explosive.clear();
+    m_effectID.clear();
+    m_weapon.clear();
+
+    m_targetRow.clear();
+    m_targetID.clear();
+    m_tx.clear();
+    m_ty.clear();
+    m_tz.clear();
+    m_tvx.clear();
+    m_tvy.clear();
+    m_tvz.clear();
+    m_sig.clear();
+    m_hit.clear();
+}
+
+SystemEntity* CombatPass::GetSE(uint32 entityID)
+{
+    return m_system->GetSE(entityID);
+}
+
+void CombatPass::Queue(SystemEntity* pShooter, SystemEntity* pTarget, const Damage& d, const TurretStats& stats)
+{
+    if ((pShooter == nullptr) or (pTarget == nullptr))
+        return;
+
+    int32 row(0);
+    std::map<uint32, int32>::iterator itr = m_targetRow.find(pTarget->GetID());
+    if (itr == m_targetRow.end()) {
+        row = m_targetID.size();
+        m_targetRow[pTarget->GetID()] = row;
+        m_targetID.push_back(pTarget->GetID());
+        const GPoint& pos(pTarget->GetPosition());
+        const GVector& vel(pTarget->GetVelocity());
+        m_tx.push_back(pos.x);
+        m_ty.push_back(pos.y);
+        m_tz.push_back(pos.z);
+        m_tvx.push_back(vel.x);
+        m_tvy.push_back(vel.y);
+        m_tvz.push_back(vel.z);
+        float sig(pTarget->GetSelf()->GetAttribute(AttrSignatureRadius).get_float());
+        if (sig < 0.01f)
+            sig = pTarget->GetSelf()->GetAttribute(AttrRadius).get_float() / 10;
+        m_sig.push_back(sig);
+        m_hit.push_back(false);
+    } else {
+        row = itr->second;
+    }
+
+    const GPoint& pos(pShooter->GetPosition());
+    const GVector& vel(pShooter->GetVelocity());
+    m_shooterID.push_back(pShooter->GetID());
+    m_target.push_back(row);
+    m_x.push_back(pos.x);
+    m_y.push_back(pos.y);
+    m_z.push_back(pos.z);
+    m_vx.push_back(vel.x);
+    m_vy.push_back(vel.y);
+    m_vz.push_back(vel.z);
+    m_stats.push_back(stats);
+    m_toHit.push_back(0);
+    m_kinetic.push_back(d.GetKinetic());
+    m_thermal.push_back(d.GetThermal());
+    m_em.push_back(d.GetEM());
+    m_explosive.push_back(d.GetExplosive());
+    m_effectID.push_back(d.effectID);
+    m_weapon.push_back(d.weaponRef);
+}
+
+void CombatPass::Process()
+{
+    if (m_shooterID.empty())
+        return;
+
+    double profileStartTime(GetTimeUSeconds());
+
+    // to-hit for all shots
+    int32 t(0);
+    double dx(0), dy(0), dz(0), distance(0), transversal(0);
+    const size_t count(m_shooterID.size());
+    for (size_t i = 0; i < count; ++i) {
+        t = m_target[i];
+        dx = m_tx[t] - m_x[i];
+        dy = m_ty[t] - m_y[i];
+        dz = m_tz[t] - m_z[i];
+        distance = sqrt((dx * dx) + (dy * dy) + (dz * dz));
+        dx = m_tvx[t] - m_vx[i];
+        dy = m_tvy[t] - m_vy[i];
+        dz = m_tvz[t] - m_vz[i];
+        transversal = sqrt((dx * dx) + (dy * dy) + (dz * dz));
+        m_toHit[i] = TurretFormulas::GetToHit(m_stats[i], distance, transversal, m_sig[t], MakeRandomFloat());
+    }
+
+    /* apply damage.  shooters and targets are found by id, as a shot may kill either one
+     *  (and a dead target is removed from the system) before later shots are applied
+     */
+    SystemEntity* pTarget(nullptr);
+    SystemEntity* pShooter(nullptr);
+    for (size_t i = 0; i < count; ++i) {
+        t = m_target[i];
+        pTarget = GetSE(m_targetID[t]);
+        if (pTarget == nullptr)
+            continue;
+        pShooter = GetSE(m_shooterID[i]);
+        if (pShooter == nullptr)
+            continue;
+        Damage d(pShooter, m_weapon[i], m_kinetic[i], m_thermal[i], m_em[i], m_explosive[i], m_toHit[i], m_effectID[i]);
+        if (pTarget->ApplyDamage(d, false))
+            continue;
+        m_hit[t] = true;
+    }
+
+    // one damage state update per target
+    for (size_t i = 0; i < m_targetID.size(); ++i) {
+        if (!m_hit[i])
+            continue;
+        pTarget = GetSE(m_targetID[i]);
+        if (pTarget != nullptr)
+            pTarget->SendDamageStateChanged();
+    }
+
+    Clear();
+
+    // whole pass.  each ApplyDamage() also adds its own time to Profile::damage
+    if (sConfig.debug.UseProfiling)
+        sProfiler.AddTime(Profile::combat, GetTimeUSeconds() - profileStartTime);
+}
@@ -0,0 +1,105 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#ifndef EVEMU_SYSTEM_COMBATPASS_H__
+#define EVEMU_SYSTEM_COMBATPASS_H__
+
+#include "../eve-server.h"
+
+class Damage;
+class SystemEntity;
+class SystemManager;
+
+/* weapon side of the to-hit formula.  filled by the shooter through TurretFormulas when its cycle completes */
+struct TurretStats {
+    float range;        // optimal
+    float falloff;
+    float tracking;
+    float sigRes;
+    float crit;         // crit chance, from server config
+    float miss;         // modifier returned on a miss
+    bool sigModifier;   // when weapon can track target but sigRes > targSig, reduce damage instead of chance to hit
+};
+
+/*  turret shots (ship turrets, npcs, concord, drones and sentries) for one system.  owned by SystemManager.
+ *  a weapon whose cycle completes queues its shot here with its base damage and TurretStats, instead of
+ *  working out to-hit and applying damage itself.  Process() runs once per tic after entities are processed:
+ *  to-hit for every shot is done in one pass over packed shooter and target kinematics, then damage is applied,
+ *  and each target that was hit sends its damage state once.
+ *  target position, velocity and signature are read once per tic, when the target is first shot at.
+ */
+class CombatPass {
+public:
+    CombatPass(SystemManager* pSystem);
+    virtual ~CombatPass()                               { /* do nothing here */ }
+
+    // d is base damage.  its modifier is set from to-hit when the shot is resolved
+    void Queue(SystemEntity* pShooter, SystemEntity* pTarget, const Damage& d, const TurretStats& stats);
+    // resolves all shots queued this tic.  called once per tic
+    void Process();
+    void Clear();
+
+    size_t Size()                                       { return m_shooterID.size(); }
+
+protected:
+    // shooters and targets are found by id when damage is applied
+    virtual SystemEntity* GetSE(uint32 entityID);
+
+private:
+    SystemManager* m_system;
+
+    // shots
+    std::vector<uint32> m_shooterID;
+    std::vector<int32> m_target;        // row in target cache
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    std::vector<double> m_vx;
+    std::vector<double> m_vy;
+    std::vector<double> m_vz;
+    std::vector<TurretStats> m_stats;
+    std::vector<float> m_toHit;
+    // base damage, after weapon multipliers
+    std::vector<float> m_kinetic;
+    std::vector<float> m_thermal;
+    std::vector<float> m_em;
+    std::vector<float> m_explosive;
+    std::vector<uint16> m_effectID;
+    std::vector<InventoryItemRef> m_weapon;
+
+    // target cache.  targetID/row
+    std::map<uint32, int32> m_targetRow;
+    std::vector<uint32> m_targetID;
+    std::vector<double> m_tx;
+    std::vector<double> m_ty;
+    std::vector<double> m_tz;
+    std::vector<double> m_tvx;
+    std::vector<double> m_tvy;
+    std::vector<double> m_tvz;
+    std::vector<float> m_sig;
+    std::vector<bool> m_hit;
+};
+
+#endif  // EVEMU_SYSTEM_COMBATPASS_H__
@@ -0,0 +1,107 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#include "system/DScanCache.h"
+
+void DScanCache::Clear()
+{
+    m_dirty = true;
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_se.clear();
+}
+
+void DScanCache::Add(SystemEntity* pSE, const GPoint& pos)
+{
+    m_x.push_back(pos.x);
+    m_y.push_back(pos.y);
+    m_z.push_back(pos.z);
+    m_se.push_back(pSE);
+}
+
+void DScanCache::RangeQuery(double range, const GPoint& pos, std::vector<SystemEntity*>& into)
+{
+    const size_t count(m_se.size());
+    m_hit.resize(count);
+    const double px(pos.x), py(pos.y), pz(pos.z), range2(range * range);
+    const double* x(m_x.data());
+    const double* y(m_y.data());
+    const double* z(m_z.data());
+    uint8* hit(m_hit.data());
+    for (size_t i = 0; i < count; ++i) {
+        const double dx(x[i] - px), dy(y[i] - py), dz(z[i] - pz);
+        hit[i] = ((dx * dx + dy * dy + dz * dz) < range2);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        if (hit[i])
+            into.push_back(m_se[i]);
+}
+
+void DScanCache::ConeQuery(double range, const GPoint& pos, const GVector& dir, double angle, std::vector<SystemEntity*>& into)
+{
+    /* point R is inside cone with vertex V, axis U and half-angle A when  acos(U.VR / |VR|) < A
+     *  which is  U.VR > cos(A) * |VR|.
+     * squaring both sides removes the sqrt, but the sign of each side has to be kept:
+     *  cos(A) >= 0 :  U.VR > 0  and  (U.VR)^2 > cos(A)^2 * |VR|^2
+     *  cos(A) < 0  :  U.VR >= 0  or  (U.VR)^2 < cos(A)^2 * |VR|^2
+     * points at the vertex are never inside (old code got NaN from normalize here)
+     */
+    const double half(std::min(std::max(angle / 2, 0.0), M_PI));
+    const double cosA(std::cos(half)), cos2(cosA * cosA);
+    double ux(dir.x), uy(dir.y), uz(dir.z);
+    const double len(std::sqrt(ux * ux + uy * uy + uz * uz));
+    if (len <= 0)
+        return;
+    ux /= len; uy /= len; uz /= len;
+
+    const size_t count(m_se.size());
+    m_hit.resize(count);
+    const double px(pos.x), py(pos.y), pz(pos.z), range2(range * range);
+    const double* x(m_x.data());
+    const double* y(m_y.data());
+    const double* z(m_z.data());
+    uint8* hit(m_hit.data());
+    if (cosA >= 0) {
+        for (size_t i = 0; i < count; ++i) {
+            const double dx(x[i] - px), dy(y[i] - py), dz(z[i] - pz);
+            const double d2(dx * dx + dy * dy + dz * dz);
+            const double dot(ux * dx + uy * dy + uz * dz);
+            hit[i] = (d2 < range2) & (d2 > 0) & (dot > 0) & ((dot * dot) > (cos2 * d2));
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            const double dx(x[i] - px), dy(y[i] - py), dz(z[i] - pz);
+            const double d2(dx * dx + dy * dy + dz * dz);
+            const double dot(ux * dx + uy * dy + uz * dz);
+            hit[i] = (d2 < range2) & (d2 > 0) & ((dot >= 0) | ((dot * dot) < (cos2 * d2)));
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        if (hit[i])
+            into.push_back(m_se[i]);
+}
@@ -0,0 +1,66 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#ifndef EVEMU_SYSTEM_DSCANCACHE_H__
+#define EVEMU_SYSTEM_DSCANCACHE_H__
+
+#include "../eve-server.h"
+
+class SystemEntity;
+
+/*  structure-of-arrays copy of positions for entities visible on directional scan.
+ *  owned by SystemManager, which marks it dirty on each tic and on entity add/remove, and refills it on next scan.
+ *  the query loops are written branch-free over flat arrays so the compiler can vectorize them.
+ *  neither query uses sqrt or acos.
+ */
+class DScanCache {
+public:
+    DScanCache()                                        { Clear(); }
+    ~DScanCache()                                       { /* do nothing here */ }
+
+    void Clear();
+    void Add(SystemEntity* pSE, const GPoint& pos);
+
+    bool IsDirty()                                      { return m_dirty; }
+    void SetDirty()                                     { m_dirty = true; }
+    void SetClean()                                     { m_dirty = false; }
+    size_t Size()                                       { return m_se.size(); }
+
+    // all entities within range of pos
+    void RangeQuery(double range, const GPoint& pos, std::vector<SystemEntity*>& into);
+    // all entities within range of pos, inside cone along dir with total width of angle (rad)
+    void ConeQuery(double range, const GPoint& pos, const GVector& dir, double angle, std::vector<SystemEntity*>& into);
+
+private:
+    bool m_dirty;
+
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    std::vector<SystemEntity*> m_se;
+    std::vector<uint8> m_hit;       // scratch for query results
+};
+
+#endif  // EVEMU_SYSTEM_DSCANCACHE_H__
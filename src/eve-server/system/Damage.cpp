@@ -96,7 +96,7 @@ chargeRef(InventoryItemRef(nullptr))
     assert(fatal_blow and "Damage() fatal_blow called without 2nd param being true!");
 }
 
-bool SystemEntity::ApplyDamage(Damage &d) {
+bool SystemEntity::ApplyDamage(Damage &d, bool sendState/*true*/) {
     double profileStartTime(GetTimeUSeconds());
 
     if (is_log_enabled(DAMAGE__MESSAGE)) {
@@ -352,7 +352,8 @@ bool SystemEntity::ApplyDamage(Damage &d) {
             }
         }
 
-        SendDamageStateChanged();
+        if (sendState)
+            SendDamageStateChanged();
     }
 
     if (sConfig.debug.UseProfiling)
@@ -40,11 +40,11 @@ public:
 
     ~Damage()                                           { /* do nothing here */ }
 
-    float GetThermal()                                  { return thermal; }
-    float GetEM()                                       { return em; }
-    float GetKinetic()                                  { return kinetic; }
-    float GetExplosive()                                { return explosive; }
-    float GetModifier()                                 { return modifier; }
+    float GetThermal() const                            { return thermal; }
+    float GetEM() const                                 { return em; }
+    float GetKinetic() const                            { return kinetic; }
+    float GetExplosive() const                          { return explosive; }
+    float GetModifier() const                           { return modifier; }
     float GetTotal() const                              { return (kinetic + thermal + em + explosive); }
 
     Damage MultiplyDup( float kinetic_multiplier,
@@ -42,6 +42,7 @@
 #include "ship/Ship.h"
 #include "station/Station.h"
 #include "station/StationDataMgr.h"
+#include "system/BallStore.h"
 #include "system/BubbleManager.h"
 #include "system/Container.h"
 #include "system/DestinyManager.h"
@@ -52,6 +53,8 @@
 
 DestinyManager::DestinyManager(SystemEntity *self)
 : mySE(self),
+m_ball(-1),
+m_ballStore(nullptr),
 m_maxSpeed(1.0f),
 m_shipAccelTime(0.0f),
 m_shipMaxAccelTime(0.0f),
@@ -123,13 +126,14 @@ mvPacket(nullptr)
 }
 
 DestinyManager::~DestinyManager() {
+    DropMove();
     m_warpTimer.Disable();
     SafeDelete(m_warpState);
 }
 
 // this is called once per tic by SystemEntity::Process()
 void DestinyManager::Process() {
-    double profileStartTime(GetTimeUSeconds());
+    ProfileZone zone(Profile::destiny);
 
     if (mySE->IsFrozen()) {
         Halt();
@@ -144,9 +148,6 @@ void DestinyManager::Process() {
     }
 
     ProcessState();
-
-    if (sConfig.debug.UseProfiling)
-        sProfiler.AddTime(Profile::destiny, GetTimeUSeconds() - profileStartTime);
 }
 
 void DestinyManager::ProcessState() {
@@ -164,13 +165,8 @@ void DestinyManager::ProcessState() {
         } break;
         case Ball::Mode::MISSILE: {
             // if target was removed, continue movement and wait for Missile::EndOfLife() call to do cleanup
-            //set current direction based on position and targetPoint.  this will keep missile aligned properly
-            GVector moveVector(m_position, m_targetPoint);
-            moveVector.normalize();
-            //set position and direction for this round of movement
-            m_shipHeading = moveVector;
-            m_velocity = (moveVector * m_maxSpeed);
-            SetPosition(m_position + m_velocity);
+            //  heading is set toward targetPoint and missile is moved at full speed in BallStore::Integrate().  this will keep missile aligned properly
+            mySE->SystemMgr()->GetBallStore()->SetSeek(QueueMove(), m_targetPoint, m_maxSpeed);
         } break;
         case Ball::Mode::ORBIT: {
             if (IsTargetInvalid())
@@ -759,24 +755,27 @@ void DestinyManager::MoveObject() {
             Turn();
     }
 
-    float speed(0.0f);
-    std::string move = "";
-
     // keep timer in seconds.
     timeStamp = (GetTimeMSeconds() - m_moveTime) * 0.001f;
 
+    /* speed for this tic is  m_maxShipSpeed * asf,  where asf ramps from -> to as tf = (1 - exp(-timeStamp / m_shipAgility))
+     *  accel:  asf = psf + (usf - psf) * tf    (psf = 0 for simple accel, which is usf * tf)
+     *  decel:  asf = psf - (psf - usf) * tf
+     * tf and asf are computed for all moving balls at once in BallStore::Integrate(), and set in PostMove()
+     */
+    bool ramp(false);
+    float from(m_activeSpeedFraction), to(m_activeSpeedFraction);
     if ((timeStamp > m_shipAccelTime) and (m_timeFraction > 0.9998f)) {
         m_activeSpeedFraction = m_userSpeedFraction;
-        speed = m_maxShipSpeed * m_activeSpeedFraction;
 
         if (m_decel) {
             if (is_log_enabled(DESTINY__MOVE_TRACE))
                 _log(DESTINY__MOVE_TRACE, "Destiny::MoveObject() - %s(%u) has decel'd from %.2fm/s to %.2fm/s in %.3fs.", \
-                    mySE->GetName(), mySE->GetID(), m_prevSpeed, speed, timeStamp);
+                    mySE->GetName(), mySE->GetID(), m_prevSpeed, m_maxShipSpeed * m_activeSpeedFraction, timeStamp);
         } else if (m_accel) {
             if (is_log_enabled(DESTINY__MOVE_TRACE))
                 _log(DESTINY__MOVE_TRACE, "Destiny::MoveObject() - %s(%u) has accel'd from %.2fm/s to %.2fm/s in %.3fs.", \
-                mySE->GetName(), mySE->GetID(), m_prevSpeed, speed, timeStamp);
+                mySE->GetName(), mySE->GetID(), m_prevSpeed, m_maxShipSpeed * m_activeSpeedFraction, timeStamp);
         }
 
         m_accel = false;
@@ -784,10 +783,7 @@ void DestinyManager::MoveObject() {
         m_prevSpeed = 0.0f;
         m_prevSpeedFraction = 0.0f;
 
-        if (m_userSpeedFraction) {
-            // ship has reached full commanded speed
-            move = "at constant speed, going";
-        } else {
+        if (!m_userSpeedFraction) {
             //ship has reached full stop
             if (is_log_enabled(DESTINY__MOVE_TRACE))
                 _log(DESTINY__MOVE_TRACE, "Destiny::MoveObject() - %s(%u) is at full stop after %.3f seconds.", \
@@ -795,37 +791,20 @@ void DestinyManager::MoveObject() {
             Halt();
             return;
         }
+        // ship has reached full commanded speed
+        from = to = m_activeSpeedFraction;
     } else {
-        // changed speed and asf != usf
-        m_timeFraction = (1 - exp(-timeStamp / m_shipAgility));
-
+        // changed speed and asf != usf.  tf is updated for all of these
+        ramp = true;
         if (m_accel) {
             // object still accelerating.
-            move = "accelerating";
-            if (m_turning)
-                move = "accelerating in turn";
-
-            if (m_prevSpeedFraction) {
-                /* accel from previous non-full speed
-                 *   take diff of psf and usf then multiply by tf
-                 *   add result to psf to get asf
-                 *  asf is the fraction of max speed the ship is moving at this tic.
-                 */
-                m_activeSpeedFraction = m_prevSpeedFraction + (m_userSpeedFraction - m_prevSpeedFraction) * m_timeFraction;
-            } else {
-                // this is simple acceleration.  asf = usf * tf
-                m_activeSpeedFraction = m_userSpeedFraction * m_timeFraction;
-            }
+            from = m_prevSpeedFraction;
+            to = m_userSpeedFraction;
         } else if (m_decel) {
             // object still decelerating.
-            move = "decelerating";
-            if (m_turning) {
-                // decel for turn
-                move = "decelerating for turn";
-            }
             if (m_prevSpeedFraction) {
-                // asf = psf - (psf - usf) * tf
-                m_activeSpeedFraction = m_prevSpeedFraction - (m_prevSpeedFraction - m_userSpeedFraction) * m_timeFraction;
+                from = m_prevSpeedFraction;
+                to = m_userSpeedFraction;
             } else {
                 // this should never hit....should not have decel w/o previous speed
                 sLog.Warning("Destiny::MoveObject()", "decel = true, but psf = 0.");
@@ -837,13 +816,13 @@ void DestinyManager::MoveObject() {
                     mySE->GetName(), mySE->GetID(), (m_accel ? "True" : "False"), (m_decel ? "True" : "False"), (m_turning ? "True" : "False"), \
                     m_turnTic, (m_tractored ? "True" : "False"), (m_tractorPause ? "True" : "False"));
         }
-
-        speed = (m_maxShipSpeed * m_activeSpeedFraction);
     }
 
     // ships tend to "level out" when stopping.  try to mimic that here (wip)
     // this will also need *something* with ship agility
-    if (m_stop and (m_timeFraction > 0.5f)) {
+    // m_timeFraction is only set in PostMove(), so use this tic's value while ramping
+    float timeFraction(ramp ? (1.0f - std::exp(-timeStamp / m_shipAgility)) : m_timeFraction);
+    if (m_stop and (timeFraction > 0.5f)) {
         if (m_shipHeading.y < -0.15f) {
             m_shipHeading.y += 0.05f;
         } else if (m_shipHeading.y > 0.15f) {
@@ -851,27 +830,72 @@ void DestinyManager::MoveObject() {
         }
     }
 
+    float maxSpeed(m_maxShipSpeed);
     if (m_orbiting)
         if (m_orbiting < Destiny::Ball::Orbit::TooClose) {
             // object is orbiting...set orbit speed correctly.
-            speed *= m_maxOrbitSpeedFraction;
-            move += " in orbit";
+            maxSpeed *= m_maxOrbitSpeedFraction;
+        }
+
+    // velocity and position for this tic are set in PostMove()
+    mySE->SystemMgr()->GetBallStore()->SetLinear(QueueMove(), m_shipHeading, maxSpeed, from, to, ramp, m_timeFraction, m_shipAgility, m_moveTime);
+}
+
+int32 DestinyManager::QueueMove() {
+    BallStore* pStore(mySE->SystemMgr()->GetBallStore());
+    // ship changed systems after it was queued
+    if ((m_ball > -1) and (m_ballStore != pStore))
+        DropMove();
+    if (m_ball < 0) {
+        m_ballStore = pStore;
+        m_ball = pStore->Add(this, m_position);
+    }
+    return m_ball;
+}
+
+void DestinyManager::DropMove() {
+    if (m_ball < 0)
+        return;
+    m_ballStore->Drop(m_ball);
+    m_ball = -1;
+    m_ballStore = nullptr;
+}
+
+void DestinyManager::PostMove(BallStore* pStore, int32 idx) {
+    m_ball = -1;
+    m_ballStore = nullptr;
+
+    m_velocity = pStore->GetVelocity(idx);
+    if (pStore->IsSeek(idx)) {
+        // missile
+        m_shipHeading = pStore->GetHeading(idx);
+        SetPosition(pStore->GetPosition(idx));
+        return;
     }
 
+    m_timeFraction = pStore->GetTimeFraction(idx);
+    m_activeSpeedFraction = pStore->GetSpeedFraction(idx);
+    SetPosition(pStore->GetPosition(idx), sConfig.debug.PositionHack);   // (PositionHack == true) here will force position update to client
+
+    float timeStamp((GetTimeMSeconds() - m_moveTime) * 0.001f);
     if (is_log_enabled(DESTINY__MOVE_TRACE)) {
+        std::string move = "at constant speed, going";
+        if (m_accel) {
+            move = (m_turning ? "accelerating in turn" : "accelerating");
+        } else if (m_decel) {
+            move = (m_turning ? "decelerating for turn" : "decelerating");
+        }
+        if (m_orbiting and (m_orbiting < Destiny::Ball::Orbit::TooClose))
+            move += " in orbit";
         if (m_prevSpeedFraction) {
             _log(DESTINY__MOVE_TRACE, "Destiny::MoveObject() - %s(%u) is %s at %.3f m/s (tf:%.4f asf:%.4f ps:%.2f psf:%.4f, sec: %.5f).", \
-                mySE->GetName(), mySE->GetID(), move.c_str(), speed, m_timeFraction, m_activeSpeedFraction, m_prevSpeed, m_prevSpeedFraction, timeStamp);
+                mySE->GetName(), mySE->GetID(), move.c_str(), m_velocity.length(), m_timeFraction, m_activeSpeedFraction, m_prevSpeed, m_prevSpeedFraction, timeStamp);
         } else {
             _log(DESTINY__MOVE_TRACE, "Destiny::MoveObject() - %s(%u) is %s at %.3f m/s (tf:%.4f asf:%.4f sec: %.5f).", \
-                mySE->GetName(), mySE->GetID(), move.c_str(), speed, m_timeFraction, m_activeSpeedFraction, timeStamp);
+                mySE->GetName(), mySE->GetID(), move.c_str(), m_velocity.length(), m_timeFraction, m_activeSpeedFraction, timeStamp);
         }
     }
 
-    //set velocity and position for this tic
-    m_velocity = m_shipHeading * speed;
-    SetPosition(m_position + m_velocity, sConfig.debug.PositionHack);   // (PositionHack == true) here will force position update to client
-
     if (is_log_enabled(DESTINY__MOVE_DEBUG))
         _log(DESTINY__MOVE_DEBUG, "Destiny::MoveObject() - %s(%u) Pos:%.2f,%.2f,%.2f  Vel:%.3f,%.3f,%.3f  Head:%.3f,%.3f,%.3f", \
             mySE->GetName(), mySE->GetID(), m_position.x, m_position.y, m_position.z, m_velocity.x, m_velocity.y, m_velocity.z,\
@@ -2428,6 +2452,9 @@ void DestinyManager::DockingAccepted()
 void DestinyManager::SetPosition(const GPoint &pt, bool update /*false*/) {
     _log(DESTINY__TRACE, "Destiny::SetPosition() called by %s(%u)", mySE->GetName(), mySE->GetID());
 
+    // a move queued this tic would be from the old position
+    DropMove();
+
     if (pt.isZero()) {
         _log(DESTINY__TRACE, "Destiny::SetPosition() - %s(%u) point is zero", mySE->GetName(), mySE->GetID());
         EvE::traceStack();
@@ -2677,7 +2704,8 @@ void DestinyManager::MakeMissile(Missile* pMissile) {
     m_stateStamp = sEntityList.GetStamp();
 
     SystemEntity* pTarget = pMissile->GetTargetSE();
-    m_targetPoint = GPoint(pTarget->GetPosition());
+    // head for where the target will be.  this also queues the missile's hit
+    m_targetPoint = mySE->SystemMgr()->GetMissileVolleyMgr()->Launch(pMissile);
     m_targetEntity.first = pTarget->GetID();
     m_targetEntity.second = pTarget;
     m_targetDistance = static_cast<double>(m_position.distance(m_targetPoint));
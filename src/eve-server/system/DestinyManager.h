@@ -57,6 +57,7 @@ namespace Destiny {
     }
 }
 
+class BallStore;
 class InventoryItem;
 class Missile;
 class PyRep;
@@ -100,6 +101,8 @@ public:
     ~DestinyManager();
 
     void Process();
+    // called by BallStore::Commit() with this tic's movement results
+    void PostMove(BallStore* pStore, int32 idx);
 
     void SendSingleDestinyEvent(PyTuple** ev, bool self_only=false) const;
     void SendSingleDestinyUpdate(PyTuple** up, bool self_only=false) const;
@@ -305,8 +308,14 @@ protected:
     GVector m_targetHeading;            //direction to target from current heading
     std::pair<uint32, SystemEntity*> m_targetEntity;   //we do not own the SystemEntity*
 
+    // row in our system's BallStore while a move is queued this tic, else -1
+    int32 m_ball;
+    BallStore* m_ballStore;
+    int32 QueueMove();                  //get row for this tic's move, adding one if needed
+    void DropMove();                    //cancel this tic's move (ball was moved or stopped after it was queued)
+
     // movement methods
-    void MoveObject();                  //apply velocity to our position for this round of movement
+    void MoveObject();                  //set heading and speed for this round of movement, and queue it in BallStore
     void Orbit();
     void Follow();                      //follow or approach object in space
     void BeginMovement();               //set initial variables for all movement (common code)
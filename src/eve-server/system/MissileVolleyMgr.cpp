@@ -0,0 +1,171 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#include "EVEServerConfig.h"
+#include "Profiler.h"
+#include "ship/Missile.h"
+#include "system/MissileVolleyMgr.h"
+#include "system/SystemBubble.h"
+#include "system/SystemManager.h"
+
+MissileVolleyMgr::MissileVolleyMgr(SystemManager* pSystem)
+: m_system(pSystem)
+{
+    m_queue.clear();
+    m_done.clear();
+    m_removed.clear();
+}
+
+GPoint MissileVolleyMgr::Launch(Missile* pMissile)
+{
+    SystemEntity* pTarget(pMissile->GetTargetSE());
+    GPoint pos(NULL_ORIGIN);
+    GVector vel(NULL_ORIGIN_V);
+    GetKinematics(pTarget, pos, vel);
+
+    double speed(pMissile->GetSpeed()), life(pMissile->GetFlightTime() / 1000), time(0);
+    bool hit(Intercept(pMissile->GetPosition(), speed, pos, vel, pTarget->GetRadius(), time) and (time <= life));
+    if (!hit)
+        time = life;
+    // client needs time to show the launch
+    if (time < 1)
+        time = 1;
+
+    // missile flies straight at where the target will be.  a miss flies at where it would be at end of flight
+    GPoint aim(pos.x + vel.x * time, pos.y + vel.y * time, pos.z + vel.z * time);
+    GVector flight(pMissile->GetPosition(), aim);
+    flight.normalize();
+    flight *= speed;
+
+    double now(GetTimeMSeconds());
+    pMissile->SetFlight(flight, now);
+    m_queue.insert(std::make_pair(now + time * 1000, std::make_pair(pMissile->GetID(), hit)));
+
+    _log(DAMAGE__INFO, "MissileVolleyMgr::Launch() - %s(%u) at %s(%u): %s in %.2fs", \
+            pMissile->GetName(), pMissile->GetID(), pTarget->GetName(), pTarget->GetID(), (hit ? "hit" : "miss"), time);
+
+    return aim;
+}
+
+void MissileVolleyMgr::Process()
+{
+    if (m_queue.empty())
+        return;
+
+    double profileStartTime(GetTimeUSeconds()), now(GetTimeMSeconds());
+    uint32 missileID(0);
+    bool hit(false);
+    SystemEntity* pSE(nullptr);
+    Missile* pMissile(nullptr);
+    SystemBubble* pBubble(nullptr);
+    std::multimap<double, std::pair<uint32, bool>>::iterator itr = m_queue.begin();
+    while ((itr != m_queue.end()) and (itr->first <= now)) {
+        missileID = itr->second.first;
+        hit = itr->second.second;
+        itr = m_queue.erase(itr);
+
+        // missile may have gone with its system's entities
+        pSE = m_system->GetSE(missileID);
+        if ((pSE == nullptr) or !pSE->IsMissileSE())
+            continue;
+        pMissile = pSE->GetMissileSE();
+
+        if (hit)
+            pMissile->HitTarget();
+
+        pBubble = pMissile->SysBubble();
+        if ((pBubble != nullptr) and pBubble->HasPlayers())
+            m_removed[pBubble].push_back(missileID);
+
+        pMissile->EndOfLife();
+        m_done.push_back(pMissile);
+    }
+
+    // the missiles' own removal does not send RemoveBall.  send them here, one update per bubble
+    for (auto cur : m_removed)
+        cur.first->RemoveBallList(cur.second);
+    m_removed.clear();
+
+    for (auto cur : m_done)
+        SafeDelete(cur);
+    m_done.clear();
+
+    if (sConfig.debug.UseProfiling)
+        sProfiler.AddTime(Profile::missile, GetTimeUSeconds() - profileStartTime);
+}
+
+bool MissileVolleyMgr::Intercept(const GPoint& from, double speed, const GPoint& pos, const GVector& vel, double radius, double& time)
+{
+    /* solve |D + V*t| = s*t + r for the smallest t >= 0, where D = pos - from
+     *  (V.V - s^2)t^2 + 2(D.V - s*r)t + (D.D - r^2) = 0
+     */
+    double dx(pos.x - from.x), dy(pos.y - from.y), dz(pos.z - from.z);
+    double c((dx * dx) + (dy * dy) + (dz * dz) - (radius * radius));
+    if (c <= 0) {
+        // already within radius
+        time = 0;
+        return true;
+    }
+    if (speed <= 0)
+        return false;
+
+    double a((vel.x * vel.x) + (vel.y * vel.y) + (vel.z * vel.z) - (speed * speed));
+    double b(2 * ((dx * vel.x) + (dy * vel.y) + (dz * vel.z) - (speed * radius)));
+    if (fabs(a) < 0.001) {
+        // target moves as fast as the missile.  linear
+        if (b >= 0)
+            return false;
+        time = -c / b;
+        return true;
+    }
+
+    double disc((b * b) - (4 * a * c));
+    if (disc < 0)
+        return false;
+    disc = sqrt(disc);
+    double t1((-b - disc) / (2 * a)), t2((-b + disc) / (2 * a));
+    if (t1 > t2)
+        std::swap(t1, t2);
+    if (t1 >= 0) {
+        time = t1;
+    } else if (t2 >= 0) {
+        time = t2;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void MissileVolleyMgr::GetKinematics(SystemEntity* pSE, GPoint& pos, GVector& vel)
+{
+    if (pSE->IsMissileSE()) {
+        Missile* pMissile(pSE->GetMissileSE());
+        pos = pMissile->GetFlightPosition();
+        vel = pMissile->GetFlightVelocity();
+        return;
+    }
+    pos = pSE->GetPosition();
+    vel = pSE->GetVelocity();
+}
@@ -0,0 +1,75 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+
+#ifndef EVEMU_SYSTEM_MISSILEVOLLEYMGR_H__
+#define EVEMU_SYSTEM_MISSILEVOLLEYMGR_H__
+
+#include "../eve-server.h"
+
+class Missile;
+class SystemBubble;
+class SystemEntity;
+class SystemManager;
+
+/*  times missiles in flight for one system.  owned by SystemManager.
+ *  a missile is still a SystemEntity with a ball, as the client needs that to draw its flight, and defenders need
+ *  something to shoot at.  but it is no longer ticked or moved by the server.
+ *  at launch, the intercept time is solved from the missile's speed and the target's position and velocity,
+ *  and the missile's end (hit, or end of flight time) is queued here.  Process() hits and removes missiles as
+ *  they come due, and sends one RemoveBalls per bubble for all missiles that ended in that tic.
+ */
+class MissileVolleyMgr {
+public:
+    MissileVolleyMgr(SystemManager* pSystem);
+    ~MissileVolleyMgr()                                 { /* do nothing here */ }
+
+    // sets missile's flight and queues its end.  returns point the missile flies at
+    GPoint Launch(Missile* pMissile);
+    // hits and removes missiles that are due.  called once per tic
+    void Process();
+    // forgets queued missiles.  entities are deleted by SystemManager on unload
+    void Clear()                                        { m_queue.clear(); }
+
+    size_t Size()                                       { return m_queue.size(); }
+
+    /* time (s) for a missile at 'from' flying at 'speed' to come within 'radius' of a target at 'pos' moving at 'vel'.
+     *  returns false if it can never catch the target
+     */
+    static bool Intercept(const GPoint& from, double speed, const GPoint& pos, const GVector& vel, double radius, double& time);
+    // missiles in flight are not moved by the server, so these come from their flight line
+    static void GetKinematics(SystemEntity* pSE, GPoint& pos, GVector& vel);
+
+private:
+    SystemManager* m_system;
+
+    // due time (ms)/(missileID, hit)
+    std::multimap<double, std::pair<uint32, bool>> m_queue;
+
+    // scratch for Process()
+    std::vector<Missile*> m_done;
+    std::map<SystemBubble*, std::vector<uint32>> m_removed;
+};
+
+#endif  // EVEMU_SYSTEM_MISSILEVOLLEYMGR_H__
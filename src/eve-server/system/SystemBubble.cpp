@@ -429,7 +429,8 @@ void SystemBubble::Untrack(SystemEntity *pSE) {
     }
 
     // notify everybody else in the bubble of the removal
-    if (!m_players.empty()) {
+    //  missiles are sent in groups by MissileVolleyMgr, with the others that ended that tic
+    if (!m_players.empty() and !pSE->IsMissileSE()) {
         RemoveBall(pSE);
     }
 
@@ -876,6 +877,23 @@ void SystemBubble::RemoveBall(SystemEntity *about_who) {
     PySafeDecRef( tmp );
 }
 
+void SystemBubble::RemoveBallList(const std::vector<uint32>& ballIDs) {
+    if (!m_system->IsLoaded())
+        return;
+    if (ballIDs.empty())
+        return;
+    RemoveBallsFromBP removeball;
+    removeball.balls.assign(ballIDs.begin(), ballIDs.end());
+
+    _log(DESTINY__MESSAGE, "SystemBubble::RemoveBallList() - %lu balls", ballIDs.size());
+    if (is_log_enabled(DESTINY__BALL_DUMP))
+        removeball.Dump( DESTINY__BALL_DUMP, "    " );
+
+    PyTuple *tmp = removeball.Encode();
+    BubblecastDestinyUpdate(&tmp, "RemoveBall");
+    PySafeDecRef( tmp );
+}
+
 // this *should* only be called from DestinyMgr::Cloak() and DestinyMgr::Jump()
 void SystemBubble::RemoveBallExclusive(SystemEntity *about_who) {
     RemoveBallFromBP removeball;
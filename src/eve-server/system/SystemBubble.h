@@ -170,6 +170,8 @@ public:
     void SyncPos();
     /* for command dropLoot - commands all npcs in bubble to jettison loot */
     void CmdDropLoot();
+    /* for MissileVolleyMgr - removes all missiles that ended this tic in one update */
+    void RemoveBallList(const std::vector<uint32>& ballIDs);
 
 protected:
     const GPoint m_center;
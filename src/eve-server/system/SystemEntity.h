@@ -254,7 +254,8 @@ public:
     /* public generic functions handled in base class. */
     void                        DropLoot(WreckContainerRef wreckRef, uint32 groupID, uint32 owner);
     void                        AwardSecurityStatus(InventoryItemRef iRef, Character* pChar);
-    bool                        ApplyDamage(Damage &d); /* This method is defined in Damage.cpp */
+    /* This method is defined in Damage.cpp.  sendState=false leaves damage state update to caller (CombatPass sends one per target per tic) */
+    bool                        ApplyDamage(Damage &d, bool sendState=true);
     double                      DistanceTo2(const SystemEntity* other);
     PyTuple*                    MakeDamageState();
 
@@ -65,15 +65,19 @@
 #include "system/cosmicMgrs/SpawnMgr.h"
 #include "station/Outpost.h"
 #include "services/ServiceManager.h"
+#include "utils/TimerWheel.h"
 
 SystemManager::SystemManager(uint32 systemID, EVEServiceManager &svc)
 :m_services(svc),
-m_bountyTimer(0),
-m_minutetimer(0, true),
+m_bountyTimerID(0),
+m_minuteTimerID(0),
 m_anomMgr(new AnomalyMgr(this, svc)),
 m_beltMgr(new BeltMgr(this, svc)),
 m_dungMgr(new DungeonMgr(this, svc)),
 m_spawnMgr(new SpawnMgr(this, svc)),
+m_npcAIPass(this),
+m_missileVolley(this),
+m_combatPass(this),
 m_loaded(false),
 m_entityChanged(false),
 m_docked(0),
@@ -124,6 +128,9 @@ SystemManager::~SystemManager() {
     if (m_loaded)
         UnloadSystem();
 
+    // timers hold this system.  UnloadSystem() may bail out, and BootSystem() may have failed after scheduling them
+    CancelTimers();
+
     SafeDelete(m_dungMgr);
     SafeDelete(m_anomMgr);
     SafeDelete(m_beltMgr);
@@ -175,7 +182,7 @@ bool SystemManager::BootSystem() {
             */
 
     if (sConfig.server.BountyPayoutDelayed)
-        m_bountyTimer.Start(sConfig.server.BountyPayoutTimer * 60 * 1000);
+        m_bountyTimerID = sTimerWheel.Schedule(sConfig.server.BountyPayoutTimer * 60 * 1000, [this]() { BountyTic(); });
 
     //create our chat channels
     this->m_lsc->CreateSystemChannel(m_data.regionID);
@@ -192,7 +199,7 @@ bool SystemManager::BootSystem() {
     MapDB::LoadDynamicData(m_data.systemID, m_killData);
 
     //start minute timer
-    m_minutetimer.Start(60000);
+    m_minuteTimerID = sTimerWheel.Schedule(60000, [this]() { MinuteTic(); });
 
     return (m_loaded = true);
 }
@@ -222,7 +229,13 @@ bool SystemManager::LoadCosmicMgrs()
 
 //called once per second from EntityList. (1Hz Tic)
 bool SystemManager::ProcessTic() {
-    double profileStartTime(GetTimeUSeconds());
+    ProfileZone zone(Profile::system);
+
+    // positions have moved.  dscan cache is refilled on next scan
+    m_dscanCache.SetDirty();
+
+    // idle npcs look for targets.  this may change npc state before their own Process() below
+    m_npcAIPass.Process(sEntityList.GetStamp());
 
     /* the idea here is entities map NEVER has invalid items in it, but our iterator may become invalid
      *      when SE->Process() returns because Process() will add/remove from the map as needed
@@ -250,31 +263,38 @@ bool SystemManager::ProcessTic() {
         ++itr;
     }
 
+    // move all balls queued above in one pass, then hand results back for per-ball updates
+    m_ballStore.Integrate(GetTimeMSeconds());
+    m_ballStore.Commit();
+
+    // turret shots fired this tic
+    m_combatPass.Process();
+
+    // missiles due this tic hit (or miss) and are removed
+    m_missileVolley.Process();
+
     // tic for sov structures (as they aren't in ticEntities)
     for (auto cur : m_opStaticEntities)
         if (cur.second->IsOperSE())
             cur.second->GetPOSSE()->Process();
-    // check bounty timer
-    if (m_bountyTimer.Check(sConfig.server.BountyPayoutDelayed))
-        PayBounties();
     /* the following are coded for single-tic calls */
-    m_anomMgr->Process();
-    if (m_beltCount)
-        m_beltMgr->Process();
     m_dungMgr->Process();
     m_spawnMgr->Process();
 
-    // process planets for PI
-    if (m_minutetimer.Check()) {
-        //++m_minutes;  // not used at this time
-        for (auto cur : m_planetMap)
-            cur.second->Process();
-    }
+    return SystemActivity();
+}
 
-    if (sConfig.debug.UseProfiling)
-        sProfiler.AddTime(Profile::system, GetTimeUSeconds() - profileStartTime);
+void SystemManager::BountyTic() {
+    PayBounties();
+    m_bountyTimerID = sTimerWheel.Schedule(sConfig.server.BountyPayoutTimer * 60 * 1000, [this]() { BountyTic(); });
+}
 
-    return SystemActivity();
+void SystemManager::MinuteTic() {
+    //++m_minutes;  // not used at this time
+    // process planets for PI
+    for (auto cur : m_planetMap)
+        cur.second->Process();
+    m_minuteTimerID = sTimerWheel.Schedule(60000, [this]() { MinuteTic(); });
 }
 
 bool SystemManager::SystemActivity() {
@@ -286,8 +306,18 @@ bool SystemManager::SystemActivity() {
     return true;
 }
 
+void SystemManager::CancelTimers()
+{
+    sTimerWheel.Cancel(m_bountyTimerID);
+    sTimerWheel.Cancel(m_minuteTimerID);
+    m_bountyTimerID = m_minuteTimerID = 0;
+}
+
 // called from EntityList::Process() and EntityList::Close()
 void SystemManager::UnloadSystem() {
+    // both callers delete this system after unloading, so scheduled tics must stop even if unload bails out
+    CancelTimers();
+
     if (!m_loaded or !SafeToUnload())
         return;
 
@@ -299,7 +329,7 @@ void SystemManager::UnloadSystem() {
     // system is being unloaded.  pay bounties now
     /** @todo  this will throw on error.  if called from d'tor, this CANNOT throw.  fix it */
     //PayBounties();
-    
+
     // unload belts, which saves and removes roids from system
     m_beltMgr->ClearAll();
     // close anomaly mgr, which saves and removes sigs from system
@@ -342,6 +372,10 @@ void SystemManager::UnloadSystem() {
         sBubbleMgr.Remove(pSE);
         SafeDelete(pSE);
     }
+    m_dscanCache.Clear();
+    // in-flight missiles were deleted above
+    m_missileVolley.Clear();
+    m_combatPass.Clear();
 
     // save items, then remove from system inventory, item factory and decrement item count
     m_solarSystemRef->GetMyInventory()->Unload();
@@ -453,6 +487,7 @@ bool SystemManager::LoadSystemStatics() {
             _log(INV__WARNING, "SystemManager::LoadSystemStatics() - Failed to load additional data for entity %u. Continuing.", cur.itemID);
 
         m_entities[cur.itemID] = pSE;
+        m_dscanCache.SetDirty();
         m_staticEntities[cur.itemID] = pSE;
         AddItemToInventory(pSE->GetSelf());
     }
@@ -1056,6 +1091,7 @@ void SystemManager::AddEntity(SystemEntity* pSE, bool addSignal/*true*/) {
     } else {
         _log(ITEM__TRACE, "%s(%u): Added to system manager for %s(%u)", pSE->GetName(), itemID, m_data.name.c_str(), m_data.systemID);
         m_entities[itemID] = pSE;
+        m_dscanCache.SetDirty();
 
         if ((pSE->IsCOSE())
         or  (pSE->isGlobal())) {
@@ -1068,6 +1104,8 @@ void SystemManager::AddEntity(SystemEntity* pSE, bool addSignal/*true*/) {
             // probes are now running sub-hz tics, so dont add to proc list.
             addSignal = false;  // redundant...called with AddSignal=false
             sEntityList.AddProbe(itemID, pSE->GetProbeSE());
+        } else if (pSE->IsMissileSE()) {
+            // missiles are timed by MissileVolleyMgr, so dont add to proc list.
         } else if (!IsStaticItem(itemID)) {
             // *most* dynamic items need proc tics.  add to proc list
             m_entityChanged = true;
@@ -1108,6 +1146,7 @@ void SystemManager::AddMarker(SystemEntity* pSE, bool sendBall/*false*/, bool ad
         return;
 
     m_entities[pSE->GetID()] = pSE;
+    m_dscanCache.SetDirty();
     // Add Entity's Item Ref to Solar System Dynamic Inventory:
     //m_solarSystemRef->AddItemToInventory(pSE->GetSelf());
 
@@ -1464,6 +1503,7 @@ void SystemManager::RemoveItemFromInventory(InventoryItemRef iRef)
     if (itr != m_entities.end()) {
         _log(ITEM__TRACE, "%s(%u): Removed from system manager for %s(%u)", iRef->name(), iRef->itemID(), m_data.name.c_str(), m_data.systemID);
         m_entities.erase(itr);
+        m_dscanCache.SetDirty();
     } else {
         _log(ITEM__WARNING, "%s(%u): Called RemoveEntity(), but they weren\'t found in system manager for %s(%u)", \
                 iRef->name(), iRef->itemID(), m_data.name.c_str(), m_data.systemID);
@@ -1560,7 +1600,7 @@ void SystemManager::GetClientList(std::vector< Client* >& cVec)
         cVec.push_back(cur.second);
 }
 
-void SystemManager::DScan(int64 range, const GPoint& pos, std::vector<SystemEntity*>& vector )
+void SystemManager::UpdateDScanCache()
 {
     /** @todo finish this for correct dscan entity reporting
      * all ships (not cloaked)
@@ -1577,7 +1617,11 @@ void SystemManager::DScan(int64 range, const GPoint& pos, std::vector<SystemEnti
      * may not be in this version, but check for "scan inhibitor" POS module; ships in it are invis to dscan
      * AttrDScanImmune is from rhea expansion.  may be able to implement here.
      */
-    for (auto cur : m_entities) {
+    if (!m_dscanCache.IsDirty())
+        return;
+
+    m_dscanCache.Clear();
+    for (auto& cur : m_entities) {
         // these dont show on dscan
         if (IsTempItem(cur.first))
             continue;
@@ -1598,9 +1642,21 @@ void SystemManager::DScan(int64 range, const GPoint& pos, std::vector<SystemEnti
             if (cur.second->DestinyMgr()->IsCloaked())
                 continue;
         // made it this far.  add item to scan list
-        if (pos.distance(cur.second->GetPosition()) < range)
-            vector.push_back(cur.second);
+        m_dscanCache.Add(cur.second, cur.second->GetPosition());
     }
+    m_dscanCache.SetClean();
+}
+
+void SystemManager::DScan(int64 range, const GPoint& pos, std::vector<SystemEntity*>& vector )
+{
+    UpdateDScanCache();
+    m_dscanCache.RangeQuery(range, pos, vector);
+}
+
+void SystemManager::ConeScan(int64 range, const GPoint& pos, const GVector& dir, double angle, std::vector<SystemEntity*>& vector )
+{
+    UpdateDScanCache();
+    m_dscanCache.ConeQuery(range, pos, dir, angle, vector);
 }
 
 PyRep* SystemManager::GetCurrentEntities()
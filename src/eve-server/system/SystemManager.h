@@ -27,7 +27,12 @@
 #ifndef __SYSTEMMANAGER_H_INCL__
 #define __SYSTEMMANAGER_H_INCL__
 
+#include "npc/NPCAIPass.h"
+#include "system/BallStore.h"
 #include "system/BubbleManager.h"
+#include "system/CombatPass.h"
+#include "system/DScanCache.h"
+#include "system/MissileVolleyMgr.h"
 #include "system/SolarSystem.h"
 #include "system/SystemDB.h"
 #include "chat/LSCService.h"
@@ -108,6 +113,10 @@ public:
     // CosmicMgr interface
     BeltMgr* GetBeltMgr()                               { return m_beltMgr; }
     SpawnMgr* GetSpawnMgr()                             { return m_spawnMgr; }
+    NPCAIPass* GetNPCAIPass()                           { return &m_npcAIPass; }
+    BallStore* GetBallStore()                           { return &m_ballStore; }
+    MissileVolleyMgr* GetMissileVolleyMgr()             { return &m_missileVolley; }
+    CombatPass* GetCombatPass()                         { return &m_combatPass; }
     AnomalyMgr* GetAnomMgr()                            { return m_anomMgr; }
     DungeonMgr* GetDungMgr()                            { return m_dungMgr; }
 
@@ -146,6 +155,8 @@ public:
 
     // this returns entities in range for display on dscan.
     void DScan(int64 range, const GPoint& pos, std::vector< SystemEntity* >& vector);
+    // this returns entities in range and inside cone along dir (angle is full cone width in rad)
+    void ConeScan(int64 range, const GPoint& pos, const GVector& dir, double angle, std::vector< SystemEntity* >& vector);
     // this returns entities in system for display on Groove's Entity Map in client
     PyRep* GetCurrentEntities();
     // this returns entities in system for display on ship scanner when enabled.
@@ -166,6 +177,11 @@ public:
 protected:
     /** @todo  this needs more work */
     void PayBounties();
+    // scheduled on sTimerWheel.  each reschedules itself
+    void BountyTic();
+    void MinuteTic();
+    // cancels both tics.  safe to call when they were never scheduled
+    void CancelTimers();
 
     /* hack to avoid errors with dock count */
     void GetDockedCount();
@@ -229,14 +245,30 @@ private:
     std::map<uint32, SystemEntity*> m_staticEntities;   // this list is for static entities to send in setstate
     std::map<uint32, SystemEntity*> m_opStaticEntities; // this list is for static entities which are operational and need to be initialized and operated upon even when system is empty
 
-    // for bounty processing (20m timer)
-    Timer m_bountyTimer;
+    // dscan position cache.  refilled on first scan after tic or entity list change
+    DScanCache m_dscanCache;
+    void UpdateDScanCache();
+
+    // batched idle npc target scans.  run once per tic, before entity processing
+    NPCAIPass m_npcAIPass;
+
+    // movement queued by DestinyManager::Process() this tic.  integrated after entity processing
+    BallStore m_ballStore;
+
+    // missiles in flight.  these are not ticked; their hits are queued at launch
+    MissileVolleyMgr m_missileVolley;
+
+    // turret shots from weapon cycles that completed this tic.  resolved after entity processing
+    CombatPass m_combatPass;
+
+    // for bounty processing (20m timer).  timerIDs are in sTimerWheel
+    uint32 m_bountyTimerID;
     typedef std::map<uint16, uint8> RatDataMap;  // typeID/amt
     std::map<uint32, BountyData> m_bountyMap;  // charID/data
     std::map<uint32, RatDataMap> m_ratMap;  // charID/rat data
 
     // for PI timing
-    Timer m_minutetimer;
+    uint32 m_minuteTimerID;
     uint32 m_minutes;
 
     // check for null iterator.  this will need to be moved to a memory code file eventually.
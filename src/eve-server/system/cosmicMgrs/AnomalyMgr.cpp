@@ -23,6 +23,7 @@
 #include "system/cosmicMgrs/DungeonMgr.h"
 #include "system/cosmicMgrs/SpawnMgr.h"
 #include "system/cosmicMgrs/WormholeMgr.h"
+#include "utils/TimerWheel.h"
 
 #include "../../../eve-common/EVE_Scanning.h"
 
@@ -54,7 +55,7 @@ m_beltMgr(nullptr),
 m_dungMgr(nullptr),
 m_spawnMgr(nullptr),
 m_spawnTimer(0),
-m_procTimer(0),
+m_procTimerID(0),
 m_WH(0),
 m_Sigs(0),
 m_Anoms(0),
@@ -73,6 +74,7 @@ m_initalized(false)
 
 AnomalyMgr::~AnomalyMgr()
 {
+    sTimerWheel.Cancel(m_procTimerID);
     // this shouldnt be needed...SysMgr should handle all objects in their systems
     /*
     InventoryItemRef iRef(nullptr);
@@ -137,7 +139,7 @@ bool AnomalyMgr::Init(BeltMgr* beltMgr, DungeonMgr* dungMgr, SpawnMgr* spawnMgr)
         else                       { m_maxSigs = 3; }
     }
 
-    m_procTimer.Start(1000); // Initial 5s timer to ensure everything gets loaded correctly
+    m_procTimerID = sTimerWheel.Schedule(1000, [this]() { Process(); }); // Initial 1s timer to ensure everything gets loaded correctly
     // populate the type vector with all of the anomaly types we will use in this system
     for (int i = 0; i < m_maxSigs; i++) { // anomaly and signature count should be accounted for while fillimg the typeList vector
         m_typeList.push_back(GetDungeonType());
@@ -167,28 +169,20 @@ bool AnomalyMgr::Init(BeltMgr* beltMgr, DungeonMgr* dungMgr, SpawnMgr* spawnMgr)
 void AnomalyMgr::Process() {
     if (!m_initalized)
         return;
-    if (m_procTimer.Check(/*!sConfig.debug.IsTestServer*/)) {
-        // Only generate new signals when a player is in the system
-        if (m_system->PlayerCount() > 0 && m_typeList.size () > 0) {
-            auto cur = m_typeList.begin();
-            auto end = m_typeList.end();
-
-            for (; cur != end; cur++) {
-                CreateAnomaly (*cur);
-            }
+    // Only generate new signals when a player is in the system
+    if (m_system->PlayerCount() > 0 && m_typeList.size () > 0) {
+        auto cur = m_typeList.begin();
+        auto end = m_typeList.end();
 
-            m_typeList.clear();
-        }
-        // Once initial spawn is complete, set correct timer based upon whether this is test server or not
-        if (m_firstSpawn) {
-            if (sConfig.debug.IsTestServer) {
-                m_procTimer.SetTimer(10000);  // 10s
-            } else {
-                m_procTimer.SetTimer(120000);  // 2m
-            }
-            m_firstSpawn = false;
+        for (; cur != end; cur++) {
+            CreateAnomaly (*cur);
         }
+
+        m_typeList.clear();
     }
+    // after initial spawn, timer is based upon whether this is test server or not
+    m_firstSpawn = false;
+    m_procTimerID = sTimerWheel.Schedule(sConfig.debug.IsTestServer ? 10000 : 120000, [this]() { Process(); });  // 10s : 2m
     //TODO: Implement checking for expired anomalies
     /*if (m_spawnTimer.Check(false)) {
         // Check for expired anomalies and delete them
@@ -198,6 +192,8 @@ void AnomalyMgr::Process() {
 
 void AnomalyMgr::Close()
 {
+    sTimerWheel.Cancel(m_procTimerID);
+    m_procTimerID = 0;
     _log(COSMIC_MGR__MESSAGE, "Closing AnomalyMgr for %s(%u).", m_system->GetName(), m_system->GetID());
 }
 
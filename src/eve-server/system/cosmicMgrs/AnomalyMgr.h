@@ -33,6 +33,7 @@ class AnomalyMgr
 
     bool Init(BeltMgr* beltMgr, DungeonMgr* dungMgr, SpawnMgr* spawnMgr);
     void Close();
+    // scheduled on sTimerWheel.  1s after Init(), then every 2m (10s on test server)
     void Process();
 
     void CreateAnomaly(int8 typeID);
@@ -69,7 +70,7 @@ private:
     EVEServiceManager& m_services;
 
     Timer m_spawnTimer;
-    Timer m_procTimer;
+    uint32 m_procTimerID;
 
     bool m_initalized;
     bool m_firstSpawn;
@@ -24,10 +24,11 @@
 #include "system/SystemManager.h"
 #include "system/cosmicMgrs/BeltMgr.h"
 #include "system/cosmicMgrs/SpawnMgr.h"
+#include "utils/TimerWheel.h"
 
 
 BeltMgr::BeltMgr(SystemManager* mgr, EVEServiceManager& svc)
-: m_respawnTimer(0),
+: m_respawnTimerID(0),
 m_system(mgr),
 m_services(svc),
 m_initialized(false)
@@ -39,6 +40,11 @@ m_initialized(false)
     m_spawned.clear();
 }
 
+BeltMgr::~BeltMgr()
+{
+    sTimerWheel.Cancel(m_respawnTimerID);
+}
+
 void BeltMgr::Init()
 {
     if (!sConfig.cosmic.BeltEnabled) {
@@ -50,7 +56,8 @@ void BeltMgr::Init()
     m_active.clear();
     m_spawned.clear();
 
-    m_respawnTimer.Start(sConfig.cosmic.BeltRespawn *60 *60 *1000);  // hours->ms
+    sTimerWheel.Cancel(m_respawnTimerID);
+    m_respawnTimerID = sTimerWheel.Schedule(sConfig.cosmic.BeltRespawn *60 *60 *1000, [this]() { Process(); });  // hours->ms
 
     m_initialized = true;
     _log(COSMIC_MGR__INIT, "BeltMgr Initialized for %s(%u)", m_system->GetName(), m_system->GetID());
@@ -71,6 +78,8 @@ void BeltMgr::ClearBelt(uint16 bubbleID)
 }
 
 void BeltMgr::ClearAll() {
+    sTimerWheel.Cancel(m_respawnTimerID);
+    m_respawnTimerID = 0;
     Save();
     for (auto cur : m_asteroids) {
         m_system->RemoveEntity(cur.second);
@@ -128,14 +137,14 @@ void BeltMgr::Process() {
     if (!m_initialized)
         return;
 
-    if (m_respawnTimer.Check()) {
-        for (auto cur : m_spawned)
-            if (!cur.second) {
-                std::unordered_multimap<float, uint16> roidTypes;
-                roidTypes.clear();
-                SpawnBelt(cur.first, roidTypes);
-            }
-    }
+    for (auto cur : m_spawned)
+        if (!cur.second) {
+            std::unordered_multimap<float, uint16> roidTypes;
+            roidTypes.clear();
+            SpawnBelt(cur.first, roidTypes);
+        }
+
+    m_respawnTimerID = sTimerWheel.Schedule(sConfig.cosmic.BeltRespawn *60 *60 *1000, [this]() { Process(); });
 }
 
 bool BeltMgr::Load(uint16 bubbleID) {
@@ -35,10 +35,11 @@ class BeltMgr
 {
 public:
     BeltMgr(SystemManager* mgr, EVEServiceManager& svc);
-    ~BeltMgr()    { /* do nothing here */ }
+    ~BeltMgr();
 
     void Init();
     void Save();
+    // respawns depleted belts.  scheduled on sTimerWheel every BeltRespawn hours
     void Process();
     void ClearAll();
     void ClearBelt(uint16 bubbleID);
@@ -56,7 +57,7 @@ public:
     void RemoveAsteroid(uint32 beltID, AsteroidSE* pASE);
 
 protected:
-    Timer m_respawnTimer;
+    uint32 m_respawnTimerID;
 
     void SpawnBelt(uint16 bubbleID, std::unordered_multimap<float, uint16>& roidTypes, int type = 0, bool anomaly = false);
     void SpawnAsteroid(uint32 beltID, uint32 typeID, double radius, const GPoint& position, bool ice=false);
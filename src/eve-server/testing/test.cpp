@@ -11,7 +11,21 @@
 #include "eve-server.h"
 
 #include "Client.h"
+#include "character/Character.h"
+#include "effects/EffectsGraph.h"
+#include "inventory/Inventory.h"
+#include "npc/NPCAIPass.h"
+#include "search/SearchIndex.h"
+#include "services/Service.h"
+#include "ship/Ship.h"
+#include "ship/modules/TurretFormulas.h"
+#include "system/BallStore.h"
+#include "system/CombatPass.h"
+#include "system/Damage.h"
+#include "system/DScanCache.h"
+#include "system/MissileVolleyMgr.h"
 #include "system/SystemEntity.h"
+#include "system/SystemManager.h"
 #include "testing/test.h"
 
 void testing::posTest(Client* pClient) {
@@ -19,3 +33,767 @@ void testing::posTest(Client* pClient) {
 
     sLog.Warning("\ttesting","Test competed");
 }
+
+namespace {
+    // runs fn(i) for each loop, and returns the mean time per loop in us
+    template <typename Fn>
+    double TimeLoops(uint32 loops, Fn fn)
+    {
+        double start(GetTimeUSeconds());
+        for (uint32 i = 0; i < loops; ++i)
+            fn(i);
+        return (GetTimeUSeconds() - start) / loops;
+    }
+
+    // logs a bench's results and returns them for the caller's reply
+    std::string Report(const std::ostringstream& str)
+    {
+        sLog.Warning("\ttesting", "%s", str.str().c_str());
+        return str.str();
+    }
+
+    // CombatPass for combatBench.  its entities are not in the system, so they are looked up here instead
+    class BenchCombatPass : public CombatPass {
+    public:
+        BenchCombatPass(SystemManager* pSystem, std::map<uint32, SystemEntity*>& entities)
+        : CombatPass(pSystem), m_entities(entities)     { /* do nothing here */ }
+
+    protected:
+        SystemEntity* GetSE(uint32 entityID) override
+        {
+            std::map<uint32, SystemEntity*>::iterator itr = m_entities.find(entityID);
+            return (itr == m_entities.end() ? nullptr : itr->second);
+        }
+
+    private:
+        std::map<uint32, SystemEntity*>& m_entities;
+    };
+
+    // minimal refcounted object for the container iteration test
+    class BenchObj : public RefObject {
+    public:
+        BenchObj(uint32 id) : RefObject(0), m_id(id)    { /* do nothing here */ }
+        uint32 id() const                               { return m_id; }
+    private:
+        uint32 m_id;
+    };
+}
+
+std::string testing::refPtrBench(Client* pClient, uint32 loops)
+{
+    if (loops < 1)
+        loops = 100;
+
+    std::ostringstream str;
+    str << "RefPtr benchmark (" << loops << " loops)<br>";
+
+    // container iteration; same shape as Inventory::mContents
+    std::map<uint32, RefPtr<BenchObj>> contents;
+    for (uint32 i = 0; i < 10000; ++i)
+        contents.emplace(i, RefPtr<BenchObj>(new BenchObj(i)));
+
+    int64 sum(0);
+    double byValue = TimeLoops(loops, [&](uint32) {
+        for (auto cur : contents)
+            sum += cur.second->id();
+    });
+    double byRef = TimeLoops(loops, [&](uint32) {
+        for (auto& cur : contents)
+            sum += cur.second->id();
+    });
+
+    str << "  map iteration, 10k items: by value " << byValue << "us, by reference " << byRef << "us<br>";
+
+    // building a ref list, as item queries do.  copy (old) vs move
+    std::vector<RefPtr<BenchObj>> refVec;
+    refVec.reserve(contents.size());
+    double byCopy = TimeLoops(loops, [&](uint32) {
+        refVec.clear();
+        for (auto& cur : contents) {
+            RefPtr<BenchObj> ref(cur.second);
+            refVec.push_back(ref);
+        }
+    });
+    double byMove = TimeLoops(loops, [&](uint32) {
+        refVec.clear();
+        for (auto& cur : contents) {
+            RefPtr<BenchObj> ref(cur.second);
+            refVec.push_back(std::move(ref));
+        }
+    });
+
+    str << "  vector fill, 10k items: copy " << byCopy << "us, move " << byMove << "us<br>";
+
+    // ship inventory listing
+    ShipItemRef shipRef(pClient->GetShip());
+    Inventory* pInv(shipRef->GetMyInventory());
+    if (pInv != nullptr) {
+        // List()'s row loop over the ship's items, with each ref copied out of the map (old) and by reference
+        std::map<uint32, InventoryItemRef> invMap;
+        pInv->GetInventoryMap(invMap);
+        DBRowDescriptor* header(sDataMgr.CreateHeader());
+        CRowSet* rowset(new CRowSet(&header));
+        double listCopy = TimeLoops(loops, [&](uint32) {
+            for (auto cur : invMap)
+                cur.second->GetItemRow(rowset->NewRow());
+        });
+        double listRef = TimeLoops(loops, [&](uint32) {
+            for (auto& cur : invMap)
+                cur.second->GetItemRow(rowset->NewRow());
+        });
+        PyDecRef(rowset);
+        str << "  item rows for " << invMap.size() << " items: by value " << listCopy << "us, by reference " << listRef << "us<br>";
+
+        double list = TimeLoops(loops, [&](uint32) { PyDecRef(pInv->List(flagNone)); });
+        str << "  Inventory::List() for " << shipRef->name() << ": " << list << "us<br>";
+    }
+
+    // effect application.  only run docked, as this resets and reapplies all ship and skill modifiers
+    if (pClient->IsDocked()) {
+        double effects = TimeLoops(loops, [&](uint32) {
+            shipRef->ProcessEffects(false);
+            shipRef->ProcessEffects(true, false);
+        });
+        str << "  ShipItem::ProcessEffects() reset+apply: " << effects << "us<br>";
+    } else {
+        str << "  effect application skipped (must be docked)<br>";
+    }
+
+    str << "  (checksum " << sum << ")<br>";
+    return Report(str);
+}
+
+std::string testing::dscanBench(Client* pClient, uint32 loops)
+{
+    if (loops < 1)
+        loops = 100;
+
+    std::ostringstream str;
+    str << "DScan benchmark (" << loops << " loops, 10k entities)<br>";
+
+    // random positions within 14AU of origin.  entity pointers are not used by the queries
+    const double maxRange(14.4 * ONE_AU_IN_METERS);
+    const double range(5 * ONE_AU_IN_METERS);
+    const float angle(M_PI / 3);    // 60 degree cone
+    std::vector<GPoint> points;
+    DScanCache cache;
+    for (uint32 i = 0; i < 10000; ++i) {
+        GPoint pos(MakeRandomFloat(-maxRange, maxRange), MakeRandomFloat(-maxRange, maxRange), MakeRandomFloat(-maxRange, maxRange));
+        points.push_back(pos);
+        cache.Add(nullptr, pos);
+    }
+    const GPoint vertex(NULL_ORIGIN);
+    GVector U(1, 1, 0);
+    U.normalize();
+
+    // old method.  range check then normalize, dot and acos per entity
+    uint32 oldRange(0), oldCone(0);
+    double oldTime = TimeLoops(loops, [&](uint32) {
+        oldRange = 0;
+        oldCone = 0;
+        for (auto& cur : points) {
+            if (vertex.distance(cur) >= range)
+                continue;
+            ++oldRange;
+            GVector VR(vertex, cur);
+            VR.normalize();
+            if (acos(U.dotProduct(VR)) < angle / 2)
+                ++oldCone;
+        }
+    });
+
+    std::vector<SystemEntity*> rangeVec, coneVec;
+    double rangeTime = TimeLoops(loops, [&](uint32) {
+        rangeVec.clear();
+        cache.RangeQuery(range, vertex, rangeVec);
+    });
+    double coneTime = TimeLoops(loops, [&](uint32) {
+        coneVec.clear();
+        cache.ConeQuery(range, vertex, U, angle, coneVec);
+    });
+
+    str << "  per-entity range+acos: " << oldTime << "us (" << oldRange << " in range, " << oldCone << " in cone)<br>";
+    str << "  DScanCache::RangeQuery(): " << rangeTime << "us (" << rangeVec.size() << " in range)<br>";
+    str << "  DScanCache::ConeQuery(): " << coneTime << "us (" << coneVec.size() << " in cone)<br>";
+
+    // live system, if we're in space
+    if (!pClient->IsDocked() and (pClient->SystemMgr() != nullptr)) {
+        std::vector<SystemEntity*> seVec;
+        double scanTime = TimeLoops(loops, [&](uint32) {
+            seVec.clear();
+            pClient->SystemMgr()->ConeScan(range, pClient->GetShipSE()->GetPosition(), U, angle, seVec);
+        });
+        str << "  SystemManager::ConeScan() in " << pClient->GetSystemName() << ": " << scanTime << "us (" << seVec.size() << " found)<br>";
+    }
+
+    return Report(str);
+}
+
+namespace {
+    // small service with a few overloads, registered in the same order real services do
+    class BenchService : public Service <BenchService> {
+    public:
+        BenchService() : Service("benchService") {
+            this->Add("GetInfo", &BenchService::GetInfo);
+            this->Add("GetInfo", static_cast <PyResult(BenchService::*)(PyCallArgs&, PyInt*)>(&BenchService::GetItem));
+            this->Add("GetItem", static_cast <PyResult(BenchService::*)(PyCallArgs&, PyString*)>(&BenchService::GetItem));
+            this->Add("GetItem", static_cast <PyResult(BenchService::*)(PyCallArgs&, PyInt*, PyInt*)>(&BenchService::GetItem));
+            this->Add("GetItem", static_cast <PyResult(BenchService::*)(PyCallArgs&, PyInt*)>(&BenchService::GetItem));
+            this->Add("GetList", &BenchService::GetList);
+        }
+
+        PyResult GetInfo(PyCallArgs& call)                                  { return nullptr; }
+        PyResult GetItem(PyCallArgs& call, PyString* name)                  { return nullptr; }
+        PyResult GetItem(PyCallArgs& call, PyInt* itemID, PyInt* typeID)    { return nullptr; }
+        PyResult GetItem(PyCallArgs& call, PyInt* itemID)                   { return nullptr; }
+        PyResult GetList(PyCallArgs& call, std::optional <PyList*> list)    { return nullptr; }
+    };
+}
+
+std::string testing::dispatchBench(Client* pClient, uint32 loops)
+{
+    if (loops < 1)
+        loops = 100000;
+
+    std::ostringstream str;
+    str << "Service dispatch benchmark (" << loops << " loops)<br>";
+
+    BenchService svc;
+    // old layout.  linear (name, handler) list, signature mismatch reported by exception
+    std::vector<std::pair<std::string, CallHandlerBase*>> oldHandlers;
+    oldHandlers.push_back(std::make_pair(std::string("GetInfo"), new CallHandler<BenchService>(&BenchService::GetInfo)));
+    oldHandlers.push_back(std::make_pair(std::string("GetInfo"), new CallHandler<BenchService>(static_cast <PyResult(BenchService::*)(PyCallArgs&, PyInt*)>(&BenchService::GetItem))));
+    oldHandlers.push_back(std::make_pair(std::string("GetItem"), new CallHandler<BenchService>(static_cast <PyResult(BenchService::*)(PyCallArgs&, PyString*)>(&BenchService::GetItem))));
+    oldHandlers.push_back(std::make_pair(std::string("GetItem"), new CallHandler<BenchService>(static_cast <PyResult(BenchService::*)(PyCallArgs&, PyInt*, PyInt*)>(&BenchService::GetItem))));
+    oldHandlers.push_back(std::make_pair(std::string("GetItem"), new CallHandler<BenchService>(static_cast <PyResult(BenchService::*)(PyCallArgs&, PyInt*)>(&BenchService::GetItem))));
+    oldHandlers.push_back(std::make_pair(std::string("GetList"), new CallHandler<BenchService>(&BenchService::GetList)));
+
+    // GetItem(int) is the last overload, so the old method throws twice before finding it
+    PyTuple* tuple = new PyTuple(1);
+    tuple->SetItem(0, new PyInt(pClient->GetCharacterID()));
+    PyDict* dict = new PyDict();
+    PyCallArgs args(pClient, tuple, dict);
+    PyDecRef(dict);
+    const std::string name("GetItem");
+
+    uint32 found(0);
+    double oldTime = TimeLoops(loops, [&](uint32) {
+        for (auto handler : oldHandlers) {
+            if (handler.first != name)
+                continue;
+            try {
+                if (!handler.second->matches(args))
+                    throw std::invalid_argument("arguments do not match");
+                (*handler.second)(reinterpret_cast <void*> (&svc), args);
+                ++found;
+                break;
+            } catch (std::invalid_argument) {
+                // ignored, this just means the function does not match the possible calls
+            }
+        }
+    });
+    double newTime = TimeLoops(loops, [&](uint32) { svc.Dispatch(name, args); });
+
+    for (auto cur : oldHandlers)
+        delete cur.second;
+
+    const CallTable::Method& method = svc.GetCallTable().methods().at(name);
+    str << "  linear scan + exceptions: " << (oldTime * 1000) << "ns/call (" << found << " dispatched)<br>";
+    str << "  CallTable: " << (newTime * 1000) << "ns/call (" << method.calls << " calls, " << method.mismatches << " not matched)<br>";
+
+    return Report(str);
+}
+
+std::string testing::searchBench(Client* pClient, uint32 loops)
+{
+    if (loops < 1)
+        loops = 100;
+
+    std::ostringstream str;
+    str << "Name search benchmark (" << loops << " loops, 300k names)<br>";
+
+    // two or three random syllables each, like generated character names
+    const char* syllables[] = { "al", "an", "ar", "bel", "cor", "da", "el", "en", "fal", "gar", "hal", "in", "ja", "kor", "la",
+                                "mar", "nor", "or", "pa", "qui", "ra", "sol", "ta", "ul", "ven", "wyn", "xa", "yor", "zen" };
+    const uint8 count(sizeof(syllables) / sizeof(syllables[0]));
+    std::vector<std::string> names;
+    NameIndex index;
+    double start(GetTimeMSeconds());
+    for (uint32 i = 0; i < 300000; ++i) {
+        std::string name;
+        for (uint8 j = 0, parts = MakeRandomInt(2, 3); j < parts; ++j)
+            name += syllables[MakeRandomInt(0, count - 1)];
+        name += " ";
+        for (uint8 j = 0, parts = MakeRandomInt(2, 3); j < parts; ++j)
+            name += syllables[MakeRandomInt(0, count - 1)];
+        name[0] -= 'a' - 'A';
+        names.push_back(name);
+        index.Add(90000000 + i, name);
+    }
+    str << "  index built in " << (GetTimeMSeconds() - start) << "ms<br>";
+
+    // client wildcards are already converted to '%' by the search service
+    const std::vector<std::string> patterns = { "kormar%", "%venwyn%", "%or%zen%", names[12345] };
+    std::vector<uint32> found;
+    for (auto& pattern : patterns) {
+        // old method, as the db did it.  check every name, cap at searchMaxResults
+        std::string lower(NameIndex::ToLower(pattern));
+        uint32 oldCount(0);
+        double oldTime = TimeLoops(loops, [&](uint32) {
+            oldCount = 0;
+            for (auto& cur : names) {
+                if (!NameIndex::Match(NameIndex::ToLower(cur), lower))
+                    continue;
+                if (++oldCount >= searchMaxResults)
+                    break;
+            }
+        });
+        double newTime = TimeLoops(loops, [&](uint32) {
+            found.clear();
+            index.Find(pattern, found, searchMaxResults);
+        });
+
+        str << "  '" << pattern << "': scan " << oldTime << "us (" << oldCount << " found), ";
+        str << "NameIndex " << newTime << "us (" << found.size() << " found)<br>";
+    }
+
+    return Report(str);
+}
+
+std::string testing::rowsetBench(Client* pClient, uint32 loops)
+{
+    if (loops < 1)
+        loops = 20;
+
+    std::ostringstream str;
+    str << "Rowset benchmark (" << loops << " loops, invTypes cache query)<br>";
+
+    double queryTime(0), rowsetTime(0), marshalTime(0), start(0);
+    size_t rows(0), bytes(0);
+    for (uint32 i = 0; i < loops; ++i) {
+        DBQueryResult res;
+        start = GetTimeUSeconds();
+        if (!sDatabase.RunQuery(res,
+            "SELECT typeID, groupID, typeName, description, graphicID, radius, mass, volume, capacity, portionSize, raceID,"
+            " basePrice, published, marketGroupID, chanceOfDuplicating, soundID, iconID, dataID, typeNameID, descriptionID"
+            " FROM invTypes LIMIT 5000"))
+        {
+            codelog(DATABASE__ERROR, "Error in query: %s", res.error.c_str());
+            str << "  query failed<br>";
+            return str.str();
+        }
+        queryTime += GetTimeUSeconds() - start;
+        rows = res.GetRowCount();
+
+        start = GetTimeUSeconds();
+        PyRep* rep = DBResultToCRowset(res);
+        rowsetTime += GetTimeUSeconds() - start;
+
+        Buffer data;
+        start = GetTimeUSeconds();
+        Marshal(rep, data);
+        marshalTime += GetTimeUSeconds() - start;
+        bytes = data.size();
+        PyDecRef(rep);
+    }
+
+    str << "  query: " << (queryTime / loops) << "us, DBResultToCRowset: " << (rowsetTime / loops) << "us, Marshal: ";
+    str << (marshalTime / loops) << "us (" << rows << " rows, " << bytes << " bytes)<br>";
+
+    return Report(str);
+}
+
+std::string testing::npcAIBench(Client* pClient, uint32 loops)
+{
+    if (loops < 1)
+        loops = 100;
+
+    const uint32 bubbles(50), npcs(100), players(10), sightRange(20000), cycle(NPCAIPass::GetScanCycle(4000));
+    std::ostringstream str;
+    str << "NPC AI benchmark (" << loops << " tics, " << (bubbles * npcs) << " idle npcs, " << (bubbles * players) << " players, " << bubbles << " bubbles)<br>";
+
+    // npcs and players spread within 40km of each bubble center.  bubble list is keyed by id, as SystemBubble's is
+    const double spread(40000);
+    std::vector<std::map<uint32, GPoint>> bubblePlayers(bubbles);
+    std::vector<std::vector<GPoint>> bubbleNPCs(bubbles);
+    uint32 id(0);
+    for (uint32 b = 0; b < bubbles; ++b) {
+        for (uint32 i = 0; i < players; ++i)
+            bubblePlayers[b][++id] = GPoint(MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread));
+        for (uint32 i = 0; i < npcs; ++i)
+            bubbleNPCs[b].push_back(GPoint(MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread)));
+    }
+
+    // old method.  every npc copies its bubble's player list and takes the first player in sight
+    uint32 oldFound(0);
+    double oldTime = TimeLoops(loops, [&](uint32) {
+        oldFound = 0;
+        for (uint32 b = 0; b < bubbles; ++b) {
+            for (auto& npc : bubbleNPCs[b]) {
+                std::vector<GPoint> playerVec;
+                for (auto& cur : bubblePlayers[b])
+                    playerVec.push_back(cur.second);
+                for (auto& cur : playerVec) {
+                    if (npc.distance(cur) > sightRange)
+                        continue;
+                    ++oldFound;
+                    break;
+                }
+            }
+        }
+    });
+
+    // one target list per bubble, nearest target in sight.  all npcs scan every tic
+    NPCTargetList targets;
+    uint32 newFound(0);
+    double newTime = TimeLoops(loops, [&](uint32) {
+        newFound = 0;
+        for (uint32 b = 0; b < bubbles; ++b) {
+            targets.Clear();
+            for (auto& cur : bubblePlayers[b])
+                targets.Add(nullptr, cur.second);
+            for (auto& npc : bubbleNPCs[b])
+                if (targets.Nearest(npc, sightRange) > -1)
+                    ++newFound;
+        }
+    });
+
+    // as NPCAIPass does it.  npcs scan once per attack cycle on their own slot, and bubbles with nobody due are skipped
+    uint32 scans(0);
+    double passTime = TimeLoops(loops, [&](uint32 i) {
+        id = 0;
+        for (uint32 b = 0; b < bubbles; ++b) {
+            bool filled(false);
+            for (auto& npc : bubbleNPCs[b]) {
+                if ((i + ++id) % cycle)
+                    continue;
+                if (!filled) {
+                    targets.Clear();
+                    for (auto& cur : bubblePlayers[b])
+                        targets.Add(nullptr, cur.second);
+                    filled = true;
+                }
+                targets.Nearest(npc, sightRange);
+                ++scans;
+            }
+        }
+    });
+
+    str << "  per-npc copy and scan: " << oldTime << "us per tic (" << oldFound << " found targets)<br>";
+    str << "  NPCTargetList per bubble: " << newTime << "us per tic (" << newFound << " found targets)<br>";
+    str << "  staggered over " << cycle << " tics: " << passTime << "us per tic (" << (scans / loops) << " scans per tic)<br>";
+
+    // live system is not run here, as Process() would change npc state.  just show how many npcs it has
+    if (!pClient->IsDocked() and (pClient->SystemMgr() != nullptr))
+        str << "  NPCAIPass in " << pClient->GetSystemName() << ": " << pClient->SystemMgr()->GetNPCAIPass()->Size() << " npcs<br>";
+
+    return Report(str);
+}
+
+namespace {
+    // stand-in for an entity and its DestinyManager.  each is its own allocation, with the movement vars among others
+    class BenchBall {
+    public:
+        BenchBall() : m_pad() { }
+        virtual ~BenchBall() { }
+        virtual void Process(double nowMs) {
+            float tf(m_timeFraction);
+            if (m_ramp) {
+                tf = (1 - exp(-((nowMs - m_moveTime) * 0.001f) / m_agility));
+                m_timeFraction = tf;
+            }
+            if (m_seek) {
+                GVector heading(m_position, m_target);
+                heading.normalize();
+                m_heading = heading;
+            }
+            float speed(m_maxSpeed * (m_from + (m_to - m_from) * tf));
+            m_velocity = m_heading * speed;
+            m_position += m_velocity;
+        }
+
+        GPoint m_position, m_target;
+        GVector m_velocity, m_heading;
+        float m_maxSpeed, m_from, m_to, m_timeFraction;
+        double m_agility, m_moveTime;
+        bool m_ramp, m_seek;
+        char m_pad[512];    // rest of DestinyManager/SystemEntity
+    };
+}
+
+std::string testing::ballBench(Client* pClient, uint32 loops)
+{
+    if (loops < 1)
+        loops = 100;
+
+    const uint32 count(10000);
+    std::ostringstream str;
+    str << "Ball movement benchmark (" << loops << " tics, " << count << " balls.  1 in 4 changing speed, 1 in 10 missiles)<br>";
+
+    // balls within 100km, headed in random directions
+    const double spread(100000), now(GetTimeMSeconds());
+    std::map<uint32, BenchBall*> balls;
+    for (uint32 i = 0; i < count; ++i) {
+        BenchBall* pBall(new BenchBall());
+        pBall->m_position = GPoint(MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread));
+        pBall->m_target = GPoint(MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread));
+        GVector heading(MakeRandomFloat(-1, 1), MakeRandomFloat(-1, 1), MakeRandomFloat(-1, 1));
+        heading.normalize();
+        pBall->m_heading = heading;
+        pBall->m_maxSpeed = MakeRandomFloat(100, 3000);
+        pBall->m_agility = MakeRandomFloat(2, 20);
+        pBall->m_moveTime = now - MakeRandomFloat(0, 10000);
+        pBall->m_ramp = ((i % 4) == 0);
+        pBall->m_seek = ((i % 10) == 0);
+        pBall->m_from = (pBall->m_ramp ? 0.0f : 1.0f);
+        pBall->m_to = 1.0f;
+        pBall->m_timeFraction = (pBall->m_ramp ? 0.0f : 1.0f);
+        // spread keys out, as itemIDs are
+        balls[140000000 + i * 7] = pBall;
+    }
+
+    // old method.  each ball moves itself through a virtual call, in map order
+    double oldTime = TimeLoops(loops, [&](uint32 i) {
+        for (auto cur : balls)
+            cur.second->Process(now + i * 1000);
+    });
+
+    // BallStore.  rows are queued each tic, as DestinyManager::MoveObject() does, then integrated together
+    BallStore store;
+    double queueTime(0), intTime(0), start(0), mark(0);
+    for (uint32 i = 0; i < loops; ++i) {
+        start = GetTimeUSeconds();
+        for (auto cur : balls) {
+            BenchBall* pBall(cur.second);
+            int32 idx(store.Add(nullptr, pBall->m_position));
+            if (pBall->m_seek) {
+                store.SetSeek(idx, pBall->m_target, pBall->m_maxSpeed);
+            } else {
+                store.SetLinear(idx, pBall->m_heading, pBall->m_maxSpeed, pBall->m_from, pBall->m_to, pBall->m_ramp, pBall->m_timeFraction, pBall->m_agility, pBall->m_moveTime);
+            }
+        }
+        mark = GetTimeUSeconds();
+        queueTime += mark - start;
+        store.Integrate(now + i * 1000);
+        intTime += GetTimeUSeconds() - mark;
+        // rows have no owner here, so Commit() would not hand anything back
+        store.Clear();
+    }
+
+    str << "  per-ball Process(): " << oldTime << "us per tic<br>";
+    str << "  BallStore queue: " << (queueTime / loops) << "us per tic<br>";
+    str << "  BallStore::Integrate(): " << (intTime / loops) << "us per tic<br>";
+
+    for (auto cur : balls)
+        SafeDelete(cur.second);
+
+    return Report(str);
+}
+
+std::string testing::interceptBench(Client* pClient, uint32 loops)
+{
+    if (loops < 1)
+        loops = 10;
+
+    const uint32 count(5000), tics(10);
+    std::ostringstream str;
+    str << "Missile intercept benchmark (" << loops << " volleys of " << count << " missiles, " << tics << "s flight)<br>";
+
+    // targets within 50km of launchers, moving at up to 400m/s.  missiles at 3-5km/s
+    const double spread(50000);
+    std::vector<GPoint> from(count), pos(count);
+    std::vector<GVector> vel(count);
+    std::vector<double> speed(count);
+    for (uint32 i = 0; i < count; ++i) {
+        from[i] = GPoint(MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread));
+        pos[i] = GPoint(MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread));
+        vel[i] = GVector(MakeRandomFloat(-230, 230), MakeRandomFloat(-230, 230), MakeRandomFloat(-230, 230));
+        speed[i] = MakeRandomFloat(3000, 5000);
+    }
+
+    // old method.  each missile seeks its target every tic until its hit or life timer runs out
+    uint32 oldHits(0), hits(0);
+    double oldTime = TimeLoops(loops, [&](uint32) {
+        std::vector<GPoint> missile(from), target(pos);
+        std::vector<bool> alive(count, true);
+        for (uint32 t = 1; t <= tics; ++t) {
+            for (uint32 i = 0; i < count; ++i) {
+                if (!alive[i])
+                    continue;
+                target[i] += vel[i];
+                GVector heading(missile[i], target[i]);
+                double dist(heading.length());
+                heading.normalize();
+                if (dist <= speed[i]) {
+                    alive[i] = false;
+                    ++oldHits;
+                    continue;
+                }
+                missile[i] += heading * speed[i];
+            }
+        }
+    });
+
+    // intercept solved once at launch, then due missiles popped from a queue each tic, as MissileVolleyMgr does
+    double time(0);
+    double newTime = TimeLoops(loops, [&](uint32) {
+        std::multimap<double, uint32> queue;
+        for (uint32 i = 0; i < count; ++i)
+            if (MissileVolleyMgr::Intercept(from[i], speed[i], pos[i], vel[i], 0, time) and (time <= tics))
+                queue.insert(std::make_pair(time, i));
+        for (uint32 t = 1; t <= tics; ++t) {
+            std::multimap<double, uint32>::iterator itr = queue.begin();
+            while ((itr != queue.end()) and (itr->first <= t)) {
+                itr = queue.erase(itr);
+                ++hits;
+            }
+        }
+    });
+
+    str << "  per-tic seek: " << oldTime << "us per volley, " << (oldHits / loops) << " hits<br>";
+    str << "  intercept + queue: " << newTime << "us per volley, " << (hits / loops) << " hits<br>";
+
+    return Report(str);
+}
+
+std::string testing::combatBench(Client* pClient, uint32 loops)
+{
+    if (loops < 1)
+        loops = 100;
+
+    const uint32 shots(5000), targets(200);
+    std::ostringstream str;
+    str << "Combat benchmark (" << loops << " tics, " << shots << " shots on " << targets << " targets)<br>";
+    SystemManager* pSystem(pClient->SystemMgr());
+    if (pSystem == nullptr) {
+        str << "  skipped (not in a system)<br>";
+        return Report(str);
+    }
+
+    /* synthetic shooters and targets.  temp items of our ship's type, with entities that are not added to the system.
+     *  they have no destiny, so velocity is zero and to-hit is down to range and signature.
+     *  shields are high enough that nothing dies.  the weapon is a temp item of the same type, which ApplyDamage() treats as a turret
+     */
+    const ItemType* pType(sItemFactory.GetType(pClient->GetShip()->typeID()));
+    const double spread(30000);
+    std::map<uint32, SystemEntity*> entities;
+    auto MakeSE = [&]() -> SystemEntity* {
+        ItemData data(pType->id(), ownerSystem, locTemp, flagNone, "combatBench",
+                      GPoint(MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread), MakeRandomFloat(-spread, spread)));
+        InventoryItemRef iRef(new InventoryItem(sItemFactory.GetNextTempID(), *pType, data));
+        iRef->GetAttributeMap()->Load();
+        iRef->SetAttribute(AttrSignatureRadius, MakeRandomFloat(30, 400), false);
+        iRef->SetAttribute(AttrShieldCapacity, 1e12, false);
+        iRef->SetAttribute(AttrShieldCharge, 1e12, false);
+        SystemEntity* pSE(new SystemEntity(iRef, pClient->services(), pSystem));
+        entities[pSE->GetID()] = pSE;
+        return pSE;
+    };
+
+    std::vector<SystemEntity*> target(targets), shooter(shots);
+    for (uint32 i = 0; i < targets; ++i)
+        target[i] = MakeSE();
+    std::vector<uint32> targetOf(shots);
+    std::vector<TurretStats> stats(shots);
+    for (uint32 i = 0; i < shots; ++i) {
+        shooter[i] = MakeSE();
+        targetOf[i] = MakeRandomInt(0, targets - 1);
+        stats[i].range = MakeRandomFloat(5000, 20000);
+        stats[i].falloff = MakeRandomFloat(5000, 20000);
+        stats[i].tracking = MakeRandomFloat(0.01, 0.3);
+        stats[i].sigRes = MakeRandomFloat(40, 400);
+        stats[i].crit = 0.02f;
+        stats[i].miss = 0;
+        stats[i].sigModifier = true;
+    }
+    ItemData wData(pType->id(), ownerSystem, locTemp, flagNone, "combatBench weapon");
+    InventoryItemRef weaponRef(new InventoryItem(sItemFactory.GetNextTempID(), *pType, wData));
+
+    // old method.  each shot reads its target's signature and kinematics, then applies damage and sends damage state
+    float sig(0);
+    double oldTime = TimeLoops(loops, [&](uint32) {
+        for (uint32 i = 0; i < shots; ++i) {
+            SystemEntity* pTarget(target[targetOf[i]]);
+            sig = pTarget->GetSelf()->GetAttribute(AttrSignatureRadius).get_float();
+            if (sig < 0.01f)
+                sig = pTarget->GetSelf()->GetAttribute(AttrRadius).get_float() / 10;
+            GVector trans(pTarget->GetVelocity() - shooter[i]->GetVelocity());
+            float toHit(TurretFormulas::GetToHit(stats[i], shooter[i]->GetPosition().distance(pTarget->GetPosition()), trans.length(), sig, MakeRandomFloat()));
+            Damage d(shooter[i], weaponRef, 20, 20, 0, 0, toHit, 0);
+            pTarget->ApplyDamage(d);
+        }
+    });
+
+    // CombatPass.  all shots queued, then resolved in one Process()
+    BenchCombatPass pass(pSystem, entities);
+    double newTime = TimeLoops(loops, [&](uint32) {
+        for (uint32 i = 0; i < shots; ++i) {
+            Damage d(shooter[i], weaponRef, 20, 20, 0, 0, 1, 0);
+            pass.Queue(shooter[i], target[targetOf[i]], d, stats[i]);
+        }
+        pass.Process();
+    });
+
+    str << "  per-shot: " << oldTime << "us per tic<br>";
+    str << "  CombatPass: " << newTime << "us per tic<br>";
+
+    for (const auto& cur : entities)
+        delete cur.second;
+
+    return Report(str);
+}
+
+std::string testing::fxTest(Client* pClient)
+{
+    std::ostringstream str;
+    str << "Incremental effects test<br>";
+    // only run docked, as this resets and reapplies all ship and skill modifiers
+    if (!pClient->IsDocked()) {
+        str << "  skipped (must be docked)<br>";
+        return Report(str);
+    }
+
+    // run the graph even if it is off in config.  config is put back at the end
+    const bool enabled(sConfig.testing.IncrementalFx);
+    sConfig.testing.IncrementalFx = true;
+    ShipItemRef shipRef(pClient->GetShip());
+    shipRef->ProcessEffects(false);
+    shipRef->ProcessEffects(true, false);
+
+    FxGraph* pGraph(shipRef->GetFxGraph());
+    uint32 additive(0), multiplicative(0);
+    pGraph->CountEdges(additive, multiplicative);
+    str << "  " << shipRef->name() << ": " << pGraph->GetNodeCount() << " modified attribs, " << additive << " additive and ";
+    str << multiplicative << " multiplicative modifiers<br>";
+    if ((additive == 0) or (multiplicative == 0)) {
+        str << "  FAILED: needs both kinds of modifier.  online a fitted module (cpu and power load) and train its skills<br>";
+    } else {
+        // full build thru the graph
+        uint32 count(pGraph->Verify());
+        str << "  graph build: " << count << " attribs differ from the legacy full recompute<br>";
+
+        // writes from outside the graph.  reset the modules' attribs, and the graph has to put its modifiers back on top
+        std::vector<InventoryItemRef> modVec;
+        shipRef->GetModuleManager()->GetModuleListOfRefsAsc(modVec);
+        for (auto& cur : modVec)
+            cur->ResetAttributes();
+        pGraph->Recalculate(false);
+        uint32 reset(pGraph->Verify());
+        str << "  after resetting " << modVec.size() << " modules: " << reset << " attribs differ<br>";
+
+        if ((count + reset) > 0) {
+            str << "  FAILED (see EFFECTS__ERROR log)<br>";
+        } else {
+            str << "  passed<br>";
+        }
+    }
+
+    sConfig.testing.IncrementalFx = enabled;
+    if (!enabled) {
+        // drop the graph and put the legacy values back
+        shipRef->ProcessEffects(false);
+        shipRef->ProcessEffects(true, false);
+    }
+
+    return Report(str);
+}
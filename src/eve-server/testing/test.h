@@ -21,6 +21,34 @@ public:
 
     static void posTest(Client* pClient);
 
+    // ship effects thru FxGraph, checked against the legacy full recompute.  uses the pilot's ship, which needs
+    //   both additive and multiplicative modifiers.  must be docked
+    static std::string fxTest(Client* pClient);
+
+    /* micro-benchmarks run from the 'benchmark' debug command.
+     *   each returns a short report, which is also logged.
+     */
+    // RefPtr iteration cost, ship inventory listing and ship/char effect application
+    static std::string refPtrBench(Client* pClient, uint32 loops);
+    // dscan range and cone queries over 10k random positions, per-entity (old) vs DScanCache
+    static std::string dscanBench(Client* pClient, uint32 loops);
+    // service method dispatch.  hashed table with signature match vs linear scan with exceptions
+    static std::string dispatchBench(Client* pClient, uint32 loops);
+    // name search over 300k synthetic names.  LIKE-style scan of every name vs NameIndex
+    static std::string searchBench(Client* pClient, uint32 loops);
+    // DBResultToCRowset and marshal of the invTypes cache query.  the rest of the marshal benchmarks are in eve-test
+    static std::string rowsetBench(Client* pClient, uint32 loops);
+    // idle npc target scan, 5000 npcs and 500 players in 50 bubbles.  per-npc player copy and scan (old) vs NPCAIPass
+    static std::string npcAIBench(Client* pClient, uint32 loops);
+    // movement integration for 10k balls.  per-ball objects through a virtual call (old) vs BallStore
+    static std::string ballBench(Client* pClient, uint32 loops);
+    /* 5k missile flights, as points and vectors only.  per-tic seek (old) vs MissileVolleyMgr::Intercept() and a due-time queue.
+     *  times the intercept solver, not MissileVolleyMgr itself, as Launch() and Process() need real missile entities
+     */
+    static std::string interceptBench(Client* pClient, uint32 loops);
+    // 5k turret shots on 200 synthetic targets.  per-shot to-hit and damage (old) vs queued in CombatPass and resolved per tic
+    static std::string combatBench(Client* pClient, uint32 loops);
+
 };
 
 
@@ -0,0 +1,753 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+/**
+ * @name EVEMarshalBench.cpp
+ *   serialization micro-benchmarks.  times Marshal/Unmarshal, the deflated variants,
+ *   PyPacket encoding and the generated packet classes over a corpus of payloads shaped
+ *   like the ones the server sends most, and reports ns/op, bytes/op and allocations/op.
+ *
+ *   usage: eve-test marshal/EVEMarshalBench [--time <ms>] [--filter <str>]
+ *                   [--save <file>] [--baseline <file>] [--threshold <pct>]
+ *
+ *   --save writes the results as a baseline.  --baseline compares against one, and fails
+ *   if any op got slower than threshold (default 10%), or allocates or leaks more than it did.
+ *   ops that leak are run fewer times, so their leaks stay bounded.
+ *
+ *   DBResultToCRowset needs a live query result, so it is timed by the server's
+ *   'benchmark rowset' command instead.
+ */
+
+#include "eve-test.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <new>
+
+#include "packets/Destiny.h"
+#include "packets/LSCPkts.h"
+#include "python/PyPacket.h"
+
+#ifdef HAVE_WINDOWS_H
+#   define BlockSize(ptr) _msize(ptr)
+#else
+#   include <malloc.h>
+#   define BlockSize(ptr) malloc_usable_size(ptr)
+#endif
+
+/*
+ * allocations made by the bench thread while an op is being measured are counted here, so each op can
+ * report allocations, allocated bytes and bytes it never released.  outside of Run()'s timed batches
+ * (and on every other thread) these are plain malloc/free, so the rest of eve-test is not affected.
+ * live bytes use the allocator's block size, as that is known on both new and delete.
+ * zlib uses malloc directly, so its buffers are not included.
+ */
+namespace {
+    thread_local bool t_counting(false);
+    std::atomic<int64> s_allocCount(0);
+    std::atomic<int64> s_allocBytes(0);
+    std::atomic<int64> s_liveBytes(0);
+}
+
+void* operator new(size_t size)
+{
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    if (t_counting) {
+        s_allocCount.fetch_add(1, std::memory_order_relaxed);
+        s_allocBytes.fetch_add(size, std::memory_order_relaxed);
+        s_liveBytes.fetch_add(BlockSize(ptr), std::memory_order_relaxed);
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr == nullptr)
+        return;
+    if (t_counting)
+        s_liveBytes.fetch_sub(BlockSize(ptr), std::memory_order_relaxed);
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+namespace {
+    struct Result {
+        double ns;          // per op, fastest of three batches
+        double bytes;       // allocated per op
+        double allocs;      // per op
+        double leaked;      // bytes allocated per op and never released
+        uint32 size;        // stream size the op wrote or read
+    };
+
+    struct Bench {
+        std::string name;
+        // runs the op once.  returns the stream size it wrote or read, or 0 on error
+        std::function<uint32()> op;
+    };
+
+    /*  corpus  */
+
+    const int32 shipID(140000100);
+    const int32 charID(90000100);
+    const int32 corpID(98000001);
+
+    PyTuple* DamageState(double shield, double armor, double hull)
+    {
+        PyTuple* shieldState = new PyTuple(3);
+            shieldState->SetItem(0, new PyFloat(shield));
+            shieldState->SetItem(1, new PyFloat(250000.0));
+            shieldState->SetItem(2, new PyLong(Win32TimeNow()));
+        PyTuple* state = new PyTuple(3);
+            state->SetItem(0, shieldState);
+            state->SetItem(1, new PyFloat(armor));
+            state->SetItem(2, new PyFloat(hull));
+        return state;
+    }
+
+    // one tick of movement and damage updates in a busy bubble
+    PyTuple* DestinyUpdate()
+    {
+        PyList* updates = new PyList();
+        for (int32 i = 0; i < 12; ++i) {
+            int32 ballID(shipID + i);
+            PyTuple* args(nullptr);
+            PyTuple* update = new PyTuple(2);
+            switch (i % 4) {
+                case 0: {
+                    args = new PyTuple(4);
+                    args->SetItem(0, new PyInt(ballID));
+                    args->SetItem(1, new PyFloat(0.577));
+                    args->SetItem(2, new PyFloat(-0.577));
+                    args->SetItem(3, new PyFloat(0.577));
+                    update->SetItem(0, new PyString("GotoDirection"));
+                } break;
+                case 1: {
+                    args = new PyTuple(4);
+                    args->SetItem(0, new PyInt(ballID));
+                    args->SetItem(1, new PyFloat(124.5));
+                    args->SetItem(2, new PyFloat(-87.25));
+                    args->SetItem(3, new PyFloat(12.0));
+                    update->SetItem(0, new PyString("SetBallVelocity"));
+                } break;
+                case 2: {
+                    args = new PyTuple(2);
+                    args->SetItem(0, new PyInt(ballID));
+                    args->SetItem(1, new PyFloat(0.75));
+                    update->SetItem(0, new PyString("SetSpeedFraction"));
+                } break;
+                case 3: {
+                    args = new PyTuple(2);
+                    args->SetItem(0, new PyInt(ballID));
+                    args->SetItem(1, DamageState(0.62, 1.0, 1.0));
+                    update->SetItem(0, new PyString("OnDamageStateChange"));
+                } break;
+            }
+            update->SetItem(1, args);
+
+            DoDestinyAction action;
+                action.stamp = 1680000;
+                action.update = update;
+            updates->AddItem(action.Encode());
+        }
+
+        DoDestinyUpdateMain_2 dum;
+            dum.updates = updates;
+            dum.waitForBubble = false;
+        return dum.Encode();
+    }
+
+    // state sent on entering a bubble of 150 balls
+    SetState* SetStateData()
+    {
+        const uint32 balls(150);
+        SetState* ss = new SetState();
+        ss->stamp = 1680000;
+        ss->ego = shipID;
+
+        // ball state is a packed binary blob, ~70 bytes each
+        Buffer* state = new Buffer();
+        state->Append<uint8>(0);
+        state->Append<int32>(1680000);
+        for (uint32 i = 0; i < balls; ++i) {
+            state->Append<int64>(shipID + i);
+            state->Append<uint8>(0xE0);
+            state->Append<float>(40.0f);
+            for (uint8 j = 0; j < 3; ++j)
+                state->Append<double>(MakeRandomFloat(-1e10, 1e10));
+            state->Append<float>(1.3e6f);
+            for (uint8 j = 0; j < 4; ++j)
+                state->Append<float>(MakeRandomFloat(0, 200));
+            state->Append<uint8>(0xFF);
+        }
+        ss->destiny_state = new PyBuffer(&state);
+
+        ss->slims = new PyList();
+        for (uint32 i = 0; i < balls; ++i) {
+            SlimItem slim;
+                slim.itemID = shipID + i;
+                slim.typeID = 24698;
+                slim.corpID = corpID;
+                slim.modules.push_back(shipID + balls + i);
+                slim.modules.push_back(shipID + balls * 2 + i);
+                slim.securityStatus = 1.5;
+                slim.ownerID = charID + i;
+                slim.groupID = 419;
+                slim.categoryID = 6;
+                slim.charID = charID + i;
+            ss->slims->AddItem(slim.Encode());
+            ss->damageState[shipID + i] = DamageState(1.0, 1.0, 1.0);
+        }
+
+        ss->droneState = PyStatic.NewNone();
+        ss->solItem = PyStatic.NewNone();
+        ss->effectStates = new PyList();
+        ss->allianceBridges = new PyList();
+        return ss;
+    }
+
+    // GetOrders() result for a popular type
+    PyRep* MarketOrders()
+    {
+        DBRowDescriptor* header = new DBRowDescriptor();
+            header->AddColumn("price",          DBTYPE_CY);
+            header->AddColumn("volRemaining",   DBTYPE_R8);
+            header->AddColumn("typeID",         DBTYPE_I4);
+            header->AddColumn("range",          DBTYPE_I4);
+            header->AddColumn("orderID",        DBTYPE_I4);
+            header->AddColumn("volEntered",     DBTYPE_I4);
+            header->AddColumn("minVolume",      DBTYPE_I4);
+            header->AddColumn("bid",            DBTYPE_BOOL);
+            header->AddColumn("issueDate",      DBTYPE_FILETIME);
+            header->AddColumn("duration",       DBTYPE_I2);
+            header->AddColumn("stationID",      DBTYPE_I4);
+            header->AddColumn("regionID",       DBTYPE_I4);
+            header->AddColumn("solarSystemID",  DBTYPE_I4);
+            header->AddColumn("jumps",          DBTYPE_I4);
+        CRowSet* rs = new CRowSet(&header);
+        for (int32 i = 0; i < 1000; ++i) {
+            PyPackedRow* row = rs->NewRow();
+            row->SetField("price",          new PyLong(MakeRandomInt(40000, 90000)));
+            row->SetField("volRemaining",   new PyFloat(MakeRandomInt(1, 100000)));
+            row->SetField("typeID",         new PyInt(34));
+            row->SetField("range",          new PyInt(32767));
+            row->SetField("orderID",        new PyInt(2000000 + i));
+            row->SetField("volEntered",     new PyInt(100000));
+            row->SetField("minVolume",      new PyInt(1));
+            row->SetField("bid",            new PyBool(i % 2));
+            row->SetField("issueDate",      new PyLong(Win32TimeNow()));
+            row->SetField("duration",       new PyInt(90));
+            row->SetField("stationID",      new PyInt(60003760));
+            row->SetField("regionID",       new PyInt(10000002));
+            row->SetField("solarSystemID",  new PyInt(30000142));
+            row->SetField("jumps",          new PyInt(0));
+        }
+        return rs;
+    }
+
+    // hangar List() of 2000 items, with the invItem header from StaticDataMgr::CreateHeader()
+    PyRep* InventoryList()
+    {
+        PyList* keywords = new PyList();
+            keywords->AddItem(new_tuple(new PyString("stacksize"), new PyToken("util.StackSize")));
+            keywords->AddItem(new_tuple(new PyString("singleton"), new PyToken("util.Singleton")));
+        DBRowDescriptor* header = new DBRowDescriptor(keywords);
+            header->AddColumn("itemID",     DBTYPE_I8);
+            header->AddColumn("typeID",     DBTYPE_I4);
+            header->AddColumn("ownerID",    DBTYPE_I4);
+            header->AddColumn("locationID", DBTYPE_I4);
+            header->AddColumn("flagID",     DBTYPE_I2);
+            header->AddColumn("quantity",   DBTYPE_I4);
+            header->AddColumn("groupID",    DBTYPE_I4);
+            header->AddColumn("categoryID", DBTYPE_I4);
+            header->AddColumn("customInfo", DBTYPE_STR);
+        CRowSet* rs = new CRowSet(&header);
+        for (int32 i = 0; i < 2000; ++i) {
+            PyPackedRow* row = rs->NewRow();
+            row->SetField("itemID",     new PyLong(140010000 + i));
+            row->SetField("typeID",     new PyInt(MakeRandomInt(18, 30000)));
+            row->SetField("ownerID",    new PyInt(charID));
+            row->SetField("locationID", new PyInt(60003760));
+            row->SetField("flagID",     new PyInt(4));
+            row->SetField("quantity",   new PyInt(i % 3 ? MakeRandomInt(1, 5000) : -1));
+            row->SetField("groupID",    new PyInt(MakeRandomInt(1, 1000)));
+            row->SetField("categoryID", new PyInt(MakeRandomInt(1, 30)));
+            row->SetField("customInfo", new PyString(""));
+        }
+        return rs;
+    }
+
+    // one chunk of the dogmaExpressions bulk table
+    PyRep* BulkChunk()
+    {
+        DBRowDescriptor* header = new DBRowDescriptor();
+            header->AddColumn("expressionID",           DBTYPE_I4);
+            header->AddColumn("operandID",              DBTYPE_I4);
+            header->AddColumn("arg1",                   DBTYPE_I4);
+            header->AddColumn("arg2",                   DBTYPE_I4);
+            header->AddColumn("expressionValue",        DBTYPE_WSTR);
+            header->AddColumn("description",            DBTYPE_WSTR);
+            header->AddColumn("expressionName",         DBTYPE_WSTR);
+            header->AddColumn("expressionTypeID",       DBTYPE_I4);
+            header->AddColumn("expressionGroupID",      DBTYPE_I4);
+            header->AddColumn("expressionAttributeID",  DBTYPE_I4);
+        CRowSet* rs = new CRowSet(&header);
+        char buf[64];
+        for (int32 i = 0; i < 3000; ++i) {
+            PyPackedRow* row = rs->NewRow();
+            row->SetField("expressionID",           new PyInt(i + 1));
+            row->SetField("operandID",              new PyInt(MakeRandomInt(1, 80)));
+            row->SetField("arg1",                   new PyInt(MakeRandomInt(1, 3000)));
+            row->SetField("arg2",                   new PyInt(MakeRandomInt(1, 3000)));
+            snprintf(buf, sizeof(buf), "%i", MakeRandomInt(0, 5000));
+            row->SetField("expressionValue",        new PyWString(buf, strlen(buf)));
+            snprintf(buf, sizeof(buf), "expression %i", i + 1);
+            row->SetField("description",            new PyWString(buf, strlen(buf)));
+            snprintf(buf, sizeof(buf), "Ship.AddItemModifier(%i)", MakeRandomInt(1, 2000));
+            row->SetField("expressionName",         new PyWString(buf, strlen(buf)));
+            row->SetField("expressionTypeID",       new PyInt(0));
+            row->SetField("expressionGroupID",      new PyInt(0));
+            row->SetField("expressionAttributeID",  new PyInt(MakeRandomInt(0, 2000)));
+        }
+        return rs;
+    }
+
+    OnLSC_SendMessage* ChatMessage()
+    {
+        OnLSC_SendMessage* msg = new OnLSC_SendMessage();
+            msg->channelID = new PyInt(1);
+            msg->member_count = 120;
+            msg->sender = new OnLSC_SenderInfo();
+            msg->sender->corpID = corpID;
+            msg->sender->senderID = charID;
+            msg->sender->senderName = "Load Bot";
+            msg->sender->senderType = 1373;
+            msg->sender->role = 1;
+            msg->sender->corp_role = 0;
+            msg->message = "wts 10 x Caldari Navy Ballistic Control System, 40m each.  convo me";
+        return msg;
+    }
+
+    /*  ops  */
+
+    uint32 DoMarshal(const PyRep* rep)
+    {
+        Buffer into;
+        return (Marshal(rep, into) ? into.size() : 0);
+    }
+
+    uint32 DoUnmarshal(const Buffer& data)
+    {
+        PyRep* rep = Unmarshal(data);
+        if (rep == nullptr)
+            return 0;
+        PyDecRef(rep);
+        return data.size();
+    }
+
+    uint32 DoMarshalDeflate(const PyRep* rep)
+    {
+        Buffer into;
+        return (MarshalDeflate(rep, into) ? into.size() : 0);
+    }
+
+    uint32 DoInflateUnmarshal(const Buffer& data)
+    {
+        PyRep* rep = InflateUnmarshal(data);
+        if (rep == nullptr)
+            return 0;
+        PyDecRef(rep);
+        return data.size();
+    }
+
+    // builds the packet the way Client::SendNotification() does, then encodes and marshals it
+    uint32 DoNotification(const char* notifyType, PyTuple* args)
+    {
+        EVENotificationStream notify;
+            notify.notifyType = notifyType;
+            notify.remoteObject = 1;
+            notify.args = args;
+        PyIncRef(args);
+
+        PyPacket packet;
+            packet.type_string = "macho.Notification";
+            packet.type = NOTIFICATION;
+            packet.source.type = PyAddress::Node;
+            packet.source.objectID = 888444;
+            packet.dest.type = PyAddress::Broadcast;
+            packet.dest.service = notifyType;
+            packet.dest.bcast_idtype = "charid";
+            packet.userid = 1;
+            packet.payload = notify.Encode();
+            packet.named_payload = new PyDict();
+            packet.named_payload->SetItemString("sn", new PyInt(1));
+
+        PyRep* rep = packet.Encode();
+        // Encode() hands payload and named_payload to rep
+        packet.payload = nullptr;
+        packet.named_payload = nullptr;
+        uint32 size(DoMarshal(rep));
+        PyDecRef(rep);
+        return size;
+    }
+
+    // builds the packet the way Client::_SendCallReturn() does, then encodes and marshals it
+    uint32 DoCallReturn(PyRep* result)
+    {
+        PyPacket packet;
+            packet.type_string = "macho.CallRsp";
+            packet.type = CALL_RSP;
+            packet.source.type = PyAddress::Node;
+            packet.source.objectID = 888444;
+            packet.source.service = "marketProxy";
+            packet.dest.type = PyAddress::Client;
+            packet.dest.objectID = 1;
+            packet.dest.callID = 42;
+            packet.userid = 1;
+            packet.payload = new PyTuple(1);
+        PyIncRef(result);
+        packet.payload->SetItem(0, new PySubStream(result));
+
+        PyRep* rep = packet.Encode();
+        packet.payload = nullptr;
+        uint32 size(DoMarshal(rep));
+        PyDecRef(rep);
+        return size;
+    }
+
+    // what the receiving side does with a marshaled packet
+    uint32 DoReceive(const Buffer& data)
+    {
+        PyRep* rep = Unmarshal(data);
+        if (rep == nullptr)
+            return 0;
+        PyPacket packet;
+        if (!packet.Decode(&rep))
+            return 0;
+        return data.size();
+    }
+
+    /*  runner  */
+
+    Result Run(const Bench& bench, double targetUs)
+    {
+        Result res = Result();
+        // first call warms up.  the second shows whether the op leaks, which limits how often it can run
+        bench.op();
+        int64 live(s_liveBytes.load());
+        t_counting = true;
+        res.size = bench.op();
+        t_counting = false;
+        int64 leak(std::max<int64>(s_liveBytes.load() - live, 0));
+        const int64 leakLimit(0x2000000);
+
+        // double the loop count until a batch takes a third of the target time
+        uint32 loops(1);
+        double start(0), elapsed(0);
+        while (true) {
+            start = GetTimeUSeconds();
+            for (uint32 i = 0; i < loops; ++i)
+                res.size = bench.op();
+            elapsed = GetTimeUSeconds() - start;
+            if ((elapsed * 3 >= targetUs) or (loops >= 0x1000000) or (leak * loops * 2 > leakLimit))
+                break;
+            loops *= 2;
+        }
+        res.ns = elapsed * 1000 / loops;
+
+        for (uint8 i = 0; i < 3; ++i) {
+            int64 count(s_allocCount.load()), bytes(s_allocBytes.load());
+            live = s_liveBytes.load();
+            t_counting = true;
+            start = GetTimeUSeconds();
+            for (uint32 j = 0; j < loops; ++j)
+                bench.op();
+            elapsed = GetTimeUSeconds() - start;
+            t_counting = false;
+            res.ns = std::min(res.ns, elapsed * 1000 / loops);
+            res.allocs = double(s_allocCount.load() - count) / loops;
+            res.bytes = double(s_allocBytes.load() - bytes) / loops;
+            // an op may free blocks from before the batch, which are not counted as allocated here
+            res.leaked = double(std::max<int64>(s_liveBytes.load() - live, 0)) / loops;
+        }
+        return res;
+    }
+
+    bool LoadBaseline(const std::string& fileName, std::map<std::string, Result>& into)
+    {
+        FILE* fp = fopen(fileName.c_str(), "r");
+        if (fp == nullptr)
+            return false;
+
+        char buf[256], name[128];
+        Result res = Result();
+        while (fgets(buf, sizeof(buf), fp) != nullptr) {
+            if (buf[0] == '#')
+                continue;
+            if (sscanf(buf, "%127s %lf %lf %lf %lf %u", name, &res.ns, &res.bytes, &res.allocs, &res.leaked, &res.size) == 6)
+                into[name] = res;
+        }
+        fclose(fp);
+        return true;
+    }
+
+    bool SaveBaseline(const std::string& fileName, const std::vector<std::pair<std::string, Result>>& results)
+    {
+        FILE* fp = fopen(fileName.c_str(), "w");
+        if (fp == nullptr)
+            return false;
+
+        fprintf(fp, "# name ns/op bytes/op allocs/op leaked/op size\n");
+        for (auto& cur : results)
+            fprintf(fp, "%s %.1f %.1f %.2f %.1f %u\n", cur.first.c_str(), cur.second.ns, cur.second.bytes, cur.second.allocs, \
+                    cur.second.leaked, cur.second.size);
+        fclose(fp);
+        return true;
+    }
+
+    double Change(double base, double now)
+    {
+        return (base > 0 ? (now - base) * 100 / base : 0);
+    }
+}
+
+int marshal_EVEMarshalBench( int argc, char* argv[] )
+{
+    double targetUs(300000), threshold(10);
+    std::string filter, saveFile, baselineFile;
+    // argv[0] is the test name
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (i + 1 >= argc) {
+            ::printf("Missing value for %s\n", arg.c_str());
+            return EXIT_FAILURE;
+        }
+        std::string val(argv[++i]);
+        if (arg == "--time") {
+            targetUs = atof(val.c_str()) * 1000;
+        } else if (arg == "--filter") {
+            filter = val;
+        } else if (arg == "--save") {
+            saveFile = val;
+        } else if (arg == "--baseline") {
+            baselineFile = val;
+        } else if (arg == "--threshold") {
+            threshold = atof(val.c_str());
+        } else {
+            ::printf("Unknown option %s\n", arg.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::map<std::string, Result> baseline;
+    if (!baselineFile.empty() and !LoadBaseline(baselineFile, baseline)) {
+        ::printf("Unable to read baseline %s\n", baselineFile.c_str());
+        return EXIT_FAILURE;
+    }
+
+    // build the corpus, and its marshaled forms for the read side
+    PyTuple* destiny = DestinyUpdate();
+    SetState* setState = SetStateData();
+    PyTuple* state = setState->Encode();
+    PyRep* market = MarketOrders();
+    PyRep* inventory = InventoryList();
+    PyRep* bulk = BulkChunk();
+    OnLSC_SendMessage* chat = ChatMessage();
+    PyTuple* chatRep = chat->Encode();
+
+    std::vector<std::pair<std::string, PyRep*>> corpus;
+    corpus.push_back(std::make_pair("destiny", destiny));
+    corpus.push_back(std::make_pair("setstate", state));
+    corpus.push_back(std::make_pair("market", market));
+    corpus.push_back(std::make_pair("inventory", inventory));
+    corpus.push_back(std::make_pair("bulk", bulk));
+    corpus.push_back(std::make_pair("chat", chatRep));
+
+    std::map<std::string, Buffer> marshaled, deflated;
+    for (auto& cur : corpus) {
+        // everything has to survive a round trip, or the numbers mean nothing.
+        //  dicts may come back in a different order, so only the size is compared
+        Buffer& data = marshaled[cur.first];
+        PyRep* rep(nullptr);
+        Buffer again;
+        if (!Marshal(cur.second, data) or ((rep = Unmarshal(data)) == nullptr) or !Marshal(rep, again) or (again.size() != data.size())) {
+            ::printf("%s does not survive a marshal round trip.\n", cur.first.c_str());
+            PySafeDecRef(rep);
+            return EXIT_FAILURE;
+        }
+        PyDecRef(rep);
+        if (!MarshalDeflate(cur.second, deflated[cur.first])) {
+            ::printf("%s failed to marshal deflated.\n", cur.first.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    Buffer chatPacket;
+    {
+        PyPacket packet;
+        packet.type_string = "macho.Notification";
+        packet.type = NOTIFICATION;
+        packet.source.type = PyAddress::Node;
+        packet.source.objectID = 888444;
+        packet.dest.type = PyAddress::Broadcast;
+        packet.dest.service = "OnLSC";
+        packet.dest.bcast_idtype = "charid";
+        packet.userid = 1;
+        EVENotificationStream notify;
+        notify.notifyType = "OnLSC";
+        notify.remoteObject = 1;
+        notify.args = chatRep;
+        PyIncRef(chatRep);
+        packet.payload = notify.Encode();
+        PyRep* rep = packet.Encode();
+        packet.payload = nullptr;
+        Marshal(rep, chatPacket);
+        PyDecRef(rep);
+    }
+
+    std::vector<Bench> benches;
+    for (auto& cur : corpus) {
+        const PyRep* rep(cur.second);
+        const Buffer& data = marshaled[cur.first];
+        const Buffer& zdata = deflated[cur.first];
+        benches.push_back(Bench{cur.first + "/Marshal", [rep]() { return DoMarshal(rep); }});
+        benches.push_back(Bench{cur.first + "/Unmarshal", [&data]() { return DoUnmarshal(data); }});
+        // only the large payloads are ever big enough to be deflated
+        if (data.size() >= 0x2000) {
+            benches.push_back(Bench{cur.first + "/MarshalDeflate", [rep]() { return DoMarshalDeflate(rep); }});
+            benches.push_back(Bench{cur.first + "/InflateUnmarshal", [&zdata]() { return DoInflateUnmarshal(zdata); }});
+        }
+    }
+
+    benches.push_back(Bench{"destiny/PyPacket::Encode", [destiny]() { return DoNotification("DoDestinyUpdate", destiny); }});
+    benches.push_back(Bench{"chat/PyPacket::Encode", [chatRep]() { return DoNotification("OnLSC", chatRep); }});
+    benches.push_back(Bench{"chat/PyPacket::Decode", [&chatPacket]() { return DoReceive(chatPacket); }});
+    benches.push_back(Bench{"market/PyPacket::Encode", [market]() { return DoCallReturn(market); }});
+
+    // generated classes don't touch a stream, so these report the size of the payload they build or read
+    uint32 stateSize(marshaled["setstate"].size()), chatSize(marshaled["chat"].size());
+    benches.push_back(Bench{"setstate/xmlp Encode", [setState, stateSize]() {
+        PyTuple* rep = setState->Encode();
+        PyDecRef(rep);
+        return stateSize;
+    }});
+    benches.push_back(Bench{"setstate/xmlp Decode", [state, stateSize]() {
+        SetState ss;
+        return (ss.Decode(state) ? stateSize : 0);
+    }});
+    benches.push_back(Bench{"chat/xmlp Encode", [chat, chatSize]() {
+        PyTuple* rep = chat->Encode();
+        PyDecRef(rep);
+        return chatSize;
+    }});
+    benches.push_back(Bench{"chat/xmlp Decode", [chatRep, chatSize]() {
+        OnLSC_SendMessage msg;
+        return (msg.Decode(chatRep) ? chatSize : 0);
+    }});
+
+    ::printf("%-34s %11s %11s %10s %10s %9s", "op", "ns/op", "bytes/op", "allocs/op", "leaked/op", "size");
+    if (!baseline.empty())
+        ::printf(" %8s %8s %8s", "ns", "bytes", "allocs");
+    ::printf("\n");
+
+    bool failed(false);
+    uint32 regressions(0);
+    std::vector<std::pair<std::string, Result>> results;
+    for (auto& cur : benches) {
+        // names are single tokens in the baseline file
+        std::string name(cur.name);
+        std::replace(name.begin(), name.end(), ' ', '_');
+        if (!filter.empty() and (name.find(filter) == std::string::npos))
+            continue;
+
+        Result res(Run(cur, targetUs));
+        if (res.size == 0) {
+            ::printf("%-34s failed\n", name.c_str());
+            failed = true;
+            continue;
+        }
+        results.push_back(std::make_pair(name, res));
+        ::printf("%-34s %11.1f %11.1f %10.2f %10.1f %9u", name.c_str(), res.ns, res.bytes, res.allocs, res.leaked, res.size);
+
+        if (!baseline.empty()) {
+            auto itr = baseline.find(name);
+            if (itr == baseline.end()) {
+                ::printf("      new");
+            } else {
+                const Result& base = itr->second;
+                double ns(Change(base.ns, res.ns)), bytes(Change(base.bytes, res.bytes)), allocs(Change(base.allocs, res.allocs));
+                ::printf(" %+7.1f%% %+7.1f%% %+7.1f%%", ns, bytes, allocs);
+                // allocations are deterministic, so any increase counts.  time is allowed some noise
+                if ((ns > threshold) or (bytes > threshold) or (res.allocs > base.allocs + 0.01) or (res.leaked > base.leaked + 0.5)) {
+                    ::printf("  REGRESSION");
+                    ++regressions;
+                }
+            }
+        }
+        ::printf("\n");
+    }
+
+    if (!saveFile.empty()) {
+        if (SaveBaseline(saveFile, results)) {
+            ::printf("Baseline saved to %s\n", saveFile.c_str());
+        } else {
+            ::printf("Unable to write baseline %s\n", saveFile.c_str());
+            failed = true;
+        }
+    }
+    if (regressions > 0)
+        ::printf("%u ops regressed against %s (threshold %.1f%%)\n", regressions, baselineFile.c_str(), threshold);
+
+    PyDecRef(destiny);
+    PyDecRef(state);
+    PyDecRef(market);
+    PyDecRef(inventory);
+    PyDecRef(bulk);
+    PyDecRef(chatRep);
+    SafeDelete(setState);
+    SafeDelete(chat);
+
+    return ((failed or (regressions > 0)) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -0,0 +1,88 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+#include "eve-test.h"
+
+#include "log/AsyncLog.h"
+
+/*
+ * producers and Stop() run concurrently here, so this is the test to run under -fsanitize=thread.
+ * every message queued must be written out, or counted as dropped.
+ */
+static const uint32 s_threads = 4;
+static const uint32 s_messages = 1000;
+
+// writes count messages, or until the writer stops when count is 0.  returns number queued
+static void Produce(uint32 count, std::atomic<int64>& queued)
+{
+    char text[64];
+    int length(0);
+    for (uint32 i = 0; (count == 0) or (i < count); ++i) {
+        length = snprintf(text, sizeof(text), " [AsyncLogTest] thread message %u\n", i);
+        if (!sAsyncLog.Write(AsyncLog::TARGET_LOGSYS, text, length))
+            break;
+        queued.fetch_add(1);
+    }
+}
+
+static bool RunPhase(const char* name, bool block, uint32 count, uint32 stopAfter)
+{
+    std::atomic<int64> queued(0);
+    int64 written(sAsyncLog.GetWritten()), dropped(sAsyncLog.GetDropped());
+
+    sAsyncLog.Start(block);
+    std::vector<std::thread> threads;
+    for (uint32 i = 0; i < s_threads; ++i)
+        threads.emplace_back(Produce, count, std::ref(queued));
+    if (stopAfter > 0) {
+        // stop while producers are still writing
+        std::this_thread::sleep_for(std::chrono::milliseconds(stopAfter));
+        sAsyncLog.Stop();
+        for (auto& cur : threads)
+            cur.join();
+    } else {
+        for (auto& cur : threads)
+            cur.join();
+        sAsyncLog.Stop();
+    }
+
+    written = sAsyncLog.GetWritten() - written;
+    dropped = sAsyncLog.GetDropped() - dropped;
+    bool ok((written + dropped) == queued.load());
+    if (block)
+        ok &= (dropped == 0);
+    ::printf( "%-24s queued %li, written %li, dropped %li  %s\n", name, queued.load(), written, dropped, (ok ? "ok" : "FAILED") );
+    return ok;
+}
+
+int utils_AsyncLogTest( int argc, char* argv[] )
+{
+    bool ok(true);
+    ok &= RunPhase("block", true, s_messages, 0);
+    ok &= RunPhase("drop", false, s_messages, 0);
+    ok &= RunPhase("stop while writing", true, 0, 5);
+    ok &= !AsyncLog::IsRunning();
+
+    return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
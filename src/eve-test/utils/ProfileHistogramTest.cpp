@@ -0,0 +1,67 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+#include "eve-test.h"
+
+#include "utils/ProfileHistogram.h"
+
+int utils_ProfileHistogramTest( int argc, char* argv[] )
+{
+    bool ok(true);
+    if ((ProfileHistogram::GetBucket(0) != 0) or (ProfileHistogram::GetBucket(-5) != 0)
+    or (ProfileHistogram::GetBucket(63) != 63) or (ProfileHistogram::GetBucket(64) != 64)) {
+        ::puts( "Linear buckets are wrong." );
+        ok = false;
+    }
+
+    // buckets never go down, and each bucket's upper bound is within ~3% of the values in it
+    uint16 bucket(0), last(0);
+    double upper(0);
+    for (int64 ns = 1; ns < ((int64)1 << 40); ns += (ns >> 4) + 1) {
+        bucket = ProfileHistogram::GetBucket(ns);
+        upper = ProfileHistogram::GetBucketValue(bucket) * 1000;
+        if ((bucket < last) or (upper < ns) or (upper > ns * 1.04 + 1)) {
+            ::printf( "Bucket %u for %lins is wrong (last %u, upper bound %.0fns).\n", bucket, ns, last, upper );
+            ok = false;
+            break;
+        }
+        last = bucket;
+    }
+    if (ProfileHistogram::GetBucket(INT64_MAX) != ProfileHistogram::bucketCount - 1) {
+        ::puts( "Values past the last bucket are not clamped." );
+        ok = false;
+    }
+
+    ProfileHistogram hist;
+    for (uint32 i = 1; i <= 1000; ++i)
+        hist.Record(i);     // 1us..1ms
+    ::printf( "p50 %.1fus, p99 %.1fus, max %.1fus\n", hist.Percentile(50), hist.Percentile(99), hist.Max() );
+    if ((hist.Percentile(50) < 500) or (hist.Percentile(50) > 500 * 1.04)
+    or (hist.Percentile(99) < 990) or (hist.Percentile(99) > 1000)) {
+        ::puts( "Percentiles are wrong." );
+        ok = false;
+    }
+
+    return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
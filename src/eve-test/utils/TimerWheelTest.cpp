@@ -0,0 +1,96 @@
+/*
+    ------------------------------------------------------------------------------------
+    LICENSE:
+    ------------------------------------------------------------------------------------
+    This file is part of EVEmu: EVE Online Server Emulator
+    Copyright 2006 - 2021 The EVEmu Team
+    For the latest information visit https://evemu.dev
+    ------------------------------------------------------------------------------------
+    This program is free software; you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any later
+    version.
+
+    This program is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License along with
+    this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+    Place - Suite 330, Boston, MA 02111-1307, USA, or go to
+    http://www.gnu.org/copyleft/lesser.txt.
+    ------------------------------------------------------------------------------------
+*/
+
+#include "eve-test.h"
+
+#include "utils/timer.h"
+#include "utils/TimerWheel.h"
+
+/* owner that cancels its timer in the d'tor, as TimerWheel requires */
+class TimerOwner
+{
+public:
+    TimerOwner(uint32 delay, uint32& fired)
+    : m_fired(fired) { m_timerID = sTimerWheel.Schedule(delay, [this]() { ++m_fired; }); }
+    ~TimerOwner()                                       { sTimerWheel.Cancel(m_timerID); }
+
+private:
+    uint32& m_fired;
+    uint32 m_timerID;
+};
+
+static bool Check(bool test, const char* what)
+{
+    ::printf( "%-60s %s\n", what, (test ? "ok" : "FAILED") );
+    return test;
+}
+
+int utils_TimerWheelTest( int argc, char* argv[] )
+{
+    TimerWheel& wheel = sTimerWheel;
+    // the wheel only moves in Process(), so drive it from its own start time
+    uint32 now = Timer::Now();
+    wheel.Process(now);
+
+    bool ok(true);
+    uint32 near(0), far(0), cancelled(0), repeat(0), owned(0);
+
+    // level 0, and far enough out to cascade down from level 2
+    uint32 nearID = wheel.Schedule(100, [&near]() { ++near; });
+    uint32 farID = wheel.Schedule(70000, [&far]() { ++far; });
+    uint32 cancelID = wheel.Schedule(50, [&cancelled]() { ++cancelled; });
+    ok &= Check(nearID != 0 and farID != 0 and cancelID != 0, "Schedule() returns nonzero ids");
+    ok &= Check(wheel.GetRemainingTime(farID) == 70000, "GetRemainingTime() on new timer");
+
+    ok &= Check(wheel.Cancel(cancelID), "Cancel() of pending timer");
+    ok &= Check(!wheel.Cancel(cancelID), "Cancel() twice returns false");
+    ok &= Check(!wheel.Cancel(0), "Cancel(0) is ignored");
+
+    // periodic use.  callback reschedules itself three times
+    std::function<void()> tic = [&]() { if (++repeat < 3) wheel.Schedule(1000, tic); };
+    wheel.Schedule(1000, tic);
+
+    // owner destroyed before its timer is due.  callback must not run
+    {
+        TimerOwner owner(200, owned);
+    }
+
+    wheel.Process(now + 99);
+    ok &= Check(near == 0, "timer does not run early");
+    wheel.Process(now + 100);
+    ok &= Check(near == 1, "timer runs when due");
+    ok &= Check(!wheel.IsScheduled(nearID), "timer is removed after running");
+    ok &= Check(cancelled == 0, "cancelled timer does not run");
+    ok &= Check(owned == 0, "timer of destroyed owner does not run");
+
+    wheel.Process(now + 69999);
+    ok &= Check(far == 0, "cascaded timer does not run early");
+    ok &= Check(repeat == 3, "self-rescheduling timer runs each period");
+    wheel.Process(now + 70000);
+    ok &= Check(far == 1, "cascaded timer runs when due");
+    ok &= Check(near == 1, "timer runs only once");
+    ok &= Check(wheel.Count() == 0, "wheel is empty");
+
+    return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}